@@ -0,0 +1,163 @@
+/* dht/batch.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Application of a discrete Hankel transform to many sampled functions
+ * at once. gsl_dht stores the symmetric numerator J_nu(j_n j_m / j_N)
+ * in packed form, so gsl_dht_apply is a matrix-vector product limited
+ * by memory bandwidth. Here the full transform matrix
+ *
+ * K_{mi} = 2 (xmax / j_N)^2 J_nu(j_m j_i / j_N) / J_{nu+1}^2(j_i)
+ *
+ * is expanded once, and a set of functions stored in the rows of a
+ * matrix F is transformed with a single matrix-matrix product,
+ * G = F K^T, using gsl_blas_dgemm.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_dht.h>
+
+/*
+gsl_dht_batch_alloc()
+  Allocate a workspace for batched transforms
+
+Inputs: t - discrete Hankel transform, which must be initialized
+
+Return: pointer to workspace
+
+Notes:
+1) The transform matrix is copied from t; if t is later re-initialized
+with gsl_dht_init, gsl_dht_batch_init must be called to update it
+*/
+
+gsl_dht_batch *
+gsl_dht_batch_alloc(const gsl_dht * t)
+{
+  gsl_dht_batch * b;
+
+  b = calloc(1, sizeof(gsl_dht_batch));
+  if(b == 0) {
+    GSL_ERROR_NULL("failed to allocate space for batch workspace", GSL_ENOMEM);
+  }
+
+  b->size = t->size;
+
+  b->K = gsl_matrix_alloc(t->size, t->size);
+  if(b->K == 0) {
+    gsl_dht_batch_free(b);
+    GSL_ERROR_NULL("failed to allocate space for transform matrix", GSL_ENOMEM);
+  }
+
+  if(gsl_dht_batch_init(b, t) != GSL_SUCCESS) {
+    gsl_dht_batch_free(b);
+    return 0;
+  }
+
+  return b;
+}
+
+void
+gsl_dht_batch_free(gsl_dht_batch * b)
+{
+  RETURN_IF_NULL(b);
+
+  if(b->K)
+    gsl_matrix_free(b->K);
+
+  free(b);
+}
+
+/*
+gsl_dht_batch_init()
+  Expand the packed transform of t into the full transform matrix
+
+Inputs: b - batch workspace
+        t - discrete Hankel transform of the same size
+
+Return: success/error
+*/
+
+int
+gsl_dht_batch_init(gsl_dht_batch * b, const gsl_dht * t)
+{
+  if(t->size != b->size) {
+    GSL_ERROR("transform size does not match workspace", GSL_EBADLEN);
+  }
+  else if(t->xmax <= 0.0) {
+    GSL_ERROR("transform is not initialized", GSL_EINVAL);
+  }
+  else {
+    const double jN = t->j[t->size + 1];
+    const double r  = t->xmax / jN;
+    const double c  = 2.0 * r * r;
+    size_t m, i;
+
+    /* the packed Jjj is symmetric, so fill the lower triangle of K
+     * and the transposed upper triangle in one pass over Jjj */
+    for(m=0; m<t->size; m++) {
+      const double * Jm = t->Jjj + m*(m+1)/2;
+      for(i=0; i<=m; i++) {
+        gsl_matrix_set(b->K, m, i, c * Jm[i] / t->J2[i+1]);
+        gsl_matrix_set(b->K, i, m, c * Jm[i] / t->J2[m+1]);
+      }
+    }
+
+    return GSL_SUCCESS;
+  }
+}
+
+/*
+gsl_dht_batch_apply()
+  Transform a set of sampled functions
+
+Inputs: b     - batch workspace
+        F_in  - input functions, one per row, nvec-by-size
+        F_out - (output) transforms, one per row, nvec-by-size
+
+Return: success/error
+
+Notes:
+1) Row i of F_out is the result of gsl_dht_apply on row i of F_in
+
+2) The workspace is not modified, so several threads may apply the
+same workspace to disjoint blocks of rows concurrently. When GSL is
+linked against a multithreaded BLAS library, each call is also
+parallelized by the BLAS.
+*/
+
+int
+gsl_dht_batch_apply(const gsl_dht_batch * b, const gsl_matrix * F_in, gsl_matrix * F_out)
+{
+  if(F_in->size2 != b->size) {
+    GSL_ERROR("F_in must have size columns", GSL_EBADLEN);
+  }
+  else if(F_out->size1 != F_in->size1 || F_out->size2 != F_in->size2) {
+    GSL_ERROR("F_out must have the same dimensions as F_in", GSL_EBADLEN);
+  }
+  else if(F_in->size1 == 0) {
+    return GSL_SUCCESS;
+  }
+  else {
+    return gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, F_in, b->K, 0.0, F_out);
+  }
+}
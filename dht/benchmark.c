@@ -0,0 +1,204 @@
+/* dht/benchmark.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <time.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_dht.h>
+
+/* Usage: benchmark [n]
+   Compare the discrete Hankel transform gsl_dht with the fast
+   logarithmic transform gsl_dht_fftlog for length n, or for a range of
+   lengths if n is not given. Both transform f(r) = r exp(-r^2/2) with
+   nu = 1, whose transform is g(k) = k exp(-k^2/2), and the table shows
+   the time to set up the transform, the time to apply it, and the
+   maximum error of g over the output samples with k <= 10. The column
+   dht_batch is the time per array of gsl_dht_batch_apply on a batch of
+   nbatch arrays. The dense transform is only timed up to n = 2048,
+   since its setup evaluates n^2/2 Bessel functions. */
+
+void my_error_handler (const char *reason, const char *file,
+                       int line, int err);
+
+static void benchmark (const size_t n);
+static double benchmark_f (const double r);
+static double benchmark_seconds (const clock_t start, const clock_t end,
+                                 const size_t count);
+
+/* minimum time spent on each measurement */
+static const clock_t resolution = CLOCKS_PER_SEC / 5;
+
+/* largest length for the dense transform */
+static const size_t nmax_dense = 2048;
+
+/* number of arrays in a batch */
+static const size_t nbatch = 256;
+
+int
+main (int argc, char *argv[])
+{
+  gsl_set_error_handler (&my_error_handler);
+
+  printf ("%8s %12s %12s %12s %12s %12s %12s %12s\n", "n",
+          "dht_init", "dht_apply", "dht_batch", "dht_err",
+          "fftlog_init", "fftlog_apply", "fftlog_err");
+
+  if (argc == 2)
+    {
+      size_t n = strtol (argv[1], NULL, 0);
+      benchmark (n);
+    }
+  else
+    {
+      size_t n;
+
+      for (n = 64; n <= 65536; n *= 4)
+        benchmark (n);
+    }
+
+  return 0;
+}
+
+#define BENCHMARK_LOOP(expr)                            \
+  do                                                    \
+    {                                                   \
+      count = 0;                                        \
+      start = clock ();                                 \
+      do                                                \
+        {                                               \
+          expr;                                         \
+          count++;                                      \
+          end = clock ();                               \
+        }                                               \
+      while (end < start + resolution);                 \
+    }                                                   \
+  while (0)
+
+static void
+benchmark (const size_t n)
+{
+  double *f_in = malloc (n * sizeof (double));
+  double *f_out = malloc (n * sizeof (double));
+  double t[7] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  clock_t start, end;
+  size_t i, count;
+
+  if (n <= nmax_dense)
+    {
+      gsl_dht *d = gsl_dht_alloc (n);
+
+      BENCHMARK_LOOP (gsl_dht_init (d, 1.0, 20.0));
+      t[0] = benchmark_seconds (start, end, count);
+
+      for (i = 0; i < n; i++)
+        f_in[i] = benchmark_f (gsl_dht_x_sample (d, i));
+
+      BENCHMARK_LOOP (gsl_dht_apply (d, f_in, f_out));
+      t[1] = benchmark_seconds (start, end, count);
+
+      {
+        gsl_dht_batch *b = gsl_dht_batch_alloc (d);
+        gsl_matrix *F_in = gsl_matrix_alloc (nbatch, n);
+        gsl_matrix *F_out = gsl_matrix_alloc (nbatch, n);
+
+        for (i = 0; i < nbatch; i++)
+          {
+            gsl_vector_view v = gsl_matrix_row (F_in, i);
+            gsl_vector_const_view f = gsl_vector_const_view_array (f_in, n);
+            gsl_vector_memcpy (&v.vector, &f.vector);
+          }
+
+        BENCHMARK_LOOP (gsl_dht_batch_apply (b, F_in, F_out));
+        t[6] = benchmark_seconds (start, end, count * nbatch);
+
+        gsl_dht_batch_free (b);
+        gsl_matrix_free (F_in);
+        gsl_matrix_free (F_out);
+      }
+
+      for (i = 0; i < n; i++)
+        {
+          const double k = gsl_dht_k_sample (d, i);
+
+          if (k <= 10.0)
+            t[2] = GSL_MAX (t[2], fabs (f_out[i] - benchmark_f (k)));
+        }
+
+      gsl_dht_free (d);
+    }
+
+  {
+    gsl_dht_fftlog *d = NULL;
+
+    BENCHMARK_LOOP (gsl_dht_fftlog_free (d); d = gsl_dht_fftlog_alloc (n, 1.0, 1.0e-6, 1.0e3));
+    t[3] = benchmark_seconds (start, end, count);
+
+    for (i = 0; i < n; i++)
+      f_in[i] = benchmark_f (gsl_dht_fftlog_x_sample (d, i));
+
+    BENCHMARK_LOOP (gsl_dht_fftlog_apply (d, f_in, f_out));
+    t[4] = benchmark_seconds (start, end, count);
+
+    for (i = 0; i < n; i++)
+      {
+        const double k = gsl_dht_fftlog_k_sample (d, i);
+
+        if (k <= 10.0)
+          t[5] = GSL_MAX (t[5], fabs (f_out[i] - benchmark_f (k)));
+      }
+
+    gsl_dht_fftlog_free (d);
+  }
+
+  if (n <= nmax_dense)
+    printf ("%8zu %12.3e %12.3e %12.3e %12.3e %12.3e %12.3e %12.3e\n", n,
+            t[0], t[1], t[6], t[2], t[3], t[4], t[5]);
+  else
+    printf ("%8zu %12s %12s %12s %12s %12.3e %12.3e %12.3e\n", n,
+            "-", "-", "-", "-", t[3], t[4], t[5]);
+
+  free (f_in);
+  free (f_out);
+}
+
+static double
+benchmark_f (const double r)
+{
+  return r * exp (-0.5 * r * r);
+}
+
+static double
+benchmark_seconds (const clock_t start, const clock_t end, const size_t count)
+{
+  return (double) (end - start) / (double) CLOCKS_PER_SEC / (double) count;
+}
+
+void
+my_error_handler (const char *reason, const char *file, int line, int err)
+{
+  printf ("error: %s in %s at %d (gsl_errno=%d)\n", reason, file, line, err);
+}
@@ -0,0 +1,242 @@
+/* dht/fftlog.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Fast Hankel transform of logarithmically sampled functions, following
+ * A. J. S. Hamilton, "Uncorrelated modes of the non-linear power
+ * spectrum", MNRAS 312, 257 (2000), appendix B (FFTLog).
+ *
+ * The transform g(k) = int_0^inf f(r) J_nu(k r) r dr is written as
+ * g(k) = (1/k) int_0^inf a(r) J_nu(k r) k dr with a(r) = r f(r). The
+ * samples a_n = a(r_n), r_n = r_c exp((n - n_c) dlnr), are expanded in
+ * a Fourier series in ln(r),
+ *
+ * a(r) = sum_m c_m (r/r_c)^{i tau_m},  tau_m = 2 pi m / (size dlnr)
+ *
+ * and each power law is transformed analytically,
+ *
+ * int_0^inf r^{i tau} J_nu(k r) k dr = k^{-i tau} U(i tau),
+ * U(x) = 2^x Gamma((nu + 1 + x)/2) / Gamma((nu + 1 - x)/2)
+ *
+ * so that the transform is a forward FFT, a multiplication by the
+ * coefficients u_m = (k_c r_c)^{-i tau_m} U(i tau_m) and a second FFT.
+ * For real nu the u_m have unit modulus. The product k_c r_c is chosen
+ * close to 1 such that u_m is real at the Nyquist frequency, which
+ * reduces ringing (Hamilton's "low-ringing" condition).
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sf_gamma.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_dht.h>
+
+static double fftlog_phase(const double nu, const double tau, const double lnkr);
+
+/*
+gsl_dht_fftlog_alloc()
+  Allocate and initialize a fast Hankel transform
+
+Inputs: size - number of samples, at least 2
+        nu   - Bessel function order, nu >= 0
+        xmin - first sample point, > 0
+        xmax - last sample point, > xmin
+
+Return: pointer to transform object
+
+Notes:
+1) The samples x_n = xmin exp(n dlnr), n = 0,...,size-1, are spaced
+logarithmically between xmin and xmax, and the k samples have the same
+spacing, centered on 1/sqrt(xmin xmax)
+*/
+
+gsl_dht_fftlog *
+gsl_dht_fftlog_alloc (size_t size, double nu, double xmin, double xmax)
+{
+  gsl_dht_fftlog * t;
+
+  if (size < 2) {
+    GSL_ERROR_NULL ("size must be at least 2", GSL_EDOM);
+  }
+  else if (nu < 0.0) {
+    GSL_ERROR_NULL ("nu is negative", GSL_EDOM);
+  }
+  else if (xmin <= 0.0 || xmax <= xmin) {
+    GSL_ERROR_NULL ("xmin and xmax must satisfy 0 < xmin < xmax", GSL_EDOM);
+  }
+
+  t = calloc(1, sizeof(gsl_dht_fftlog));
+  if (t == 0) {
+    GSL_ERROR_NULL ("out of memory", GSL_ENOMEM);
+  }
+
+  t->u = malloc(size * sizeof(double));
+  t->work = malloc(size * sizeof(double));
+  t->real_wavetable = gsl_fft_real_wavetable_alloc(size);
+  t->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc(size);
+  t->fft_workspace = gsl_fft_real_workspace_alloc(size);
+
+  if (t->u == 0 || t->work == 0 || t->real_wavetable == 0 ||
+      t->hc_wavetable == 0 || t->fft_workspace == 0) {
+    gsl_dht_fftlog_free(t);
+    GSL_ERROR_NULL ("out of memory", GSL_ENOMEM);
+  }
+
+  t->size = size;
+  t->nu = nu;
+  t->rmin = xmin;
+  t->dlnr = log(xmax / xmin) / (size - 1.0);
+
+  {
+    const double nc = 0.5 * (size - 1.0);
+    const double rc = sqrt(xmin * xmax);
+    const double L = size * t->dlnr;
+    double lnkr = 0.0;
+    size_t m;
+
+    /* low-ringing choice of k_c r_c: make the phase of u at the
+       Nyquist frequency a multiple of pi */
+    {
+      const double phase = fftlog_phase(nu, M_PI / t->dlnr, lnkr);
+      const double iarg = floor(phase / M_PI + 0.5);
+      lnkr += (phase - iarg * M_PI) * t->dlnr / M_PI;
+    }
+
+    t->kmin = exp(lnkr) / rc * exp(-nc * t->dlnr);
+
+    /* u_m, including the phase factor exp(4 pi i m n_c / size) of the
+       two FFTs and the normalization 1/size */
+    t->u[0] = cos(fftlog_phase(nu, 0.0, lnkr)) / size;
+
+    for (m = 1; 2 * m < size; m++) {
+      const double tau = 2.0 * M_PI * m / L;
+      const double theta = fftlog_phase(nu, tau, lnkr) + 4.0 * M_PI * m * nc / size;
+      t->u[2*m - 1] = cos(theta) / size;
+      t->u[2*m] = sin(theta) / size;
+    }
+
+    if (size % 2 == 0) {
+      /* Nyquist term, real by the choice of lnkr */
+      const double tau = M_PI / t->dlnr;
+      const double theta = fftlog_phase(nu, tau, lnkr) + 2.0 * M_PI * nc;
+      t->u[size - 1] = cos(theta) / size;
+    }
+  }
+
+  return t;
+}
+
+
+void gsl_dht_fftlog_free(gsl_dht_fftlog * t)
+{
+  RETURN_IF_NULL (t);
+  free(t->u);
+  free(t->work);
+  if (t->real_wavetable) gsl_fft_real_wavetable_free(t->real_wavetable);
+  if (t->hc_wavetable) gsl_fft_halfcomplex_wavetable_free(t->hc_wavetable);
+  if (t->fft_workspace) gsl_fft_real_workspace_free(t->fft_workspace);
+  free(t);
+}
+
+
+double gsl_dht_fftlog_x_sample(const gsl_dht_fftlog * t, int n)
+{
+  return t->rmin * exp(n * t->dlnr);
+}
+
+
+double gsl_dht_fftlog_k_sample(const gsl_dht_fftlog * t, int n)
+{
+  return t->kmin * exp(n * t->dlnr);
+}
+
+/*
+gsl_dht_fftlog_apply()
+  Compute the Hankel transform g(k_n) = int_0^inf f(r) J_nu(k_n r) r dr
+from the samples f(x_n)
+
+Inputs: t     - transform object
+        f_in  - samples f(x_n), length size
+        f_out - (output) g(k_n), length size; may be the same as f_in
+
+Return: success/error
+
+Notes:
+1) The samples are treated as one period of a function periodic in
+ln(x), so r f(r) should be small at both ends of the sampling range
+*/
+
+int
+gsl_dht_fftlog_apply(gsl_dht_fftlog * t, const double * f_in, double * f_out)
+{
+  const size_t N = t->size;
+  double * a = t->work;
+  const double * u = t->u;
+  double r = t->rmin;
+  double k = t->kmin;
+  const double ratio = exp(t->dlnr);
+  size_t n, m;
+
+  for (n = 0; n < N; n++) {
+    a[n] = r * f_in[n];
+    r *= ratio;
+  }
+
+  gsl_fft_real_transform(a, 1, N, t->real_wavetable, t->fft_workspace);
+
+  /* multiply by u_m and conjugate, so that the halfcomplex backward
+     transform gives sum_m b_m exp(-2 pi i m n / N) */
+  a[0] *= u[0];
+
+  for (m = 1; 2 * m < N; m++) {
+    const double ar = a[2*m - 1], ai = a[2*m];
+    const double ur = u[2*m - 1], ui = u[2*m];
+    a[2*m - 1] = ar * ur - ai * ui;
+    a[2*m] = -(ar * ui + ai * ur);
+  }
+
+  if (N % 2 == 0) {
+    a[N - 1] *= u[N - 1];
+  }
+
+  gsl_fft_halfcomplex_transform(a, 1, N, t->hc_wavetable, t->fft_workspace);
+
+  for (n = 0; n < N; n++) {
+    f_out[n] = a[n] / k;
+    k *= ratio;
+  }
+
+  return GSL_SUCCESS;
+}
+
+/* phase of (k_c r_c)^{-i tau} U(i tau), with lnkr = ln(k_c r_c) */
+
+static double
+fftlog_phase(const double nu, const double tau, const double lnkr)
+{
+  gsl_sf_result lnr, arg;
+
+  gsl_sf_lngamma_complex_e(0.5 * (nu + 1.0), 0.5 * tau, &lnr, &arg);
+
+  return tau * (M_LN2 - lnkr) + 2.0 * arg.val;
+}
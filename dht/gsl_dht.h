@@ -23,6 +23,9 @@
 #define __GSL_DHT_H__
 
 #include <stdlib.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_matrix_double.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -84,6 +87,49 @@ void gsl_dht_free(gsl_dht * t);
 int gsl_dht_apply(const gsl_dht * t, double * f_in, double * f_out);
 
 
+/* Workspace for transforming many sampled arrays with the same
+ * transform; the packed matrix of gsl_dht is expanded to a full
+ * size-by-size matrix so that a batch is one matrix product.
+ */
+struct gsl_dht_batch_struct {
+  size_t       size;  /* size of the sample arrays to be transformed  */
+  gsl_matrix * K;     /* transform matrix, f_out = K f_in             */
+};
+typedef struct gsl_dht_batch_struct gsl_dht_batch;
+
+gsl_dht_batch * gsl_dht_batch_alloc(const gsl_dht * t);
+void gsl_dht_batch_free(gsl_dht_batch * b);
+int gsl_dht_batch_init(gsl_dht_batch * b, const gsl_dht * t);
+
+/* Transform each row of F_in, storing the results in the rows of F_out.
+ */
+int gsl_dht_batch_apply(const gsl_dht_batch * b, const gsl_matrix * F_in, gsl_matrix * F_out);
+
+
+/* Fast Hankel transform on logarithmically spaced samples
+ * (FFTLog), in O(size log size) operations.
+ */
+struct gsl_dht_fftlog_struct {
+  size_t    size;  /* number of samples                                */
+  double    nu;    /* Bessel function order                            */
+  double    rmin;  /* first x sample, x_n = rmin exp(n dlnr)           */
+  double    kmin;  /* first k sample, k_n = kmin exp(n dlnr)           */
+  double    dlnr;  /* logarithmic spacing of the samples               */
+  double *  u;     /* kernel coefficients, halfcomplex storage         */
+  double *  work;  /* workspace, size                                  */
+  gsl_fft_real_wavetable * real_wavetable;
+  gsl_fft_halfcomplex_wavetable * hc_wavetable;
+  gsl_fft_real_workspace * fft_workspace;
+};
+typedef struct gsl_dht_fftlog_struct gsl_dht_fftlog;
+
+gsl_dht_fftlog * gsl_dht_fftlog_alloc(size_t size, double nu, double xmin, double xmax);
+void gsl_dht_fftlog_free(gsl_dht_fftlog * t);
+double gsl_dht_fftlog_x_sample(const gsl_dht_fftlog * t, int n);
+double gsl_dht_fftlog_k_sample(const gsl_dht_fftlog * t, int n);
+int gsl_dht_fftlog_apply(gsl_dht_fftlog * t, const double * f_in, double * f_out);
+
+
 __END_DECLS
 
 #endif /* __GSL_DHT_H__ */
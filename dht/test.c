@@ -25,6 +25,7 @@
 #include <math.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_test.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_dht.h>
 
 
@@ -180,6 +181,103 @@ test_dht_poly1(void)
 }
 
 
+/* Test the fast transform
+ * Integrate[ x^(nu+1) exp(-x^2/2) J_nu(a x), {x,0,Inf}] = a^nu exp(-a^2/2)
+ */
+int
+test_dht_fftlog(size_t size, double nu, double xmin, double xmax, double tol)
+{
+  int stat = 0;
+  size_t n;
+  double * f_in = malloc(size * sizeof(double));
+  double * f_out = malloc(size * sizeof(double));
+  gsl_dht_fftlog * t = gsl_dht_fftlog_alloc(size, nu, xmin, xmax);
+
+  for(n=0; n<size; n++) {
+    const double x = gsl_dht_fftlog_x_sample(t, n);
+    f_in[n] = pow(x, nu) * exp(-0.5*x*x);
+  }
+
+  /* transform in place */
+  gsl_dht_fftlog_apply(t, f_in, f_in);
+
+  /* The samples are assumed periodic in log(x), so the errors
+   * are largest near the ends of the k range; check the
+   * central part.
+   */
+  for(n=0; n<size; n++) {
+    const double k = gsl_dht_fftlog_k_sample(t, n);
+    if(k > 1.0e-2 && k < 10.0) {
+      const double g = pow(k, nu) * exp(-0.5*k*k);
+      if(fabs(f_in[n] - g) > tol) stat++;
+    }
+  }
+
+  /* the sample points are logarithmically spaced */
+  if(fabs(gsl_dht_fftlog_x_sample(t, 0) - xmin)/xmin > 1.0e-14) stat++;
+  if(fabs(gsl_dht_fftlog_x_sample(t, size-1) - xmax)/xmax > 1.0e-12) stat++;
+
+  gsl_dht_fftlog_free(t);
+  free(f_in);
+  free(f_out);
+
+  return stat;
+}
+
+
+/* Test batched transforms against gsl_dht_apply on each array,
+ * including a block of rows of a larger matrix.
+ */
+int
+test_dht_batch(size_t size, size_t nvec, double nu)
+{
+  int stat = 0;
+  size_t i, n;
+  double * f_out = malloc(size * sizeof(double));
+  gsl_dht * t = gsl_dht_new(size, nu, 1.0);
+  gsl_dht_batch * b = gsl_dht_batch_alloc(t);
+  gsl_matrix * F_in  = gsl_matrix_alloc(nvec, size);
+  gsl_matrix * F_out = gsl_matrix_alloc(nvec, size);
+
+  for(i=0; i<nvec; i++) {
+    for(n=0; n<size; n++) {
+      const double x = gsl_dht_x_sample(t, n);
+      gsl_matrix_set(F_in, i, n, cos((i + 1.0) * x) / (1.0 + x*x));
+    }
+  }
+
+  gsl_matrix_set_all(F_out, 0.0);
+
+  /* transform the rows in two blocks, as separate threads would */
+  {
+    const size_t nhalf = nvec / 2;
+    gsl_matrix_const_view A_in  = gsl_matrix_const_submatrix(F_in, 0, 0, nhalf, size);
+    gsl_matrix_const_view B_in  = gsl_matrix_const_submatrix(F_in, nhalf, 0, nvec - nhalf, size);
+    gsl_matrix_view A_out = gsl_matrix_submatrix(F_out, 0, 0, nhalf, size);
+    gsl_matrix_view B_out = gsl_matrix_submatrix(F_out, nhalf, 0, nvec - nhalf, size);
+
+    stat += gsl_dht_batch_apply(b, &A_in.matrix, &A_out.matrix) != GSL_SUCCESS;
+    stat += gsl_dht_batch_apply(b, &B_in.matrix, &B_out.matrix) != GSL_SUCCESS;
+  }
+
+  for(i=0; i<nvec; i++) {
+    gsl_dht_apply(t, gsl_matrix_ptr(F_in, i, 0), f_out);
+    for(n=0; n<size; n++) {
+      const double g = gsl_matrix_get(F_out, i, n);
+      if(fabs(g - f_out[n]) > 1.0e-13 * (1.0 + fabs(f_out[n]))) stat++;
+    }
+  }
+
+  gsl_matrix_free(F_in);
+  gsl_matrix_free(F_out);
+  gsl_dht_batch_free(b);
+  gsl_dht_free(t);
+  free(f_out);
+
+  return stat;
+}
+
+
 int main()
 {
   gsl_ieee_env_setup ();
@@ -189,5 +287,15 @@ int main()
   gsl_test( test_dht_exp1(),    "Exp  J1 DHT");
   gsl_test( test_dht_poly1(),   "Poly J1 DHT");
 
+  gsl_test( test_dht_batch(1, 3, 0.0),    "Batch J0 DHT n=1");
+  gsl_test( test_dht_batch(37, 20, 1.0),  "Batch J1 DHT n=37");
+  gsl_test( test_dht_batch(128, 65, 2.5), "Batch J2.5 DHT n=128");
+
+  gsl_test( test_dht_fftlog(512, 0.0, 1.0e-6, 1.0e6, 1.0e-8),  "FFTLog J0 n=512");
+  gsl_test( test_dht_fftlog(511, 0.0, 1.0e-6, 1.0e6, 1.0e-8),  "FFTLog J0 n=511");
+  gsl_test( test_dht_fftlog(512, 1.0, 1.0e-5, 1.0e5, 1.0e-9),  "FFTLog J1 n=512");
+  gsl_test( test_dht_fftlog(1024, 2.5, 1.0e-4, 1.0e4, 1.0e-11), "FFTLog J2.5 n=1024");
+  gsl_test( test_dht_fftlog(4096, 1.0, 1.0e-6, 1.0e6, 1.0e-10), "FFTLog J1 n=4096");
+
   exit (gsl_test_summary());
 }
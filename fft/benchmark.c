@@ -1,17 +1,18 @@
 /* fft/benchmark.c
- * 
+ *
  * Copyright (C) 1996, 1997, 1998, 1999, 2000, 2007 Brian Gough
- * 
+ * Copyright (C) 2021 Patrick Alken
+ *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
  * the Free Software Foundation; either version 3 of the License, or (at
  * your option) any later version.
- * 
+ *
  * This program is distributed in the hope that it will be useful, but
  * WITHOUT ANY WARRANTY; without even the implied warranty of
  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
  * General Public License for more details.
- * 
+ *
  * You should have received a copy of the GNU General Public License
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
@@ -21,132 +22,275 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
-#include <float.h>
 
 #include <time.h>
 
 #include <gsl/gsl_complex.h>
 #include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_complex_float.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_real_float.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_halfcomplex_float.h>
 
 #include <gsl/gsl_errno.h>
 
-#include "complex_internal.h"
-#include "bitreverse.h"
 #include "urand.c"
 
+/* Usage: benchmark [n [howmany]]
+   Time the fft routines for length n, or for a range of lengths if n
+   is not given. The speed is reported in MFLOPS using the nominal
+   operation count 5 n log2(n) for a complex transform and
+   2.5 n log2(n) for a real transform, so that the figures can be
+   compared across lengths and with other libraries.
+
+   If howmany is given, compare gsl_fft_complex_batch_transform for
+   howmany signals of length n with a loop calling
+   gsl_fft_complex_transform for each signal, both for contiguous
+   signals (stride 1, distance n) and for interleaved signals (stride
+   howmany, distance 1). */
+
 void my_error_handler (const char *reason, const char *file,
                        int line, int err);
 
+static void benchmark (const size_t n);
+static void benchmark_batch (const size_t n, const size_t howmany);
+static int benchmark_loop (double *data, const size_t stride, const size_t distance,
+                           const size_t n, const size_t howmany,
+                           const gsl_fft_complex_wavetable * wavetable,
+                           gsl_fft_complex_workspace * work,
+                           const gsl_fft_direction sign);
+static double benchmark_mflops (const double flops, const clock_t start,
+                                const clock_t end, const size_t count);
+static int benchmark_power_of_2 (const size_t n);
+
+/* minimum time spent on each measurement */
+static const clock_t resolution = CLOCKS_PER_SEC / 5;
+
 int
 main (int argc, char *argv[])
 {
-  double *data, *fft_data;
-  gsl_fft_complex_wavetable * cw;
-  unsigned int i, logn;
-  int result;
-  int status;
-  clock_t start, end;
-  int resolution = CLOCKS_PER_SEC;
-  unsigned int n = 1;
-
   gsl_set_error_handler (&my_error_handler);
 
   if (argc == 2)
     {
-      n = strtol (argv[1], NULL, 0);
+      size_t n = strtol (argv[1], NULL, 0);
+      benchmark (n);
     }
-  else
+  else if (argc == 3)
     {
-      printf ("test n\n");
-      exit (EXIT_FAILURE);
+      size_t n = strtol (argv[1], NULL, 0);
+      size_t howmany = strtol (argv[2], NULL, 0);
+
+      printf ("%10s %8s %12s %12s %12s %12s\n", "n", "howmany", "loop",
+              "batch", "loop_int", "batch_int");
+      benchmark_batch (n, howmany);
     }
+  else
+    {
+      /* powers of two followed by mixed-radix lengths */
+      const size_t lengths[] = { 16, 64, 256, 1024, 4096, 16384, 65536,
+                                 262144, 1048576, 60, 630, 1000, 12000,
+                                 100000, 0 };
+      size_t i;
 
-  cw = gsl_fft_complex_wavetable_alloc (n);
-  cwork = gsl_fft_complex_wavetable_workspace_alloc (n);
-  status = gsl_fft_complex_init (n, cw, cwork);
-  status = gsl_fft_complex_generate (n, cw, cwork);
+      printf ("%10s %12s %12s %12s %12s %12s\n", "n", "complex", "complex_f",
+              "radix2", "real", "real_f");
 
-  data = (double *) malloc (n * 2 * sizeof (double));
-  fft_data = (double *) malloc (n * 2 * sizeof (double));
+      /* many short signals, for which the per-call overhead matters most */
+      const size_t batches[][2] = { { 16, 4096 }, { 64, 1024 }, { 256, 256 },
+                                    { 60, 1000 }, { 1024, 64 }, { 0, 0 } };
 
-  for (i = 0; i < n; i++)
-    {
-      REAL(data,1,i) = urand ();
-      IMAG(data,1,i) = urand ();
+      for (i = 0; lengths[i] != 0; i++)
+        benchmark (lengths[i]);
+
+      printf ("\n%10s %8s %12s %12s %12s %12s\n", "n", "howmany", "loop",
+              "batch", "loop_int", "batch_int");
+
+      for (i = 0; batches[i][0] != 0; i++)
+        benchmark_batch (batches[i][0], batches[i][1]);
     }
 
+  return 0;
+}
 
-  /* compute the fft */
+#define BENCHMARK_LOOP(expr)                            \
+  do                                                    \
+    {                                                   \
+      count = 0;                                        \
+      start = clock ();                                 \
+      do                                                \
+        {                                               \
+          status = (expr);                              \
+          count++;                                      \
+          end = clock ();                               \
+        }                                               \
+      while (end < start + resolution && status == 0);  \
+    }                                                   \
+  while (0)
 
-  memcpy (fft_data, data, n * 2 * sizeof (double));
+static void
+benchmark (const size_t n)
+{
+  const double flops = 5.0 * n * log ((double) n) / M_LN2;
+  double *data = malloc (2 * n * sizeof (double));
+  float *data_f = malloc (2 * n * sizeof (float));
+  gsl_fft_complex_wavetable *cw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_complex_workspace *cwork = gsl_fft_complex_workspace_alloc (n);
+  gsl_fft_complex_wavetable_float *cw_f = gsl_fft_complex_wavetable_float_alloc (n);
+  gsl_fft_complex_workspace_float *cwork_f = gsl_fft_complex_workspace_float_alloc (n);
+  gsl_fft_real_wavetable *rw = gsl_fft_real_wavetable_alloc (n);
+  gsl_fft_halfcomplex_wavetable *hw = gsl_fft_halfcomplex_wavetable_alloc (n);
+  gsl_fft_real_workspace *rwork = gsl_fft_real_workspace_alloc (n);
+  gsl_fft_real_wavetable_float *rw_f = gsl_fft_real_wavetable_float_alloc (n);
+  gsl_fft_halfcomplex_wavetable_float *hw_f = gsl_fft_halfcomplex_wavetable_float_alloc (n);
+  gsl_fft_real_workspace_float *rwork_f = gsl_fft_real_workspace_float_alloc (n);
+  double mflops[5];
+  clock_t start, end;
+  size_t i, count;
+  int status;
 
-  start = clock ();
-  i = 0;
-  do
+  for (i = 0; i < 2 * n; i++)
     {
-      status = gsl_fft_complex_forward (fft_data, 1, n, cw, cwork);
-      i++;
-      end = clock ();
+      data[i] = urand () - 0.5;
+      data_f[i] = (float) data[i];
     }
-  while (end < start + resolution && status == 0);
 
-  if (status == 0)
+  /* the transforms are applied repeatedly to the same array, so the
+     forward and backward directions are alternated to keep the data
+     bounded (for real data the forward transform alternates with the
+     halfcomplex inverse) */
+
+  BENCHMARK_LOOP (gsl_fft_complex_transform (data, 1, n, cw, cwork,
+                                             (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+  mflops[0] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
+
+  BENCHMARK_LOOP (gsl_fft_complex_float_transform (data_f, 1, n, cw_f, cwork_f,
+                                                   (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+  mflops[1] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
+
+  if (benchmark_power_of_2 (n))
     {
-      printf ("n = %d gsl_fft_complex_forward %f seconds\n", n, (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC));
+      BENCHMARK_LOOP (gsl_fft_complex_radix2_transform (data, 1, n,
+                                                        (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+      mflops[2] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
     }
   else
     {
-      printf ("MR fft failed\n");
+      mflops[2] = 0.0;
     }
 
+  for (i = 0; i < 2 * n; i++)
+    {
+      data[i] = urand () - 0.5;
+      data_f[i] = (float) data[i];
+    }
 
-  /* compute the fft with radix2 */
-  memcpy (fft_data, data, n * 2 * sizeof (double));
+  BENCHMARK_LOOP ((count & 1) ? gsl_fft_halfcomplex_inverse (data, 1, n, hw, rwork)
+                  : gsl_fft_real_transform (data, 1, n, rw, rwork));
+  mflops[3] = status ? 0.0 : benchmark_mflops (0.5 * flops, start, end, count);
 
-  result = fft_binary_logn(n) ;
+  BENCHMARK_LOOP ((count & 1) ? gsl_fft_halfcomplex_float_inverse (data_f, 1, n, hw_f, rwork_f)
+                  : gsl_fft_real_float_transform (data_f, 1, n, rw_f, rwork_f));
+  mflops[4] = status ? 0.0 : benchmark_mflops (0.5 * flops, start, end, count);
 
-  if (result == -1) {
-    exit(EXIT_SUCCESS) ;
-  } else {
-    logn = result ;
-  }
+  printf ("%10zu %12.1f %12.1f %12.1f %12.1f %12.1f\n", n, mflops[0], mflops[1],
+          mflops[2], mflops[3], mflops[4]);
 
-  start = clock ();
-  i = 0;
-  do
-    {
-      status = gsl_fft_complex_radix2_forward (fft_data, 1, n);
-      i++;
-      end = clock ();
-    }
-  while (end < start + resolution && status == 0);
+  gsl_fft_complex_wavetable_free (cw);
+  gsl_fft_complex_workspace_free (cwork);
+  gsl_fft_complex_wavetable_float_free (cw_f);
+  gsl_fft_complex_workspace_float_free (cwork_f);
+  gsl_fft_real_wavetable_free (rw);
+  gsl_fft_halfcomplex_wavetable_free (hw);
+  gsl_fft_real_workspace_free (rwork);
+  gsl_fft_real_wavetable_float_free (rw_f);
+  gsl_fft_halfcomplex_wavetable_float_free (hw_f);
+  gsl_fft_real_workspace_float_free (rwork_f);
+  free (data);
+  free (data_f);
+}
 
-  if (status == 0)
-    {
-      printf ("n = %d gsl_fft_complex_radix2_forward %f seconds\n", n, (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC));
-    }
-  else
-    {
-      printf ("fft_radix2: not a power of 2\n");
-    }
+static void
+benchmark_batch (const size_t n, const size_t howmany)
+{
+  const double flops = 5.0 * n * log ((double) n) / M_LN2 * howmany;
+  double *data = malloc (2 * n * howmany * sizeof (double));
+  gsl_fft_complex_wavetable *cw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_complex_workspace *cwork = gsl_fft_complex_workspace_alloc (n);
+  double mflops[4];
+  clock_t start, end;
+  size_t i, count;
+  int status;
+
+  for (i = 0; i < 2 * n * howmany; i++)
+    data[i] = urand () - 0.5;
+
+  /* contiguous signals */
+
+  BENCHMARK_LOOP (benchmark_loop (data, 1, n, n, howmany, cw, cwork,
+                                  (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+  mflops[0] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
+
+  BENCHMARK_LOOP (gsl_fft_complex_batch_transform (data, 1, n, n, howmany, cw, cwork,
+                                                   (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+  mflops[1] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
+
+  /* interleaved signals, as in the column transforms of a matrix */
+
+  BENCHMARK_LOOP (benchmark_loop (data, howmany, 1, n, howmany, cw, cwork,
+                                  (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+  mflops[2] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
 
-  start = clock ();
-  i = 0;
-  do
+  BENCHMARK_LOOP (gsl_fft_complex_batch_transform (data, howmany, 1, n, howmany, cw, cwork,
+                                                   (count & 1) ? gsl_fft_backward : gsl_fft_forward));
+  mflops[3] = status ? 0.0 : benchmark_mflops (flops, start, end, count);
+
+  printf ("%10zu %8zu %12.1f %12.1f %12.1f %12.1f\n", n, howmany, mflops[0], mflops[1],
+          mflops[2], mflops[3]);
+
+  gsl_fft_complex_wavetable_free (cw);
+  gsl_fft_complex_workspace_free (cwork);
+  free (data);
+}
+
+/* reference for the batch transform: one call per signal */
+
+static int
+benchmark_loop (double *data, const size_t stride, const size_t distance,
+                const size_t n, const size_t howmany,
+                const gsl_fft_complex_wavetable * wavetable,
+                gsl_fft_complex_workspace * work, const gsl_fft_direction sign)
+{
+  size_t j;
+
+  for (j = 0; j < howmany; j++)
     {
-      status = fft_complex_bitreverse_order (fft_data, 1, n, logn);
-      i++;
-      end = clock ();
+      int status = gsl_fft_complex_transform (data + 2 * distance * j, stride, n,
+                                              wavetable, work, sign);
+      if (status)
+        return status;
     }
-  while (end < start + resolution && status == 0);
 
-  printf ("n = %d gsl_fft_complex_bitreverse_order %f seconds\n", n, (end - start) / ((double) i) / ((double) CLOCKS_PER_SEC));
+  return 0;
+}
 
+static double
+benchmark_mflops (const double flops, const clock_t start, const clock_t end,
+                  const size_t count)
+{
+  const double t = (double) (end - start) / (double) CLOCKS_PER_SEC / (double) count;
 
-  return 0;
+  return flops / t * 1.0e-6;
 }
 
+static int
+benchmark_power_of_2 (const size_t n)
+{
+  return n > 0 && (n & (n - 1)) == 0;
+}
 
 void
 my_error_handler (const char *reason, const char *file, int line, int err)
@@ -0,0 +1,197 @@
+/* fft/c_bluestein.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Bluestein's algorithm writes the DFT of length n as a convolution,
+   using jk = (j^2 + k^2 - (j-k)^2)/2,
+
+   x'_j = sum_k x_k exp(-2 pi i jk/n)
+        = c_j sum_k (x_k c_k) conj(c_{j-k}),   c_k = exp(-i pi k^2/n)
+
+   The convolution is computed with complex mixed-radix transforms of
+   a length nb >= 2n-1 which factorizes into the optimized modules, so
+   the cost is O(n log n) for any n.
+
+   The chirp table has n + nb elements. The first n elements are c_k,
+   and the remaining nb elements are the forward transform of the
+   convolution kernel conj(c_k), wrapped around to length nb and
+   scaled by 1/nb so that no separate normalization is needed. */
+
+static int
+FUNCTION(fft_complex,bluestein_alloc) (const size_t n,
+                                       const size_t nb,
+                                       size_t * nf,
+                                       size_t factors[],
+                                       TYPE(gsl_complex) * twiddle[],
+                                       TYPE(gsl_complex) ** trig,
+                                       TYPE(gsl_complex) ** chirp)
+{
+  int status;
+  size_t k, m;
+  TYPE(gsl_complex) * c;
+  BASE * b;
+  BASE * scratch;
+
+  status = fft_complex_factorize (nb, nf, factors);
+
+  if (status)
+    {
+      GSL_ERROR ("factorization failed", GSL_EFACTOR);
+    }
+
+  *trig = (TYPE(gsl_complex) *) malloc (nb * sizeof (TYPE(gsl_complex)));
+
+  if (*trig == NULL)
+    {
+      GSL_ERROR ("failed to allocate trigonometric lookup table", GSL_ENOMEM);
+    }
+
+  *chirp = (TYPE(gsl_complex) *) malloc ((n + nb) * sizeof (TYPE(gsl_complex)));
+
+  if (*chirp == NULL)
+    {
+      free (*trig);
+      GSL_ERROR ("failed to allocate chirp table", GSL_ENOMEM);
+    }
+
+  scratch = (BASE *) malloc (2 * nb * sizeof (BASE));
+
+  if (scratch == NULL)
+    {
+      free (*trig);
+      free (*chirp);
+      GSL_ERROR ("failed to allocate scratch space", GSL_ENOMEM);
+    }
+
+  FUNCTION(fft_complex,trig_init) (nb, *nf, factors, twiddle, *trig);
+
+  c = *chirp;
+  b = (BASE *) (c + n);
+
+  /* c_k = exp(-i pi k^2/n), with k^2 reduced modulo 2n for accuracy */
+
+  m = 0;
+  for (k = 0; k < n; k++)
+    {
+      const double theta = -M_PI * (double) m / (double) n;
+
+      GSL_REAL(c[k]) = cos (theta);
+      GSL_IMAG(c[k]) = sin (theta);
+
+      m += 2 * k + 1;           /* (k+1)^2 = k^2 + 2k + 1 */
+      while (m >= 2 * n)
+        m -= 2 * n;
+    }
+
+  /* kernel b_k = conj(c_|k|) for -n < k < n, wrapped to length nb */
+
+  for (k = 0; k < nb; k++)
+    {
+      REAL(b,1,k) = 0;
+      IMAG(b,1,k) = 0;
+    }
+
+  for (k = 0; k < n; k++)
+    {
+      const ATOMIC re = GSL_REAL(c[k]) / (ATOMIC) nb;
+      const ATOMIC im = -GSL_IMAG(c[k]) / (ATOMIC) nb;
+
+      REAL(b,1,k) = re;
+      IMAG(b,1,k) = im;
+
+      if (k > 0)
+        {
+          REAL(b,1,nb - k) = re;
+          IMAG(b,1,nb - k) = im;
+        }
+    }
+
+  FUNCTION(fft_complex,mixed_radix) (b, 1, nb, *nf, factors, twiddle,
+                                     scratch, gsl_fft_forward);
+
+  free (scratch);
+
+  return GSL_SUCCESS;
+}
+
+static int
+FUNCTION(fft_complex,bluestein) (BASE data[],
+                                 const size_t stride,
+                                 const size_t n,
+                                 const size_t nb,
+                                 const size_t nf,
+                                 const size_t factors[],
+                                 TYPE(gsl_complex) * const twiddle[],
+                                 const TYPE(gsl_complex) chirp[],
+                                 BASE work[],
+                                 const gsl_fft_direction sign)
+{
+  /* the backward transform is computed as conj(F(conj(x))) */
+  const ATOMIC s = (sign == gsl_fft_forward) ? 1 : -1;
+  const BASE * const b = (const BASE *) (chirp + n);
+  BASE * const a = work;
+  BASE * const scratch = work + 2 * nb;
+  size_t k;
+
+  for (k = 0; k < n; k++)
+    {
+      const ATOMIC x_real = REAL(data,stride,k);
+      const ATOMIC x_imag = s * IMAG(data,stride,k);
+      const ATOMIC c_real = GSL_REAL(chirp[k]);
+      const ATOMIC c_imag = GSL_IMAG(chirp[k]);
+
+      REAL(a,1,k) = x_real * c_real - x_imag * c_imag;
+      IMAG(a,1,k) = x_real * c_imag + x_imag * c_real;
+    }
+
+  for (k = n; k < nb; k++)
+    {
+      REAL(a,1,k) = 0;
+      IMAG(a,1,k) = 0;
+    }
+
+  FUNCTION(fft_complex,mixed_radix) (a, 1, nb, nf, factors, twiddle,
+                                     scratch, gsl_fft_forward);
+
+  for (k = 0; k < nb; k++)
+    {
+      const ATOMIC a_real = REAL(a,1,k);
+      const ATOMIC a_imag = IMAG(a,1,k);
+      const ATOMIC b_real = REAL(b,1,k);
+      const ATOMIC b_imag = IMAG(b,1,k);
+
+      REAL(a,1,k) = a_real * b_real - a_imag * b_imag;
+      IMAG(a,1,k) = a_real * b_imag + a_imag * b_real;
+    }
+
+  FUNCTION(fft_complex,mixed_radix) (a, 1, nb, nf, factors, twiddle,
+                                     scratch, gsl_fft_backward);
+
+  for (k = 0; k < n; k++)
+    {
+      const ATOMIC a_real = REAL(a,1,k);
+      const ATOMIC a_imag = IMAG(a,1,k);
+      const ATOMIC c_real = GSL_REAL(chirp[k]);
+      const ATOMIC c_imag = GSL_IMAG(chirp[k]);
+
+      REAL(data,stride,k) = a_real * c_real - a_imag * c_imag;
+      IMAG(data,stride,k) = s * (a_real * c_imag + a_imag * c_real);
+    }
+
+  return 0;
+}
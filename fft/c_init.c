@@ -17,14 +17,55 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "c_pass.h"
+
+static size_t
+FUNCTION(fft_complex,trig_init) (const size_t n, const size_t nf,
+                                 const size_t factor[],
+                                 TYPE(gsl_complex) * twiddle[],
+                                 TYPE(gsl_complex) trig[])
+{
+  size_t i;
+  size_t t, product, product_1, q;
+  const double d_theta = -2.0 * M_PI / ((double) n);
+
+  t = 0;
+  product = 1;
+  for (i = 0; i < nf; i++)
+    {
+      size_t j;
+      twiddle[i] = trig + t;
+      product_1 = product;      /* product_1 = p_(i-1) */
+      product *= factor[i];
+      q = n / product;
+
+      for (j = 1; j < factor[i]; j++)
+        {
+          size_t k;
+          size_t m = 0;
+          for (k = 1; k <= q; k++)
+            {
+              double theta;
+              m = m + j * product_1;
+              m = m % n;
+              theta = d_theta * m;      /*  d_theta*j*k*p_(i-1) */
+              GSL_REAL(trig[t]) = cos (theta);
+              GSL_IMAG(trig[t]) = sin (theta);
+
+              t++;
+            }
+        }
+    }
+
+  return t;
+}
+
 TYPE(gsl_fft_complex_wavetable) * 
 FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
 {
   int status ;
-  size_t i;
   size_t n_factors;
-  size_t t, product, product_1, q;
-  double d_theta;
+  size_t t;
 
   TYPE(gsl_fft_complex_wavetable) * wavetable ;
 
@@ -41,6 +82,31 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
       GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
     }
 
+  wavetable->n = n ;
+  wavetable->nb = fft_complex_bluestein_length (n);
+  wavetable->chirp = NULL;
+
+  if (wavetable->nb)
+    {
+      /* large prime factors, use Bluestein's algorithm */
+
+      status = FUNCTION(fft_complex,bluestein_alloc) (n, wavetable->nb,
+                                                      &(wavetable->nf),
+                                                      wavetable->factor,
+                                                      wavetable->twiddle,
+                                                      &(wavetable->trig),
+                                                      &(wavetable->chirp));
+
+      if (status)
+        {
+          free (wavetable);
+
+          GSL_ERROR_VAL ("failed to initialize Bluestein tables", status, 0);
+        }
+
+      return wavetable;
+    }
+
   wavetable->trig = (TYPE(gsl_complex) *) malloc (n * sizeof (TYPE(gsl_complex)));
 
   if (wavetable->trig == NULL)
@@ -51,8 +117,6 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
                         GSL_ENOMEM, 0);
     }
 
-  wavetable->n = n ;
-
   status = fft_complex_factorize (n, &n_factors, wavetable->factor);
 
   if (status)
@@ -67,36 +131,8 @@ FUNCTION(gsl_fft_complex_wavetable,alloc) (size_t n)
 
   wavetable->nf = n_factors;
 
-  d_theta = -2.0 * M_PI / ((double) n);
-
-  t = 0;
-  product = 1;
-  for (i = 0; i < n_factors; i++)
-    {
-      size_t j;
-      const size_t factor = wavetable->factor[i];
-      wavetable->twiddle[i] = wavetable->trig + t;
-      product_1 = product;      /* product_1 = p_(i-1) */
-      product *= factor;
-      q = n / product;
-
-      for (j = 1; j < factor; j++)
-        {
-          size_t k;
-          size_t m = 0;
-          for (k = 1; k <= q; k++)
-            {
-              double theta;
-              m = m + j * product_1;
-              m = m % n;
-              theta = d_theta * m;      /*  d_theta*j*k*p_(i-1) */
-              GSL_REAL(wavetable->trig[t]) = cos (theta);
-              GSL_IMAG(wavetable->trig[t]) = sin (theta);
-
-              t++;
-            }
-        }
-    }
+  t = FUNCTION(fft_complex,trig_init) (n, n_factors, wavetable->factor,
+                                       wavetable->twiddle, wavetable->trig);
 
   if (t > n)
     {
@@ -133,7 +169,13 @@ FUNCTION(gsl_fft_complex_workspace,alloc) (size_t n)
 
   workspace->n = n ;
 
-  workspace->scratch = (BASE *) malloc (2 * n * sizeof (BASE));
+  {
+    /* Bluestein's algorithm needs two complex arrays of length nb */
+    const size_t nb = fft_complex_bluestein_length (n);
+    const size_t len = nb ? 4 * nb : 2 * n;
+
+    workspace->scratch = (BASE *) malloc (len * sizeof (BASE));
+  }
 
   if (workspace->scratch == NULL)
     {
@@ -155,6 +197,9 @@ FUNCTION(gsl_fft_complex_wavetable,free) (TYPE(gsl_fft_complex_wavetable) * wave
   free (wavetable->trig);
   wavetable->trig = NULL;
 
+  free (wavetable->chirp);
+  wavetable->chirp = NULL;
+
   free (wavetable) ;
 }
 
@@ -181,10 +226,16 @@ FUNCTION(gsl_fft_complex,memcpy) (TYPE(gsl_fft_complex_wavetable) * dest,
       GSL_ERROR ("length of src and dest do not match", GSL_EINVAL);
     } 
   
-  n = dest->n ;
+  n = dest->nb ? dest->nb : dest->n ;
   nf = dest->nf ;
 
-  memcpy(dest->trig, src->trig, n * sizeof (double)) ;
+  memcpy(dest->trig, src->trig, n * sizeof (TYPE(gsl_complex))) ;
+
+  if (dest->nb)
+    {
+      memcpy(dest->chirp, src->chirp,
+             (dest->n + dest->nb) * sizeof (TYPE(gsl_complex))) ;
+    }
   
   for (i = 0 ; i < nf ; i++)
     {
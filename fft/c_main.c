@@ -83,25 +83,6 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
                                      TYPE(gsl_fft_complex_workspace) * work,
                                      const gsl_fft_direction sign)
 {
-  const size_t nf = wavetable->nf;
-
-  size_t i;
-
-  size_t q, product = 1;
-
-  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4,
-    *twiddle5, *twiddle6;
-
-  size_t state = 0;
-
-  BASE * const scratch = work->scratch;
-
-  BASE * in = data;
-  size_t istride = stride;
-
-  BASE * out = scratch;
-  size_t ostride = 1;
-
   if (n == 0)
     {
       GSL_ERROR ("length n must be positive integer", GSL_EDOM);
@@ -122,9 +103,49 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->nb)
+    {
+      return FUNCTION(fft_complex,bluestein) (data, stride, n, wavetable->nb,
+                                              wavetable->nf, wavetable->factor,
+                                              wavetable->twiddle,
+                                              wavetable->chirp,
+                                              work->scratch, sign);
+    }
+
+  return FUNCTION(fft_complex,mixed_radix) (data, stride, n, wavetable->nf,
+                                            wavetable->factor,
+                                            wavetable->twiddle,
+                                            work->scratch, sign);
+}
+
+static int
+FUNCTION(fft_complex,mixed_radix) (BASE data[],
+                                   const size_t stride,
+                                   const size_t n,
+                                   const size_t nf,
+                                   const size_t factors[],
+                                   TYPE(gsl_complex) * const twiddle[],
+                                   BASE scratch[],
+                                   const gsl_fft_direction sign)
+{
+  size_t i;
+
+  size_t q, product = 1;
+
+  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4,
+    *twiddle5, *twiddle6;
+
+  size_t state = 0;
+
+  BASE * in = data;
+  size_t istride = stride;
+
+  BASE * out = scratch;
+  size_t ostride = 1;
+
   for (i = 0; i < nf; i++)
     {
-      const size_t factor = wavetable->factor[i];
+      const size_t factor = factors[i];
       product *= factor;
       q = n / product;
 
@@ -147,20 +168,20 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
 
       if (factor == 2)
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           FUNCTION(fft_complex,pass_2) (in, istride, out, ostride, sign, 
                                         product, n, twiddle1);
         }
       else if (factor == 3)
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           twiddle2 = twiddle1 + q;
           FUNCTION(fft_complex,pass_3) (in, istride, out, ostride, sign, 
                                         product, n, twiddle1, twiddle2);
         }
       else if (factor == 4)
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           twiddle2 = twiddle1 + q;
           twiddle3 = twiddle2 + q;
           FUNCTION(fft_complex,pass_4) (in, istride, out, ostride, sign, 
@@ -169,7 +190,7 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
         }
       else if (factor == 5)
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           twiddle2 = twiddle1 + q;
           twiddle3 = twiddle2 + q;
           twiddle4 = twiddle3 + q;
@@ -179,7 +200,7 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
         }
       else if (factor == 6)
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           twiddle2 = twiddle1 + q;
           twiddle3 = twiddle2 + q;
           twiddle4 = twiddle3 + q;
@@ -190,7 +211,7 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
         }
       else if (factor == 7)
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           twiddle2 = twiddle1 + q;
           twiddle3 = twiddle2 + q;
           twiddle4 = twiddle3 + q;
@@ -203,7 +224,7 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
         }
       else
         {
-          twiddle1 = wavetable->twiddle[i];
+          twiddle1 = twiddle[i];
           FUNCTION(fft_complex,pass_n) (in, istride, out, ostride, sign, 
                                         factor, product, n, twiddle1);
         }
@@ -221,3 +242,130 @@ FUNCTION(gsl_fft_complex,transform) (TYPE(gsl_complex_packed_array) data,
   return 0;
 
 }
+
+/* Batched transforms of howmany signals of length n, where element k
+   of signal j is stored at data[2*(j*distance + k*stride)] (in units
+   of complex elements, distance and stride). The wavetable and
+   workspace are checked once and reused for every signal. */
+
+int
+FUNCTION(gsl_fft_complex,batch_forward) (TYPE(gsl_complex_packed_array) data,
+                                         const size_t stride,
+                                         const size_t distance,
+                                         const size_t n,
+                                         const size_t howmany,
+                                         const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                         TYPE(gsl_fft_complex_workspace) * work)
+{
+  return FUNCTION(gsl_fft_complex,batch_transform) (data, stride, distance, n, howmany,
+                                                    wavetable, work, gsl_fft_forward);
+}
+
+int
+FUNCTION(gsl_fft_complex,batch_backward) (TYPE(gsl_complex_packed_array) data,
+                                          const size_t stride,
+                                          const size_t distance,
+                                          const size_t n,
+                                          const size_t howmany,
+                                          const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                          TYPE(gsl_fft_complex_workspace) * work)
+{
+  return FUNCTION(gsl_fft_complex,batch_transform) (data, stride, distance, n, howmany,
+                                                    wavetable, work, gsl_fft_backward);
+}
+
+int
+FUNCTION(gsl_fft_complex,batch_inverse) (TYPE(gsl_complex_packed_array) data,
+                                         const size_t stride,
+                                         const size_t distance,
+                                         const size_t n,
+                                         const size_t howmany,
+                                         const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                         TYPE(gsl_fft_complex_workspace) * work)
+{
+  int status = FUNCTION(gsl_fft_complex,batch_transform) (data, stride, distance, n, howmany,
+                                                          wavetable, work, gsl_fft_backward);
+
+  if (status)
+    {
+      return status;
+    }
+
+  /* normalize inverse fft with 1/n */
+
+  {
+    const ATOMIC norm = ONE / (ATOMIC)n;
+    size_t i, j;
+    for (j = 0; j < howmany; j++)
+      {
+        BASE * const x = data + 2 * distance * j;
+
+        for (i = 0; i < n; i++)
+          {
+            REAL(x,stride,i) *= norm;
+            IMAG(x,stride,i) *= norm;
+          }
+      }
+  }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_complex,batch_transform) (TYPE(gsl_complex_packed_array) data,
+                                           const size_t stride,
+                                           const size_t distance,
+                                           const size_t n,
+                                           const size_t howmany,
+                                           const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                           TYPE(gsl_fft_complex_workspace) * work,
+                                           const gsl_fft_direction sign)
+{
+  size_t j;
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (stride == 0)
+    {
+      GSL_ERROR ("stride must be positive integer", GSL_EINVAL);
+    }
+
+  if (n != wavetable->n)
+    {
+      GSL_ERROR ("wavetable does not match length of data", GSL_EINVAL);
+    }
+
+  if (n != work->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (n == 1)
+    {                           /* FFT of 1 data point is the identity */
+      return 0;
+    }
+
+  for (j = 0; j < howmany; j++)
+    {
+      BASE * const x = data + 2 * distance * j;
+
+      if (wavetable->nb)
+        {
+          FUNCTION(fft_complex,bluestein) (x, stride, n, wavetable->nb,
+                                           wavetable->nf, wavetable->factor,
+                                           wavetable->twiddle, wavetable->chirp,
+                                           work->scratch, sign);
+        }
+      else
+        {
+          FUNCTION(fft_complex,mixed_radix) (x, stride, n, wavetable->nf,
+                                             wavetable->factor, wavetable->twiddle,
+                                             work->scratch, sign);
+        }
+    }
+
+  return 0;
+}
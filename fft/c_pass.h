@@ -17,6 +17,37 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+static int
+FUNCTION(fft_complex,mixed_radix) (BASE data[],
+                                   const size_t stride,
+                                   const size_t n,
+                                   const size_t nf,
+                                   const size_t factors[],
+                                   TYPE(gsl_complex) * const twiddle[],
+                                   BASE scratch[],
+                                   const gsl_fft_direction sign);
+
+static int
+FUNCTION(fft_complex,bluestein_alloc) (const size_t n,
+                                       const size_t nb,
+                                       size_t * nf,
+                                       size_t factors[],
+                                       TYPE(gsl_complex) * twiddle[],
+                                       TYPE(gsl_complex) ** trig,
+                                       TYPE(gsl_complex) ** chirp);
+
+static int
+FUNCTION(fft_complex,bluestein) (BASE data[],
+                                 const size_t stride,
+                                 const size_t n,
+                                 const size_t nb,
+                                 const size_t nf,
+                                 const size_t factors[],
+                                 TYPE(gsl_complex) * const twiddle[],
+                                 const TYPE(gsl_complex) chirp[],
+                                 BASE work[],
+                                 const gsl_fft_direction sign);
+
 static int
 FUNCTION(fft_complex,pass_2) (const BASE in[],
                               const size_t istride,
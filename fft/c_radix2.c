@@ -17,6 +17,9 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+/* number of consecutive butterflies sharing a pass over the data */
+#define RADIX2_BLOCK 32
+
 int
 FUNCTION(gsl_fft_complex,radix2_forward) (TYPE(gsl_complex_packed_array) data,
                                           const size_t stride, const size_t n)
@@ -113,56 +116,51 @@ FUNCTION(gsl_fft_complex,radix2_transform) (TYPE(gsl_complex_packed_array) data,
       const ATOMIC t = sin (theta / 2.0);
       const ATOMIC s2 = 2.0 * t * t;
 
-      size_t a, b;
-
-      /* a = 0 */
+      size_t a, a0, b;
 
-      for (b = 0; b < n; b += 2 * dual)
-        {
-          const size_t i = b ;
-          const size_t j = b + dual;
-          
-          const ATOMIC z1_real = REAL(data,stride,j) ;
-          const ATOMIC z1_imag = IMAG(data,stride,j) ;
-
-          const ATOMIC wd_real = z1_real ;
-          const ATOMIC wd_imag = z1_imag ;
-          
-          REAL(data,stride,j) = REAL(data,stride,i) - wd_real;
-          IMAG(data,stride,j) = IMAG(data,stride,i) - wd_imag;
-          REAL(data,stride,i) += wd_real;
-          IMAG(data,stride,i) += wd_imag;
-        }
-      
-      /* a = 1 .. (dual-1) */
+      /* the butterflies are computed in blocks of RADIX2_BLOCK
+         consecutive values of a, so that each part of the array is
+         loaded once per pass instead of once for every value of a */
 
-      for (a = 1; a < dual; a++)
+      for (a0 = 0; a0 < dual; a0 += RADIX2_BLOCK)
         {
+          const size_t na = GSL_MIN (RADIX2_BLOCK, dual - a0);
+          ATOMIC wa_real[RADIX2_BLOCK], wa_imag[RADIX2_BLOCK];
 
-          /* trignometric recurrence for w-> exp(i theta) w */
-
-          {
-            const ATOMIC tmp_real = w_real - s * w_imag - s2 * w_real;
-            const ATOMIC tmp_imag = w_imag + s * w_real - s2 * w_imag;
-            w_real = tmp_real;
-            w_imag = tmp_imag;
-          }
+          for (a = 0; a < na; a++)
+            {
+              if (a0 + a > 0)
+                {
+                  /* trignometric recurrence for w-> exp(i theta) w */
+
+                  const ATOMIC tmp_real = w_real - s * w_imag - s2 * w_real;
+                  const ATOMIC tmp_imag = w_imag + s * w_real - s2 * w_imag;
+                  w_real = tmp_real;
+                  w_imag = tmp_imag;
+                }
+
+              wa_real[a] = w_real;
+              wa_imag[a] = w_imag;
+            }
 
           for (b = 0; b < n; b += 2 * dual)
             {
-              const size_t i = b + a;
-              const size_t j = b + a + dual;
-
-              const ATOMIC z1_real = REAL(data,stride,j) ;
-              const ATOMIC z1_imag = IMAG(data,stride,j) ;
-              
-              const ATOMIC wd_real = w_real * z1_real - w_imag * z1_imag;
-              const ATOMIC wd_imag = w_real * z1_imag + w_imag * z1_real;
-
-              REAL(data,stride,j) = REAL(data,stride,i) - wd_real;
-              IMAG(data,stride,j) = IMAG(data,stride,i) - wd_imag;
-              REAL(data,stride,i) += wd_real;
-              IMAG(data,stride,i) += wd_imag;
+              for (a = 0; a < na; a++)
+                {
+                  const size_t i = b + a0 + a;
+                  const size_t j = i + dual;
+
+                  const ATOMIC z1_real = REAL(data,stride,j) ;
+                  const ATOMIC z1_imag = IMAG(data,stride,j) ;
+
+                  const ATOMIC wd_real = wa_real[a] * z1_real - wa_imag[a] * z1_imag;
+                  const ATOMIC wd_imag = wa_real[a] * z1_imag + wa_imag[a] * z1_real;
+
+                  REAL(data,stride,j) = REAL(data,stride,i) - wd_real;
+                  IMAG(data,stride,j) = IMAG(data,stride,i) - wd_imag;
+                  REAL(data,stride,i) += wd_real;
+                  IMAG(data,stride,i) += wd_imag;
+                }
             }
         }
       dual *= 2;
@@ -266,34 +264,50 @@ FUNCTION(gsl_fft_complex,radix2_dif_transform) (TYPE(gsl_complex_packed_array) d
       const ATOMIC t = sin (theta / 2.0);
       const ATOMIC s2 = 2.0 * t * t;
 
-      size_t a, b;
+      size_t a, b, b0;
 
-      for (b = 0; b < dual; b++)
+      /* the butterflies are computed in blocks of RADIX2_BLOCK
+         consecutive values of b, as in the decimation in time
+         transform above */
+
+      for (b0 = 0; b0 < dual; b0 += RADIX2_BLOCK)
         {
-          for (a = 0; a < n; a+= 2 * dual)
+          const size_t nb = GSL_MIN (RADIX2_BLOCK, dual - b0);
+          ATOMIC wb_real[RADIX2_BLOCK], wb_imag[RADIX2_BLOCK];
+
+          for (b = 0; b < nb; b++)
             {
-              const size_t i = b + a;
-              const size_t j = b + a + dual;
-              
-              const ATOMIC t1_real = REAL(data,stride,i) + REAL(data,stride,j);
-              const ATOMIC t1_imag = IMAG(data,stride,i) + IMAG(data,stride,j);
-              const ATOMIC t2_real = REAL(data,stride,i) - REAL(data,stride,j);
-              const ATOMIC t2_imag = IMAG(data,stride,i) - IMAG(data,stride,j);
-
-              REAL(data,stride,i) = t1_real;
-              IMAG(data,stride,i) = t1_imag;
-              REAL(data,stride,j) = w_real*t2_real - w_imag * t2_imag;
-              IMAG(data,stride,j) = w_real*t2_imag + w_imag * t2_real;
-            }
+              wb_real[b] = w_real;
+              wb_imag[b] = w_imag;
 
-          /* trignometric recurrence for w-> exp(i theta) w */
+              /* trignometric recurrence for w-> exp(i theta) w */
 
-          {
-            const ATOMIC tmp_real = w_real - s * w_imag - s2 * w_real;
-            const ATOMIC tmp_imag = w_imag + s * w_real - s2 * w_imag;
-            w_real = tmp_real;
-            w_imag = tmp_imag;
-          }
+              {
+                const ATOMIC tmp_real = w_real - s * w_imag - s2 * w_real;
+                const ATOMIC tmp_imag = w_imag + s * w_real - s2 * w_imag;
+                w_real = tmp_real;
+                w_imag = tmp_imag;
+              }
+            }
+
+          for (a = 0; a < n; a += 2 * dual)
+            {
+              for (b = 0; b < nb; b++)
+                {
+                  const size_t i = b0 + b + a;
+                  const size_t j = i + dual;
+
+                  const ATOMIC t1_real = REAL(data,stride,i) + REAL(data,stride,j);
+                  const ATOMIC t1_imag = IMAG(data,stride,i) + IMAG(data,stride,j);
+                  const ATOMIC t2_real = REAL(data,stride,i) - REAL(data,stride,j);
+                  const ATOMIC t2_imag = IMAG(data,stride,i) - IMAG(data,stride,j);
+
+                  REAL(data,stride,i) = t1_real;
+                  IMAG(data,stride,i) = t1_imag;
+                  REAL(data,stride,j) = wb_real[b] * t2_real - wb_imag[b] * t2_imag;
+                  IMAG(data,stride,j) = wb_real[b] * t2_imag + wb_imag[b] * t2_real;
+                }
+            }
         }
       dual /= 2;
     }
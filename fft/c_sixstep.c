@@ -0,0 +1,433 @@
+/* fft/c_sixstep.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * The six-step algorithm computes a transform of length n = n1 * n2
+ * as two sets of short row transforms separated by transposes:
+ *
+ * With j = j1 n2 + j2 and k = k1 + n1 k2,
+ *
+ * X(k1 + n1 k2) = sum_j2 W_n2^(j2 k2) [ W_n^(j2 k1) sum_j1 x(j1 n2 + j2) W_n1^(j1 k1) ]
+ *
+ * The stages are
+ *
+ * 0: y = x^T             (x is n1-by-n2, y is n2-by-n1)
+ * 1: x = y, then transform each of the n2 rows of length n1 and
+ *    multiply element (j2,k1) by the twiddle factor W_n^(j2 k1)
+ * 2: y = x^T             (y is n1-by-n2)
+ * 3: x = y, then transform each of the n1 rows of length n2
+ * 4: y = x^T             (y is n2-by-n1)
+ * 5: x = y
+ *
+ * The matrix y is the scratch space of a workspace of length n. Within
+ * each stage the rows are independent, so a stage may be split into
+ * ranges of rows which are processed concurrently. When a row is
+ * transformed it is first copied from y to x, and the same row of y is
+ * then free to be used as scratch space for the mixed-radix passes.
+ */
+
+/* size of the square blocks used in the transposes */
+#define SIXSTEP_BLOCK 16
+
+static int
+FUNCTION(fft_complex,sixstep_transpose) (const BASE in[],
+                                         const size_t istride,
+                                         BASE out[],
+                                         const size_t ostride,
+                                         const size_t nrows,
+                                         const size_t ncols,
+                                         const size_t first,
+                                         const size_t last);
+
+static int
+FUNCTION(fft_complex,sixstep_rows) (BASE data[],
+                                    const size_t stride,
+                                    BASE scratch[],
+                                    const size_t len,
+                                    const size_t first,
+                                    const size_t last,
+                                    const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                    const gsl_fft_direction sign);
+
+static int
+FUNCTION(fft_complex,sixstep_twiddle) (BASE data[],
+                                       const size_t stride,
+                                       const size_t n1,
+                                       const size_t first,
+                                       const size_t last,
+                                       const TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable,
+                                       const gsl_fft_direction sign);
+
+TYPE(gsl_fft_complex_sixstep_wavetable) *
+FUNCTION(gsl_fft_complex_sixstep_wavetable,alloc) (size_t n)
+{
+  TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable;
+  size_t n1, i;
+
+  if (n == 0)
+    {
+      GSL_ERROR_VAL ("length n must be positive integer", GSL_EDOM, 0);
+    }
+
+  wavetable = (TYPE(gsl_fft_complex_sixstep_wavetable) *)
+    malloc (sizeof (TYPE(gsl_fft_complex_sixstep_wavetable)));
+
+  if (wavetable == NULL)
+    {
+      GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
+    }
+
+  /* choose the largest divisor n1 <= sqrt(n) for which neither row
+     length needs Bluestein's algorithm, since the rows only have
+     scratch space for the mixed-radix passes. Otherwise n1 = 1 and the
+     whole transform is done as a single row in stage 3 */
+
+  n1 = (size_t) sqrt ((double) n);
+
+  while (n1 * n1 > n)
+    n1--;
+
+  while ((n1 + 1) * (n1 + 1) <= n)
+    n1++;
+
+  for ( ; n1 > 1; n1--)
+    {
+      if (n % n1 == 0 &&
+          fft_complex_bluestein_length (n1) == 0 &&
+          fft_complex_bluestein_length (n / n1) == 0)
+        break;
+    }
+
+  wavetable->n = n;
+  wavetable->n1 = n1;
+  wavetable->n2 = n / n1;
+
+  wavetable->wavetable1 = FUNCTION(gsl_fft_complex_wavetable,alloc) (wavetable->n1);
+
+  if (wavetable->wavetable1 == NULL)
+    {
+      free (wavetable);
+      GSL_ERROR_VAL ("failed to allocate row wavetable", GSL_ENOMEM, 0);
+    }
+
+  wavetable->wavetable2 = FUNCTION(gsl_fft_complex_wavetable,alloc) (wavetable->n2);
+
+  if (wavetable->wavetable2 == NULL)
+    {
+      FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->wavetable1);
+      free (wavetable);
+      GSL_ERROR_VAL ("failed to allocate row wavetable", GSL_ENOMEM, 0);
+    }
+
+  /* the twiddle factors W_n^m, 0 <= m < n, are stored as the products
+     of two tables of length about sqrt(n), W_n^m = hi[m / nw] lo[m % nw] */
+
+  wavetable->nw = n1;
+
+  wavetable->twiddle = (TYPE(gsl_complex) *)
+    malloc ((wavetable->nw + wavetable->n2) * sizeof (TYPE(gsl_complex)));
+
+  if (wavetable->twiddle == NULL)
+    {
+      FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->wavetable1);
+      FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->wavetable2);
+      free (wavetable);
+      GSL_ERROR_VAL ("failed to allocate twiddle factors", GSL_ENOMEM, 0);
+    }
+
+  {
+    const double d_theta = -2.0 * M_PI / ((double) n);
+    TYPE(gsl_complex) * lo = wavetable->twiddle;
+    TYPE(gsl_complex) * hi = wavetable->twiddle + wavetable->nw;
+
+    for (i = 0; i < wavetable->nw; i++)
+      {
+        const double theta = d_theta * i;
+        GSL_REAL(lo[i]) = cos (theta);
+        GSL_IMAG(lo[i]) = sin (theta);
+      }
+
+    for (i = 0; i < wavetable->n2; i++)
+      {
+        const double theta = d_theta * (i * wavetable->nw);
+        GSL_REAL(hi[i]) = cos (theta);
+        GSL_IMAG(hi[i]) = sin (theta);
+      }
+  }
+
+  return wavetable;
+}
+
+void
+FUNCTION(gsl_fft_complex_sixstep_wavetable,free) (TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable)
+{
+  RETURN_IF_NULL (wavetable);
+
+  FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->wavetable1);
+  FUNCTION(gsl_fft_complex_wavetable,free) (wavetable->wavetable2);
+  free (wavetable->twiddle);
+  free (wavetable);
+}
+
+size_t
+FUNCTION(gsl_fft_complex,sixstep_nrows) (const size_t stage,
+                                         const TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable)
+{
+  if (stage == 2 || stage == 3)
+    return wavetable->n1;
+  else if (stage < GSL_FFT_SIXSTEP_NSTAGES)
+    return wavetable->n2;
+  else
+    return 0;
+}
+
+int
+FUNCTION(gsl_fft_complex,sixstep_transform) (TYPE(gsl_complex_packed_array) data,
+                                             const size_t stride,
+                                             const size_t n,
+                                             const TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable,
+                                             TYPE(gsl_fft_complex_workspace) * work,
+                                             const gsl_fft_direction sign)
+{
+  size_t stage;
+
+  for (stage = 0; stage < GSL_FFT_SIXSTEP_NSTAGES; stage++)
+    {
+      const size_t nrows = FUNCTION(gsl_fft_complex,sixstep_nrows) (stage, wavetable);
+      int status = FUNCTION(gsl_fft_complex,sixstep_stage) (data, stride, n, stage,
+                                                            0, nrows, wavetable,
+                                                            work, sign);
+
+      if (status)
+        return status;
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+FUNCTION(gsl_fft_complex,sixstep_stage) (TYPE(gsl_complex_packed_array) data,
+                                         const size_t stride,
+                                         const size_t n,
+                                         const size_t stage,
+                                         const size_t first,
+                                         const size_t last,
+                                         const TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable,
+                                         TYPE(gsl_fft_complex_workspace) * work,
+                                         const gsl_fft_direction sign)
+{
+  const size_t n1 = wavetable->n1;
+  const size_t n2 = wavetable->n2;
+  BASE * y = work->scratch;
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (n != wavetable->n)
+    {
+      GSL_ERROR ("wavetable does not match length of data", GSL_EINVAL);
+    }
+
+  if (n != work->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (stage >= GSL_FFT_SIXSTEP_NSTAGES)
+    {
+      GSL_ERROR ("stage number is out of range", GSL_EINVAL);
+    }
+
+  if (first > last || last > FUNCTION(gsl_fft_complex,sixstep_nrows) (stage, wavetable))
+    {
+      GSL_ERROR ("row range is out of range for this stage", GSL_EINVAL);
+    }
+
+  switch (stage)
+    {
+    case 0:
+      FUNCTION(fft_complex,sixstep_transpose) (data, stride, y, 1, n1, n2, first, last);
+      break;
+
+    case 1:
+      FUNCTION(fft_complex,sixstep_rows) (data, stride, y, n1, first, last,
+                                          wavetable->wavetable1, sign);
+      FUNCTION(fft_complex,sixstep_twiddle) (data, stride, n1, first, last,
+                                             wavetable, sign);
+      break;
+
+    case 2:
+      FUNCTION(fft_complex,sixstep_transpose) (data, stride, y, 1, n2, n1, first, last);
+      break;
+
+    case 3:
+      FUNCTION(fft_complex,sixstep_rows) (data, stride, y, n2, first, last,
+                                          wavetable->wavetable2, sign);
+      break;
+
+    case 4:
+      FUNCTION(fft_complex,sixstep_transpose) (data, stride, y, 1, n1, n2, first, last);
+      break;
+
+    case 5:
+      {
+        size_t i;
+
+        for (i = first * n1; i < last * n1; i++)
+          {
+            REAL(data,stride,i) = REAL(y,1,i);
+            IMAG(data,stride,i) = IMAG(y,1,i);
+          }
+      }
+      break;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* transpose the nrows-by-ncols matrix in into the ncols-by-nrows matrix
+   out, for the rows first <= i < last of out. The copy is done in
+   square blocks so that both matrices are accessed in cache lines */
+
+static int
+FUNCTION(fft_complex,sixstep_transpose) (const BASE in[],
+                                         const size_t istride,
+                                         BASE out[],
+                                         const size_t ostride,
+                                         const size_t nrows,
+                                         const size_t ncols,
+                                         const size_t first,
+                                         const size_t last)
+{
+  size_t i0, j0, i, j;
+
+  for (i0 = first; i0 < last; i0 += SIXSTEP_BLOCK)
+    {
+      const size_t imax = GSL_MIN (i0 + SIXSTEP_BLOCK, last);
+
+      for (j0 = 0; j0 < nrows; j0 += SIXSTEP_BLOCK)
+        {
+          const size_t jmax = GSL_MIN (j0 + SIXSTEP_BLOCK, nrows);
+
+          for (i = i0; i < imax; i++)
+            {
+              for (j = j0; j < jmax; j++)
+                {
+                  REAL(out,ostride,i * nrows + j) = REAL(in,istride,j * ncols + i);
+                  IMAG(out,ostride,i * nrows + j) = IMAG(in,istride,j * ncols + i);
+                }
+            }
+        }
+    }
+
+  return 0;
+}
+
+/* copy the rows first <= i < last of length len from the scratch
+   matrix y to data, and transform them in place using the row of y as
+   scratch space */
+
+static int
+FUNCTION(fft_complex,sixstep_rows) (BASE data[],
+                                    const size_t stride,
+                                    BASE scratch[],
+                                    const size_t len,
+                                    const size_t first,
+                                    const size_t last,
+                                    const TYPE(gsl_fft_complex_wavetable) * wavetable,
+                                    const gsl_fft_direction sign)
+{
+  size_t i, k;
+
+  for (i = first; i < last; i++)
+    {
+      BASE * const x = data + 2 * stride * i * len;
+      BASE * const y = scratch + 2 * i * len;
+
+      for (k = 0; k < len; k++)
+        {
+          REAL(x,stride,k) = REAL(y,1,k);
+          IMAG(x,stride,k) = IMAG(y,1,k);
+        }
+
+      if (len == 1)
+        continue;
+
+      if (wavetable->nb)
+        {
+          /* only when the transform is not split, n1 = 1, and y is
+             the whole workspace */
+
+          FUNCTION(fft_complex,bluestein) (x, stride, len, wavetable->nb,
+                                           wavetable->nf, wavetable->factor,
+                                           wavetable->twiddle, wavetable->chirp,
+                                           y, sign);
+        }
+      else
+        {
+          FUNCTION(fft_complex,mixed_radix) (x, stride, len, wavetable->nf,
+                                             wavetable->factor, wavetable->twiddle,
+                                             y, sign);
+        }
+    }
+
+  return 0;
+}
+
+/* multiply element k1 of row j2 by W_n^(j2 k1), or by its conjugate
+   for the backward transform */
+
+static int
+FUNCTION(fft_complex,sixstep_twiddle) (BASE data[],
+                                       const size_t stride,
+                                       const size_t n1,
+                                       const size_t first,
+                                       const size_t last,
+                                       const TYPE(gsl_fft_complex_sixstep_wavetable) * wavetable,
+                                       const gsl_fft_direction sign)
+{
+  const size_t nw = wavetable->nw;
+  const TYPE(gsl_complex) * lo = wavetable->twiddle;
+  const TYPE(gsl_complex) * hi = wavetable->twiddle + nw;
+  const ATOMIC s = (sign == gsl_fft_forward) ? 1 : -1;
+  size_t j2, k1;
+
+  for (j2 = first; j2 < last; j2++)
+    {
+      BASE * const x = data + 2 * stride * j2 * n1;
+
+      for (k1 = 1; k1 < n1; k1++)
+        {
+          const size_t m = j2 * k1;
+          const TYPE(gsl_complex) a = hi[m / nw];
+          const TYPE(gsl_complex) b = lo[m % nw];
+          const ATOMIC w_real = GSL_REAL(a) * GSL_REAL(b) - GSL_IMAG(a) * GSL_IMAG(b);
+          const ATOMIC w_imag = s * (GSL_REAL(a) * GSL_IMAG(b) + GSL_IMAG(a) * GSL_REAL(b));
+          const ATOMIC z_real = REAL(x,stride,k1);
+          const ATOMIC z_imag = IMAG(x,stride,k1);
+
+          REAL(x,stride,k1) = w_real * z_real - w_imag * z_imag;
+          IMAG(x,stride,k1) = w_real * z_imag + w_imag * z_real;
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,337 @@
+/* fft/cache.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_fft_cache.h>
+
+/* kinds of cached objects */
+enum
+{
+  CACHE_COMPLEX_WAVETABLE,
+  CACHE_COMPLEX_WAVETABLE_FLOAT,
+  CACHE_REAL_WAVETABLE,
+  CACHE_REAL_WAVETABLE_FLOAT,
+  CACHE_HALFCOMPLEX_WAVETABLE,
+  CACHE_HALFCOMPLEX_WAVETABLE_FLOAT,
+  CACHE_COMPLEX_WORKSPACE,
+  CACHE_COMPLEX_WORKSPACE_FLOAT,
+  CACHE_REAL_WORKSPACE,
+  CACHE_REAL_WORKSPACE_FLOAT
+};
+
+/* initial number of entries */
+#define CACHE_NALLOC          16
+
+static void * cache_get (const int type, const size_t n, gsl_fft_cache * c);
+static size_t cache_find (const int type, const size_t n, const gsl_fft_cache * c);
+static void * cache_create (const int type, const size_t n);
+static void cache_destroy (gsl_fft_cache_entry * e);
+
+/*
+gsl_fft_cache_alloc()
+  Allocate an empty cache of wavetables and workspaces
+
+Notes:
+1) Objects are created on the first request for a given length and
+kind, and the same object is returned by later requests until the
+cache is reset or freed
+
+2) Requests for objects already in the cache do not modify it, so
+several threads may share a cache of wavetables (which are read-only)
+once it has been filled. Adding objects is not thread-safe, and
+workspaces must not be shared between threads, so each thread should
+use its own cache for workspaces
+*/
+
+gsl_fft_cache *
+gsl_fft_cache_alloc (void)
+{
+  gsl_fft_cache * c;
+
+  c = calloc (1, sizeof (gsl_fft_cache));
+  if (c == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate cache", GSL_ENOMEM);
+    }
+
+  c->entry = malloc (CACHE_NALLOC * sizeof (gsl_fft_cache_entry));
+  if (c->entry == NULL)
+    {
+      free (c);
+      GSL_ERROR_NULL ("failed to allocate cache entries", GSL_ENOMEM);
+    }
+
+  c->size = 0;
+  c->nalloc = CACHE_NALLOC;
+
+  return c;
+}
+
+void
+gsl_fft_cache_free (gsl_fft_cache * c)
+{
+  RETURN_IF_NULL (c);
+
+  gsl_fft_cache_reset (c);
+  free (c->entry);
+  free (c);
+}
+
+/* free all cached objects; pointers previously returned become invalid */
+
+void
+gsl_fft_cache_reset (gsl_fft_cache * c)
+{
+  size_t i;
+
+  for (i = 0; i < c->size; ++i)
+    cache_destroy (&(c->entry[i]));
+
+  c->size = 0;
+}
+
+size_t
+gsl_fft_cache_size (const gsl_fft_cache * c)
+{
+  return c->size;
+}
+
+const gsl_fft_complex_wavetable *
+gsl_fft_cache_complex_wavetable (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_COMPLEX_WAVETABLE, n, c);
+}
+
+const gsl_fft_complex_wavetable_float *
+gsl_fft_cache_complex_wavetable_float (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_COMPLEX_WAVETABLE_FLOAT, n, c);
+}
+
+const gsl_fft_real_wavetable *
+gsl_fft_cache_real_wavetable (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_REAL_WAVETABLE, n, c);
+}
+
+const gsl_fft_real_wavetable_float *
+gsl_fft_cache_real_wavetable_float (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_REAL_WAVETABLE_FLOAT, n, c);
+}
+
+const gsl_fft_halfcomplex_wavetable *
+gsl_fft_cache_halfcomplex_wavetable (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_HALFCOMPLEX_WAVETABLE, n, c);
+}
+
+const gsl_fft_halfcomplex_wavetable_float *
+gsl_fft_cache_halfcomplex_wavetable_float (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_HALFCOMPLEX_WAVETABLE_FLOAT, n, c);
+}
+
+gsl_fft_complex_workspace *
+gsl_fft_cache_complex_workspace (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_COMPLEX_WORKSPACE, n, c);
+}
+
+gsl_fft_complex_workspace_float *
+gsl_fft_cache_complex_workspace_float (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_COMPLEX_WORKSPACE_FLOAT, n, c);
+}
+
+gsl_fft_real_workspace *
+gsl_fft_cache_real_workspace (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_REAL_WORKSPACE, n, c);
+}
+
+gsl_fft_real_workspace_float *
+gsl_fft_cache_real_workspace_float (const size_t n, gsl_fft_cache * c)
+{
+  return cache_get (CACHE_REAL_WORKSPACE_FLOAT, n, c);
+}
+
+/* return the cached object of the given kind and length, creating it
+   if necessary */
+
+static void *
+cache_get (const int type, const size_t n, gsl_fft_cache * c)
+{
+  const size_t idx = cache_find (type, n, c);
+  gsl_fft_cache_entry * e;
+  void * ptr;
+
+  if (idx < c->size && c->entry[idx].type == type && c->entry[idx].n == n)
+    return c->entry[idx].ptr;
+
+  ptr = cache_create (type, n);
+  if (ptr == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate cached object", GSL_ENOMEM);
+    }
+
+  if (c->size == c->nalloc)
+    {
+      gsl_fft_cache_entry * p = realloc (c->entry, 2 * c->nalloc * sizeof (gsl_fft_cache_entry));
+
+      if (p == NULL)
+        {
+          gsl_fft_cache_entry tmp;
+
+          tmp.type = type;
+          tmp.ptr = ptr;
+          cache_destroy (&tmp);
+
+          GSL_ERROR_NULL ("failed to grow cache", GSL_ENOMEM);
+        }
+
+      c->entry = p;
+      c->nalloc *= 2;
+    }
+
+  /* insert at idx to keep the entries sorted */
+  memmove (c->entry + idx + 1, c->entry + idx, (c->size - idx) * sizeof (gsl_fft_cache_entry));
+
+  e = &(c->entry[idx]);
+  e->type = type;
+  e->n = n;
+  e->ptr = ptr;
+  ++(c->size);
+
+  return ptr;
+}
+
+/* binary search for the first entry not less than (type, n) */
+
+static size_t
+cache_find (const int type, const size_t n, const gsl_fft_cache * c)
+{
+  size_t lo = 0, hi = c->size;
+
+  while (lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      const gsl_fft_cache_entry * e = &(c->entry[mid]);
+
+      if (e->type < type || (e->type == type && e->n < n))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return lo;
+}
+
+static void *
+cache_create (const int type, const size_t n)
+{
+  switch (type)
+    {
+      case CACHE_COMPLEX_WAVETABLE:
+        return gsl_fft_complex_wavetable_alloc (n);
+
+      case CACHE_COMPLEX_WAVETABLE_FLOAT:
+        return gsl_fft_complex_wavetable_float_alloc (n);
+
+      case CACHE_REAL_WAVETABLE:
+        return gsl_fft_real_wavetable_alloc (n);
+
+      case CACHE_REAL_WAVETABLE_FLOAT:
+        return gsl_fft_real_wavetable_float_alloc (n);
+
+      case CACHE_HALFCOMPLEX_WAVETABLE:
+        return gsl_fft_halfcomplex_wavetable_alloc (n);
+
+      case CACHE_HALFCOMPLEX_WAVETABLE_FLOAT:
+        return gsl_fft_halfcomplex_wavetable_float_alloc (n);
+
+      case CACHE_COMPLEX_WORKSPACE:
+        return gsl_fft_complex_workspace_alloc (n);
+
+      case CACHE_COMPLEX_WORKSPACE_FLOAT:
+        return gsl_fft_complex_workspace_float_alloc (n);
+
+      case CACHE_REAL_WORKSPACE:
+        return gsl_fft_real_workspace_alloc (n);
+
+      case CACHE_REAL_WORKSPACE_FLOAT:
+        return gsl_fft_real_workspace_float_alloc (n);
+
+      default:
+        return NULL;
+    }
+}
+
+static void
+cache_destroy (gsl_fft_cache_entry * e)
+{
+  switch (e->type)
+    {
+      case CACHE_COMPLEX_WAVETABLE:
+        gsl_fft_complex_wavetable_free (e->ptr);
+        break;
+
+      case CACHE_COMPLEX_WAVETABLE_FLOAT:
+        gsl_fft_complex_wavetable_float_free (e->ptr);
+        break;
+
+      case CACHE_REAL_WAVETABLE:
+        gsl_fft_real_wavetable_free (e->ptr);
+        break;
+
+      case CACHE_REAL_WAVETABLE_FLOAT:
+        gsl_fft_real_wavetable_float_free (e->ptr);
+        break;
+
+      case CACHE_HALFCOMPLEX_WAVETABLE:
+        gsl_fft_halfcomplex_wavetable_free (e->ptr);
+        break;
+
+      case CACHE_HALFCOMPLEX_WAVETABLE_FLOAT:
+        gsl_fft_halfcomplex_wavetable_float_free (e->ptr);
+        break;
+
+      case CACHE_COMPLEX_WORKSPACE:
+        gsl_fft_complex_workspace_free (e->ptr);
+        break;
+
+      case CACHE_COMPLEX_WORKSPACE_FLOAT:
+        gsl_fft_complex_workspace_float_free (e->ptr);
+        break;
+
+      case CACHE_REAL_WORKSPACE:
+        gsl_fft_real_workspace_free (e->ptr);
+        break;
+
+      case CACHE_REAL_WORKSPACE_FLOAT:
+        gsl_fft_real_workspace_float_free (e->ptr);
+        break;
+    }
+
+  e->ptr = NULL;
+}
@@ -0,0 +1,779 @@
+/* fft/convolve.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_convolve.h>
+
+/* relative cost of one point of a real FFT of length n, per log2(n),
+   compared to one multiply-add of the direct convolution */
+#define CONVOLVE_FFT_COST     1.0
+
+static size_t convolve_fft_length (const size_t n);
+static int convolve_range (const gsl_fft_convolve_mode_t mode, const size_t n, const size_t k,
+                           size_t * start, size_t * ny);
+static int convolve_use_fft (const size_t n, const size_t k, const size_t ny,
+                             const double ratio, const gsl_fft_convolve_workspace * w);
+static int convolve_real (const gsl_fft_convolve_mode_t mode, const int correlate,
+                          const gsl_vector * x, const gsl_vector * h, gsl_vector * y,
+                          gsl_fft_convolve_workspace * w);
+static int convolve_complex (const gsl_fft_convolve_mode_t mode, const int correlate,
+                             const gsl_vector_complex * x, const gsl_vector_complex * h,
+                             gsl_vector_complex * y, gsl_fft_convolve_workspace * w);
+static void convolve_hc_mul (double * a, const double * b, const size_t n);
+
+/*
+gsl_fft_convolve_alloc()
+  Allocate a workspace for convolutions and correlations
+
+Inputs: n - maximum signal length
+        k - maximum kernel length
+
+Return: pointer to workspace
+*/
+
+gsl_fft_convolve_workspace *
+gsl_fft_convolve_alloc (const size_t n, const size_t k)
+{
+  gsl_fft_convolve_workspace * w;
+
+  if (n == 0 || k == 0)
+    {
+      GSL_ERROR_NULL ("lengths must be positive integers", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_convolve_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->nmax = n;
+  w->kmax = k;
+  w->nfft = convolve_fft_length (n + k - 1);
+  w->method = GSL_FFT_CONVOLVE_AUTO;
+
+  w->real_wavetable = gsl_fft_real_wavetable_alloc (w->nfft);
+  w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (w->nfft);
+  w->real_work = gsl_fft_real_workspace_alloc (w->nfft);
+  w->complex_wavetable = gsl_fft_complex_wavetable_alloc (w->nfft);
+  w->complex_work = gsl_fft_complex_workspace_alloc (w->nfft);
+
+  if (w->real_wavetable == NULL || w->hc_wavetable == NULL || w->real_work == NULL ||
+      w->complex_wavetable == NULL || w->complex_work == NULL)
+    {
+      gsl_fft_convolve_free (w);
+      GSL_ERROR_NULL ("failed to allocate wavetables", GSL_ENOMEM);
+    }
+
+  w->buf1 = malloc (2 * w->nfft * sizeof (double));
+  w->buf2 = malloc (2 * w->nfft * sizeof (double));
+
+  if (w->buf1 == NULL || w->buf2 == NULL)
+    {
+      gsl_fft_convolve_free (w);
+      GSL_ERROR_NULL ("failed to allocate buffers", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_convolve_free (gsl_fft_convolve_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->complex_wavetable)
+    gsl_fft_complex_wavetable_free (w->complex_wavetable);
+
+  if (w->complex_work)
+    gsl_fft_complex_workspace_free (w->complex_work);
+
+  if (w->buf1)
+    free (w->buf1);
+
+  if (w->buf2)
+    free (w->buf2);
+
+  free (w);
+}
+
+int
+gsl_fft_convolve_set_method (const gsl_fft_convolve_method_t method,
+                             gsl_fft_convolve_workspace * w)
+{
+  if (method != GSL_FFT_CONVOLVE_AUTO && method != GSL_FFT_CONVOLVE_DIRECT &&
+      method != GSL_FFT_CONVOLVE_FFT)
+    {
+      GSL_ERROR ("unknown convolution method", GSL_EINVAL);
+    }
+
+  w->method = method;
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_convolve_size()
+  Return the length of the output of a convolution or correlation
+
+Inputs: mode - portion of the full convolution
+        n    - signal length
+        k    - kernel length
+
+Return: output length, or 0 if there are no outputs (mode = VALID and k > n)
+*/
+
+size_t
+gsl_fft_convolve_size (const gsl_fft_convolve_mode_t mode, const size_t n, const size_t k)
+{
+  size_t start, ny;
+
+  if (n == 0 || k == 0)
+    return 0;
+
+  if (convolve_range (mode, n, k, &start, &ny))
+    return 0;
+
+  return ny;
+}
+
+/*
+gsl_fft_convolve()
+  Compute the convolution of a real signal with a real kernel,
+
+y_full(i) = sum_j h(j) x(i - j), 0 <= i < n + k - 1
+
+Inputs: mode - portion of y_full to return
+        x    - input signal, length n <= w->nmax
+        h    - kernel, length k <= w->kmax
+        y    - (output) convolution, length gsl_fft_convolve_size(mode, n, k)
+        w    - workspace
+
+Notes:
+1) For mode = SAME, y(i) = y_full(i + (k - 1)/2), 0 <= i < n
+2) For mode = VALID, y(i) = y_full(i + k - 1), 0 <= i < n - k + 1
+*/
+
+int
+gsl_fft_convolve (const gsl_fft_convolve_mode_t mode, const gsl_vector * x,
+                  const gsl_vector * h, gsl_vector * y, gsl_fft_convolve_workspace * w)
+{
+  return convolve_real (mode, 0, x, h, y, w);
+}
+
+/*
+gsl_fft_correlate()
+  Compute the cross-correlation of a real signal with a real kernel,
+
+y_full(i) = sum_j h(j) x(i + j - (k - 1)), 0 <= i < n + k - 1
+
+which is the convolution of x with the reversed kernel. The modes
+are the same as gsl_fft_convolve().
+*/
+
+int
+gsl_fft_correlate (const gsl_fft_convolve_mode_t mode, const gsl_vector * x,
+                   const gsl_vector * h, gsl_vector * y, gsl_fft_convolve_workspace * w)
+{
+  return convolve_real (mode, 1, x, h, y, w);
+}
+
+int
+gsl_fft_convolve_complex (const gsl_fft_convolve_mode_t mode, const gsl_vector_complex * x,
+                          const gsl_vector_complex * h, gsl_vector_complex * y,
+                          gsl_fft_convolve_workspace * w)
+{
+  return convolve_complex (mode, 0, x, h, y, w);
+}
+
+/* complex cross-correlation uses the conjugate of the kernel,
+   y_full(i) = sum_j conj(h(j)) x(i + j - (k - 1)) */
+
+int
+gsl_fft_correlate_complex (const gsl_fft_convolve_mode_t mode, const gsl_vector_complex * x,
+                           const gsl_vector_complex * h, gsl_vector_complex * y,
+                           gsl_fft_convolve_workspace * w)
+{
+  return convolve_complex (mode, 1, x, h, y, w);
+}
+
+/*
+gsl_fft_convolve_stream_alloc()
+  Allocate a workspace for convolving a long signal with a fixed
+kernel in consecutive pieces
+
+Inputs: type  - GSL_FFT_CONVOLVE_OVERLAP_ADD or GSL_FFT_CONVOLVE_OVERLAP_SAVE
+        k     - kernel length
+        block - number of new input samples processed by each FFT;
+                if 0, a block length of 4*k is used
+
+Return: pointer to workspace
+
+Notes:
+1) The FFT length is the smallest 5-smooth length >= block + k - 1,
+and the block length is then increased to fill it
+*/
+
+gsl_fft_convolve_stream_workspace *
+gsl_fft_convolve_stream_alloc (const gsl_fft_convolve_stream_t type,
+                               const size_t k, const size_t block)
+{
+  gsl_fft_convolve_stream_workspace * w;
+
+  if (k == 0)
+    {
+      GSL_ERROR_NULL ("kernel length must be a positive integer", GSL_EDOM);
+    }
+
+  if (type != GSL_FFT_CONVOLVE_OVERLAP_ADD && type != GSL_FFT_CONVOLVE_OVERLAP_SAVE)
+    {
+      GSL_ERROR_NULL ("unknown streaming method", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_convolve_stream_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->type = type;
+  w->k = k;
+  w->nfft = convolve_fft_length ((block > 0 ? block : 4 * k) + k - 1);
+  w->block = w->nfft - k + 1;
+
+  w->real_wavetable = gsl_fft_real_wavetable_alloc (w->nfft);
+  w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (w->nfft);
+  w->real_work = gsl_fft_real_workspace_alloc (w->nfft);
+
+  if (w->real_wavetable == NULL || w->hc_wavetable == NULL || w->real_work == NULL)
+    {
+      gsl_fft_convolve_stream_free (w);
+      GSL_ERROR_NULL ("failed to allocate wavetables", GSL_ENOMEM);
+    }
+
+  w->H = calloc (w->nfft, sizeof (double));
+  w->buf = malloc (w->nfft * sizeof (double));
+  w->state = calloc (w->nfft, sizeof (double));
+
+  if (w->H == NULL || w->buf == NULL || w->state == NULL)
+    {
+      gsl_fft_convolve_stream_free (w);
+      GSL_ERROR_NULL ("failed to allocate buffers", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_convolve_stream_free (gsl_fft_convolve_stream_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->H)
+    free (w->H);
+
+  if (w->buf)
+    free (w->buf);
+
+  if (w->state)
+    free (w->state);
+
+  free (w);
+}
+
+/*
+gsl_fft_convolve_stream_init()
+  Set the kernel and reset the stream to zero history
+
+Inputs: h - kernel, length w->k
+        w - workspace
+*/
+
+int
+gsl_fft_convolve_stream_init (const gsl_vector * h, gsl_fft_convolve_stream_workspace * w)
+{
+  if (h->size != w->k)
+    {
+      GSL_ERROR ("kernel length does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t i;
+
+      /* the kernel transform is scaled by 1/nfft so that the backward
+         halfcomplex transform gives the convolution directly */
+
+      for (i = 0; i < w->k; ++i)
+        w->H[i] = gsl_vector_get (h, i) / (double) w->nfft;
+
+      for (i = w->k; i < w->nfft; ++i)
+        w->H[i] = 0.0;
+
+      gsl_fft_real_transform (w->H, 1, w->nfft, w->real_wavetable, w->real_work);
+
+      return gsl_fft_convolve_stream_reset (w);
+    }
+}
+
+int
+gsl_fft_convolve_stream_reset (gsl_fft_convolve_stream_workspace * w)
+{
+  memset (w->state, 0, w->nfft * sizeof (double));
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_convolve_stream_apply()
+  Apply the kernel to the next piece of a long signal. Over successive
+calls, the outputs are the first samples of the full convolution of
+the concatenated inputs,
+
+y(i) = sum_{j=0}^{k-1} h(j) x(i - j)
+
+with x(i) = 0 for i < 0 (before the first call after init/reset).
+
+Inputs: x - next input samples, any length
+        y - (output) next output samples, same length as x
+        w - workspace
+
+Notes:
+1) x and y may be the same vector
+2) Pieces longer than w->block are processed in several blocks;
+shorter pieces are processed immediately, so there is no latency
+*/
+
+int
+gsl_fft_convolve_stream_apply (const gsl_vector * x, gsl_vector * y,
+                               gsl_fft_convolve_stream_workspace * w)
+{
+  if (x->size != y->size)
+    {
+      GSL_ERROR ("input and output vectors must have same length", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = x->size;
+      const size_t nfft = w->nfft;
+      double * buf = w->buf;
+      double * state = w->state;
+      size_t i0 = 0;
+
+      while (i0 < n)
+        {
+          const size_t len = GSL_MIN (w->block, n - i0);
+          size_t i;
+
+          if (w->type == GSL_FFT_CONVOLVE_OVERLAP_ADD)
+            {
+              /* convolve the zero-padded piece and add it to the tail
+                 of the previous pieces */
+
+              for (i = 0; i < len; ++i)
+                buf[i] = gsl_vector_get (x, i0 + i);
+
+              for (i = len; i < nfft; ++i)
+                buf[i] = 0.0;
+
+              gsl_fft_real_transform (buf, 1, nfft, w->real_wavetable, w->real_work);
+              convolve_hc_mul (buf, w->H, nfft);
+              gsl_fft_halfcomplex_transform (buf, 1, nfft, w->hc_wavetable, w->real_work);
+
+              for (i = 0; i < len + w->k - 1; ++i)
+                state[i] += buf[i];
+
+              for (i = 0; i < len; ++i)
+                gsl_vector_set (y, i0 + i, state[i]);
+
+              /* at most k - 1 samples of the tail remain */
+              memmove (state, state + len, (nfft - len) * sizeof (double));
+              memset (state + nfft - len, 0, len * sizeof (double));
+            }
+          else
+            {
+              /* append the piece to the last nfft input samples; the
+                 last len outputs of the circular convolution are free
+                 of wrap-around since nfft - len >= k - 1 */
+
+              memmove (state, state + len, (nfft - len) * sizeof (double));
+
+              for (i = 0; i < len; ++i)
+                state[nfft - len + i] = gsl_vector_get (x, i0 + i);
+
+              memcpy (buf, state, nfft * sizeof (double));
+
+              gsl_fft_real_transform (buf, 1, nfft, w->real_wavetable, w->real_work);
+              convolve_hc_mul (buf, w->H, nfft);
+              gsl_fft_halfcomplex_transform (buf, 1, nfft, w->hc_wavetable, w->real_work);
+
+              for (i = 0; i < len; ++i)
+                gsl_vector_set (y, i0 + i, buf[nfft - len + i]);
+            }
+
+          i0 += len;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* smallest length >= n of the form 2^a 3^b 5^c, which are computed
+   efficiently by both the real and complex transforms */
+
+static size_t
+convolve_fft_length (const size_t n)
+{
+  size_t m;
+
+  for (m = n; ; ++m)
+    {
+      size_t t = m;
+
+      while (t % 2 == 0)
+        t /= 2;
+
+      while (t % 3 == 0)
+        t /= 3;
+
+      while (t % 5 == 0)
+        t /= 5;
+
+      if (t == 1)
+        return m;
+    }
+}
+
+/* compute the first index and length of the output within the full
+   convolution of length n + k - 1 */
+
+static int
+convolve_range (const gsl_fft_convolve_mode_t mode, const size_t n, const size_t k,
+                size_t * start, size_t * ny)
+{
+  switch (mode)
+    {
+      case GSL_FFT_CONVOLVE_FULL:
+        *start = 0;
+        *ny = n + k - 1;
+        break;
+
+      case GSL_FFT_CONVOLVE_SAME:
+        *start = (k - 1) / 2;
+        *ny = n;
+        break;
+
+      case GSL_FFT_CONVOLVE_VALID:
+        if (k > n)
+          {
+            GSL_ERROR ("kernel is longer than signal in VALID mode", GSL_EBADLEN);
+          }
+
+        *start = k - 1;
+        *ny = n - k + 1;
+        break;
+
+      default:
+        GSL_ERROR ("unknown convolution mode", GSL_EINVAL);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* decide whether the FFT is expected to be faster than the direct sum;
+   the direct method costs about ny*min(n,k) multiply-adds, and the FFT
+   method three transforms of length nfft. The ratio is the cost of a
+   multiply-add relative to a point of the transform, compared to the
+   real case */
+
+static int
+convolve_use_fft (const size_t n, const size_t k, const size_t ny,
+                  const double ratio, const gsl_fft_convolve_workspace * w)
+{
+  if (w->method == GSL_FFT_CONVOLVE_DIRECT)
+    return 0;
+  else if (w->method == GSL_FFT_CONVOLVE_FFT)
+    return 1;
+  else
+    {
+      const double nfft = (double) w->nfft;
+      const double cost_direct = ratio * (double) ny * (double) GSL_MIN (n, k);
+      const double cost_fft = 3.0 * CONVOLVE_FFT_COST * nfft * log (nfft) / M_LN2;
+
+      return cost_fft < cost_direct;
+    }
+}
+
+static int
+convolve_real (const gsl_fft_convolve_mode_t mode, const int correlate,
+               const gsl_vector * x, const gsl_vector * h, gsl_vector * y,
+               gsl_fft_convolve_workspace * w)
+{
+  const size_t n = x->size;
+  const size_t k = h->size;
+  size_t start, ny;
+  int status;
+
+  if (n == 0 || k == 0)
+    {
+      GSL_ERROR ("signal and kernel must have positive length", GSL_EBADLEN);
+    }
+  else if (n > w->nmax)
+    {
+      GSL_ERROR ("signal is longer than workspace", GSL_EBADLEN);
+    }
+  else if (k > w->kmax)
+    {
+      GSL_ERROR ("kernel is longer than workspace", GSL_EBADLEN);
+    }
+
+  status = convolve_range (mode, n, k, &start, &ny);
+  if (status)
+    return status;
+
+  if (y->size != ny)
+    {
+      GSL_ERROR ("output vector has wrong length for this mode", GSL_EBADLEN);
+    }
+
+  if (convolve_use_fft (n, k, ny, 1.0, w))
+    {
+      const size_t nfft = w->nfft;
+      double * a = w->buf1;
+      double * b = w->buf2;
+      size_t i;
+
+      for (i = 0; i < n; ++i)
+        a[i] = gsl_vector_get (x, i);
+
+      for (i = n; i < nfft; ++i)
+        a[i] = 0.0;
+
+      for (i = 0; i < k; ++i)
+        b[i] = gsl_vector_get (h, correlate ? k - 1 - i : i);
+
+      for (i = k; i < nfft; ++i)
+        b[i] = 0.0;
+
+      gsl_fft_real_transform (a, 1, nfft, w->real_wavetable, w->real_work);
+      gsl_fft_real_transform (b, 1, nfft, w->real_wavetable, w->real_work);
+      convolve_hc_mul (a, b, nfft);
+      gsl_fft_halfcomplex_inverse (a, 1, nfft, w->hc_wavetable, w->real_work);
+
+      for (i = 0; i < ny; ++i)
+        gsl_vector_set (y, i, a[start + i]);
+    }
+  else
+    {
+      const double * xd = x->data;
+      const double * hd = h->data;
+      const size_t xs = x->stride;
+      const size_t hs = h->stride;
+      size_t i, j;
+
+      for (i = 0; i < ny; ++i)
+        {
+          const size_t m = start + i; /* index in full convolution */
+          const size_t jmin = (m >= n) ? m - n + 1 : 0;
+          const size_t jmax = GSL_MIN (k - 1, m);
+          double sum = 0.0;
+
+          if (correlate)
+            {
+              for (j = jmin; j <= jmax; ++j)
+                sum += hd[(k - 1 - j) * hs] * xd[(m - j) * xs];
+            }
+          else
+            {
+              for (j = jmin; j <= jmax; ++j)
+                sum += hd[j * hs] * xd[(m - j) * xs];
+            }
+
+          gsl_vector_set (y, i, sum);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+convolve_complex (const gsl_fft_convolve_mode_t mode, const int correlate,
+                  const gsl_vector_complex * x, const gsl_vector_complex * h,
+                  gsl_vector_complex * y, gsl_fft_convolve_workspace * w)
+{
+  const size_t n = x->size;
+  const size_t k = h->size;
+  const double s = correlate ? -1.0 : 1.0; /* sign of imaginary part of kernel */
+  size_t start, ny;
+  int status;
+
+  if (n == 0 || k == 0)
+    {
+      GSL_ERROR ("signal and kernel must have positive length", GSL_EBADLEN);
+    }
+  else if (n > w->nmax)
+    {
+      GSL_ERROR ("signal is longer than workspace", GSL_EBADLEN);
+    }
+  else if (k > w->kmax)
+    {
+      GSL_ERROR ("kernel is longer than workspace", GSL_EBADLEN);
+    }
+
+  status = convolve_range (mode, n, k, &start, &ny);
+  if (status)
+    return status;
+
+  if (y->size != ny)
+    {
+      GSL_ERROR ("output vector has wrong length for this mode", GSL_EBADLEN);
+    }
+
+  /* a complex multiply-add costs about four times a real one, while a
+     complex FFT costs about twice a real FFT */
+
+  if (convolve_use_fft (n, k, ny, 2.0, w))
+    {
+      const size_t nfft = w->nfft;
+      double * a = w->buf1;
+      double * b = w->buf2;
+      size_t i;
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_complex z = gsl_vector_complex_get (x, i);
+          a[2 * i] = GSL_REAL (z);
+          a[2 * i + 1] = GSL_IMAG (z);
+        }
+
+      for (i = 2 * n; i < 2 * nfft; ++i)
+        a[i] = 0.0;
+
+      for (i = 0; i < k; ++i)
+        {
+          gsl_complex z = gsl_vector_complex_get (h, correlate ? k - 1 - i : i);
+          b[2 * i] = GSL_REAL (z);
+          b[2 * i + 1] = s * GSL_IMAG (z);
+        }
+
+      for (i = 2 * k; i < 2 * nfft; ++i)
+        b[i] = 0.0;
+
+      gsl_fft_complex_forward (a, 1, nfft, w->complex_wavetable, w->complex_work);
+      gsl_fft_complex_forward (b, 1, nfft, w->complex_wavetable, w->complex_work);
+
+      for (i = 0; i < nfft; ++i)
+        {
+          const double ar = a[2 * i], ai = a[2 * i + 1];
+          const double br = b[2 * i], bi = b[2 * i + 1];
+
+          a[2 * i] = ar * br - ai * bi;
+          a[2 * i + 1] = ar * bi + ai * br;
+        }
+
+      gsl_fft_complex_inverse (a, 1, nfft, w->complex_wavetable, w->complex_work);
+
+      for (i = 0; i < ny; ++i)
+        {
+          gsl_complex z;
+          GSL_SET_COMPLEX (&z, a[2 * (start + i)], a[2 * (start + i) + 1]);
+          gsl_vector_complex_set (y, i, z);
+        }
+    }
+  else
+    {
+      const double * xd = x->data;
+      const double * hd = h->data;
+      const size_t xs = 2 * x->stride;
+      const size_t hs = 2 * h->stride;
+      size_t i, j;
+
+      for (i = 0; i < ny; ++i)
+        {
+          const size_t m = start + i;
+          const size_t jmin = (m >= n) ? m - n + 1 : 0;
+          const size_t jmax = GSL_MIN (k - 1, m);
+          double sum_r = 0.0, sum_i = 0.0;
+          gsl_complex z;
+
+          for (j = jmin; j <= jmax; ++j)
+            {
+              const double * hj = hd + (correlate ? k - 1 - j : j) * hs;
+              const double * xj = xd + (m - j) * xs;
+              const double hr = hj[0], hi = s * hj[1];
+
+              sum_r += hr * xj[0] - hi * xj[1];
+              sum_i += hr * xj[1] + hi * xj[0];
+            }
+
+          GSL_SET_COMPLEX (&z, sum_r, sum_i);
+          gsl_vector_complex_set (y, i, z);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* multiply two halfcomplex arrays of length n elementwise, a := a * b */
+
+static void
+convolve_hc_mul (double * a, const double * b, const size_t n)
+{
+  size_t i;
+
+  a[0] *= b[0];
+
+  for (i = 1; i + 1 < n; i += 2)
+    {
+      const double ar = a[i], ai = a[i + 1];
+      const double br = b[i], bi = b[i + 1];
+
+      a[i] = ar * br - ai * bi;
+      a[i + 1] = ar * bi + ai * br;
+    }
+
+  if (n % 2 == 0)
+    a[n - 1] *= b[n - 1];
+}
@@ -23,6 +23,12 @@
 
 #include "factorize.h"
 
+/* smallest prime factor for which Bluestein's algorithm is considered */
+#define FFT_BLUESTEIN_MIN_FACTOR 17
+
+/* relative cost of the extra O(n) work in Bluestein's algorithm */
+#define FFT_BLUESTEIN_COST 8.0
+
 static int
 fft_complex_factorize (const size_t n,
                            size_t *nf,
@@ -62,6 +68,33 @@ fft_real_factorize (const size_t n,
   return status;
 }
 
+static size_t
+fft_complex_bluestein_length (const size_t n)
+{
+  const size_t complex_subtransforms[] =
+  {7, 6, 5, 4, 3, 2, 0};
+
+  return fft_bluestein_length (n, complex_subtransforms);
+}
+
+static size_t
+fft_halfcomplex_bluestein_length (const size_t n)
+{
+  const size_t halfcomplex_subtransforms[] =
+  {5, 4, 3, 2, 0};
+
+  return fft_bluestein_length (n, halfcomplex_subtransforms);
+}
+
+static size_t
+fft_real_bluestein_length (const size_t n)
+{
+  const size_t real_subtransforms[] =
+  {5, 4, 3, 2, 0};
+
+  return fft_bluestein_length (n, real_subtransforms);
+}
+
 
 static int
 fft_factorize (const size_t n,
@@ -174,3 +207,99 @@ fft_binary_logn (const size_t n)
 
 
 
+
+
+/* Decide whether a transform of length n should be computed with
+   Bluestein's algorithm, as a convolution of length nb >= 2n-1 using
+   the complex subtransforms, instead of the general length-n module.
+
+   The run-time of the mixed-radix transform is approximately
+   n*sum(f_i), where the f_i are the factors. The general module is
+   used for every factor f_i that is not in the list of implemented
+   subtransforms; its inner loops run over the n/f_i subtransforms, so
+   the loop overhead is significant when n/f_i is small and we use
+   f_i*(1 + f_i/n) for these factors. Bluestein's algorithm costs two
+   complex transforms of length nb.
+
+   Returns nb if Bluestein's algorithm is expected to be faster, and 0
+   otherwise. */
+
+static size_t
+fft_bluestein_length (const size_t n,
+                      const size_t implemented_subtransforms[])
+{
+  const size_t complex_subtransforms[] =
+  {7, 6, 5, 4, 3, 2, 0};
+  size_t factors[64];
+  size_t nf, nb, i, j;
+  double cost_direct = 0.0, cost_bluestein = 0.0;
+
+  if (n < FFT_BLUESTEIN_MIN_FACTOR)
+    {
+      return 0;
+    }
+
+  if (fft_factorize (n, implemented_subtransforms, &nf, factors))
+    {
+      return 0;
+    }
+
+  for (i = 0; i < nf; i++)
+    {
+      size_t implemented = 0;
+
+      for (j = 0; implemented_subtransforms[j]; j++)
+        {
+          if (factors[i] == implemented_subtransforms[j])
+            implemented = 1;
+        }
+
+      if (implemented)
+        {
+          cost_direct += (double) factors[i];
+        }
+      else
+        {
+          const double f = (double) factors[i];
+          cost_direct += f * (1.0 + f / (double) n);
+        }
+    }
+
+  cost_direct *= (double) n;
+
+  /* find the smallest 7-smooth length nb >= 2n - 1 */
+
+  for (nb = 2 * n - 1; ; nb++)
+    {
+      size_t ntest = nb;
+
+      for (j = 0; complex_subtransforms[j]; j++)
+        {
+          while (ntest % complex_subtransforms[j] == 0)
+            ntest /= complex_subtransforms[j];
+        }
+
+      if (ntest == 1)
+        break;
+    }
+
+  if (fft_factorize (nb, complex_subtransforms, &nf, factors))
+    {
+      return 0;
+    }
+
+  for (i = 0; i < nf; i++)
+    {
+      cost_bluestein += (double) factors[i];
+    }
+
+  /* two transforms of length nb, plus the pointwise products */
+  cost_bluestein = (double) nb * (2.0 * cost_bluestein + FFT_BLUESTEIN_COST);
+
+  if (cost_bluestein < cost_direct)
+    {
+      return nb;
+    }
+
+  return 0;
+}
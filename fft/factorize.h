@@ -27,3 +27,11 @@ static int fft_factorize (const size_t n, const size_t implemented_subtransforms
 
 static int fft_binary_logn (const size_t n) ;
 
+static size_t fft_complex_bluestein_length (const size_t n);
+
+static size_t fft_halfcomplex_bluestein_length (const size_t n);
+
+static size_t fft_real_bluestein_length (const size_t n);
+
+static size_t fft_bluestein_length (const size_t n, const size_t implemented_subtransforms[]);
+
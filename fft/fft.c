@@ -28,6 +28,7 @@
 #include "templates_on.h"
 #include "c_init.c"
 #include "c_main.c"
+#include "c_bluestein.c"
 #include "c_pass_2.c"
 #include "c_pass_3.c"
 #include "c_pass_4.c"
@@ -36,6 +37,7 @@
 #include "c_pass_7.c"
 #include "c_pass_n.c"
 #include "c_radix2.c"
+#include "c_sixstep.c"
 #include "templates_off.h"
 #undef  BASE_DOUBLE
 
@@ -43,6 +45,7 @@
 #include "templates_on.h"
 #include "c_init.c"
 #include "c_main.c"
+#include "c_bluestein.c"
 #include "c_pass_2.c"
 #include "c_pass_3.c"
 #include "c_pass_4.c"
@@ -51,6 +54,7 @@
 #include "c_pass_7.c"
 #include "c_pass_n.c"
 #include "c_radix2.c"
+#include "c_sixstep.c"
 #include "templates_off.h"
 #undef  BASE_FLOAT
 
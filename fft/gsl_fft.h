@@ -46,6 +46,10 @@ gsl_fft_direction;
        
    where - is the forward transform direction and + the inverse direction */
 
+/* number of stages of the six-step transform, see gsl_fft_complex_sixstep_stage */
+
+#define GSL_FFT_SIXSTEP_NSTAGES 6
+
 __END_DECLS
 
 #endif /* __GSL_FFT_H__ */
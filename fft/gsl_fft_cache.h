@@ -0,0 +1,77 @@
+/* fft/gsl_fft_cache.h
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_CACHE_H__
+#define __GSL_FFT_CACHE_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_complex_float.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_real_float.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_halfcomplex_float.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  int type;                   /* kind of object */
+  size_t n;                   /* transform length */
+  void *ptr;                  /* wavetable or workspace */
+} gsl_fft_cache_entry;
+
+typedef struct
+{
+  size_t size;                /* number of entries */
+  size_t nalloc;              /* allocated number of entries */
+  gsl_fft_cache_entry *entry; /* entries sorted by (type, n) */
+} gsl_fft_cache;
+
+gsl_fft_cache *gsl_fft_cache_alloc (void);
+void gsl_fft_cache_free (gsl_fft_cache * c);
+void gsl_fft_cache_reset (gsl_fft_cache * c);
+size_t gsl_fft_cache_size (const gsl_fft_cache * c);
+
+const gsl_fft_complex_wavetable *gsl_fft_cache_complex_wavetable (const size_t n, gsl_fft_cache * c);
+const gsl_fft_complex_wavetable_float *gsl_fft_cache_complex_wavetable_float (const size_t n, gsl_fft_cache * c);
+const gsl_fft_real_wavetable *gsl_fft_cache_real_wavetable (const size_t n, gsl_fft_cache * c);
+const gsl_fft_real_wavetable_float *gsl_fft_cache_real_wavetable_float (const size_t n, gsl_fft_cache * c);
+const gsl_fft_halfcomplex_wavetable *gsl_fft_cache_halfcomplex_wavetable (const size_t n, gsl_fft_cache * c);
+const gsl_fft_halfcomplex_wavetable_float *gsl_fft_cache_halfcomplex_wavetable_float (const size_t n, gsl_fft_cache * c);
+
+gsl_fft_complex_workspace *gsl_fft_cache_complex_workspace (const size_t n, gsl_fft_cache * c);
+gsl_fft_complex_workspace_float *gsl_fft_cache_complex_workspace_float (const size_t n, gsl_fft_cache * c);
+gsl_fft_real_workspace *gsl_fft_cache_real_workspace (const size_t n, gsl_fft_cache * c);
+gsl_fft_real_workspace_float *gsl_fft_cache_real_workspace_float (const size_t n, gsl_fft_cache * c);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_CACHE_H__ */
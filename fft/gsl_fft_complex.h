@@ -84,6 +84,8 @@ typedef struct
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    size_t nb;
+    gsl_complex *chirp;
   }
 gsl_fft_complex_wavetable;
 
@@ -131,6 +133,72 @@ int gsl_fft_complex_transform (gsl_complex_packed_array data,
                                gsl_fft_complex_workspace * work,
                                const gsl_fft_direction sign);
 
+int gsl_fft_complex_batch_forward (gsl_complex_packed_array data,
+                                   const size_t stride,
+                                   const size_t distance,
+                                   const size_t n,
+                                   const size_t howmany,
+                                   const gsl_fft_complex_wavetable * wavetable,
+                                   gsl_fft_complex_workspace * work);
+
+int gsl_fft_complex_batch_backward (gsl_complex_packed_array data,
+                                    const size_t stride,
+                                    const size_t distance,
+                                    const size_t n,
+                                    const size_t howmany,
+                                    const gsl_fft_complex_wavetable * wavetable,
+                                    gsl_fft_complex_workspace * work);
+
+int gsl_fft_complex_batch_inverse (gsl_complex_packed_array data,
+                                   const size_t stride,
+                                   const size_t distance,
+                                   const size_t n,
+                                   const size_t howmany,
+                                   const gsl_fft_complex_wavetable * wavetable,
+                                   gsl_fft_complex_workspace * work);
+
+int gsl_fft_complex_batch_transform (gsl_complex_packed_array data,
+                                     const size_t stride, const size_t distance,
+                                     const size_t n, const size_t howmany,
+                                     const gsl_fft_complex_wavetable * wavetable,
+                                     gsl_fft_complex_workspace * work,
+                                     const gsl_fft_direction sign);
+
+/*  Six-step routines for long transforms  */
+
+typedef struct
+{
+  size_t n;
+  size_t n1;
+  size_t n2;
+  gsl_fft_complex_wavetable * wavetable1;
+  gsl_fft_complex_wavetable * wavetable2;
+  size_t nw;
+  gsl_complex *twiddle;
+}
+gsl_fft_complex_sixstep_wavetable;
+
+gsl_fft_complex_sixstep_wavetable *gsl_fft_complex_sixstep_wavetable_alloc (size_t n);
+
+void gsl_fft_complex_sixstep_wavetable_free (gsl_fft_complex_sixstep_wavetable * wavetable);
+
+size_t gsl_fft_complex_sixstep_nrows (const size_t stage,
+                                    const gsl_fft_complex_sixstep_wavetable * wavetable);
+
+int gsl_fft_complex_sixstep_transform (gsl_complex_packed_array data,
+                                       const size_t stride, const size_t n,
+                                       const gsl_fft_complex_sixstep_wavetable * wavetable,
+                                       gsl_fft_complex_workspace * work,
+                                       const gsl_fft_direction sign);
+
+int gsl_fft_complex_sixstep_stage (gsl_complex_packed_array data,
+                                   const size_t stride, const size_t n,
+                                   const size_t stage,
+                                   const size_t first, const size_t last,
+                                   const gsl_fft_complex_sixstep_wavetable * wavetable,
+                                   gsl_fft_complex_workspace * work,
+                                   const gsl_fft_direction sign);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_COMPLEX_H__ */
@@ -84,6 +84,8 @@ typedef struct
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    size_t nb;
+    gsl_complex_float *chirp;
   }
 gsl_fft_complex_wavetable_float;
 
@@ -132,6 +134,72 @@ int gsl_fft_complex_float_transform (gsl_complex_packed_array_float data,
                                      gsl_fft_complex_workspace_float * work,
                                      const gsl_fft_direction sign);
 
+int gsl_fft_complex_float_batch_forward (gsl_complex_packed_array_float data,
+                                         const size_t stride,
+                                         const size_t distance,
+                                         const size_t n,
+                                         const size_t howmany,
+                                         const gsl_fft_complex_wavetable_float * wavetable,
+                                         gsl_fft_complex_workspace_float * work);
+
+int gsl_fft_complex_float_batch_backward (gsl_complex_packed_array_float data,
+                                          const size_t stride,
+                                          const size_t distance,
+                                          const size_t n,
+                                          const size_t howmany,
+                                          const gsl_fft_complex_wavetable_float * wavetable,
+                                          gsl_fft_complex_workspace_float * work);
+
+int gsl_fft_complex_float_batch_inverse (gsl_complex_packed_array_float data,
+                                         const size_t stride,
+                                         const size_t distance,
+                                         const size_t n,
+                                         const size_t howmany,
+                                         const gsl_fft_complex_wavetable_float * wavetable,
+                                         gsl_fft_complex_workspace_float * work);
+
+int gsl_fft_complex_float_batch_transform (gsl_complex_packed_array_float data,
+                                           const size_t stride, const size_t distance,
+                                           const size_t n, const size_t howmany,
+                                           const gsl_fft_complex_wavetable_float * wavetable,
+                                           gsl_fft_complex_workspace_float * work,
+                                           const gsl_fft_direction sign);
+
+/*  Six-step routines for long transforms  */
+
+typedef struct
+{
+  size_t n;
+  size_t n1;
+  size_t n2;
+  gsl_fft_complex_wavetable_float * wavetable1;
+  gsl_fft_complex_wavetable_float * wavetable2;
+  size_t nw;
+  gsl_complex_float *twiddle;
+}
+gsl_fft_complex_sixstep_wavetable_float;
+
+gsl_fft_complex_sixstep_wavetable_float *gsl_fft_complex_sixstep_wavetable_float_alloc (size_t n);
+
+void gsl_fft_complex_sixstep_wavetable_float_free (gsl_fft_complex_sixstep_wavetable_float * wavetable);
+
+size_t gsl_fft_complex_float_sixstep_nrows (const size_t stage,
+                                    const gsl_fft_complex_sixstep_wavetable_float * wavetable);
+
+int gsl_fft_complex_float_sixstep_transform (gsl_complex_packed_array_float data,
+                                       const size_t stride, const size_t n,
+                                       const gsl_fft_complex_sixstep_wavetable_float * wavetable,
+                                       gsl_fft_complex_workspace_float * work,
+                                       const gsl_fft_direction sign);
+
+int gsl_fft_complex_float_sixstep_stage (gsl_complex_packed_array_float data,
+                                   const size_t stride, const size_t n,
+                                   const size_t stage,
+                                   const size_t first, const size_t last,
+                                   const gsl_fft_complex_sixstep_wavetable_float * wavetable,
+                                   gsl_fft_complex_workspace_float * work,
+                                   const gsl_fft_direction sign);
+
 __END_DECLS
 
 #endif /* __GSL_FFT_COMPLEX_FLOAT_H__ */
@@ -0,0 +1,124 @@
+/* fft/gsl_fft_convolve.h
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_CONVOLVE_H__
+#define __GSL_FFT_CONVOLVE_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/* portion of the full convolution which is returned */
+typedef enum
+{
+  GSL_FFT_CONVOLVE_FULL,  /* all n + k - 1 outputs */
+  GSL_FFT_CONVOLVE_SAME,  /* central n outputs */
+  GSL_FFT_CONVOLVE_VALID  /* n - k + 1 outputs not depending on zero padding */
+} gsl_fft_convolve_mode_t;
+
+/* method used to compute the convolution */
+typedef enum
+{
+  GSL_FFT_CONVOLVE_AUTO,   /* choose the faster of the two methods below */
+  GSL_FFT_CONVOLVE_DIRECT, /* direct summation, O(n k) */
+  GSL_FFT_CONVOLVE_FFT     /* zero-padded FFTs, O((n + k) log(n + k)) */
+} gsl_fft_convolve_method_t;
+
+typedef struct
+{
+  size_t nmax;                                /* maximum signal length */
+  size_t kmax;                                /* maximum kernel length */
+  size_t nfft;                                /* FFT length, >= nmax + kmax - 1 */
+  gsl_fft_convolve_method_t method;           /* method used for the convolution */
+  gsl_fft_real_wavetable *real_wavetable;     /* wavetables and workspaces of length nfft */
+  gsl_fft_halfcomplex_wavetable *hc_wavetable;
+  gsl_fft_real_workspace *real_work;
+  gsl_fft_complex_wavetable *complex_wavetable;
+  gsl_fft_complex_workspace *complex_work;
+  double *buf1;                               /* buffers, size 2*nfft */
+  double *buf2;
+} gsl_fft_convolve_workspace;
+
+gsl_fft_convolve_workspace *gsl_fft_convolve_alloc (const size_t n, const size_t k);
+void gsl_fft_convolve_free (gsl_fft_convolve_workspace * w);
+int gsl_fft_convolve_set_method (const gsl_fft_convolve_method_t method,
+                                 gsl_fft_convolve_workspace * w);
+size_t gsl_fft_convolve_size (const gsl_fft_convolve_mode_t mode, const size_t n,
+                              const size_t k);
+
+int gsl_fft_convolve (const gsl_fft_convolve_mode_t mode, const gsl_vector * x,
+                      const gsl_vector * h, gsl_vector * y, gsl_fft_convolve_workspace * w);
+int gsl_fft_correlate (const gsl_fft_convolve_mode_t mode, const gsl_vector * x,
+                       const gsl_vector * h, gsl_vector * y, gsl_fft_convolve_workspace * w);
+int gsl_fft_convolve_complex (const gsl_fft_convolve_mode_t mode, const gsl_vector_complex * x,
+                              const gsl_vector_complex * h, gsl_vector_complex * y,
+                              gsl_fft_convolve_workspace * w);
+int gsl_fft_correlate_complex (const gsl_fft_convolve_mode_t mode, const gsl_vector_complex * x,
+                               const gsl_vector_complex * h, gsl_vector_complex * y,
+                               gsl_fft_convolve_workspace * w);
+
+/* streaming convolution of a long signal processed in blocks */
+typedef enum
+{
+  GSL_FFT_CONVOLVE_OVERLAP_ADD,
+  GSL_FFT_CONVOLVE_OVERLAP_SAVE
+} gsl_fft_convolve_stream_t;
+
+typedef struct
+{
+  gsl_fft_convolve_stream_t type;             /* overlap-add or overlap-save */
+  size_t k;                                   /* kernel length */
+  size_t block;                               /* maximum number of input samples per FFT */
+  size_t nfft;                                /* FFT length, >= block + k - 1 */
+  gsl_fft_real_wavetable *real_wavetable;
+  gsl_fft_halfcomplex_wavetable *hc_wavetable;
+  gsl_fft_real_workspace *real_work;
+  double *H;                                  /* halfcomplex transform of kernel, size nfft */
+  double *buf;                                /* FFT buffer, size nfft */
+  double *state;                              /* output tail (overlap-add) or input history (overlap-save), size nfft */
+} gsl_fft_convolve_stream_workspace;
+
+gsl_fft_convolve_stream_workspace *gsl_fft_convolve_stream_alloc (const gsl_fft_convolve_stream_t type,
+                                                                  const size_t k, const size_t block);
+void gsl_fft_convolve_stream_free (gsl_fft_convolve_stream_workspace * w);
+int gsl_fft_convolve_stream_init (const gsl_vector * h, gsl_fft_convolve_stream_workspace * w);
+int gsl_fft_convolve_stream_reset (gsl_fft_convolve_stream_workspace * w);
+int gsl_fft_convolve_stream_apply (const gsl_vector * x, gsl_vector * y,
+                                   gsl_fft_convolve_stream_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_CONVOLVE_H__ */
@@ -50,6 +50,8 @@ typedef struct
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    size_t nb;
+    gsl_complex_float *chirp;
   }
 gsl_fft_halfcomplex_wavetable_float;
 
@@ -71,6 +73,24 @@ int gsl_fft_halfcomplex_float_transform (float data[], const size_t stride, cons
                                          const gsl_fft_halfcomplex_wavetable_float * wavetable,
                                          gsl_fft_real_workspace_float * work);
 
+int gsl_fft_halfcomplex_float_batch_backward (float data[], const size_t stride,
+                                              const size_t distance, const size_t n,
+                                              const size_t howmany,
+                                              const gsl_fft_halfcomplex_wavetable_float * wavetable,
+                                              gsl_fft_real_workspace_float * work);
+
+int gsl_fft_halfcomplex_float_batch_inverse (float data[], const size_t stride,
+                                             const size_t distance, const size_t n,
+                                             const size_t howmany,
+                                             const gsl_fft_halfcomplex_wavetable_float * wavetable,
+                                             gsl_fft_real_workspace_float * work);
+
+int gsl_fft_halfcomplex_float_batch_transform (float data[], const size_t stride,
+                                               const size_t distance, const size_t n,
+                                               const size_t howmany,
+                                               const gsl_fft_halfcomplex_wavetable_float * wavetable,
+                                               gsl_fft_real_workspace_float * work);
+
 int
 gsl_fft_halfcomplex_float_unpack (const float halfcomplex_coefficient[],
                                   float complex_coefficient[],
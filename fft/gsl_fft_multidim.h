@@ -0,0 +1,133 @@
+/* fft/gsl_fft_multidim.h
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_FFT_MULTIDIM_H__
+#define __GSL_FFT_MULTIDIM_H__
+
+#include <stddef.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_complex.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_fft.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS /* empty */
+# define __END_DECLS /* empty */
+#endif
+
+__BEGIN_DECLS
+
+/* complex transforms */
+
+typedef struct
+{
+  size_t n1;                                  /* number of rows */
+  size_t n2;                                  /* number of columns */
+  gsl_fft_complex_wavetable *wavetable[2];    /* wavetables for each dimension */
+  gsl_fft_complex_workspace *work[2];         /* workspaces for each dimension */
+  double *block;                              /* column block buffer */
+} gsl_fft_complex_2d_workspace;
+
+typedef struct
+{
+  size_t n1;
+  size_t n2;
+  size_t n3;
+  gsl_fft_complex_wavetable *wavetable[3];
+  gsl_fft_complex_workspace *work[3];
+  double *block;
+} gsl_fft_complex_3d_workspace;
+
+gsl_fft_complex_2d_workspace *gsl_fft_complex_2d_alloc (const size_t n1, const size_t n2);
+void gsl_fft_complex_2d_free (gsl_fft_complex_2d_workspace * w);
+int gsl_fft_complex_2d_forward (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w);
+int gsl_fft_complex_2d_backward (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w);
+int gsl_fft_complex_2d_inverse (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w);
+int gsl_fft_complex_2d_transform (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w,
+                                  const gsl_fft_direction sign);
+
+gsl_fft_complex_3d_workspace *gsl_fft_complex_3d_alloc (const size_t n1, const size_t n2, const size_t n3);
+void gsl_fft_complex_3d_free (gsl_fft_complex_3d_workspace * w);
+int gsl_fft_complex_3d_forward (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w);
+int gsl_fft_complex_3d_backward (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w);
+int gsl_fft_complex_3d_inverse (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w);
+int gsl_fft_complex_3d_transform (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w,
+                                  const gsl_fft_direction sign);
+
+/* real and halfcomplex transforms */
+
+typedef struct
+{
+  size_t n1;                                  /* number of rows */
+  size_t n2;                                  /* number of columns of real data */
+  gsl_fft_complex_wavetable *wavetable;       /* wavetable for first dimension */
+  gsl_fft_complex_workspace *work;            /* workspace for first dimension */
+  gsl_fft_real_wavetable *real_wavetable;     /* wavetable for real rows */
+  gsl_fft_halfcomplex_wavetable *hc_wavetable;/* wavetable for halfcomplex rows */
+  gsl_fft_real_workspace *real_work;          /* workspace for rows */
+  double *row;                                /* row buffer, size n2 */
+  double *block;                              /* column block buffer */
+  double *data;                               /* copy of complex input for backward transforms */
+} gsl_fft_real_2d_workspace;
+
+typedef struct
+{
+  size_t n1;
+  size_t n2;
+  size_t n3;
+  gsl_fft_complex_wavetable *wavetable[2];
+  gsl_fft_complex_workspace *work[2];
+  gsl_fft_real_wavetable *real_wavetable;
+  gsl_fft_halfcomplex_wavetable *hc_wavetable;
+  gsl_fft_real_workspace *real_work;
+  double *row;
+  double *block;
+  double *data;
+} gsl_fft_real_3d_workspace;
+
+gsl_fft_real_2d_workspace *gsl_fft_real_2d_alloc (const size_t n1, const size_t n2);
+void gsl_fft_real_2d_free (gsl_fft_real_2d_workspace * w);
+int gsl_fft_real_2d_transform (const gsl_matrix * A, gsl_matrix_complex * B,
+                               gsl_fft_real_2d_workspace * w);
+int gsl_fft_halfcomplex_2d_transform (const gsl_matrix_complex * B, gsl_matrix * A,
+                                      gsl_fft_real_2d_workspace * w);
+int gsl_fft_halfcomplex_2d_inverse (const gsl_matrix_complex * B, gsl_matrix * A,
+                                    gsl_fft_real_2d_workspace * w);
+
+gsl_fft_real_3d_workspace *gsl_fft_real_3d_alloc (const size_t n1, const size_t n2, const size_t n3);
+void gsl_fft_real_3d_free (gsl_fft_real_3d_workspace * w);
+int gsl_fft_real_3d_transform (const double data[], gsl_complex_packed_array out,
+                               gsl_fft_real_3d_workspace * w);
+int gsl_fft_halfcomplex_3d_transform (gsl_const_complex_packed_array in, double data[],
+                                      gsl_fft_real_3d_workspace * w);
+int gsl_fft_halfcomplex_3d_inverse (gsl_const_complex_packed_array in, double data[],
+                                    gsl_fft_real_3d_workspace * w);
+
+__END_DECLS
+
+#endif /* __GSL_FFT_MULTIDIM_H__ */
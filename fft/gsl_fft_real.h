@@ -47,6 +47,8 @@ typedef struct
     size_t factor[64];
     gsl_complex *twiddle[64];
     gsl_complex *trig;
+    size_t nb;
+    gsl_complex *chirp;
   }
 gsl_fft_real_wavetable;
 
@@ -71,6 +73,13 @@ int gsl_fft_real_transform (double data[], const size_t stride, const size_t n,
                             gsl_fft_real_workspace * work);
 
 
+int gsl_fft_real_batch_transform (double data[], const size_t stride,
+                                  const size_t distance, const size_t n,
+                                  const size_t howmany,
+                                  const gsl_fft_real_wavetable * wavetable,
+                                  gsl_fft_real_workspace * work);
+
+
 int gsl_fft_real_unpack (const double real_coefficient[],
                          double complex_coefficient[],
                          const size_t stride, const size_t n);
@@ -47,6 +47,8 @@ typedef struct
     size_t factor[64];
     gsl_complex_float *twiddle[64];
     gsl_complex_float *trig;
+    size_t nb;
+    gsl_complex_float *chirp;
   }
 gsl_fft_real_wavetable_float;
 
@@ -70,6 +72,13 @@ int gsl_fft_real_float_transform (float data[], const size_t stride, const size_
                                   gsl_fft_real_workspace_float * work);
 
 
+int gsl_fft_real_float_batch_transform (float data[], const size_t stride,
+                                        const size_t distance, const size_t n,
+                                        const size_t howmany,
+                                        const gsl_fft_real_wavetable_float * wavetable,
+                                        gsl_fft_real_workspace_float * work);
+
+
 int gsl_fft_real_float_unpack (const float real_float_coefficient[],
                                float complex_coefficient[],
                                const size_t stride, const size_t n);
@@ -41,6 +41,33 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (size_t n)
       GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
     }
 
+  wavetable->nb = fft_halfcomplex_bluestein_length (n);
+  wavetable->chirp = NULL;
+
+  if (wavetable->nb)
+    {
+      /* large prime factors, use Bluestein's algorithm with complex
+         transforms of length nb */
+
+      wavetable->n = n;
+
+      status = FUNCTION(fft_complex,bluestein_alloc) (n, wavetable->nb,
+                                                      &(wavetable->nf),
+                                                      wavetable->factor,
+                                                      wavetable->twiddle,
+                                                      &(wavetable->trig),
+                                                      &(wavetable->chirp));
+
+      if (status)
+        {
+          free (wavetable);
+
+          GSL_ERROR_VAL ("failed to initialize Bluestein tables", status, 0);
+        }
+
+      return wavetable;
+    }
+
   wavetable->trig = (TYPE(gsl_complex) *) malloc (n * sizeof (TYPE(gsl_complex)));
 
   if (wavetable->trig == NULL)
@@ -123,6 +150,9 @@ FUNCTION(gsl_fft_halfcomplex_wavetable,free) (TYPE(gsl_fft_halfcomplex_wavetable
   free (wavetable->trig);
   wavetable->trig = NULL;
 
+  free (wavetable->chirp);
+  wavetable->chirp = NULL;
+
   free (wavetable);
 }
 
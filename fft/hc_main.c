@@ -63,26 +63,55 @@ FUNCTION(gsl_fft_halfcomplex,inverse) (BASE data[], const size_t stride,
   return status;
 }
 
-int
-FUNCTION(gsl_fft_halfcomplex,transform) (BASE data[], const size_t stride, const size_t n,
-                                         const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
-                                         TYPE(gsl_fft_real_workspace) * work)
+/* unpack the halfcomplex data into a complex array and compute the
+   transform with Bluestein's algorithm */
+
+static int
+FUNCTION(fft_halfcomplex,bluestein) (BASE data[], const size_t stride, const size_t n,
+                                     const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                     BASE work[])
 {
-  BASE * const scratch = work->scratch;
+  BASE * const z = work;
+  size_t k;
 
-  BASE * in;
-  BASE * out;
-  size_t istride, ostride ;
+  z[0] = data[0];
+  z[1] = 0;
 
+  for (k = 1; k < n - k; k++)
+    {
+      const BASE z_real = data[stride * (2 * k - 1)];
+      const BASE z_imag = data[stride * (2 * k)];
 
-  size_t factor, product, q;
-  size_t i;
-  size_t nf;
-  int state;
-  int product_1;
-  int tskip;
-  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4;
+      z[2 * k] = z_real;
+      z[2 * k + 1] = z_imag;
+      z[2 * (n - k)] = z_real;
+      z[2 * (n - k) + 1] = -z_imag;
+    }
+
+  if (k == n - k)
+    {
+      z[2 * k] = data[stride * (n - 1)];
+      z[2 * k + 1] = 0;
+    }
+
+  FUNCTION(fft_complex,bluestein) (z, 1, n, wavetable->nb, wavetable->nf,
+                                   wavetable->factor, wavetable->twiddle,
+                                   wavetable->chirp, work + 2 * n,
+                                   gsl_fft_backward);
+
+  for (k = 0; k < n; k++)
+    {
+      data[stride * k] = z[2 * k];
+    }
 
+  return 0;
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,transform) (BASE data[], const size_t stride, const size_t n,
+                                         const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                         TYPE(gsl_fft_real_workspace) * work)
+{
   if (n == 0)
     {
       GSL_ERROR ("length n must be positive integer", GSL_EDOM);
@@ -103,6 +132,35 @@ FUNCTION(gsl_fft_halfcomplex,transform) (BASE data[], const size_t stride, const
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->nb)
+    {
+      return FUNCTION(fft_halfcomplex,bluestein) (data, stride, n, wavetable,
+                                                  work->scratch);
+    }
+
+  return FUNCTION(fft_halfcomplex,mixed_radix) (data, stride, n, wavetable,
+                                                work->scratch);
+}
+
+static int
+FUNCTION(fft_halfcomplex,mixed_radix) (BASE data[], const size_t stride,
+                                       const size_t n,
+                                       const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                       BASE scratch[])
+{
+  BASE * in;
+  BASE * out;
+  size_t istride, ostride ;
+
+
+  size_t factor, product, q;
+  size_t i;
+  size_t nf;
+  int state;
+  int product_1;
+  int tskip;
+  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4;
+
   nf = wavetable->nf;
   product = 1;
   state = 0;
@@ -186,3 +244,106 @@ FUNCTION(gsl_fft_halfcomplex,transform) (BASE data[], const size_t stride, const
 }
 
 
+
+/* Batched transforms of howmany signals of length n, where element k
+   of signal j is stored at data[j*distance + k*stride]. The arguments
+   are checked once and the kernels are called directly for each
+   signal. */
+
+int
+FUNCTION(gsl_fft_halfcomplex,batch_backward) (BASE data[], const size_t stride,
+                                              const size_t distance, const size_t n,
+                                              const size_t howmany,
+                                              const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                              TYPE(gsl_fft_real_workspace) * work)
+{
+  return FUNCTION(gsl_fft_halfcomplex,batch_transform) (data, stride, distance, n, howmany,
+                                                        wavetable, work);
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,batch_inverse) (BASE data[], const size_t stride,
+                                             const size_t distance, const size_t n,
+                                             const size_t howmany,
+                                             const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                             TYPE(gsl_fft_real_workspace) * work)
+{
+  int status = FUNCTION(gsl_fft_halfcomplex,batch_transform) (data, stride, distance, n,
+                                                              howmany, wavetable, work);
+
+  if (status)
+    {
+      return status;
+    }
+
+  /* normalize inverse fft with 1/n */
+
+  {
+    const double norm = 1.0 / n;
+    size_t i, j;
+    for (j = 0; j < howmany; j++)
+      {
+        BASE * const x = data + distance * j;
+
+        for (i = 0; i < n; i++)
+          {
+            x[stride*i] *= norm;
+          }
+      }
+  }
+
+  return status;
+}
+
+int
+FUNCTION(gsl_fft_halfcomplex,batch_transform) (BASE data[], const size_t stride,
+                                               const size_t distance, const size_t n,
+                                               const size_t howmany,
+                                               const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                               TYPE(gsl_fft_real_workspace) * work)
+{
+  size_t j;
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (stride == 0)
+    {
+      GSL_ERROR ("stride must be positive integer", GSL_EINVAL);
+    }
+
+  if (n != wavetable->n)
+    {
+      GSL_ERROR ("wavetable does not match length of data", GSL_EINVAL);
+    }
+
+  if (n != work->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (n == 1)
+    {                           /* FFT of one data point is the identity */
+      return 0;
+    }
+
+  for (j = 0; j < howmany; j++)
+    {
+      BASE * const x = data + distance * j;
+
+      if (wavetable->nb)
+        {
+          FUNCTION(fft_halfcomplex,bluestein) (x, stride, n, wavetable,
+                                               work->scratch);
+        }
+      else
+        {
+          FUNCTION(fft_halfcomplex,mixed_radix) (x, stride, n, wavetable,
+                                                 work->scratch);
+        }
+    }
+
+  return 0;
+}
@@ -17,6 +17,12 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+static int
+FUNCTION(fft_halfcomplex,mixed_radix) (BASE data[], const size_t stride,
+                                       const size_t n,
+                                       const TYPE(gsl_fft_halfcomplex_wavetable) * wavetable,
+                                       BASE scratch[]);
+
 #include "complex_internal.h"
 
 static void
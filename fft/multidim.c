@@ -0,0 +1,920 @@
+/* fft/multidim.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_real.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_multidim.h>
+
+/* number of columns gathered into contiguous storage for each column pass */
+#define MULTIDIM_BLOCK        16
+
+static int multidim_rows (double * data, const size_t nrows, const size_t n, const size_t tda,
+                          const gsl_fft_complex_wavetable * wavetable,
+                          gsl_fft_complex_workspace * work, const gsl_fft_direction sign);
+static int multidim_columns (double * data, const size_t n, const size_t ncols, const size_t tda,
+                             const gsl_fft_complex_wavetable * wavetable,
+                             gsl_fft_complex_workspace * work, double * block,
+                             const gsl_fft_direction sign);
+static void multidim_unpack (const double * r, double * c, const size_t n);
+static void multidim_pack (const double * c, double * r, const size_t n);
+static double * multidim_block_alloc (const size_t n);
+
+/*
+gsl_fft_complex_2d_alloc()
+  Allocate a workspace for 2-D complex FFTs
+
+Inputs: n1 - number of rows
+        n2 - number of columns
+
+Return: pointer to workspace
+*/
+
+gsl_fft_complex_2d_workspace *
+gsl_fft_complex_2d_alloc (const size_t n1, const size_t n2)
+{
+  gsl_fft_complex_2d_workspace * w;
+  const size_t n[2] = { n1, n2 };
+  size_t i;
+
+  if (n1 == 0 || n2 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_complex_2d_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+
+  for (i = 0; i < 2; ++i)
+    {
+      w->wavetable[i] = gsl_fft_complex_wavetable_alloc (n[i]);
+      w->work[i] = gsl_fft_complex_workspace_alloc (n[i]);
+
+      if (w->wavetable[i] == NULL || w->work[i] == NULL)
+        {
+          gsl_fft_complex_2d_free (w);
+          GSL_ERROR_NULL ("failed to allocate wavetable", GSL_ENOMEM);
+        }
+    }
+
+  w->block = multidim_block_alloc (n1);
+  if (w->block == NULL)
+    {
+      gsl_fft_complex_2d_free (w);
+      GSL_ERROR_NULL ("failed to allocate block buffer", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_complex_2d_free (gsl_fft_complex_2d_workspace * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 2; ++i)
+    {
+      if (w->wavetable[i])
+        gsl_fft_complex_wavetable_free (w->wavetable[i]);
+
+      if (w->work[i])
+        gsl_fft_complex_workspace_free (w->work[i]);
+    }
+
+  if (w->block)
+    free (w->block);
+
+  free (w);
+}
+
+int
+gsl_fft_complex_2d_forward (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w)
+{
+  return gsl_fft_complex_2d_transform (A, w, gsl_fft_forward);
+}
+
+int
+gsl_fft_complex_2d_backward (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w)
+{
+  return gsl_fft_complex_2d_transform (A, w, gsl_fft_backward);
+}
+
+int
+gsl_fft_complex_2d_inverse (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w)
+{
+  int status = gsl_fft_complex_2d_transform (A, w, gsl_fft_backward);
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(n1*n2) */
+  {
+    const double norm = 1.0 / ((double) w->n1 * (double) w->n2);
+    size_t i, j;
+
+    for (i = 0; i < w->n1; ++i)
+      {
+        double * Ai = A->data + 2 * i * A->tda;
+
+        for (j = 0; j < 2 * w->n2; ++j)
+          Ai[j] *= norm;
+      }
+  }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_complex_2d_transform()
+  Compute the 2-D FFT of a complex matrix in-place
+
+Inputs: A    - (input/output) n1-by-n2 complex matrix
+        w    - workspace
+        sign - transform direction
+
+Notes:
+1) The rows are transformed in-place. The columns are transformed
+MULTIDIM_BLOCK at a time, after copying them to contiguous storage,
+so that each row of A is read in contiguous segments.
+*/
+
+int
+gsl_fft_complex_2d_transform (gsl_matrix_complex * A, gsl_fft_complex_2d_workspace * w,
+                              const gsl_fft_direction sign)
+{
+  if (A->size1 != w->n1 || A->size2 != w->n2)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      status = multidim_rows (A->data, w->n1, w->n2, A->tda, w->wavetable[1], w->work[1], sign);
+      if (status)
+        return status;
+
+      status = multidim_columns (A->data, w->n1, w->n2, A->tda, w->wavetable[0], w->work[0],
+                                 w->block, sign);
+
+      return status;
+    }
+}
+
+/*
+gsl_fft_complex_3d_alloc()
+  Allocate a workspace for 3-D complex FFTs
+
+Inputs: n1 - first (slowest varying) dimension
+        n2 - second dimension
+        n3 - third (fastest varying) dimension
+
+Return: pointer to workspace
+*/
+
+gsl_fft_complex_3d_workspace *
+gsl_fft_complex_3d_alloc (const size_t n1, const size_t n2, const size_t n3)
+{
+  gsl_fft_complex_3d_workspace * w;
+  const size_t n[3] = { n1, n2, n3 };
+  size_t i;
+
+  if (n1 == 0 || n2 == 0 || n3 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_complex_3d_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+  w->n3 = n3;
+
+  for (i = 0; i < 3; ++i)
+    {
+      w->wavetable[i] = gsl_fft_complex_wavetable_alloc (n[i]);
+      w->work[i] = gsl_fft_complex_workspace_alloc (n[i]);
+
+      if (w->wavetable[i] == NULL || w->work[i] == NULL)
+        {
+          gsl_fft_complex_3d_free (w);
+          GSL_ERROR_NULL ("failed to allocate wavetable", GSL_ENOMEM);
+        }
+    }
+
+  w->block = multidim_block_alloc (GSL_MAX (n1, n2));
+  if (w->block == NULL)
+    {
+      gsl_fft_complex_3d_free (w);
+      GSL_ERROR_NULL ("failed to allocate block buffer", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_complex_3d_free (gsl_fft_complex_3d_workspace * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 3; ++i)
+    {
+      if (w->wavetable[i])
+        gsl_fft_complex_wavetable_free (w->wavetable[i]);
+
+      if (w->work[i])
+        gsl_fft_complex_workspace_free (w->work[i]);
+    }
+
+  if (w->block)
+    free (w->block);
+
+  free (w);
+}
+
+int
+gsl_fft_complex_3d_forward (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w)
+{
+  return gsl_fft_complex_3d_transform (data, w, gsl_fft_forward);
+}
+
+int
+gsl_fft_complex_3d_backward (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w)
+{
+  return gsl_fft_complex_3d_transform (data, w, gsl_fft_backward);
+}
+
+int
+gsl_fft_complex_3d_inverse (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w)
+{
+  int status = gsl_fft_complex_3d_transform (data, w, gsl_fft_backward);
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(n1*n2*n3) */
+  {
+    const size_t N = w->n1 * w->n2 * w->n3;
+    const double norm = 1.0 / (double) N;
+    size_t i;
+
+    for (i = 0; i < 2 * N; ++i)
+      data[i] *= norm;
+  }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_complex_3d_transform()
+  Compute the 3-D FFT of a complex volume in-place
+
+Inputs: data - (input/output) packed complex array of n1*n2*n3 elements,
+               element (i,j,k) is stored at index (i*n2 + j)*n3 + k
+        w    - workspace
+        sign - transform direction
+*/
+
+int
+gsl_fft_complex_3d_transform (gsl_complex_packed_array data, gsl_fft_complex_3d_workspace * w,
+                              const gsl_fft_direction sign)
+{
+  const size_t n1 = w->n1;
+  const size_t n2 = w->n2;
+  const size_t n3 = w->n3;
+  int status;
+  size_t i;
+
+  /* transform along third dimension (contiguous rows) */
+  status = multidim_rows (data, n1 * n2, n3, n3, w->wavetable[2], w->work[2], sign);
+  if (status)
+    return status;
+
+  /* transform along second dimension, one n2-by-n3 plane at a time */
+  for (i = 0; i < n1; ++i)
+    {
+      status = multidim_columns (data + 2 * i * n2 * n3, n2, n3, n3,
+                                 w->wavetable[1], w->work[1], w->block, sign);
+      if (status)
+        return status;
+    }
+
+  /* transform along first dimension, as the columns of an n1-by-(n2*n3) matrix */
+  status = multidim_columns (data, n1, n2 * n3, n2 * n3, w->wavetable[0], w->work[0],
+                             w->block, sign);
+
+  return status;
+}
+
+/*
+gsl_fft_real_2d_alloc()
+  Allocate a workspace for 2-D real and halfcomplex FFTs
+
+Inputs: n1 - number of rows
+        n2 - number of columns of the real data
+
+Return: pointer to workspace
+*/
+
+gsl_fft_real_2d_workspace *
+gsl_fft_real_2d_alloc (const size_t n1, const size_t n2)
+{
+  gsl_fft_real_2d_workspace * w;
+  const size_t h = n2 / 2 + 1;
+
+  if (n1 == 0 || n2 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_real_2d_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+
+  w->wavetable = gsl_fft_complex_wavetable_alloc (n1);
+  w->work = gsl_fft_complex_workspace_alloc (n1);
+  w->real_wavetable = gsl_fft_real_wavetable_alloc (n2);
+  w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (n2);
+  w->real_work = gsl_fft_real_workspace_alloc (n2);
+
+  if (w->wavetable == NULL || w->work == NULL || w->real_wavetable == NULL ||
+      w->hc_wavetable == NULL || w->real_work == NULL)
+    {
+      gsl_fft_real_2d_free (w);
+      GSL_ERROR_NULL ("failed to allocate wavetables", GSL_ENOMEM);
+    }
+
+  w->row = malloc (n2 * sizeof (double));
+  w->block = multidim_block_alloc (n1);
+  w->data = malloc (2 * n1 * h * sizeof (double));
+
+  if (w->row == NULL || w->block == NULL || w->data == NULL)
+    {
+      gsl_fft_real_2d_free (w);
+      GSL_ERROR_NULL ("failed to allocate buffers", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_real_2d_free (gsl_fft_real_2d_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->wavetable)
+    gsl_fft_complex_wavetable_free (w->wavetable);
+
+  if (w->work)
+    gsl_fft_complex_workspace_free (w->work);
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->row)
+    free (w->row);
+
+  if (w->block)
+    free (w->block);
+
+  if (w->data)
+    free (w->data);
+
+  free (w);
+}
+
+/*
+gsl_fft_real_2d_transform()
+  Compute the forward 2-D FFT of a real matrix
+
+Inputs: A - n1-by-n2 real matrix
+        B - (output) n1-by-(n2/2+1) complex matrix
+        w - workspace
+
+Notes:
+1) The transform of real data is conjugate symmetric,
+F(k1,k2) = conj(F(n1-k1,n2-k2)), so only the columns
+k2 = 0, ..., n2/2 are stored
+*/
+
+int
+gsl_fft_real_2d_transform (const gsl_matrix * A, gsl_matrix_complex * B,
+                           gsl_fft_real_2d_workspace * w)
+{
+  const size_t n1 = w->n1;
+  const size_t n2 = w->n2;
+  const size_t h = n2 / 2 + 1;
+
+  if (A->size1 != n1 || A->size2 != n2)
+    {
+      GSL_ERROR ("real matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (B->size1 != n1 || B->size2 != h)
+    {
+      GSL_ERROR ("complex matrix must be n1-by-(n2/2+1)", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      size_t i;
+
+      for (i = 0; i < n1; ++i)
+        {
+          memcpy (w->row, A->data + i * A->tda, n2 * sizeof (double));
+
+          status = gsl_fft_real_transform (w->row, 1, n2, w->real_wavetable, w->real_work);
+          if (status)
+            return status;
+
+          multidim_unpack (w->row, B->data + 2 * i * B->tda, n2);
+        }
+
+      status = multidim_columns (B->data, n1, h, B->tda, w->wavetable, w->work, w->block,
+                                 gsl_fft_forward);
+
+      return status;
+    }
+}
+
+/*
+gsl_fft_halfcomplex_2d_transform()
+  Compute the backward 2-D FFT of conjugate symmetric data, giving
+a real matrix
+
+Inputs: B - n1-by-(n2/2+1) complex matrix, as computed by
+            gsl_fft_real_2d_transform()
+        A - (output) n1-by-n2 real matrix
+        w - workspace
+
+Notes:
+1) B is not modified
+*/
+
+int
+gsl_fft_halfcomplex_2d_transform (const gsl_matrix_complex * B, gsl_matrix * A,
+                                  gsl_fft_real_2d_workspace * w)
+{
+  const size_t n1 = w->n1;
+  const size_t n2 = w->n2;
+  const size_t h = n2 / 2 + 1;
+
+  if (A->size1 != n1 || A->size2 != n2)
+    {
+      GSL_ERROR ("real matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (B->size1 != n1 || B->size2 != h)
+    {
+      GSL_ERROR ("complex matrix must be n1-by-(n2/2+1)", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      size_t i;
+
+      for (i = 0; i < n1; ++i)
+        memcpy (w->data + 2 * i * h, B->data + 2 * i * B->tda, 2 * h * sizeof (double));
+
+      status = multidim_columns (w->data, n1, h, h, w->wavetable, w->work, w->block,
+                                 gsl_fft_backward);
+      if (status)
+        return status;
+
+      for (i = 0; i < n1; ++i)
+        {
+          double * Ai = A->data + i * A->tda;
+
+          multidim_pack (w->data + 2 * i * h, Ai, n2);
+
+          status = gsl_fft_halfcomplex_transform (Ai, 1, n2, w->hc_wavetable, w->real_work);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_fft_halfcomplex_2d_inverse (const gsl_matrix_complex * B, gsl_matrix * A,
+                                gsl_fft_real_2d_workspace * w)
+{
+  int status = gsl_fft_halfcomplex_2d_transform (B, A, w);
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(n1*n2) */
+  {
+    const double norm = 1.0 / ((double) w->n1 * (double) w->n2);
+    size_t i, j;
+
+    for (i = 0; i < w->n1; ++i)
+      {
+        double * Ai = A->data + i * A->tda;
+
+        for (j = 0; j < w->n2; ++j)
+          Ai[j] *= norm;
+      }
+  }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_fft_real_3d_alloc()
+  Allocate a workspace for 3-D real and halfcomplex FFTs
+
+Inputs: n1 - first (slowest varying) dimension
+        n2 - second dimension
+        n3 - third (fastest varying) dimension of the real data
+
+Return: pointer to workspace
+*/
+
+gsl_fft_real_3d_workspace *
+gsl_fft_real_3d_alloc (const size_t n1, const size_t n2, const size_t n3)
+{
+  gsl_fft_real_3d_workspace * w;
+  const size_t n[2] = { n1, n2 };
+  const size_t h = n3 / 2 + 1;
+  size_t i;
+
+  if (n1 == 0 || n2 == 0 || n3 == 0)
+    {
+      GSL_ERROR_NULL ("dimensions must be positive integers", GSL_EDOM);
+    }
+
+  w = calloc (1, sizeof (gsl_fft_real_3d_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->n1 = n1;
+  w->n2 = n2;
+  w->n3 = n3;
+
+  for (i = 0; i < 2; ++i)
+    {
+      w->wavetable[i] = gsl_fft_complex_wavetable_alloc (n[i]);
+      w->work[i] = gsl_fft_complex_workspace_alloc (n[i]);
+
+      if (w->wavetable[i] == NULL || w->work[i] == NULL)
+        {
+          gsl_fft_real_3d_free (w);
+          GSL_ERROR_NULL ("failed to allocate wavetable", GSL_ENOMEM);
+        }
+    }
+
+  w->real_wavetable = gsl_fft_real_wavetable_alloc (n3);
+  w->hc_wavetable = gsl_fft_halfcomplex_wavetable_alloc (n3);
+  w->real_work = gsl_fft_real_workspace_alloc (n3);
+
+  if (w->real_wavetable == NULL || w->hc_wavetable == NULL || w->real_work == NULL)
+    {
+      gsl_fft_real_3d_free (w);
+      GSL_ERROR_NULL ("failed to allocate wavetables", GSL_ENOMEM);
+    }
+
+  w->row = malloc (n3 * sizeof (double));
+  w->block = multidim_block_alloc (GSL_MAX (n1, n2));
+  w->data = malloc (2 * n1 * n2 * h * sizeof (double));
+
+  if (w->row == NULL || w->block == NULL || w->data == NULL)
+    {
+      gsl_fft_real_3d_free (w);
+      GSL_ERROR_NULL ("failed to allocate buffers", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_fft_real_3d_free (gsl_fft_real_3d_workspace * w)
+{
+  size_t i;
+
+  RETURN_IF_NULL (w);
+
+  for (i = 0; i < 2; ++i)
+    {
+      if (w->wavetable[i])
+        gsl_fft_complex_wavetable_free (w->wavetable[i]);
+
+      if (w->work[i])
+        gsl_fft_complex_workspace_free (w->work[i]);
+    }
+
+  if (w->real_wavetable)
+    gsl_fft_real_wavetable_free (w->real_wavetable);
+
+  if (w->hc_wavetable)
+    gsl_fft_halfcomplex_wavetable_free (w->hc_wavetable);
+
+  if (w->real_work)
+    gsl_fft_real_workspace_free (w->real_work);
+
+  if (w->row)
+    free (w->row);
+
+  if (w->block)
+    free (w->block);
+
+  if (w->data)
+    free (w->data);
+
+  free (w);
+}
+
+/*
+gsl_fft_real_3d_transform()
+  Compute the forward 3-D FFT of a real volume
+
+Inputs: data - real array of n1*n2*n3 elements, element (i,j,k)
+               is stored at index (i*n2 + j)*n3 + k
+        out  - (output) packed complex array of n1*n2*(n3/2+1) elements,
+               element (i,j,k) is stored at index (i*n2 + j)*(n3/2+1) + k
+        w    - workspace
+*/
+
+int
+gsl_fft_real_3d_transform (const double data[], gsl_complex_packed_array out,
+                           gsl_fft_real_3d_workspace * w)
+{
+  const size_t n1 = w->n1;
+  const size_t n2 = w->n2;
+  const size_t n3 = w->n3;
+  const size_t h = n3 / 2 + 1;
+  int status;
+  size_t i;
+
+  for (i = 0; i < n1 * n2; ++i)
+    {
+      memcpy (w->row, data + i * n3, n3 * sizeof (double));
+
+      status = gsl_fft_real_transform (w->row, 1, n3, w->real_wavetable, w->real_work);
+      if (status)
+        return status;
+
+      multidim_unpack (w->row, out + 2 * i * h, n3);
+    }
+
+  for (i = 0; i < n1; ++i)
+    {
+      status = multidim_columns (out + 2 * i * n2 * h, n2, h, h, w->wavetable[1], w->work[1],
+                                 w->block, gsl_fft_forward);
+      if (status)
+        return status;
+    }
+
+  status = multidim_columns (out, n1, n2 * h, n2 * h, w->wavetable[0], w->work[0],
+                             w->block, gsl_fft_forward);
+
+  return status;
+}
+
+/*
+gsl_fft_halfcomplex_3d_transform()
+  Compute the backward 3-D FFT of conjugate symmetric data, giving
+a real volume
+
+Inputs: in   - packed complex array of n1*n2*(n3/2+1) elements, as
+               computed by gsl_fft_real_3d_transform(); not modified
+        data - (output) real array of n1*n2*n3 elements
+        w    - workspace
+*/
+
+int
+gsl_fft_halfcomplex_3d_transform (gsl_const_complex_packed_array in, double data[],
+                                  gsl_fft_real_3d_workspace * w)
+{
+  const size_t n1 = w->n1;
+  const size_t n2 = w->n2;
+  const size_t n3 = w->n3;
+  const size_t h = n3 / 2 + 1;
+  int status;
+  size_t i;
+
+  memcpy (w->data, in, 2 * n1 * n2 * h * sizeof (double));
+
+  status = multidim_columns (w->data, n1, n2 * h, n2 * h, w->wavetable[0], w->work[0],
+                             w->block, gsl_fft_backward);
+  if (status)
+    return status;
+
+  for (i = 0; i < n1; ++i)
+    {
+      status = multidim_columns (w->data + 2 * i * n2 * h, n2, h, h, w->wavetable[1],
+                                 w->work[1], w->block, gsl_fft_backward);
+      if (status)
+        return status;
+    }
+
+  for (i = 0; i < n1 * n2; ++i)
+    {
+      double * row = data + i * n3;
+
+      multidim_pack (w->data + 2 * i * h, row, n3);
+
+      status = gsl_fft_halfcomplex_transform (row, 1, n3, w->hc_wavetable, w->real_work);
+      if (status)
+        return status;
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_fft_halfcomplex_3d_inverse (gsl_const_complex_packed_array in, double data[],
+                                gsl_fft_real_3d_workspace * w)
+{
+  int status = gsl_fft_halfcomplex_3d_transform (in, data, w);
+
+  if (status)
+    return status;
+
+  /* normalize inverse fft with 1/(n1*n2*n3) */
+  {
+    const size_t N = w->n1 * w->n2 * w->n3;
+    const double norm = 1.0 / (double) N;
+    size_t i;
+
+    for (i = 0; i < N; ++i)
+      data[i] *= norm;
+  }
+
+  return GSL_SUCCESS;
+}
+
+/* transform nrows contiguous complex rows of length n, separated by tda */
+
+static int
+multidim_rows (double * data, const size_t nrows, const size_t n, const size_t tda,
+               const gsl_fft_complex_wavetable * wavetable,
+               gsl_fft_complex_workspace * work, const gsl_fft_direction sign)
+{
+  return gsl_fft_complex_batch_transform (data, 1, tda, n, nrows, wavetable, work, sign);
+}
+
+/*
+multidim_columns()
+  Transform the columns of an n-by-ncols complex matrix with row
+stride tda
+
+Notes:
+1) Transforming each column with stride tda touches one element per
+row, and for large tda every access is a cache miss. Instead, a block
+of MULTIDIM_BLOCK columns is copied into contiguous storage, reading
+each row in a contiguous segment, transformed with unit stride, and
+copied back.
+*/
+
+static int
+multidim_columns (double * data, const size_t n, const size_t ncols, const size_t tda,
+                  const gsl_fft_complex_wavetable * wavetable,
+                  gsl_fft_complex_workspace * work, double * block,
+                  const gsl_fft_direction sign)
+{
+  size_t j;
+
+  if (n == 1)
+    return GSL_SUCCESS;     /* FFT of 1 data point is the identity */
+
+  for (j = 0; j < ncols; j += MULTIDIM_BLOCK)
+    {
+      const size_t nb = GSL_MIN (MULTIDIM_BLOCK, ncols - j);
+      size_t i, k;
+
+      /* gather block: block(:,k) = column j + k */
+      for (i = 0; i < n; ++i)
+        {
+          const double * row = data + 2 * (i * tda + j);
+
+          for (k = 0; k < nb; ++k)
+            {
+              block[2 * (k * n + i)] = row[2 * k];
+              block[2 * (k * n + i) + 1] = row[2 * k + 1];
+            }
+        }
+
+      for (k = 0; k < nb; ++k)
+        {
+          int status = gsl_fft_complex_transform (block + 2 * k * n, 1, n, wavetable, work, sign);
+          if (status)
+            return status;
+        }
+
+      /* scatter block back */
+      for (i = 0; i < n; ++i)
+        {
+          double * row = data + 2 * (i * tda + j);
+
+          for (k = 0; k < nb; ++k)
+            {
+              row[2 * k] = block[2 * (k * n + i)];
+              row[2 * k + 1] = block[2 * (k * n + i) + 1];
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* unpack halfcomplex array r of length n into complex array c of length n/2+1 */
+
+static void
+multidim_unpack (const double * r, double * c, const size_t n)
+{
+  size_t k;
+
+  c[0] = r[0];
+  c[1] = 0.0;
+
+  for (k = 1; k < n - k; ++k)
+    {
+      c[2 * k] = r[2 * k - 1];
+      c[2 * k + 1] = r[2 * k];
+    }
+
+  if (k == n - k)
+    {
+      c[2 * k] = r[n - 1];
+      c[2 * k + 1] = 0.0;
+    }
+}
+
+/* pack complex array c of length n/2+1 into halfcomplex array r of length n */
+
+static void
+multidim_pack (const double * c, double * r, const size_t n)
+{
+  size_t k;
+
+  r[0] = c[0];
+
+  for (k = 1; k < n - k; ++k)
+    {
+      r[2 * k - 1] = c[2 * k];
+      r[2 * k] = c[2 * k + 1];
+    }
+
+  if (k == n - k)
+    {
+      r[n - 1] = c[2 * k];
+    }
+}
+
+static double *
+multidim_block_alloc (const size_t n)
+{
+  return malloc (2 * MULTIDIM_BLOCK * n * sizeof (double));
+}
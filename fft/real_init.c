@@ -41,6 +41,33 @@ FUNCTION(gsl_fft_real_wavetable,alloc) (size_t n)
       GSL_ERROR_VAL ("failed to allocate struct", GSL_ENOMEM, 0);
     }
 
+  wavetable->nb = fft_real_bluestein_length (n);
+  wavetable->chirp = NULL;
+
+  if (wavetable->nb)
+    {
+      /* large prime factors, use Bluestein's algorithm with complex
+         transforms of length nb */
+
+      wavetable->n = n;
+
+      status = FUNCTION(fft_complex,bluestein_alloc) (n, wavetable->nb,
+                                                      &(wavetable->nf),
+                                                      wavetable->factor,
+                                                      wavetable->twiddle,
+                                                      &(wavetable->trig),
+                                                      &(wavetable->chirp));
+
+      if (status)
+        {
+          free (wavetable);
+
+          GSL_ERROR_VAL ("failed to initialize Bluestein tables", status, 0);
+        }
+
+      return wavetable;
+    }
+
   if (n == 1) 
     {
       wavetable->trig = 0;
@@ -142,7 +169,15 @@ FUNCTION(gsl_fft_real_workspace,alloc) (size_t n)
 
   workspace->n = n;
 
-  workspace->scratch = (BASE *) malloc (n * sizeof (BASE));
+  {
+    /* Bluestein's algorithm needs a complex array of length n and two
+       of length nb; the real and halfcomplex transforms use the same
+       modules so they select the same nb */
+    const size_t nb = fft_real_bluestein_length (n);
+    const size_t len = nb ? 2 * n + 4 * nb : n;
+
+    workspace->scratch = (BASE *) malloc (len * sizeof (BASE));
+  }
 
   if (workspace->scratch == NULL)
     {
@@ -167,6 +202,9 @@ FUNCTION(gsl_fft_real_wavetable,free) (TYPE(gsl_fft_real_wavetable) * wavetable)
   free (wavetable->trig);
   wavetable->trig = NULL;
 
+  free (wavetable->chirp);
+  wavetable->chirp = NULL;
+
   free (wavetable) ;
 }
 
@@ -27,28 +27,49 @@
 
 #include "real_pass.h"
 
-int
-FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t n,
-                                  const TYPE(gsl_fft_real_wavetable) * wavetable,
-                                  TYPE(gsl_fft_real_workspace) * work)
+/* compute the transform with Bluestein's algorithm by treating the
+   data as complex, and pack the result into halfcomplex order */
+
+static int
+FUNCTION(fft_real,bluestein) (BASE data[], const size_t stride, const size_t n,
+                              const TYPE(gsl_fft_real_wavetable) * wavetable,
+                              BASE work[])
 {
-  const size_t nf = wavetable->nf;
+  BASE * const z = work;
+  size_t k;
 
-  size_t i;
+  for (k = 0; k < n; k++)
+    {
+      z[2 * k] = data[stride * k];
+      z[2 * k + 1] = 0;
+    }
 
-  size_t q, product = 1;
-  size_t tskip;
-  size_t product_1;
+  FUNCTION(fft_complex,bluestein) (z, 1, n, wavetable->nb, wavetable->nf,
+                                   wavetable->factor, wavetable->twiddle,
+                                   wavetable->chirp, work + 2 * n,
+                                   gsl_fft_forward);
 
-  BASE *const scratch = work->scratch;
-  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4;
+  data[0] = z[0];
 
-  size_t state = 0;
-  BASE *in = data;
-  size_t istride = stride ;
-  BASE *out = scratch;
-  size_t ostride = 1 ;
-  
+  for (k = 1; k < n - k; k++)
+    {
+      data[stride * (2 * k - 1)] = z[2 * k];
+      data[stride * (2 * k)] = z[2 * k + 1];
+    }
+
+  if (k == n - k)
+    {
+      data[stride * (n - 1)] = z[2 * k];
+    }
+
+  return 0;
+}
+
+int
+FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t n,
+                                  const TYPE(gsl_fft_real_wavetable) * wavetable,
+                                  TYPE(gsl_fft_real_workspace) * work)
+{
   if (n == 0)
     {
       GSL_ERROR ("length n must be positive integer", GSL_EDOM);
@@ -69,6 +90,37 @@ FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t
       GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
     }
 
+  if (wavetable->nb)
+    {
+      return FUNCTION(fft_real,bluestein) (data, stride, n, wavetable,
+                                           work->scratch);
+    }
+
+  return FUNCTION(fft_real,mixed_radix) (data, stride, n, wavetable,
+                                         work->scratch);
+}
+
+static int
+FUNCTION(fft_real,mixed_radix) (BASE data[], const size_t stride, const size_t n,
+                                const TYPE(gsl_fft_real_wavetable) * wavetable,
+                                BASE scratch[])
+{
+  const size_t nf = wavetable->nf;
+
+  size_t i;
+
+  size_t q, product = 1;
+  size_t tskip;
+  size_t product_1;
+
+  TYPE(gsl_complex) *twiddle1, *twiddle2, *twiddle3, *twiddle4;
+
+  size_t state = 0;
+  BASE *in = data;
+  size_t istride = stride ;
+  BASE *out = scratch;
+  size_t ostride = 1 ;
+
   for (i = 0; i < nf; i++)
     {
       const size_t factor = wavetable->factor[i];
@@ -143,3 +195,58 @@ FUNCTION(gsl_fft_real,transform) (BASE data[], const size_t stride, const size_t
   return 0;
 
 }
+
+/* Batched transform of howmany signals of length n, where element k of
+   signal j is stored at data[j*distance + k*stride]. The arguments are
+   checked once and the kernels are called directly for each signal. */
+
+int
+FUNCTION(gsl_fft_real,batch_transform) (BASE data[], const size_t stride,
+                                        const size_t distance, const size_t n,
+                                        const size_t howmany,
+                                        const TYPE(gsl_fft_real_wavetable) * wavetable,
+                                        TYPE(gsl_fft_real_workspace) * work)
+{
+  size_t j;
+
+  if (n == 0)
+    {
+      GSL_ERROR ("length n must be positive integer", GSL_EDOM);
+    }
+
+  if (stride == 0)
+    {
+      GSL_ERROR ("stride must be positive integer", GSL_EINVAL);
+    }
+
+  if (n != wavetable->n)
+    {
+      GSL_ERROR ("wavetable does not match length of data", GSL_EINVAL);
+    }
+
+  if (n != work->n)
+    {
+      GSL_ERROR ("workspace does not match length of data", GSL_EINVAL);
+    }
+
+  if (n == 1)
+    {                           /* FFT of one data point is the identity */
+      return 0;
+    }
+
+  for (j = 0; j < howmany; j++)
+    {
+      BASE * const x = data + distance * j;
+
+      if (wavetable->nb)
+        {
+          FUNCTION(fft_real,bluestein) (x, stride, n, wavetable, work->scratch);
+        }
+      else
+        {
+          FUNCTION(fft_real,mixed_radix) (x, stride, n, wavetable, work->scratch);
+        }
+    }
+
+  return 0;
+}
@@ -17,6 +17,11 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+static int
+FUNCTION(fft_real,mixed_radix) (BASE data[], const size_t stride, const size_t n,
+                                const TYPE(gsl_fft_real_wavetable) * wavetable,
+                                BASE scratch[]);
+
 static void FUNCTION(fft_real,pass_2) (const BASE in[],
                                        const size_t istride,
                                        BASE out[],
@@ -34,12 +34,18 @@
 #include <gsl/gsl_fft_real_float.h>
 #include <gsl/gsl_fft_halfcomplex.h>
 #include <gsl/gsl_fft_halfcomplex_float.h>
+#include <gsl/gsl_fft_multidim.h>
+#include <gsl/gsl_fft_convolve.h>
+#include <gsl/gsl_fft_cache.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_ieee_utils.h>
 #include <gsl/gsl_test.h>
 
 void my_error_handler (const char *reason, const char *file,
                        int line, int err);
 
+double urand (void);
+
 #include "complex_internal.h"
 
 /* Usage: test [n]
@@ -66,6 +72,11 @@ void my_error_handler (const char *reason, const char *file,
 #include "templates_off.h"
 #undef  BASE_FLOAT
 
+#include "test_multidim.c"
+#include "test_convolve.c"
+#include "test_cache.c"
+#include "test_bluestein.c"
+
 int
 main (int argc, char *argv[])
 {
@@ -108,7 +119,63 @@ main (int argc, char *argv[])
           test_complex_float_func (stride, i) ;
           test_real_func (stride, i) ;
           test_real_float_func (stride, i) ;
+          test_complex_batch (stride, i) ;
+          test_complex_float_batch (stride, i) ;
+          test_real_batch (stride, i) ;
+          test_real_float_batch (stride, i) ;
+        }
+    }
+
+  if (n == 0)
+    {
+      /* lengths with large prime factors, which use Bluestein's algorithm */
+      const size_t bluestein_lengths[] = { 211, 2 * 503, 5 * 211, 1009, 0 };
+
+      for (i = 0; bluestein_lengths[i] != 0; i++)
+        {
+          for (stride = 1 ; stride < 4 ; stride++)
+            {
+              test_complex_func (stride, bluestein_lengths[i]) ;
+              test_complex_float_func (stride, bluestein_lengths[i]) ;
+              test_real_func (stride, bluestein_lengths[i]) ;
+              test_real_float_func (stride, bluestein_lengths[i]) ;
+              test_complex_batch (stride, bluestein_lengths[i]) ;
+              test_real_batch (stride, bluestein_lengths[i]) ;
+            }
+        }
+
+      /* radix-2 lengths spanning several blocks of butterflies */
+
+      for (i = 256; i <= 1024; i *= 4)
+        {
+          for (stride = 1 ; stride < 4 ; stride++)
+            {
+              test_complex_radix2 (stride, i) ;
+              test_complex_float_radix2 (stride, i) ;
+            }
         }
+
+      /* six-step transforms, including lengths which are not split */
+      {
+        const size_t sixstep_lengths[] = { 1, 2, 7, 64, 630, 1000, 1024,
+                                           17 * 17, 211, 4 * 211, 0 };
+
+        for (i = 0; sixstep_lengths[i] != 0; i++)
+          {
+            for (stride = 1 ; stride < 4 ; stride++)
+              {
+                test_complex_sixstep (stride, sixstep_lengths[i]) ;
+                test_complex_float_sixstep (stride, sixstep_lengths[i]) ;
+              }
+          }
+      }
+
+      test_multidim () ;
+      test_convolve () ;
+      test_cache () ;
+
+      /* a length with a large prime factor: 2 * 100003 */
+      test_bluestein (200006) ;
     }
 
   gsl_set_error_handler (&my_error_handler);
@@ -0,0 +1,209 @@
+/* fft/test_bluestein.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Accuracy of Bluestein's algorithm for a length with a large prime
+   factor, which is too long for a full O(n^2) reference transform.
+   Instead a sample of coefficients is compared with a direct DFT,
+   accumulated in long double, and the whole signal is checked by a
+   round trip. The errors are measured relative to the norm of the
+   input, since each coefficient is a sum of n terms. */
+
+static void test_bluestein_dft (const double z[], const size_t n, const size_t k,
+                                const double sign, double * re, double * im);
+static double test_bluestein_norm (const double z[], const size_t n);
+static size_t test_bluestein_index (const size_t i, const size_t n);
+
+/* number of coefficients compared with the direct DFT */
+#define TEST_BLUESTEIN_NSAMPLE 16
+
+static void
+test_bluestein (const size_t n)
+{
+  const double tol = 1.0e-13;
+  double *x = malloc (2 * n * sizeof (double));
+  double *y = malloc (2 * n * sizeof (double));
+  double *z = malloc (2 * n * sizeof (double));
+  gsl_fft_complex_wavetable * cw = gsl_fft_complex_wavetable_alloc (n);
+  gsl_fft_complex_workspace * cwork = gsl_fft_complex_workspace_alloc (n);
+  gsl_fft_real_wavetable * rw = gsl_fft_real_wavetable_alloc (n);
+  gsl_fft_halfcomplex_wavetable * hw = gsl_fft_halfcomplex_wavetable_alloc (n);
+  gsl_fft_real_workspace * rwork = gsl_fft_real_workspace_alloc (n);
+  double norm, err, re, im;
+  size_t i, k;
+
+  gsl_test (cw->nb == 0, "bluestein complex wavetable n=%zu uses Bluestein's algorithm", n);
+  gsl_test (rw->nb == 0, "bluestein real wavetable n=%zu uses Bluestein's algorithm", n);
+  gsl_test (hw->nb == 0, "bluestein halfcomplex wavetable n=%zu uses Bluestein's algorithm", n);
+
+  /* complex forward transform and round trip */
+
+  for (i = 0; i < 2 * n; i++)
+    x[i] = urand () - 0.5;
+
+  norm = test_bluestein_norm (x, n);
+  memcpy (y, x, 2 * n * sizeof (double));
+  gsl_fft_complex_forward (y, 1, n, cw, cwork);
+
+  err = 0.0;
+  for (i = 0; i < TEST_BLUESTEIN_NSAMPLE; i++)
+    {
+      k = test_bluestein_index (i, n);
+      test_bluestein_dft (x, n, k, -1.0, &re, &im);
+      err = GSL_MAX (err, hypot (y[2 * k] - re, y[2 * k + 1] - im) / norm);
+    }
+
+  gsl_test (err > tol, "bluestein complex forward n=%zu, relative error %g", n, err);
+
+  gsl_fft_complex_inverse (y, 1, n, cw, cwork);
+
+  err = 0.0;
+  for (i = 0; i < 2 * n; i++)
+    err = GSL_MAX (err, fabs (y[i] - x[i]));
+
+  gsl_test (err > tol, "bluestein complex round trip n=%zu, error %g", n, err);
+
+  /* real forward transform, compared with the DFT of the data with
+     zero imaginary part, and round trip */
+
+  for (i = 0; i < n; i++)
+    {
+      x[2 * i] = urand () - 0.5;
+      x[2 * i + 1] = 0.0;
+      y[i] = x[2 * i];
+    }
+
+  norm = test_bluestein_norm (x, n);
+  gsl_fft_real_transform (y, 1, n, rw, rwork);
+  gsl_fft_halfcomplex_unpack (y, z, 1, n);
+
+  err = 0.0;
+  for (i = 0; i < TEST_BLUESTEIN_NSAMPLE; i++)
+    {
+      k = test_bluestein_index (i, n);
+      test_bluestein_dft (x, n, k, -1.0, &re, &im);
+      err = GSL_MAX (err, hypot (z[2 * k] - re, z[2 * k + 1] - im) / norm);
+    }
+
+  gsl_test (err > tol, "bluestein real forward n=%zu, relative error %g", n, err);
+
+  gsl_fft_halfcomplex_inverse (y, 1, n, hw, rwork);
+
+  err = 0.0;
+  for (i = 0; i < n; i++)
+    err = GSL_MAX (err, fabs (y[i] - x[2 * i]));
+
+  gsl_test (err > tol, "bluestein real round trip n=%zu, error %g", n, err);
+
+  /* halfcomplex backward transform, compared with the backward DFT of
+     the unpacked coefficients, and round trip */
+
+  for (i = 0; i < n; i++)
+    y[i] = urand () - 0.5;
+
+  gsl_fft_halfcomplex_unpack (y, z, 1, n);
+  memcpy (x, y, n * sizeof (double));
+  norm = test_bluestein_norm (z, n);
+  gsl_fft_halfcomplex_transform (y, 1, n, hw, rwork);
+
+  err = 0.0;
+  for (i = 0; i < TEST_BLUESTEIN_NSAMPLE; i++)
+    {
+      k = test_bluestein_index (i, n);
+      test_bluestein_dft (z, n, k, 1.0, &re, &im);
+      err = GSL_MAX (err, fabs (y[k] - re) / norm);
+    }
+
+  gsl_test (err > tol, "bluestein halfcomplex backward n=%zu, relative error %g", n, err);
+
+  gsl_fft_real_transform (y, 1, n, rw, rwork);
+
+  err = 0.0;
+  for (i = 0; i < n; i++)
+    err = GSL_MAX (err, fabs (y[i] / (double) n - x[i]));
+
+  gsl_test (err > tol, "bluestein halfcomplex round trip n=%zu, error %g", n, err);
+
+  gsl_fft_complex_wavetable_free (cw);
+  gsl_fft_complex_workspace_free (cwork);
+  gsl_fft_real_wavetable_free (rw);
+  gsl_fft_halfcomplex_wavetable_free (hw);
+  gsl_fft_real_workspace_free (rwork);
+  free (x);
+  free (y);
+  free (z);
+}
+
+/* coefficient k of the DFT of the complex array z, with exp(sign 2 pi i jk/n) */
+
+static void
+test_bluestein_dft (const double z[], const size_t n, const size_t k,
+                    const double sign, double * re, double * im)
+{
+  long double sr = 0.0, si = 0.0;
+  size_t j, m = 0;
+
+  for (j = 0; j < n; j++)
+    {
+      /* m = jk mod n, so that the angle is exact to rounding */
+      const double theta = sign * 2.0 * M_PI * (double) m / (double) n;
+      const double c = cos (theta), s = sin (theta);
+
+      sr += (long double) z[2 * j] * c - (long double) z[2 * j + 1] * s;
+      si += (long double) z[2 * j] * s + (long double) z[2 * j + 1] * c;
+
+      m += k;
+      if (m >= n)
+        m -= n;
+    }
+
+  *re = (double) sr;
+  *im = (double) si;
+}
+
+static double
+test_bluestein_norm (const double z[], const size_t n)
+{
+  double sum = 0.0;
+  size_t i;
+
+  for (i = 0; i < 2 * n; i++)
+    sum += z[i] * z[i];
+
+  return sqrt (sum);
+}
+
+/* the ends and middle of the spectrum, then pseudo-random indices */
+
+static size_t
+test_bluestein_index (const size_t i, const size_t n)
+{
+  switch (i)
+    {
+    case 0:
+      return 0;
+    case 1:
+      return 1;
+    case 2:
+      return n / 2;
+    case 3:
+      return n - 1;
+    default:
+      return (size_t) (urand () * n) % n;
+    }
+}
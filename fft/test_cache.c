@@ -0,0 +1,118 @@
+/* fft/test_cache.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+static void
+test_cache (void)
+{
+  const size_t nlen = 40;
+  gsl_fft_cache * c = gsl_fft_cache_alloc ();
+  const gsl_fft_complex_wavetable ** cw = malloc (nlen * sizeof (gsl_fft_complex_wavetable *));
+  const gsl_fft_real_wavetable ** rw = malloc (nlen * sizeof (gsl_fft_real_wavetable *));
+  size_t i, pass;
+  int status;
+
+  /* requests in two passes, with lengths in a scrambled order, must
+     return the same objects */
+
+  for (pass = 0; pass < 2; ++pass)
+    {
+      status = 0;
+
+      for (i = 0; i < nlen; ++i)
+        {
+          const size_t n = 1 + (i * 17) % nlen;
+          const gsl_fft_complex_wavetable * a = gsl_fft_cache_complex_wavetable (n, c);
+          const gsl_fft_real_wavetable * b = gsl_fft_cache_real_wavetable (n, c);
+
+          status |= (a->n != n || b->n != n);
+
+          if (pass == 0)
+            {
+              cw[n - 1] = a;
+              rw[n - 1] = b;
+            }
+          else
+            {
+              status |= (a != cw[n - 1] || b != rw[n - 1]);
+            }
+        }
+
+      gsl_test (status, "gsl_fft_cache wavetables pass %zu", pass);
+    }
+
+  gsl_test_int (gsl_fft_cache_size (c), 2 * nlen, "gsl_fft_cache size");
+
+  /* each kind of object is cached separately */
+
+  {
+    const size_t n = 12;
+    const gsl_fft_complex_wavetable_float * a = gsl_fft_cache_complex_wavetable_float (n, c);
+    const gsl_fft_real_wavetable_float * b = gsl_fft_cache_real_wavetable_float (n, c);
+    const gsl_fft_halfcomplex_wavetable * d = gsl_fft_cache_halfcomplex_wavetable (n, c);
+    const gsl_fft_halfcomplex_wavetable_float * e = gsl_fft_cache_halfcomplex_wavetable_float (n, c);
+    gsl_fft_complex_workspace * f = gsl_fft_cache_complex_workspace (n, c);
+    gsl_fft_complex_workspace_float * g = gsl_fft_cache_complex_workspace_float (n, c);
+    gsl_fft_real_workspace * h = gsl_fft_cache_real_workspace (n, c);
+    gsl_fft_real_workspace_float * k = gsl_fft_cache_real_workspace_float (n, c);
+
+    status = (a->n != n || b->n != n || d->n != n || e->n != n ||
+              f->n != n || g->n != n || h->n != n || k->n != n);
+    status |= (gsl_fft_cache_size (c) != 2 * nlen + 8);
+    status |= (gsl_fft_cache_complex_workspace (n, c) != f ||
+               gsl_fft_cache_real_workspace_float (n, c) != k);
+
+    gsl_test (status, "gsl_fft_cache object kinds");
+  }
+
+  /* transforms with cached objects must match transforms with newly
+     allocated ones */
+
+  {
+    const size_t n = 30;
+    gsl_fft_complex_wavetable * wt = gsl_fft_complex_wavetable_alloc (n);
+    gsl_fft_complex_workspace * work = gsl_fft_complex_workspace_alloc (n);
+    double * x = malloc (2 * n * sizeof (double));
+    double * y = malloc (2 * n * sizeof (double));
+
+    for (i = 0; i < 2 * n; ++i)
+      x[i] = y[i] = urand () - 0.5;
+
+    gsl_fft_complex_forward (x, 1, n, wt, work);
+    gsl_fft_complex_forward (y, 1, n, gsl_fft_cache_complex_wavetable (n, c),
+                             gsl_fft_cache_complex_workspace (n, c));
+
+    status = 0;
+    for (i = 0; i < 2 * n; ++i)
+      status |= (x[i] != y[i]);
+
+    gsl_test (status, "gsl_fft_cache complex transform n=%zu", n);
+
+    gsl_fft_complex_wavetable_free (wt);
+    gsl_fft_complex_workspace_free (work);
+    free (x);
+    free (y);
+  }
+
+  gsl_fft_cache_reset (c);
+  gsl_test_int (gsl_fft_cache_size (c), 0, "gsl_fft_cache reset");
+
+  gsl_fft_cache_free (c);
+  free (cw);
+  free (rw);
+}
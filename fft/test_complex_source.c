@@ -26,6 +26,8 @@ int FUNCTION(test,offset) (const BASE data[], size_t stride,
                            size_t n, size_t offset);
 void FUNCTION(test_complex,bitreverse_order) (size_t stride, size_t n) ;
 void FUNCTION(test_complex,radix2) (size_t stride, size_t n);
+void FUNCTION(test_complex,batch) (size_t stride, size_t n);
+void FUNCTION(test_complex,sixstep) (size_t stride, size_t n);
 
 int FUNCTION(test,offset) (const BASE data[], size_t stride, 
                            size_t n, size_t offset)
@@ -439,10 +441,191 @@ void FUNCTION(test_complex,radix2) (size_t stride, size_t n)
               "_radix2_forward with signal_exp, n = %d, stride = %d", n, stride);
   }
 
-  
+  /* Test the decimation-in-frequency fft with noise */
+
+  {
+    FUNCTION(fft_signal,complex_noise) (n, stride, complex_data,
+                                        fft_complex_data);
+    FUNCTION(gsl_fft_complex,radix2_dif_forward) (complex_data, stride, n);
+    status = FUNCTION(compare_complex,results) ("dft", fft_complex_data,
+                                                "fft of noise", complex_data,
+                                                stride, n, 1e6);
+    gsl_test (status, NAME(gsl_fft_complex)
+              "_radix2_dif_forward with signal_noise, n = %d, stride = %d",
+              n, stride);
+
+    FUNCTION(gsl_fft_complex,radix2_dif_inverse) (complex_data, stride, n);
+    FUNCTION(gsl_fft_complex,radix2_dif_forward) (complex_data, stride, n);
+    status = FUNCTION(compare_complex,results) ("dft", fft_complex_data,
+                                                "fft of inverse", complex_data,
+                                                stride, n, 1e6);
+    gsl_test (status, NAME(gsl_fft_complex)
+              "_radix2_dif_inverse with signal_noise, n = %d, stride = %d",
+              n, stride);
+  }
+
   free (complex_data);
   free (complex_tmp);
   free (fft_complex_data);
   free (fft_complex_tmp);
 }
 
+
+void FUNCTION(test_complex,batch) (size_t stride, size_t n)
+{
+  const size_t howmany = 3;
+  const size_t distance = n * stride + 5;
+  const size_t len = 2 * distance * howmany;
+  size_t i, j ;
+  int status = 0 ;
+
+  TYPE(gsl_fft_complex_wavetable) * cw = FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+  TYPE(gsl_fft_complex_workspace) * cwork = FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+
+  BASE * batch_data = (BASE *) malloc (len * sizeof (BASE));
+  BASE * single_data = (BASE *) malloc (len * sizeof (BASE));
+
+  for (i = 0 ; i < len ; i++)
+    {
+      batch_data[i] = single_data[i] = (BASE)(urand () - 0.5) ;
+    }
+
+  /* batched forward transform must match individual transforms exactly */
+
+  FUNCTION(gsl_fft_complex,batch_forward) (batch_data, stride, distance, n, howmany, cw, cwork);
+
+  for (j = 0 ; j < howmany ; j++)
+    {
+      FUNCTION(gsl_fft_complex,forward) (single_data + 2 * distance * j, stride, n, cw, cwork);
+    }
+
+  for (i = 0 ; i < len ; i++)
+    {
+      status |= (batch_data[i] != single_data[i]);
+    }
+
+  gsl_test (status, NAME(gsl_fft_complex)
+            "_batch_forward, n = %d, stride = %d", n, stride);
+
+  /* batched inverse transform */
+
+  FUNCTION(gsl_fft_complex,batch_inverse) (batch_data, stride, distance, n, howmany, cw, cwork);
+
+  for (j = 0 ; j < howmany ; j++)
+    {
+      FUNCTION(gsl_fft_complex,inverse) (single_data + 2 * distance * j, stride, n, cw, cwork);
+    }
+
+  status = 0;
+  for (i = 0 ; i < len ; i++)
+    {
+      status |= (batch_data[i] != single_data[i]);
+    }
+
+  gsl_test (status, NAME(gsl_fft_complex)
+            "_batch_inverse, n = %d, stride = %d", n, stride);
+
+  FUNCTION(gsl_fft_complex_wavetable,free) (cw);
+  FUNCTION(gsl_fft_complex_workspace,free) (cwork);
+
+  free (batch_data) ;
+  free (single_data) ;
+}
+
+
+void FUNCTION(test_complex,sixstep) (size_t stride, size_t n)
+{
+  size_t i, stage ;
+  int status = 0 ;
+
+  TYPE(gsl_fft_complex_wavetable) * cw = FUNCTION(gsl_fft_complex_wavetable,alloc) (n);
+  TYPE(gsl_fft_complex_workspace) * cwork = FUNCTION(gsl_fft_complex_workspace,alloc) (n);
+  TYPE(gsl_fft_complex_sixstep_wavetable) * sw = FUNCTION(gsl_fft_complex_sixstep_wavetable,alloc) (n);
+
+  BASE * complex_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+  BASE * staged_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+  BASE * fft_complex_data = (BASE *) malloc (2 * n * stride * sizeof (BASE));
+
+  for (i = 0 ; i < 2 * n * stride ; i++)
+    {
+      complex_data[i] = (BASE)i ;
+      fft_complex_data[i] = (BASE)(i + 2000.0) ;
+    }
+
+  for (i = 0 ; i < n ; i++)
+    {
+      REAL(complex_data,stride,i) = (BASE)(urand () - 0.5) ;
+      IMAG(complex_data,stride,i) = (BASE)(urand () - 0.5) ;
+    }
+
+  memcpy (staged_data, complex_data, 2 * n * stride * sizeof (BASE));
+  memcpy (fft_complex_data, complex_data, 2 * n * stride * sizeof (BASE));
+
+  /* six-step transform must agree with the mixed-radix transform */
+
+  FUNCTION(gsl_fft_complex,forward) (fft_complex_data, stride, n, cw, cwork);
+  FUNCTION(gsl_fft_complex,sixstep_transform) (complex_data, stride, n, sw, cwork,
+                                               gsl_fft_forward);
+
+  status = FUNCTION(compare_complex,results) ("mixed radix", fft_complex_data,
+                                              "six-step", complex_data,
+                                              stride, n, 1e6);
+  gsl_test (status, NAME(gsl_fft_complex)
+            "_sixstep_transform forward, n = %d, stride = %d", n, stride);
+
+  if (stride > 1)
+    {
+      status = FUNCTION(test, offset) (complex_data, stride, n, 0) ;
+
+      gsl_test (status, NAME(gsl_fft_complex)
+                "_sixstep_transform avoids unstrided data, n = %d, stride = %d",
+                n, stride);
+    }
+
+  /* the stages computed over separate row ranges, in reverse order, must
+     give exactly the same result as the whole transform */
+
+  for (stage = 0 ; stage < GSL_FFT_SIXSTEP_NSTAGES ; stage++)
+    {
+      const size_t nrows = FUNCTION(gsl_fft_complex,sixstep_nrows) (stage, sw);
+      size_t last = nrows;
+
+      while (last > 0)
+        {
+          const size_t first = (last > 3) ? last - 3 : 0;
+          FUNCTION(gsl_fft_complex,sixstep_stage) (staged_data, stride, n, stage,
+                                                   first, last, sw, cwork,
+                                                   gsl_fft_forward);
+          last = first;
+        }
+    }
+
+  status = 0;
+  for (i = 0 ; i < 2 * n * stride ; i++)
+    {
+      status |= (staged_data[i] != complex_data[i]);
+    }
+
+  gsl_test (status, NAME(gsl_fft_complex)
+            "_sixstep_stage row ranges, n = %d, stride = %d", n, stride);
+
+  /* backward transform */
+
+  FUNCTION(gsl_fft_complex,backward) (fft_complex_data, stride, n, cw, cwork);
+  FUNCTION(gsl_fft_complex,sixstep_transform) (complex_data, stride, n, sw, cwork,
+                                               gsl_fft_backward);
+
+  status = FUNCTION(compare_complex,results) ("mixed radix", fft_complex_data,
+                                              "six-step", complex_data,
+                                              stride, n, 1e6);
+  gsl_test (status, NAME(gsl_fft_complex)
+            "_sixstep_transform backward, n = %d, stride = %d", n, stride);
+
+  FUNCTION(gsl_fft_complex_wavetable,free) (cw);
+  FUNCTION(gsl_fft_complex_workspace,free) (cwork);
+  FUNCTION(gsl_fft_complex_sixstep_wavetable,free) (sw);
+
+  free (complex_data) ;
+  free (staged_data) ;
+  free (fft_complex_data) ;
+}
@@ -0,0 +1,256 @@
+/* fft/test_convolve.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* compute the full convolution (or correlation) of complex x and h
+   directly from the definition */
+
+static void
+test_convolve_full (const double * x, const size_t n, const double * h, const size_t k,
+                    const int correlate, double * y)
+{
+  size_t i, j;
+
+  for (i = 0; i < n + k - 1; ++i)
+    {
+      double sum_r = 0.0, sum_i = 0.0;
+
+      for (j = 0; j < k; ++j)
+        {
+          const size_t jh = correlate ? k - 1 - j : j;
+          const double hr = h[2 * jh];
+          const double hi = correlate ? -h[2 * jh + 1] : h[2 * jh + 1];
+
+          if (i >= j && i - j < n)
+            {
+              sum_r += hr * x[2 * (i - j)] - hi * x[2 * (i - j) + 1];
+              sum_i += hr * x[2 * (i - j) + 1] + hi * x[2 * (i - j)];
+            }
+        }
+
+      y[2 * i] = sum_r;
+      y[2 * i + 1] = sum_i;
+    }
+}
+
+static void
+test_convolve_mode (const gsl_fft_convolve_mode_t mode, const gsl_fft_convolve_method_t method,
+                    const int correlate, const size_t n, const size_t k)
+{
+  const double tol = 1.0e-12;
+  const char * mode_name[] = { "full", "same", "valid" };
+  const char * desc = correlate ? "correlate" : "convolve";
+  const size_t ny = gsl_fft_convolve_size (mode, n, k);
+  const size_t start = (mode == GSL_FFT_CONVOLVE_FULL) ? 0 :
+                       (mode == GSL_FFT_CONVOLVE_SAME) ? (k - 1) / 2 : k - 1;
+  gsl_fft_convolve_workspace * w = gsl_fft_convolve_alloc (n + 3, k + 2);
+  gsl_vector * x = gsl_vector_alloc (n);
+  gsl_vector * h = gsl_vector_alloc (k);
+  gsl_vector * y = gsl_vector_alloc (ny);
+  gsl_vector_complex * xc = gsl_vector_complex_alloc (n);
+  gsl_vector_complex * hc = gsl_vector_complex_alloc (k);
+  gsl_vector_complex * yc = gsl_vector_complex_alloc (ny);
+  double * xr = calloc (2 * n, sizeof (double));
+  double * hr = calloc (2 * k, sizeof (double));
+  double * yr = malloc (2 * (n + k - 1) * sizeof (double));
+  size_t i;
+
+  gsl_fft_convolve_set_method (method, w);
+
+  /* real data */
+
+  for (i = 0; i < n; ++i)
+    {
+      xr[2 * i] = urand () - 0.5;
+      gsl_vector_set (x, i, xr[2 * i]);
+    }
+
+  for (i = 0; i < k; ++i)
+    {
+      hr[2 * i] = urand () - 0.5;
+      gsl_vector_set (h, i, hr[2 * i]);
+    }
+
+  test_convolve_full (xr, n, hr, k, correlate, yr);
+
+  if (correlate)
+    gsl_fft_correlate (mode, x, h, y, w);
+  else
+    gsl_fft_convolve (mode, x, h, y, w);
+
+  for (i = 0; i < ny; ++i)
+    {
+      gsl_test_abs (gsl_vector_get (y, i), yr[2 * (start + i)], tol,
+                    "%s real %s method=%d n=%zu k=%zu i=%zu",
+                    desc, mode_name[mode], method, n, k, i);
+    }
+
+  /* complex data */
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_complex z;
+      xr[2 * i + 1] = urand () - 0.5;
+      GSL_SET_COMPLEX (&z, xr[2 * i], xr[2 * i + 1]);
+      gsl_vector_complex_set (xc, i, z);
+    }
+
+  for (i = 0; i < k; ++i)
+    {
+      gsl_complex z;
+      hr[2 * i + 1] = urand () - 0.5;
+      GSL_SET_COMPLEX (&z, hr[2 * i], hr[2 * i + 1]);
+      gsl_vector_complex_set (hc, i, z);
+    }
+
+  test_convolve_full (xr, n, hr, k, correlate, yr);
+
+  if (correlate)
+    gsl_fft_correlate_complex (mode, xc, hc, yc, w);
+  else
+    gsl_fft_convolve_complex (mode, xc, hc, yc, w);
+
+  for (i = 0; i < ny; ++i)
+    {
+      gsl_complex z = gsl_vector_complex_get (yc, i);
+
+      gsl_test_abs (GSL_REAL (z), yr[2 * (start + i)], tol,
+                    "%s complex %s method=%d n=%zu k=%zu i=%zu real",
+                    desc, mode_name[mode], method, n, k, i);
+      gsl_test_abs (GSL_IMAG (z), yr[2 * (start + i) + 1], tol,
+                    "%s complex %s method=%d n=%zu k=%zu i=%zu imag",
+                    desc, mode_name[mode], method, n, k, i);
+    }
+
+  gsl_fft_convolve_free (w);
+  gsl_vector_free (x);
+  gsl_vector_free (h);
+  gsl_vector_free (y);
+  gsl_vector_complex_free (xc);
+  gsl_vector_complex_free (hc);
+  gsl_vector_complex_free (yc);
+  free (xr);
+  free (hr);
+  free (yr);
+}
+
+/* process a signal in pieces of varying length and compare with the
+   first n outputs of the full convolution */
+
+static void
+test_convolve_stream (const gsl_fft_convolve_stream_t type, const size_t n, const size_t k,
+                      const size_t block)
+{
+  const double tol = 1.0e-12;
+  const char * desc = (type == GSL_FFT_CONVOLVE_OVERLAP_ADD) ? "overlap-add" : "overlap-save";
+  gsl_fft_convolve_stream_workspace * w = gsl_fft_convolve_stream_alloc (type, k, block);
+  gsl_vector * x = gsl_vector_alloc (n);
+  gsl_vector * h = gsl_vector_alloc (k);
+  gsl_vector * y = gsl_vector_alloc (n);
+  double * xr = calloc (2 * n, sizeof (double));
+  double * hr = calloc (2 * k, sizeof (double));
+  double * yr = malloc (2 * (n + k - 1) * sizeof (double));
+  size_t pass, i;
+
+  for (i = 0; i < n; ++i)
+    {
+      xr[2 * i] = urand () - 0.5;
+      gsl_vector_set (x, i, xr[2 * i]);
+    }
+
+  for (i = 0; i < k; ++i)
+    {
+      hr[2 * i] = urand () - 0.5;
+      gsl_vector_set (h, i, hr[2 * i]);
+    }
+
+  test_convolve_full (xr, n, hr, k, 0, yr);
+
+  gsl_fft_convolve_stream_init (h, w);
+
+  /* the second pass checks that reset clears the history */
+
+  for (pass = 0; pass < 2; ++pass)
+    {
+      size_t i0 = 0;
+
+      while (i0 < n)
+        {
+          const size_t r = (size_t) (urand () * 3.0 * w->block) + 1;
+          const size_t len = GSL_MIN (r, n - i0);
+          gsl_vector_const_view xv = gsl_vector_const_subvector (x, i0, len);
+          gsl_vector_view yv = gsl_vector_subvector (y, i0, len);
+
+          gsl_fft_convolve_stream_apply (&xv.vector, &yv.vector, w);
+          i0 += len;
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_test_abs (gsl_vector_get (y, i), yr[2 * i], tol,
+                        "%s pass=%zu n=%zu k=%zu block=%zu i=%zu",
+                        desc, pass, n, k, w->block, i);
+        }
+
+      gsl_fft_convolve_stream_reset (w);
+    }
+
+  gsl_fft_convolve_stream_free (w);
+  gsl_vector_free (x);
+  gsl_vector_free (h);
+  gsl_vector_free (y);
+  free (xr);
+  free (hr);
+  free (yr);
+}
+
+static void
+test_convolve (void)
+{
+  const size_t lengths[][2] = { { 1, 1 }, { 10, 1 }, { 10, 3 }, { 17, 4 },
+                                { 50, 50 }, { 100, 31 }, { 3, 8 }, { 0, 0 } };
+  const gsl_fft_convolve_method_t methods[] = { GSL_FFT_CONVOLVE_AUTO,
+                                                GSL_FFT_CONVOLVE_DIRECT,
+                                                GSL_FFT_CONVOLVE_FFT };
+  size_t i, j, correlate;
+
+  for (i = 0; lengths[i][0] != 0; ++i)
+    {
+      const size_t n = lengths[i][0];
+      const size_t k = lengths[i][1];
+
+      for (j = 0; j < 3; ++j)
+        {
+          for (correlate = 0; correlate < 2; ++correlate)
+            {
+              test_convolve_mode (GSL_FFT_CONVOLVE_FULL, methods[j], correlate, n, k);
+              test_convolve_mode (GSL_FFT_CONVOLVE_SAME, methods[j], correlate, n, k);
+
+              if (k <= n)
+                test_convolve_mode (GSL_FFT_CONVOLVE_VALID, methods[j], correlate, n, k);
+            }
+        }
+    }
+
+  test_convolve_stream (GSL_FFT_CONVOLVE_OVERLAP_ADD, 500, 1, 8);
+  test_convolve_stream (GSL_FFT_CONVOLVE_OVERLAP_ADD, 500, 17, 0);
+  test_convolve_stream (GSL_FFT_CONVOLVE_OVERLAP_ADD, 1000, 64, 30);
+  test_convolve_stream (GSL_FFT_CONVOLVE_OVERLAP_SAVE, 500, 1, 8);
+  test_convolve_stream (GSL_FFT_CONVOLVE_OVERLAP_SAVE, 500, 17, 0);
+  test_convolve_stream (GSL_FFT_CONVOLVE_OVERLAP_SAVE, 1000, 64, 30);
+}
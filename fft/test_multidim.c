@@ -0,0 +1,290 @@
+/* fft/test_multidim.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* compute the 3-D DFT of a packed complex n1*n2*n3 array directly */
+
+static void
+test_multidim_dft (const double * in, double * out, const size_t n1, const size_t n2,
+                   const size_t n3, const gsl_fft_direction sign)
+{
+  size_t i1, i2, i3, j1, j2, j3;
+
+  for (j1 = 0; j1 < n1; ++j1)
+    for (j2 = 0; j2 < n2; ++j2)
+      for (j3 = 0; j3 < n3; ++j3)
+        {
+          const size_t j = (j1 * n2 + j2) * n3 + j3;
+          double sum_real = 0.0, sum_imag = 0.0;
+
+          for (i1 = 0; i1 < n1; ++i1)
+            for (i2 = 0; i2 < n2; ++i2)
+              for (i3 = 0; i3 < n3; ++i3)
+                {
+                  const size_t i = (i1 * n2 + i2) * n3 + i3;
+                  const double theta = (double) sign * 2.0 * M_PI *
+                    ((double) ((i1 * j1) % n1) / (double) n1 +
+                     (double) ((i2 * j2) % n2) / (double) n2 +
+                     (double) ((i3 * j3) % n3) / (double) n3);
+                  const double c = cos (theta), s = sin (theta);
+
+                  sum_real += in[2 * i] * c - in[2 * i + 1] * s;
+                  sum_imag += in[2 * i] * s + in[2 * i + 1] * c;
+                }
+
+          out[2 * j] = sum_real;
+          out[2 * j + 1] = sum_imag;
+        }
+}
+
+static void
+test_complex_2d (const size_t n1, const size_t n2)
+{
+  const double tol = 1.0e-10;
+  const size_t pad = 3;
+  gsl_matrix_complex * M = gsl_matrix_complex_alloc (n1, n2 + pad);
+  gsl_matrix_complex_view A = gsl_matrix_complex_submatrix (M, 0, 0, n1, n2);
+  double * x = malloc (2 * n1 * n2 * sizeof (double));
+  double * y = malloc (2 * n1 * n2 * sizeof (double));
+  gsl_fft_complex_2d_workspace * w = gsl_fft_complex_2d_alloc (n1, n2);
+  size_t i, j;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_complex z;
+
+          GSL_SET_COMPLEX (&z, urand () - 0.5, urand () - 0.5);
+          gsl_matrix_complex_set (&A.matrix, i, j, z);
+          x[2 * (i * n2 + j)] = GSL_REAL (z);
+          x[2 * (i * n2 + j) + 1] = GSL_IMAG (z);
+        }
+    }
+
+  test_multidim_dft (x, y, n1, n2, 1, gsl_fft_forward);
+  gsl_fft_complex_2d_forward (&A.matrix, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_complex z = gsl_matrix_complex_get (&A.matrix, i, j);
+
+          gsl_test_abs (GSL_REAL (z), y[2 * (i * n2 + j)], tol,
+                        "complex_2d forward n1=%zu n2=%zu (%zu,%zu) real", n1, n2, i, j);
+          gsl_test_abs (GSL_IMAG (z), y[2 * (i * n2 + j) + 1], tol,
+                        "complex_2d forward n1=%zu n2=%zu (%zu,%zu) imag", n1, n2, i, j);
+        }
+    }
+
+  gsl_fft_complex_2d_inverse (&A.matrix, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_complex z = gsl_matrix_complex_get (&A.matrix, i, j);
+
+          gsl_test_abs (GSL_REAL (z), x[2 * (i * n2 + j)], tol,
+                        "complex_2d inverse n1=%zu n2=%zu (%zu,%zu) real", n1, n2, i, j);
+          gsl_test_abs (GSL_IMAG (z), x[2 * (i * n2 + j) + 1], tol,
+                        "complex_2d inverse n1=%zu n2=%zu (%zu,%zu) imag", n1, n2, i, j);
+        }
+    }
+
+  gsl_matrix_complex_free (M);
+  gsl_fft_complex_2d_free (w);
+  free (x);
+  free (y);
+}
+
+static void
+test_complex_3d (const size_t n1, const size_t n2, const size_t n3)
+{
+  const double tol = 1.0e-10;
+  const size_t N = n1 * n2 * n3;
+  double * x = malloc (2 * N * sizeof (double));
+  double * y = malloc (2 * N * sizeof (double));
+  double * z = malloc (2 * N * sizeof (double));
+  gsl_fft_complex_3d_workspace * w = gsl_fft_complex_3d_alloc (n1, n2, n3);
+  size_t i;
+
+  for (i = 0; i < 2 * N; ++i)
+    x[i] = z[i] = urand () - 0.5;
+
+  test_multidim_dft (x, y, n1, n2, n3, gsl_fft_forward);
+  gsl_fft_complex_3d_forward (z, w);
+
+  for (i = 0; i < 2 * N; ++i)
+    {
+      gsl_test_abs (z[i], y[i], tol, "complex_3d forward n=(%zu,%zu,%zu) i=%zu",
+                    n1, n2, n3, i);
+    }
+
+  gsl_fft_complex_3d_inverse (z, w);
+
+  for (i = 0; i < 2 * N; ++i)
+    {
+      gsl_test_abs (z[i], x[i], tol, "complex_3d inverse n=(%zu,%zu,%zu) i=%zu",
+                    n1, n2, n3, i);
+    }
+
+  gsl_fft_complex_3d_free (w);
+  free (x);
+  free (y);
+  free (z);
+}
+
+static void
+test_real_2d (const size_t n1, const size_t n2)
+{
+  const double tol = 1.0e-10;
+  const size_t h = n2 / 2 + 1;
+  gsl_matrix * A = gsl_matrix_alloc (n1, n2);
+  gsl_matrix * A2 = gsl_matrix_alloc (n1, n2);
+  gsl_matrix_complex * B = gsl_matrix_complex_alloc (n1, h);
+  double * x = calloc (2 * n1 * n2, sizeof (double));
+  double * y = malloc (2 * n1 * n2 * sizeof (double));
+  gsl_fft_real_2d_workspace * w = gsl_fft_real_2d_alloc (n1, n2);
+  size_t i, j;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          double a = urand () - 0.5;
+          gsl_matrix_set (A, i, j, a);
+          x[2 * (i * n2 + j)] = a;
+        }
+    }
+
+  test_multidim_dft (x, y, n1, n2, 1, gsl_fft_forward);
+  gsl_fft_real_2d_transform (A, B, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < h; ++j)
+        {
+          gsl_complex z = gsl_matrix_complex_get (B, i, j);
+
+          gsl_test_abs (GSL_REAL (z), y[2 * (i * n2 + j)], tol,
+                        "real_2d forward n1=%zu n2=%zu (%zu,%zu) real", n1, n2, i, j);
+          gsl_test_abs (GSL_IMAG (z), y[2 * (i * n2 + j) + 1], tol,
+                        "real_2d forward n1=%zu n2=%zu (%zu,%zu) imag", n1, n2, i, j);
+        }
+    }
+
+  gsl_fft_halfcomplex_2d_inverse (B, A2, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_test_abs (gsl_matrix_get (A2, i, j), gsl_matrix_get (A, i, j), tol,
+                        "halfcomplex_2d inverse n1=%zu n2=%zu (%zu,%zu)", n1, n2, i, j);
+        }
+    }
+
+  gsl_matrix_free (A);
+  gsl_matrix_free (A2);
+  gsl_matrix_complex_free (B);
+  gsl_fft_real_2d_free (w);
+  free (x);
+  free (y);
+}
+
+static void
+test_real_3d (const size_t n1, const size_t n2, const size_t n3)
+{
+  const double tol = 1.0e-10;
+  const size_t N = n1 * n2 * n3;
+  const size_t h = n3 / 2 + 1;
+  double * a = malloc (N * sizeof (double));
+  double * a2 = malloc (N * sizeof (double));
+  double * b = malloc (2 * n1 * n2 * h * sizeof (double));
+  double * x = calloc (2 * N, sizeof (double));
+  double * y = malloc (2 * N * sizeof (double));
+  gsl_fft_real_3d_workspace * w = gsl_fft_real_3d_alloc (n1, n2, n3);
+  size_t i, k;
+
+  for (i = 0; i < N; ++i)
+    {
+      a[i] = urand () - 0.5;
+      x[2 * i] = a[i];
+    }
+
+  test_multidim_dft (x, y, n1, n2, n3, gsl_fft_forward);
+  gsl_fft_real_3d_transform (a, b, w);
+
+  for (i = 0; i < n1 * n2; ++i)
+    {
+      for (k = 0; k < h; ++k)
+        {
+          gsl_test_abs (b[2 * (i * h + k)], y[2 * (i * n3 + k)], tol,
+                        "real_3d forward n=(%zu,%zu,%zu) i=%zu k=%zu real", n1, n2, n3, i, k);
+          gsl_test_abs (b[2 * (i * h + k) + 1], y[2 * (i * n3 + k) + 1], tol,
+                        "real_3d forward n=(%zu,%zu,%zu) i=%zu k=%zu imag", n1, n2, n3, i, k);
+        }
+    }
+
+  gsl_fft_halfcomplex_3d_inverse (b, a2, w);
+
+  for (i = 0; i < N; ++i)
+    {
+      gsl_test_abs (a2[i], a[i], tol, "halfcomplex_3d inverse n=(%zu,%zu,%zu) i=%zu",
+                    n1, n2, n3, i);
+    }
+
+  gsl_fft_real_3d_free (w);
+  free (a);
+  free (a2);
+  free (b);
+  free (x);
+  free (y);
+}
+
+static void
+test_multidim (void)
+{
+  size_t n1, n2;
+
+  for (n1 = 1; n1 <= 8; ++n1)
+    {
+      for (n2 = 1; n2 <= 8; ++n2)
+        {
+          test_complex_2d (n1, n2);
+          test_real_2d (n1, n2);
+        }
+    }
+
+  /* more columns than the block size */
+  test_complex_2d (5, 37);
+  test_real_2d (6, 40);
+
+  test_complex_3d (1, 1, 1);
+  test_complex_3d (2, 3, 4);
+  test_complex_3d (5, 4, 3);
+  test_complex_3d (3, 7, 6);
+
+  test_real_3d (1, 1, 1);
+  test_real_3d (2, 3, 4);
+  test_real_3d (5, 4, 3);
+  test_real_3d (3, 7, 6);
+  test_real_3d (4, 2, 7);
+}
@@ -24,6 +24,7 @@
 void FUNCTION(test_real,func) (size_t stride, size_t n);
 void FUNCTION(test_real,bitreverse_order) (size_t stride, size_t n);
 void FUNCTION(test_real,radix2) (size_t stride, size_t n);
+void FUNCTION(test_real,batch) (size_t stride, size_t n);
 
 void FUNCTION(test_real,func) (size_t stride, size_t n) 
 {
@@ -233,3 +234,66 @@ void FUNCTION(test_real,radix2) (size_t stride, size_t n)
   free(complex_tmp) ;
   free(fft_complex_data) ;
 }
+
+void FUNCTION(test_real,batch) (size_t stride, size_t n)
+{
+  const size_t howmany = 3;
+  const size_t distance = n * stride + 5;
+  const size_t len = distance * howmany;
+  size_t i, j ;
+  int status = 0 ;
+
+  TYPE(gsl_fft_real_wavetable) * rw = FUNCTION(gsl_fft_real_wavetable,alloc) (n);
+  TYPE(gsl_fft_halfcomplex_wavetable) * hcw = FUNCTION(gsl_fft_halfcomplex_wavetable,alloc) (n);
+  TYPE(gsl_fft_real_workspace) * rwork = FUNCTION(gsl_fft_real_workspace,alloc) (n);
+
+  BASE * batch_data = (BASE *) malloc (len * sizeof (BASE));
+  BASE * single_data = (BASE *) malloc (len * sizeof (BASE));
+
+  for (i = 0 ; i < len ; i++)
+    {
+      batch_data[i] = single_data[i] = (BASE)(urand () - 0.5) ;
+    }
+
+  /* batched real transform must match individual transforms exactly */
+
+  FUNCTION(gsl_fft_real,batch_transform) (batch_data, stride, distance, n, howmany, rw, rwork);
+
+  for (j = 0 ; j < howmany ; j++)
+    {
+      FUNCTION(gsl_fft_real,transform) (single_data + distance * j, stride, n, rw, rwork);
+    }
+
+  for (i = 0 ; i < len ; i++)
+    {
+      status |= (batch_data[i] != single_data[i]);
+    }
+
+  gsl_test (status, NAME(gsl_fft_real)
+            "_batch_transform, n = %d, stride = %d", n, stride);
+
+  /* batched halfcomplex inverse */
+
+  FUNCTION(gsl_fft_halfcomplex,batch_inverse) (batch_data, stride, distance, n, howmany, hcw, rwork);
+
+  for (j = 0 ; j < howmany ; j++)
+    {
+      FUNCTION(gsl_fft_halfcomplex,inverse) (single_data + distance * j, stride, n, hcw, rwork);
+    }
+
+  status = 0;
+  for (i = 0 ; i < len ; i++)
+    {
+      status |= (batch_data[i] != single_data[i]);
+    }
+
+  gsl_test (status, NAME(gsl_fft_halfcomplex)
+            "_batch_inverse, n = %d, stride = %d", n, stride);
+
+  FUNCTION(gsl_fft_real_workspace,free) (rwork);
+  FUNCTION(gsl_fft_real_wavetable,free) (rw);
+  FUNCTION(gsl_fft_halfcomplex_wavetable,free) (hcw);
+
+  free (batch_data) ;
+  free (single_data) ;
+}
@@ -150,6 +150,110 @@ gsl_filter_gaussian(const gsl_filter_end_t endtype, const double alpha, const si
     }
 }
 
+/*
+gsl_filter_gaussian_stream_alloc()
+  Allocate a stream for Gaussian filtering of a signal received in pieces
+
+Inputs: endtype - end point handling
+        alpha   - number of standard deviations to include in Gaussian kernel
+        order   - derivative order of Gaussian
+        K       - number of samples in window; if even, it is rounded up to
+                  the next odd, to have a symmetric window
+
+Return: pointer to stream
+
+Notes:
+1) The output lags the input by K / 2 samples
+*/
+
+gsl_filter_gaussian_stream *
+gsl_filter_gaussian_stream_alloc(const gsl_filter_end_t endtype, const double alpha, const size_t order,
+                                 const size_t K)
+{
+  const size_t H = K / 2;
+  gsl_filter_gaussian_stream *s;
+  gsl_vector_view kernel;
+  int status;
+
+  s = calloc(1, sizeof(gsl_filter_gaussian_stream));
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  s->K = 2 * H + 1;
+
+  s->kernel = malloc(s->K * sizeof(double));
+  if (s->kernel == 0)
+    {
+      gsl_filter_gaussian_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for kernel", GSL_ENOMEM);
+    }
+
+  kernel = gsl_vector_view_array(s->kernel, s->K);
+  status = gsl_filter_gaussian_kernel(alpha, order, 1, &kernel.vector);
+  if (status)
+    {
+      gsl_filter_gaussian_stream_free(s);
+      GSL_ERROR_NULL ("failed to compute Gaussian kernel", status);
+    }
+
+  s->movstat_stream_p = gsl_movstat_stream_alloc((gsl_movstat_end_t) endtype, &gaussian_accum_type,
+                                                 (void *) s->kernel, H, H);
+  if (!s->movstat_stream_p)
+    {
+      gsl_filter_gaussian_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for movstat stream", GSL_ENOMEM);
+    }
+
+  return s;
+}
+
+void
+gsl_filter_gaussian_stream_free(gsl_filter_gaussian_stream * s)
+{
+  if (s->kernel)
+    free(s->kernel);
+
+  if (s->movstat_stream_p)
+    gsl_movstat_stream_free(s->movstat_stream_p);
+
+  free(s);
+}
+
+int
+gsl_filter_gaussian_stream_reset(gsl_filter_gaussian_stream * s)
+{
+  return gsl_movstat_stream_reset(s->movstat_stream_p);
+}
+
+/*
+gsl_filter_gaussian_stream_push()
+  Apply the Gaussian filter to the next piece of a signal
+
+Inputs: x  - next samples of input signal
+        y  - (output) next samples of filtered signal, size >= x->size
+        ny - (output) number of samples stored in y
+        s  - stream
+
+Notes:
+1) The concatenated outputs of all pieces, followed by the output of
+gsl_filter_gaussian_stream_finish(), are identical to the output of
+gsl_filter_gaussian() applied to the whole signal
+*/
+
+int
+gsl_filter_gaussian_stream_push(const gsl_vector * x, gsl_vector * y, size_t * ny, gsl_filter_gaussian_stream * s)
+{
+  return gsl_movstat_stream_push(x, y, NULL, ny, s->movstat_stream_p);
+}
+
+int
+gsl_filter_gaussian_stream_finish(gsl_vector * y, size_t * ny, gsl_filter_gaussian_stream * s)
+{
+  return gsl_movstat_stream_finish(y, NULL, ny, s->movstat_stream_p);
+}
+
 /*
 gsl_filter_gaussian_kernel()
   Construct Gaussian kernel with given sigma and order
@@ -0,0 +1,400 @@
+/* filter/gaussiannd.c
+ *
+ * Separable Gaussian filters of images and volumes
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_filter.h>
+
+/* number of lines filtered together in the passes along strided dimensions */
+#define GAUSSIAN_ND_BLOCK 32
+
+static int gaussian_nd_kernel(const double alpha, const size_t order, gsl_filter_gaussian_nd_workspace * w);
+static void gaussian_nd_lines(const gsl_filter_end_t endtype, const size_t n, const size_t nb,
+                              const double * x, const size_t xstride, const size_t xcstride,
+                              double * y, const size_t ystride, const size_t ycstride,
+                              gsl_filter_gaussian_nd_workspace * w);
+static void gaussian_nd_pass(const gsl_filter_end_t endtype, const size_t n, const size_t nlines,
+                             const double * x, double * y, const size_t stride,
+                             gsl_filter_gaussian_nd_workspace * w);
+
+/*
+gsl_filter_gaussian_nd_alloc()
+  Allocate a workspace for Gaussian filtering of images and volumes
+
+Inputs: K    - number of samples in window along each dimension; if even,
+               it is rounded up to the next odd, to have a symmetric window
+        nmax - maximum number of samples along any dimension
+
+Return: pointer to workspace
+*/
+
+gsl_filter_gaussian_nd_workspace *
+gsl_filter_gaussian_nd_alloc(const size_t K, const size_t nmax)
+{
+  const size_t H = K / 2;
+  gsl_filter_gaussian_nd_workspace *w;
+
+  w = calloc(1, sizeof(gsl_filter_gaussian_nd_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->H = H;
+  w->K = 2 * H + 1;
+  w->nmax = nmax;
+
+  w->kernel = malloc(w->K * sizeof(double));
+  if (w->kernel == 0)
+    {
+      gsl_filter_gaussian_nd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for kernel", GSL_ENOMEM);
+    }
+
+  w->block = malloc(GAUSSIAN_ND_BLOCK * (nmax + 2 * H) * sizeof(double));
+  if (w->block == 0)
+    {
+      gsl_filter_gaussian_nd_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for block", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_filter_gaussian_nd_free(gsl_filter_gaussian_nd_workspace * w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->kernel)
+    free(w->kernel);
+
+  if (w->block)
+    free(w->block);
+
+  free(w);
+}
+
+/*
+gsl_filter_gaussian2d()
+  Apply a separable Gaussian filter to an image
+
+Inputs: endtype - end point handling
+        alpha   - number of standard deviations to include in Gaussian kernel
+        order1  - derivative order of Gaussian along columns (first index)
+        order2  - derivative order of Gaussian along rows (second index)
+        X       - input image, n1-by-n2
+        Y       - (output) filtered image, n1-by-n2
+        w       - workspace
+
+Return: success/error
+
+Notes:
+1) Each row of X is filtered with gsl_filter_gaussian(), and then each
+column of the result, so that the output agrees with the one dimensional
+filter applied along each dimension in turn
+
+2) The columns are filtered in blocks of GAUSSIAN_ND_BLOCK, which are
+copied into contiguous storage, so that the inner loop runs over
+consecutive elements of a row
+
+3) It is allowed to have X = Y
+*/
+
+int
+gsl_filter_gaussian2d(const gsl_filter_end_t endtype, const double alpha, const size_t order1,
+                      const size_t order2, const gsl_matrix * X, gsl_matrix * Y,
+                      gsl_filter_gaussian_nd_workspace * w)
+{
+  const size_t n1 = X->size1;
+  const size_t n2 = X->size2;
+
+  if (n1 != Y->size1 || n2 != Y->size2)
+    {
+      GSL_ERROR("input and output matrices must have same dimensions", GSL_EBADLEN);
+    }
+  else if (n1 > w->nmax || n2 > w->nmax)
+    {
+      GSL_ERROR("matrix dimension exceeds workspace size", GSL_EBADLEN);
+    }
+  else if (alpha <= 0.0)
+    {
+      GSL_ERROR("alpha must be positive", GSL_EDOM);
+    }
+  else
+    {
+      int status;
+      size_t i;
+
+      if (n1 == 0 || n2 == 0)
+        return GSL_SUCCESS;
+
+      /* filter rows */
+      status = gaussian_nd_kernel(alpha, order2, w);
+      if (status)
+        return status;
+
+      for (i = 0; i < n1; ++i)
+        {
+          gaussian_nd_lines(endtype, n2, 1, X->data + i * X->tda, 1, 1,
+                            Y->data + i * Y->tda, 1, 1, w);
+        }
+
+      /* filter columns in blocks */
+      status = gaussian_nd_kernel(alpha, order1, w);
+      if (status)
+        return status;
+
+      gaussian_nd_pass(endtype, n1, n2, Y->data, Y->data, Y->tda, w);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_filter_gaussian3d()
+  Apply a separable Gaussian filter to a volume
+
+Inputs: endtype - end point handling
+        alpha   - number of standard deviations to include in Gaussian kernel
+        order1  - derivative order of Gaussian along first dimension
+        order2  - derivative order of Gaussian along second dimension
+        order3  - derivative order of Gaussian along third dimension
+        x       - input volume; element (i,j,k) is x[i*stride1 + j*stride2 + k]
+        y       - (output) filtered volume, with the same layout as x
+        n1      - number of samples along first dimension
+        n2      - number of samples along second dimension
+        n3      - number of samples along third dimension
+        stride1 - distance between consecutive samples along first dimension
+        stride2 - distance between consecutive samples along second dimension
+        w       - workspace
+
+Return: success/error
+
+Notes:
+1) The volume is filtered along the third dimension, then the second,
+then the first. The passes along the first and second dimensions filter
+blocks of GAUSSIAN_ND_BLOCK lines at a time
+
+2) The strides allow x and y to be subvolumes of larger arrays; they must
+satisfy stride2 >= n3 and stride1 >= n2 * stride2
+
+3) It is allowed to have x = y
+*/
+
+int
+gsl_filter_gaussian3d(const gsl_filter_end_t endtype, const double alpha, const size_t order1,
+                      const size_t order2, const size_t order3, const double * x, double * y,
+                      const size_t n1, const size_t n2, const size_t n3,
+                      const size_t stride1, const size_t stride2,
+                      gsl_filter_gaussian_nd_workspace * w)
+{
+  if (stride2 < n3 || stride1 < n2 * stride2)
+    {
+      GSL_ERROR("strides are too small for volume dimensions", GSL_EINVAL);
+    }
+  else if (n1 > w->nmax || n2 > w->nmax || n3 > w->nmax)
+    {
+      GSL_ERROR("volume dimension exceeds workspace size", GSL_EBADLEN);
+    }
+  else if (alpha <= 0.0)
+    {
+      GSL_ERROR("alpha must be positive", GSL_EDOM);
+    }
+  else
+    {
+      int status;
+      size_t i, j;
+
+      if (n1 == 0 || n2 == 0 || n3 == 0)
+        return GSL_SUCCESS;
+
+      /* filter along third dimension */
+      status = gaussian_nd_kernel(alpha, order3, w);
+      if (status)
+        return status;
+
+      for (i = 0; i < n1; ++i)
+        {
+          for (j = 0; j < n2; ++j)
+            {
+              const size_t offset = i * stride1 + j * stride2;
+              gaussian_nd_lines(endtype, n3, 1, x + offset, 1, 1, y + offset, 1, 1, w);
+            }
+        }
+
+      /* filter along second dimension, one n2-by-n3 slice at a time */
+      status = gaussian_nd_kernel(alpha, order2, w);
+      if (status)
+        return status;
+
+      for (i = 0; i < n1; ++i)
+        gaussian_nd_pass(endtype, n2, n3, y + i * stride1, y + i * stride1, stride2, w);
+
+      /* filter along first dimension, one n1-by-n3 slice at a time */
+      status = gaussian_nd_kernel(alpha, order1, w);
+      if (status)
+        return status;
+
+      for (j = 0; j < n2; ++j)
+        gaussian_nd_pass(endtype, n1, n3, y + j * stride2, y + j * stride2, stride1, w);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* construct the Gaussian kernel of given derivative order in w->kernel */
+
+static int
+gaussian_nd_kernel(const double alpha, const size_t order, gsl_filter_gaussian_nd_workspace * w)
+{
+  gsl_vector_view kernel = gsl_vector_view_array(w->kernel, w->K);
+  return gsl_filter_gaussian_kernel(alpha, order, 1, &kernel.vector);
+}
+
+/*
+gaussian_nd_pass()
+  Filter the columns of an n-by-nlines array, whose element (i,c) is
+stored at x[i*stride + c], in blocks of GAUSSIAN_ND_BLOCK columns
+*/
+
+static void
+gaussian_nd_pass(const gsl_filter_end_t endtype, const size_t n, const size_t nlines,
+                 const double * x, double * y, const size_t stride,
+                 gsl_filter_gaussian_nd_workspace * w)
+{
+  size_t c;
+
+  for (c = 0; c < nlines; c += GAUSSIAN_ND_BLOCK)
+    {
+      const size_t nb = GSL_MIN(GAUSSIAN_ND_BLOCK, nlines - c);
+      gaussian_nd_lines(endtype, n, nb, x + c, stride, 1, y + c, stride, 1, w);
+    }
+}
+
+/*
+gaussian_nd_lines()
+  Filter nb lines of length n with the kernel in w->kernel
+
+Inputs: endtype  - end point handling
+        n        - number of samples in each line
+        nb       - number of lines, nb <= GAUSSIAN_ND_BLOCK
+        x        - input; sample i of line c is x[i*xstride + c*xcstride]
+        xstride  - distance between samples of a line in x
+        xcstride - distance between lines in x
+        y        - (output) filtered lines, stored in the same way as x
+        ystride  - distance between samples of a line in y
+        ycstride - distance between lines in y
+        w        - workspace
+
+Notes:
+1) The lines are first copied into w->block, with sample i of line c
+stored in block[(i + H)*nb + c] and H padding samples at each end, so
+x and y may be the same array
+
+2) Each output is computed with the same operations, in the same order,
+as gsl_filter_gaussian(). In particular, a window truncated to the
+samples x(a:b) is weighted by the first b - a + 1 kernel coefficients
+*/
+
+static void
+gaussian_nd_lines(const gsl_filter_end_t endtype, const size_t n, const size_t nb,
+                  const double * x, const size_t xstride, const size_t xcstride,
+                  double * y, const size_t ystride, const size_t ycstride,
+                  gsl_filter_gaussian_nd_workspace * w)
+{
+  const size_t H = w->H;
+  const size_t K = w->K;
+  const double * kernel = w->kernel;
+  double * block = w->block;
+  double sum[GAUSSIAN_ND_BLOCK];
+  size_t i, c, t;
+
+  for (i = 0; i < n; ++i)
+    {
+      for (c = 0; c < nb; ++c)
+        block[(i + H) * nb + c] = x[i * xstride + c * xcstride];
+    }
+
+  /* pad both ends */
+  for (i = 0; i < H; ++i)
+    {
+      for (c = 0; c < nb; ++c)
+        {
+          if (endtype == GSL_FILTER_END_PADVALUE)
+            {
+              block[i * nb + c] = block[H * nb + c];
+              block[(n + H + i) * nb + c] = block[(n + H - 1) * nb + c];
+            }
+          else
+            {
+              block[i * nb + c] = 0.0;
+              block[(n + H + i) * nb + c] = 0.0;
+            }
+        }
+    }
+
+  for (i = 0; i < n; ++i)
+    {
+      if (endtype == GSL_FILTER_END_TRUNCATE && (i < H || i + H >= n))
+        {
+          /* window truncated to samples a, ..., b */
+          const size_t a = (i > H) ? i - H : 0;
+          const size_t b = GSL_MIN(i + H, n - 1);
+          const size_t m = b - a + 1;
+
+          for (c = 0; c < nb; ++c)
+            sum[c] = 0.0;
+
+          for (t = 0; t < m; ++t)
+            {
+              const double kt = kernel[m - t - 1];
+              const double * row = block + (a + t + H) * nb;
+
+              for (c = 0; c < nb; ++c)
+                sum[c] += row[c] * kt;
+            }
+        }
+      else
+        {
+          for (c = 0; c < nb; ++c)
+            sum[c] = 0.0;
+
+          for (t = 0; t < K; ++t)
+            {
+              const double kt = kernel[K - t - 1];
+              const double * row = block + (i + t) * nb;
+
+              for (c = 0; c < nb; ++c)
+                sum[c] += row[c] * kt;
+            }
+        }
+
+      for (c = 0; c < nb; ++c)
+        y[i * ystride + c * ycstride] = sum[c];
+    }
+}
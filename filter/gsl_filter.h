@@ -22,6 +22,7 @@
 
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_movstat.h>
 
 #undef __BEGIN_DECLS
@@ -67,6 +68,54 @@ int gsl_filter_gaussian(const gsl_filter_end_t endtype, const double alpha, cons
                         gsl_vector * y, gsl_filter_gaussian_workspace * w);
 int gsl_filter_gaussian_kernel(const double alpha, const size_t order, const int normalize, gsl_vector * kernel);
 
+/* stream for Gaussian filter of signals received in pieces */
+typedef struct
+{
+  size_t K;        /* window size */
+  double *kernel;  /* Gaussian kernel, size K */
+  gsl_movstat_stream *movstat_stream_p;
+} gsl_filter_gaussian_stream;
+
+gsl_filter_gaussian_stream *gsl_filter_gaussian_stream_alloc(const gsl_filter_end_t endtype, const double alpha,
+                                                             const size_t order, const size_t K);
+void gsl_filter_gaussian_stream_free(gsl_filter_gaussian_stream * s);
+int gsl_filter_gaussian_stream_reset(gsl_filter_gaussian_stream * s);
+int gsl_filter_gaussian_stream_push(const gsl_vector * x, gsl_vector * y, size_t * ny, gsl_filter_gaussian_stream * s);
+int gsl_filter_gaussian_stream_finish(gsl_vector * y, size_t * ny, gsl_filter_gaussian_stream * s);
+
+/* workspace for recursive Gaussian filter */
+typedef struct
+{
+  size_t n;        /* maximum input length */
+  double *work;    /* workspace, size 5n */
+} gsl_filter_rgaussian_workspace;
+
+gsl_filter_rgaussian_workspace *gsl_filter_rgaussian_alloc(const size_t n);
+void gsl_filter_rgaussian_free(gsl_filter_rgaussian_workspace * w);
+int gsl_filter_rgaussian(const gsl_filter_end_t endtype, const double sigma, const size_t order,
+                         const gsl_vector * x, gsl_vector * y, gsl_filter_rgaussian_workspace * w);
+
+/* workspace for separable Gaussian filters of images and volumes */
+typedef struct
+{
+  size_t H;        /* window half-length (K / 2) */
+  size_t K;        /* window size along each dimension */
+  size_t nmax;     /* maximum number of samples along each dimension */
+  double *kernel;  /* Gaussian kernel, size K */
+  double *block;   /* block of padded lines */
+} gsl_filter_gaussian_nd_workspace;
+
+gsl_filter_gaussian_nd_workspace *gsl_filter_gaussian_nd_alloc(const size_t K, const size_t nmax);
+void gsl_filter_gaussian_nd_free(gsl_filter_gaussian_nd_workspace * w);
+int gsl_filter_gaussian2d(const gsl_filter_end_t endtype, const double alpha, const size_t order1,
+                          const size_t order2, const gsl_matrix * X, gsl_matrix * Y,
+                          gsl_filter_gaussian_nd_workspace * w);
+int gsl_filter_gaussian3d(const gsl_filter_end_t endtype, const double alpha, const size_t order1,
+                          const size_t order2, const size_t order3, const double * x, double * y,
+                          const size_t n1, const size_t n2, const size_t n3,
+                          const size_t stride1, const size_t stride2,
+                          gsl_filter_gaussian_nd_workspace * w);
+
 /* workspace for standard median filter */
 typedef struct
 {
@@ -77,6 +126,42 @@ gsl_filter_median_workspace *gsl_filter_median_alloc(const size_t K);
 void gsl_filter_median_free(gsl_filter_median_workspace * w);
 int gsl_filter_median(const gsl_filter_end_t endtype, const gsl_vector * x, gsl_vector * y, gsl_filter_median_workspace * w);
 
+/* stream for standard median filter */
+typedef struct
+{
+  gsl_movstat_stream *movstat_stream_p;
+} gsl_filter_median_stream;
+
+gsl_filter_median_stream *gsl_filter_median_stream_alloc(const gsl_filter_end_t endtype, const size_t K);
+void gsl_filter_median_stream_free(gsl_filter_median_stream * s);
+int gsl_filter_median_stream_reset(gsl_filter_median_stream * s);
+int gsl_filter_median_stream_push(const gsl_vector * x, gsl_vector * y, size_t * ny, gsl_filter_median_stream * s);
+int gsl_filter_median_stream_finish(gsl_vector * y, size_t * ny, gsl_filter_median_stream * s);
+
+/* workspace for median filter of images */
+typedef struct
+{
+  size_t H;                /* window half-length (K / 2) */
+  size_t K;                /* window size along each dimension */
+  double *window;          /* window of double image, size K*K */
+  size_t nbits;            /* bits per pixel of allocated histograms, 0 if not yet allocated */
+  unsigned short *hist;    /* column histograms of integer image */
+  unsigned short *coarse;  /* coarse column histograms */
+  unsigned short *count;   /* number of samples in each column histogram */
+  unsigned int *khist;     /* window histogram */
+  unsigned int *kcoarse;   /* coarse window histogram */
+  long *updated;           /* column at which fine bins of window histogram were updated */
+} gsl_filter_median2d_workspace;
+
+gsl_filter_median2d_workspace *gsl_filter_median2d_alloc(const size_t K);
+void gsl_filter_median2d_free(gsl_filter_median2d_workspace * w);
+int gsl_filter_median2d(const gsl_filter_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                        gsl_filter_median2d_workspace * w);
+int gsl_filter_median2d_uchar(const gsl_filter_end_t endtype, const gsl_matrix_uchar * X, gsl_matrix_uchar * Y,
+                              gsl_filter_median2d_workspace * w);
+int gsl_filter_median2d_ushort(const gsl_filter_end_t endtype, const gsl_matrix_ushort * X, gsl_matrix_ushort * Y,
+                               gsl_filter_median2d_workspace * w);
+
 /* workspace for recursive median filter */
 typedef struct
 {
@@ -92,6 +177,25 @@ gsl_filter_rmedian_workspace *gsl_filter_rmedian_alloc(const size_t K);
 void gsl_filter_rmedian_free(gsl_filter_rmedian_workspace * w);
 int gsl_filter_rmedian(const gsl_filter_end_t, const gsl_vector * x, gsl_vector * y, gsl_filter_rmedian_workspace * w);
 
+/* stream for recursive median filter */
+typedef struct
+{
+  gsl_filter_end_t endtype;            /* end point handling */
+  size_t H;                            /* window half-length (K / 2) */
+  size_t K;                            /* window size */
+  size_t n;                            /* number of samples received */
+  double yprev;                        /* previous filter output */
+  double *xfirst;                      /* first H + 1 samples, size H + 1 */
+  double *window;                      /* array holding first window, size K */
+  gsl_movstat_stream *movstat_stream_p;
+} gsl_filter_rmedian_stream;
+
+gsl_filter_rmedian_stream *gsl_filter_rmedian_stream_alloc(const gsl_filter_end_t endtype, const size_t K);
+void gsl_filter_rmedian_stream_free(gsl_filter_rmedian_stream * s);
+int gsl_filter_rmedian_stream_reset(gsl_filter_rmedian_stream * s);
+int gsl_filter_rmedian_stream_push(const gsl_vector * x, gsl_vector * y, size_t * ny, gsl_filter_rmedian_stream * s);
+int gsl_filter_rmedian_stream_finish(gsl_vector * y, size_t * ny, gsl_filter_rmedian_stream * s);
+
 typedef struct
 {
   gsl_movstat_workspace *movstat_workspace_p;
@@ -103,6 +207,32 @@ int gsl_filter_impulse(const gsl_filter_end_t endtype, const gsl_filter_scale_t
                        const gsl_vector * x, gsl_vector * y, gsl_vector * xmedian, gsl_vector * xsigma, size_t * noutlier,
                        gsl_vector_int * ioutlier, gsl_filter_impulse_workspace * w);
 
+/* stream for impulse detection filter */
+typedef struct
+{
+  gsl_filter_scale_t scale_type;         /* statistic used for scale estimate */
+  double t;                              /* number of standard deviations for outliers */
+  double scale;                          /* factor to estimate standard deviation from scale statistic */
+  double scale_params;                   /* parameter for scale accumulator */
+  size_t K;                              /* window size */
+  size_t n;                              /* number of samples received */
+  size_t nout;                           /* number of samples output */
+  double *xhist;                         /* last K samples received, size K */
+  gsl_movstat_stream *median_stream_p;   /* window medians; NULL for MAD */
+  gsl_movstat_stream *scale_stream_p;    /* window scale estimates */
+} gsl_filter_impulse_stream;
+
+gsl_filter_impulse_stream *gsl_filter_impulse_stream_alloc(const gsl_filter_end_t endtype, const gsl_filter_scale_t scale_type,
+                                                           const double t, const size_t K);
+void gsl_filter_impulse_stream_free(gsl_filter_impulse_stream * s);
+int gsl_filter_impulse_stream_reset(gsl_filter_impulse_stream * s);
+int gsl_filter_impulse_stream_push(const gsl_vector * x, gsl_vector * y, gsl_vector * xmedian, gsl_vector * xsigma,
+                                   size_t * ny, size_t * noutlier, gsl_vector_int * ioutlier,
+                                   gsl_filter_impulse_stream * s);
+int gsl_filter_impulse_stream_finish(gsl_vector * y, gsl_vector * xmedian, gsl_vector * xsigma,
+                                     size_t * ny, size_t * noutlier, gsl_vector_int * ioutlier,
+                                     gsl_filter_impulse_stream * s);
+
 __END_DECLS
 
 #endif /* __GSL_FILTER_H__ */
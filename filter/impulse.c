@@ -29,6 +29,11 @@
 
 static int filter_impulse(const double scale, const double epsilon, const double t, const gsl_vector * x, const gsl_vector * xmedian,
                           gsl_vector * y, gsl_vector * xsigma, size_t * noutlier, gsl_vector_int * ioutlier);
+static int impulse_sample(const double scale, const double epsilon, const double t, const double xi, const double xmedi,
+                          double * xsigmai, double * yi);
+static int impulse_stream_output(const size_t n, const size_t absorb, const gsl_vector * x, gsl_vector * y,
+                                 const gsl_vector * xmedian, gsl_vector * xsigma, size_t * noutlier,
+                                 gsl_vector_int * ioutlier, gsl_filter_impulse_stream * s);
  
 /*
 gsl_filter_impulse_alloc()
@@ -186,6 +191,312 @@ gsl_filter_impulse(const gsl_filter_end_t endtype, const gsl_filter_scale_t scal
     }
 }
 
+/*
+gsl_filter_impulse_stream_alloc()
+  Allocate a stream for impulse detection filtering of a signal received
+in pieces
+
+Inputs: endtype    - how to handle signal end points
+        scale_type - which statistic to use for scale estimate (MAD, IQR, etc)
+        t          - number of standard deviations required to identity outliers (>= 0)
+        K          - number of samples in window; if even, it is rounded up to
+                     the next odd, to have a symmetric window
+
+Return: pointer to stream
+
+Notes:
+1) The output lags the input by K / 2 samples
+*/
+
+gsl_filter_impulse_stream *
+gsl_filter_impulse_stream_alloc(const gsl_filter_end_t endtype, const gsl_filter_scale_t scale_type,
+                                const double t, const size_t K)
+{
+  const gsl_movstat_end_t etype = (gsl_movstat_end_t) endtype;
+  const size_t H = K / 2;
+  gsl_filter_impulse_stream *s;
+
+  if (t < 0.0)
+    {
+      GSL_ERROR_NULL("t must be non-negative", GSL_EDOM);
+    }
+
+  s = calloc(1, sizeof(gsl_filter_impulse_stream));
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  s->scale_type = scale_type;
+  s->t = t;
+  s->K = 2 * H + 1;
+
+  s->xhist = malloc(s->K * sizeof(double));
+  if (s->xhist == 0)
+    {
+      gsl_filter_impulse_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for samples", GSL_ENOMEM);
+    }
+
+  switch (scale_type)
+    {
+      case GSL_FILTER_SCALE_MAD:
+        /* the MAD accumulator computes both the window medians and MADs */
+        s->scale = 1.0;
+        s->scale_params = 1.482602218505602;
+        s->scale_stream_p = gsl_movstat_stream_alloc(etype, gsl_movstat_accum_mad, &(s->scale_params), H, H);
+        break;
+
+      case GSL_FILTER_SCALE_IQR:
+        /* multiplication factor for IQR to estimate stddev for Gaussian signal */
+        s->scale = 0.741301109252801;
+        s->scale_params = 0.25;
+        s->scale_stream_p = gsl_movstat_stream_alloc(etype, gsl_movstat_accum_qqr, &(s->scale_params), H, H);
+        break;
+
+      case GSL_FILTER_SCALE_SN:
+        s->scale = 1.0;
+        s->scale_stream_p = gsl_movstat_stream_alloc(etype, gsl_movstat_accum_Sn, NULL, H, H);
+        break;
+
+      case GSL_FILTER_SCALE_QN:
+        s->scale = 1.0;
+        s->scale_stream_p = gsl_movstat_stream_alloc(etype, gsl_movstat_accum_Qn, NULL, H, H);
+        break;
+
+      default:
+        gsl_filter_impulse_stream_free(s);
+        GSL_ERROR_NULL("unknown scale type", GSL_EDOM);
+        break;
+    }
+
+  if (s->scale_stream_p == 0)
+    {
+      gsl_filter_impulse_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for movstat stream", GSL_ENOMEM);
+    }
+
+  if (scale_type != GSL_FILTER_SCALE_MAD)
+    {
+      s->median_stream_p = gsl_movstat_stream_alloc(etype, gsl_movstat_accum_median, NULL, H, H);
+      if (s->median_stream_p == 0)
+        {
+          gsl_filter_impulse_stream_free(s);
+          GSL_ERROR_NULL ("failed to allocate space for movstat stream", GSL_ENOMEM);
+        }
+    }
+
+  s->n = 0;
+  s->nout = 0;
+
+  return s;
+}
+
+void
+gsl_filter_impulse_stream_free(gsl_filter_impulse_stream * s)
+{
+  if (s->xhist)
+    free(s->xhist);
+
+  if (s->median_stream_p)
+    gsl_movstat_stream_free(s->median_stream_p);
+
+  if (s->scale_stream_p)
+    gsl_movstat_stream_free(s->scale_stream_p);
+
+  free(s);
+}
+
+int
+gsl_filter_impulse_stream_reset(gsl_filter_impulse_stream * s)
+{
+  s->n = 0;
+  s->nout = 0;
+
+  if (s->median_stream_p)
+    gsl_movstat_stream_reset(s->median_stream_p);
+
+  return gsl_movstat_stream_reset(s->scale_stream_p);
+}
+
+/*
+gsl_filter_impulse_stream_push()
+  Apply the impulse detection filter to the next piece of a signal
+
+Inputs: x        - next samples of input signal
+        y        - (output) next samples of filtered signal, size >= x->size
+        xmedian  - (output) next window medians, size >= x->size
+        xsigma   - (output) next estimated local standard deviations, size >= x->size
+        ny       - (output) number of samples stored in y, xmedian, xsigma
+        noutlier - (output) number of outliers detected in this piece
+        ioutlier - (output) boolean array indicating outliers identified, size >= x->size; may be NULL
+        s        - stream
+
+Notes:
+1) It is allowed to have x = y, but xmedian and xsigma must not overlap x
+*/
+
+int
+gsl_filter_impulse_stream_push(const gsl_vector * x, gsl_vector * y, gsl_vector * xmedian, gsl_vector * xsigma,
+                               size_t * ny, size_t * noutlier, gsl_vector_int * ioutlier,
+                               gsl_filter_impulse_stream * s)
+{
+  const size_t m = x->size;
+
+  if (y->size < m)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else if (xmedian->size < m)
+    {
+      GSL_ERROR("xmedian vector is too short", GSL_EBADLEN);
+    }
+  else if (xsigma->size < m)
+    {
+      GSL_ERROR("xsigma vector is too short", GSL_EBADLEN);
+    }
+  else if ((ioutlier != NULL) && (ioutlier->size < m))
+    {
+      GSL_ERROR("ioutlier vector is too short", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      if (s->scale_type == GSL_FILTER_SCALE_MAD)
+        {
+          status = gsl_movstat_stream_push(x, xmedian, xsigma, ny, s->scale_stream_p);
+        }
+      else
+        {
+          status = gsl_movstat_stream_push(x, xmedian, NULL, ny, s->median_stream_p);
+          if (status)
+            return status;
+
+          status = gsl_movstat_stream_push(x, xsigma, NULL, ny, s->scale_stream_p);
+        }
+
+      if (status)
+        return status;
+
+      return impulse_stream_output(*ny, m, x, y, xmedian, xsigma, noutlier, ioutlier, s);
+    }
+}
+
+/*
+gsl_filter_impulse_stream_finish()
+  Compute the final samples of the filtered signal and reset the stream
+
+Inputs: y        - (output) final samples of filtered signal, size >= K / 2
+        xmedian  - (output) final window medians, size >= K / 2
+        xsigma   - (output) final estimated local standard deviations, size >= K / 2
+        ny       - (output) number of samples stored in y, xmedian, xsigma
+        noutlier - (output) number of outliers detected in the final samples
+        ioutlier - (output) boolean array indicating outliers identified, size >= K / 2; may be NULL
+        s        - stream
+*/
+
+int
+gsl_filter_impulse_stream_finish(gsl_vector * y, gsl_vector * xmedian, gsl_vector * xsigma,
+                                 size_t * ny, size_t * noutlier, gsl_vector_int * ioutlier,
+                                 gsl_filter_impulse_stream * s)
+{
+  const size_t nout = s->n - s->nout;
+
+  if (y->size < nout)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else if ((ioutlier != NULL) && (ioutlier->size < nout))
+    {
+      GSL_ERROR("ioutlier vector is too short", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      if (s->scale_type == GSL_FILTER_SCALE_MAD)
+        {
+          status = gsl_movstat_stream_finish(xmedian, xsigma, ny, s->scale_stream_p);
+        }
+      else
+        {
+          status = gsl_movstat_stream_finish(xmedian, NULL, ny, s->median_stream_p);
+          if (status)
+            return status;
+
+          status = gsl_movstat_stream_finish(xsigma, NULL, ny, s->scale_stream_p);
+        }
+
+      if (status)
+        return status;
+
+      status = impulse_stream_output(*ny, 0, NULL, y, xmedian, xsigma, noutlier, ioutlier, s);
+      if (status)
+        return status;
+
+      return gsl_filter_impulse_stream_reset(s);
+    }
+}
+
+/*
+impulse_stream_output()
+  Apply the impulse detection test to the next 'n' output samples of a
+stream, while saving the next 'absorb' input samples
+
+Inputs: n        - number of output samples
+        absorb   - number of input samples in x
+        x        - input samples; can be NULL if absorb = 0
+        y        - (output) filtered samples, size >= n
+        xmedian  - window medians, size >= n
+        xsigma   - on input, window scale estimates; on output, estimated
+                   standard deviations, size >= n
+        noutlier - (output) number of outliers detected
+        ioutlier - (output) boolean array indicating outliers identified; may be NULL
+        s        - stream
+
+Notes:
+1) Output sample j depends on input samples up to x_{j+H}, so sample x_j
+is saved before y_j is written, which allows x = y
+*/
+
+static int
+impulse_stream_output(const size_t n, const size_t absorb, const gsl_vector * x, gsl_vector * y,
+                      const gsl_vector * xmedian, gsl_vector * xsigma, size_t * noutlier,
+                      gsl_vector_int * ioutlier, gsl_filter_impulse_stream * s)
+{
+  size_t j;
+
+  *noutlier = 0;
+
+  for (j = 0; j < GSL_MAX(n, absorb); ++j)
+    {
+      if (j < absorb)
+        {
+          s->xhist[s->n % s->K] = gsl_vector_get(x, j);
+          ++(s->n);
+        }
+
+      if (j < n)
+        {
+          double xi = s->xhist[s->nout % s->K];
+          double yj;
+          int outlier = impulse_sample(s->scale, 0.0, s->t, xi, gsl_vector_get(xmedian, j),
+                                       gsl_vector_ptr(xsigma, j), &yj);
+
+          gsl_vector_set(y, j, yj);
+          *noutlier += outlier;
+
+          if (ioutlier)
+            gsl_vector_int_set(ioutlier, j, outlier);
+
+          ++(s->nout);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
 /*
 filter_impulse()
   Apply an impulse detection filter to an input vector. The filter output is
@@ -250,34 +561,58 @@ filter_impulse(const double scale, const double epsilon, const double t, const g
       /* build output vector */
       for (i = 0; i < n; ++i)
         {
-          double xi = gsl_vector_get(x, i);
-          double xmedi = gsl_vector_get(xmedian, i);
-          double absdevi = fabs(xi - xmedi); /* absolute deviation for this sample */
-          double *xsigmai = gsl_vector_ptr(xsigma, i);
-
-          /* multiply by scale factor to get estimate of standard deviation */
-          *xsigmai *= scale;
-
-          /*
-           * If the absolute deviation for this sample is more than t stddevs
-           * for this window (and S_i is sufficiently large to avoid scale implosion),
-           * set the output value to the window median, otherwise use the original sample
-           */
-          if ((*xsigmai >= epsilon) && (absdevi > t * (*xsigmai)))
-            {
-              gsl_vector_set(y, i, xmedi);
-              ++(*noutlier);
-              if (ioutlier)
-                gsl_vector_int_set(ioutlier, i, 1);
-            }
-          else
-            {
-              gsl_vector_set(y, i, xi);
-              if (ioutlier)
-                gsl_vector_int_set(ioutlier, i, 0);
-            }
+          double yi;
+          int outlier = impulse_sample(scale, epsilon, t, gsl_vector_get(x, i), gsl_vector_get(xmedian, i),
+                                       gsl_vector_ptr(xsigma, i), &yi);
+
+          gsl_vector_set(y, i, yi);
+          *noutlier += outlier;
+
+          if (ioutlier)
+            gsl_vector_int_set(ioutlier, i, outlier);
         }
 
       return GSL_SUCCESS;
     }
 }
+
+/*
+impulse_sample()
+  Apply the impulse detection test to a single sample
+
+Inputs: scale   - scale factor to multiply xsigma to get unbiased estimate of stddev for Gaussian data
+        epsilon - minimum allowed scale estimate for identifying outliers
+        t       - number of standard deviations required to identity outliers (>= 0)
+        xi      - input sample
+        xmedi   - median of window centered on xi
+        xsigmai - on input, scale estimate of window; on output, estimated standard deviation
+        yi      - (output) filtered sample
+
+Return: 1 if xi is an outlier, 0 otherwise
+*/
+
+static int
+impulse_sample(const double scale, const double epsilon, const double t, const double xi, const double xmedi,
+               double * xsigmai, double * yi)
+{
+  double absdevi = fabs(xi - xmedi); /* absolute deviation for this sample */
+
+  /* multiply by scale factor to get estimate of standard deviation */
+  *xsigmai *= scale;
+
+  /*
+   * If the absolute deviation for this sample is more than t stddevs
+   * for this window (and S_i is sufficiently large to avoid scale implosion),
+   * set the output value to the window median, otherwise use the original sample
+   */
+  if ((*xsigmai >= epsilon) && (absdevi > t * (*xsigmai)))
+    {
+      *yi = xmedi;
+      return 1;
+    }
+  else
+    {
+      *yi = xi;
+      return 0;
+    }
+}
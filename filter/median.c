@@ -75,3 +75,86 @@ gsl_filter_median(const gsl_filter_end_t endtype, const gsl_vector * x, gsl_vect
   int status = gsl_movstat_median(endtype, x, y, w->movstat_workspace_p);
   return status;
 }
+
+/*
+gsl_filter_median_stream_alloc()
+  Allocate a stream for the standard median filter of a signal received
+in pieces
+
+Inputs: endtype - end point handling
+        K       - number of samples in window; if even, it is rounded up to
+                  the next odd, to have a symmetric window
+
+Return: pointer to stream
+
+Notes:
+1) The output lags the input by K / 2 samples
+*/
+
+gsl_filter_median_stream *
+gsl_filter_median_stream_alloc(const gsl_filter_end_t endtype, const size_t K)
+{
+  gsl_filter_median_stream *s;
+  size_t H = K / 2;
+
+  s = calloc(1, sizeof(gsl_filter_median_stream));
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  s->movstat_stream_p = gsl_movstat_stream_alloc((gsl_movstat_end_t) endtype, gsl_movstat_accum_median, NULL, H, H);
+  if (s->movstat_stream_p == NULL)
+    {
+      gsl_filter_median_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for movstat stream", GSL_ENOMEM);
+    }
+
+  return s;
+}
+
+void
+gsl_filter_median_stream_free(gsl_filter_median_stream * s)
+{
+  if (s->movstat_stream_p)
+    gsl_movstat_stream_free(s->movstat_stream_p);
+
+  free(s);
+}
+
+int
+gsl_filter_median_stream_reset(gsl_filter_median_stream * s)
+{
+  return gsl_movstat_stream_reset(s->movstat_stream_p);
+}
+
+/*
+gsl_filter_median_stream_push()
+  Apply the median filter to the next piece of a signal
+
+Inputs: x  - next samples of input signal
+        y  - (output) next samples of filtered signal, size >= x->size
+        ny - (output) number of samples stored in y
+        s  - stream
+*/
+
+int
+gsl_filter_median_stream_push(const gsl_vector * x, gsl_vector * y, size_t * ny, gsl_filter_median_stream * s)
+{
+  return gsl_movstat_stream_push(x, y, NULL, ny, s->movstat_stream_p);
+}
+
+/*
+gsl_filter_median_stream_finish()
+  Compute the final samples of the filtered signal and reset the stream
+
+Inputs: y  - (output) final samples of filtered signal, size >= K / 2
+        ny - (output) number of samples stored in y
+        s  - stream
+*/
+
+int
+gsl_filter_median_stream_finish(gsl_vector * y, size_t * ny, gsl_filter_median_stream * s)
+{
+  return gsl_movstat_stream_finish(y, NULL, ny, s->movstat_stream_p);
+}
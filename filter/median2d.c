@@ -0,0 +1,664 @@
+/* filter/median2d.c
+ *
+ * Median filters of images
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Images of doubles are filtered by sorting the K-by-K window of each
+ * pixel. For K = 3 and K = 5, the median of the window is found with a
+ * fixed network of compare-exchange operations; for larger windows, with
+ * gsl_stats_median().
+ *
+ * Images of 8 and 16 bit integers are filtered with the constant time
+ * algorithm of
+ *
+ * [1] S. Perreault and P. Hebert, Median Filtering in Constant Time,
+ * IEEE Transactions on Image Processing, 16(9), 2007.
+ *
+ * A histogram of the K samples in each column of the window is kept, and
+ * moved down one row per output row by removing one sample and adding
+ * one. The histogram of the window is moved along a row by adding the
+ * column histogram which enters the window and subtracting the one which
+ * leaves it. Histograms have two levels: coarse bins of the high half of
+ * the bits, which are updated for every pixel, and fine bins of all the
+ * bits, which are only brought up to date for the coarse bin containing
+ * the median. The cost per pixel is therefore independent of K. The image
+ * is processed in strips of MEDIAN2D_STRIP columns, so that the
+ * column histograms of a strip fit in the cache.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_statistics.h>
+#include <gsl/gsl_filter.h>
+
+/* number of output columns in a strip */
+#define MEDIAN2D_STRIP    32
+
+static int median2d_hist_alloc(const size_t nbits, gsl_filter_median2d_workspace * w);
+static void median2d_hist_free(gsl_filter_median2d_workspace * w);
+static int median2d_hist(const gsl_filter_end_t endtype, const size_t nbits, const void * x,
+                         const size_t xtda, void * y, const size_t ytda, const size_t n1,
+                         const size_t n2, gsl_filter_median2d_workspace * w);
+static int median2d_value(const gsl_filter_end_t endtype, const size_t nbits, const void * x,
+                          const size_t tda, const size_t n1, const size_t n2, const long i,
+                          const long j, unsigned int * value);
+static size_t median2d_window(const gsl_filter_end_t endtype, const gsl_matrix * X, const size_t i,
+                              const size_t j, const size_t H, double * window);
+static double median2d_network(const size_t K, double * window);
+
+/* median of 9 values, see Devillard, "Fast median search: an ANSI C implementation", 1998 */
+static const unsigned char median9_network[][2] =
+{
+  {1,2},{4,5},{7,8},{0,1},{3,4},{6,7},{1,2},{4,5},{7,8},{0,3},{5,8},{4,7},{3,6},{1,4},{2,5},{4,7},{4,2},
+  {6,4},{4,2}
+};
+
+/* median of 25 values, from Batcher's odd-even merge sort with the exchanges not affecting the median removed */
+static const unsigned char median25_network[][2] =
+{
+  {0,1},{2,3},{4,5},{6,7},{8,9},{10,11},{12,13},{14,15},{16,17},{18,19},{20,21},{22,23},{0,2},{1,3},
+  {4,6},{5,7},{8,10},{9,11},{12,14},{13,15},{16,18},{17,19},{20,22},{21,23},{1,2},{5,6},{9,10},{13,14},
+  {17,18},{21,22},{0,4},{1,5},{2,6},{3,7},{8,12},{9,13},{10,14},{11,15},{16,20},{17,21},{18,22},{19,23},
+  {2,4},{3,5},{10,12},{11,13},{18,20},{19,21},{1,2},{3,4},{5,6},{9,10},{11,12},{13,14},{17,18},{19,20},
+  {21,22},{0,8},{1,9},{2,10},{3,11},{4,12},{5,13},{6,14},{7,15},{16,24},{4,8},{5,9},{6,10},{7,11},
+  {20,24},{2,4},{3,5},{6,8},{7,9},{10,12},{11,13},{18,20},{19,21},{22,24},{1,2},{3,4},{5,6},{7,8},
+  {9,10},{11,12},{13,14},{17,18},{19,20},{21,22},{23,24},{0,16},{1,17},{2,18},{3,19},{4,20},{5,21},
+  {6,22},{7,23},{8,24},{8,16},{9,17},{10,18},{11,19},{12,20},{13,21},{6,10},{7,11},{12,16},{13,17},
+  {10,12},{11,13},{11,12}
+};
+
+/*
+gsl_filter_median2d_alloc()
+  Allocate a workspace for median filtering of images
+
+Inputs: K - number of samples in each dimension of the K-by-K window; if
+            even, it is rounded up to the next odd, to have a symmetric window
+
+Return: pointer to workspace
+*/
+
+gsl_filter_median2d_workspace *
+gsl_filter_median2d_alloc(const size_t K)
+{
+  const size_t H = K / 2;
+  gsl_filter_median2d_workspace *w;
+
+  w = calloc(1, sizeof(gsl_filter_median2d_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->H = H;
+  w->K = 2 * H + 1;
+  w->nbits = 0;
+
+  w->window = malloc(w->K * w->K * sizeof(double));
+  if (w->window == 0)
+    {
+      gsl_filter_median2d_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for window", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_filter_median2d_free(gsl_filter_median2d_workspace * w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->window)
+    free(w->window);
+
+  median2d_hist_free(w);
+
+  free(w);
+}
+
+/*
+gsl_filter_median2d()
+  Median filter of an image
+
+Inputs: endtype - end point handling
+        X       - input image, n1-by-n2
+        Y       - (output) filtered image, n1-by-n2
+        w       - workspace
+
+Return: success/error
+
+Notes:
+1) Windows near the edges of X are padded with zeros (PADZERO), with the
+nearest pixel of X (PADVALUE), or truncated to the pixels inside X
+(TRUNCATE)
+
+2) X and Y must be different matrices
+*/
+
+int
+gsl_filter_median2d(const gsl_filter_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                    gsl_filter_median2d_workspace * w)
+{
+  const size_t n1 = X->size1;
+  const size_t n2 = X->size2;
+
+  if (n1 != Y->size1 || n2 != Y->size2)
+    {
+      GSL_ERROR("input and output matrices must have same dimensions", GSL_EBADLEN);
+    }
+  else if (X->data == Y->data && n1 > 0 && n2 > 0)
+    {
+      GSL_ERROR("input and output matrices must be different", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t H = w->H;
+      const size_t K = w->K;
+      size_t i, j;
+
+      for (i = 0; i < n1; ++i)
+        {
+          for (j = 0; j < n2; ++j)
+            {
+              size_t m = median2d_window(endtype, X, i, j, H, w->window);
+              double yij;
+
+              if (m == K * K)
+                yij = median2d_network(K, w->window);
+              else
+                yij = gsl_stats_median(w->window, 1, m);
+
+              gsl_matrix_set(Y, i, j, yij);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_filter_median2d_uchar()
+gsl_filter_median2d_ushort()
+  Median filter of an image of 8 or 16 bit integers in constant time
+per pixel
+
+Inputs: endtype - end point handling
+        X       - input image, n1-by-n2
+        Y       - (output) filtered image, n1-by-n2
+        w       - workspace
+
+Return: success/error
+
+Notes:
+1) A truncated window with an even number of pixels has two middle
+values; the smaller one is returned
+
+2) X and Y must be different matrices
+
+3) The histograms are allocated on the first call, with 2^8 or 2^16
+bins per column; a workspace sized for 16 bit images is reused for
+8 bit images
+*/
+
+int
+gsl_filter_median2d_uchar(const gsl_filter_end_t endtype, const gsl_matrix_uchar * X, gsl_matrix_uchar * Y,
+                          gsl_filter_median2d_workspace * w)
+{
+  if (X->size1 != Y->size1 || X->size2 != Y->size2)
+    {
+      GSL_ERROR("input and output matrices must have same dimensions", GSL_EBADLEN);
+    }
+  else if (X->data == Y->data && X->size1 > 0 && X->size2 > 0)
+    {
+      GSL_ERROR("input and output matrices must be different", GSL_EINVAL);
+    }
+  else
+    {
+      return median2d_hist(endtype, 8, X->data, X->tda, Y->data, Y->tda, X->size1, X->size2, w);
+    }
+}
+
+int
+gsl_filter_median2d_ushort(const gsl_filter_end_t endtype, const gsl_matrix_ushort * X, gsl_matrix_ushort * Y,
+                           gsl_filter_median2d_workspace * w)
+{
+  if (X->size1 != Y->size1 || X->size2 != Y->size2)
+    {
+      GSL_ERROR("input and output matrices must have same dimensions", GSL_EBADLEN);
+    }
+  else if (X->data == Y->data && X->size1 > 0 && X->size2 > 0)
+    {
+      GSL_ERROR("input and output matrices must be different", GSL_EINVAL);
+    }
+  else
+    {
+      return median2d_hist(endtype, 16, X->data, X->tda, Y->data, Y->tda, X->size1, X->size2, w);
+    }
+}
+
+/*
+median2d_hist()
+  Median filter of an image of nbits-bit integers using histograms
+
+Inputs: endtype - end point handling
+        nbits   - number of bits per pixel, 8 or 16
+        x       - input image, unsigned char or unsigned short
+        xtda    - row stride of x
+        y       - (output) filtered image, same type as x
+        ytda    - row stride of y
+        n1      - number of rows
+        n2      - number of columns
+        w       - workspace
+
+Notes:
+1) In each strip of output columns j0 <= j < j1, histogram l holds the
+column j0 - H + l of the current window, for l = 0, ..., j1 - j0 + 2H - 1
+
+2) w->updated[b] is the column of the window at which the fine bins of
+coarse bin b of the window histogram were last brought up to date
+*/
+
+static int
+median2d_hist(const gsl_filter_end_t endtype, const size_t nbits, const void * x,
+              const size_t xtda, void * y, const size_t ytda, const size_t n1,
+              const size_t n2, gsl_filter_median2d_workspace * w)
+{
+  const long H = (long) w->H;
+  const size_t nbins = (size_t) 1 << nbits;              /* number of fine bins */
+  const size_t ncoarse = (size_t) 1 << (nbits / 2);      /* number of coarse bins */
+  const size_t nfine = nbins / ncoarse;                  /* fine bins per coarse bin */
+  const size_t shift = nbits / 2;
+  size_t j0;
+  int status;
+
+  status = median2d_hist_alloc(nbits, w);
+  if (status)
+    return status;
+
+  for (j0 = 0; j0 < n2; j0 += MEDIAN2D_STRIP)
+    {
+      const size_t j1 = GSL_MIN(j0 + MEDIAN2D_STRIP, n2);
+      const size_t ncol = j1 - j0 + 2 * w->H;
+      size_t i, j, l, b;
+
+      memset(w->hist, 0, ncol * nbins * sizeof(unsigned short));
+      memset(w->coarse, 0, ncol * ncoarse * sizeof(unsigned short));
+      memset(w->count, 0, ncol * sizeof(unsigned short));
+
+      for (i = 0; i < n1; ++i)
+        {
+          unsigned int kcount = 0;
+
+          /* move column histograms down to rows i - H, ..., i + H */
+          for (l = 0; l < ncol; ++l)
+            {
+              const long jv = (long) j0 - H + (long) l;
+              unsigned short * hist = w->hist + l * nbins;
+              unsigned short * coarse = w->coarse + l * ncoarse;
+              unsigned int v;
+              long r;
+
+              if (i == 0)
+                {
+                  for (r = -H; r < H; ++r)
+                    {
+                      if (median2d_value(endtype, nbits, x, xtda, n1, n2, r, jv, &v))
+                        {
+                          ++hist[v];
+                          ++coarse[v >> shift];
+                          ++(w->count[l]);
+                        }
+                    }
+                }
+              else if (median2d_value(endtype, nbits, x, xtda, n1, n2, (long) i - H - 1, jv, &v))
+                {
+                  --hist[v];
+                  --coarse[v >> shift];
+                  --(w->count[l]);
+                }
+
+              if (median2d_value(endtype, nbits, x, xtda, n1, n2, (long) i + H, jv, &v))
+                {
+                  ++hist[v];
+                  ++coarse[v >> shift];
+                  ++(w->count[l]);
+                }
+            }
+
+          /* window histogram of first output column; fine bins are updated when needed */
+          for (b = 0; b < ncoarse; ++b)
+            {
+              w->kcoarse[b] = 0;
+              w->updated[b] = -2 * H - 2;
+            }
+
+          for (l = 0; l < 2 * w->H + 1; ++l)
+            {
+              for (b = 0; b < ncoarse; ++b)
+                w->kcoarse[b] += w->coarse[l * ncoarse + b];
+
+              kcount += w->count[l];
+            }
+
+          for (j = 0; j < j1 - j0; ++j)
+            {
+              unsigned int rank, cum = 0, v;
+              unsigned int * kfine;
+
+              if (j > 0)
+                {
+                  /* column j + 2H enters the window and column j - 1 leaves it */
+                  const unsigned short * cin = w->coarse + (j + 2 * w->H) * ncoarse;
+                  const unsigned short * cout = w->coarse + (j - 1) * ncoarse;
+
+                  for (b = 0; b < ncoarse; ++b)
+                    w->kcoarse[b] += (unsigned int) cin[b] - cout[b];
+
+                  kcount += (unsigned int) w->count[j + 2 * w->H] - w->count[j - 1];
+                }
+
+              rank = (kcount - 1) / 2;
+
+              /* find coarse bin b containing the median */
+              for (b = 0; b < ncoarse - 1; ++b)
+                {
+                  if (cum + w->kcoarse[b] > rank)
+                    break;
+
+                  cum += w->kcoarse[b];
+                }
+
+              /* bring fine bins of b up to date */
+              kfine = w->khist + b * nfine;
+
+              if ((long) j - w->updated[b] > 2 * H)
+                {
+                  for (v = 0; v < nfine; ++v)
+                    kfine[v] = 0;
+
+                  for (l = j; l <= j + 2 * w->H; ++l)
+                    {
+                      const unsigned short * hist = w->hist + l * nbins + b * nfine;
+
+                      for (v = 0; v < nfine; ++v)
+                        kfine[v] += hist[v];
+                    }
+                }
+              else
+                {
+                  long jj;
+
+                  for (jj = w->updated[b] + 1; jj <= (long) j; ++jj)
+                    {
+                      const unsigned short * hin = w->hist + (jj + 2 * H) * nbins + b * nfine;
+                      const unsigned short * hout = w->hist + (jj - 1) * nbins + b * nfine;
+
+                      for (v = 0; v < nfine; ++v)
+                        kfine[v] += (unsigned int) hin[v] - hout[v];
+                    }
+                }
+
+              w->updated[b] = (long) j;
+
+              /* find fine bin containing the median */
+              for (v = 0; v < nfine - 1; ++v)
+                {
+                  if (cum + kfine[v] > rank)
+                    break;
+
+                  cum += kfine[v];
+                }
+
+              v += b * nfine;
+
+              if (nbits == 8)
+                ((unsigned char *) y)[i * ytda + j0 + j] = (unsigned char) v;
+              else
+                ((unsigned short *) y)[i * ytda + j0 + j] = (unsigned short) v;
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+median2d_hist_alloc()
+  Allocate the histograms of nbits-bit images in the workspace, unless
+histograms with at least nbits bits have already been allocated
+*/
+
+static int
+median2d_hist_alloc(const size_t nbits, gsl_filter_median2d_workspace * w)
+{
+  const size_t ncol = MEDIAN2D_STRIP + 2 * w->H; /* columns of histograms in a strip */
+  const size_t nbins = (size_t) 1 << nbits;
+  const size_t ncoarse = (size_t) 1 << (nbits / 2);
+
+  if (w->nbits >= nbits)
+    return GSL_SUCCESS;
+
+  median2d_hist_free(w);
+
+  w->hist = malloc(ncol * nbins * sizeof(unsigned short));
+  if (w->hist == 0)
+    {
+      median2d_hist_free(w);
+      GSL_ERROR ("failed to allocate space for column histograms", GSL_ENOMEM);
+    }
+
+  w->coarse = malloc(ncol * ncoarse * sizeof(unsigned short));
+  if (w->coarse == 0)
+    {
+      median2d_hist_free(w);
+      GSL_ERROR ("failed to allocate space for coarse column histograms", GSL_ENOMEM);
+    }
+
+  w->count = malloc(ncol * sizeof(unsigned short));
+  if (w->count == 0)
+    {
+      median2d_hist_free(w);
+      GSL_ERROR ("failed to allocate space for column counts", GSL_ENOMEM);
+    }
+
+  w->khist = malloc(nbins * sizeof(unsigned int));
+  if (w->khist == 0)
+    {
+      median2d_hist_free(w);
+      GSL_ERROR ("failed to allocate space for window histogram", GSL_ENOMEM);
+    }
+
+  w->kcoarse = malloc(ncoarse * sizeof(unsigned int));
+  if (w->kcoarse == 0)
+    {
+      median2d_hist_free(w);
+      GSL_ERROR ("failed to allocate space for coarse window histogram", GSL_ENOMEM);
+    }
+
+  w->updated = malloc(ncoarse * sizeof(long));
+  if (w->updated == 0)
+    {
+      median2d_hist_free(w);
+      GSL_ERROR ("failed to allocate space for update columns", GSL_ENOMEM);
+    }
+
+  w->nbits = nbits;
+
+  return GSL_SUCCESS;
+}
+
+static void
+median2d_hist_free(gsl_filter_median2d_workspace * w)
+{
+  if (w->hist)
+    free(w->hist);
+
+  if (w->coarse)
+    free(w->coarse);
+
+  if (w->count)
+    free(w->count);
+
+  if (w->khist)
+    free(w->khist);
+
+  if (w->kcoarse)
+    free(w->kcoarse);
+
+  if (w->updated)
+    free(w->updated);
+
+  w->hist = NULL;
+  w->coarse = NULL;
+  w->count = NULL;
+  w->khist = NULL;
+  w->kcoarse = NULL;
+  w->updated = NULL;
+  w->nbits = 0;
+}
+
+/*
+median2d_value()
+  Return the value of pixel (i,j) of an image of nbits-bit integers,
+where (i,j) may be outside the image
+
+Return: 1 if the pixel is in the (padded) window, 0 if it is excluded
+by truncation
+*/
+
+static int
+median2d_value(const gsl_filter_end_t endtype, const size_t nbits, const void * x,
+               const size_t tda, const size_t n1, const size_t n2, const long i,
+               const long j, unsigned int * value)
+{
+  const int inside = (i >= 0 && i < (long) n1 && j >= 0 && j < (long) n2);
+
+  if (inside || endtype == GSL_FILTER_END_PADVALUE)
+    {
+      const size_t ic = (size_t) GSL_MIN(GSL_MAX(i, 0), (long) n1 - 1);
+      const size_t jc = (size_t) GSL_MIN(GSL_MAX(j, 0), (long) n2 - 1);
+
+      if (nbits == 8)
+        *value = ((const unsigned char *) x)[ic * tda + jc];
+      else
+        *value = ((const unsigned short *) x)[ic * tda + jc];
+
+      return 1;
+    }
+  else if (endtype == GSL_FILTER_END_PADZERO)
+    {
+      *value = 0;
+      return 1;
+    }
+  else
+    {
+      return 0;
+    }
+}
+
+/*
+median2d_window()
+  Store the window of pixel (i,j) of X in window[], padding or truncating
+it at the edges of X
+
+Return: number of samples in window
+*/
+
+static size_t
+median2d_window(const gsl_filter_end_t endtype, const gsl_matrix * X, const size_t i,
+                const size_t j, const size_t H, double * window)
+{
+  const long n1 = (long) X->size1;
+  const long n2 = (long) X->size2;
+  long r, c;
+  size_t m = 0;
+
+  if (i >= H && (long) (i + H) < n1 && j >= H && (long) (j + H) < n2)
+    {
+      /* window inside X */
+      const size_t K = 2 * H + 1;
+
+      for (r = 0; r < (long) K; ++r)
+        {
+          const double * row = X->data + (i - H + r) * X->tda + j - H;
+
+          for (c = 0; c < (long) K; ++c)
+            window[m++] = row[c];
+        }
+
+      return m;
+    }
+
+  for (r = (long) i - (long) H; r <= (long) (i + H); ++r)
+    {
+      for (c = (long) j - (long) H; c <= (long) (j + H); ++c)
+        {
+          if (r >= 0 && r < n1 && c >= 0 && c < n2)
+            window[m++] = gsl_matrix_get(X, r, c);
+          else if (endtype == GSL_FILTER_END_PADVALUE)
+            window[m++] = gsl_matrix_get(X, GSL_MIN(GSL_MAX(r, 0), n1 - 1), GSL_MIN(GSL_MAX(c, 0), n2 - 1));
+          else if (endtype == GSL_FILTER_END_PADZERO)
+            window[m++] = 0.0;
+        }
+    }
+
+  return m;
+}
+
+/* median of the K*K values in window[], which may be reordered */
+
+static double
+median2d_network(const size_t K, double * window)
+{
+  const unsigned char (*network)[2];
+  size_t nexch, k;
+
+  if (K == 3)
+    {
+      network = median9_network;
+      nexch = sizeof(median9_network) / sizeof(median9_network[0]);
+    }
+  else if (K == 5)
+    {
+      network = median25_network;
+      nexch = sizeof(median25_network) / sizeof(median25_network[0]);
+    }
+  else
+    {
+      return gsl_stats_median(window, 1, K * K);
+    }
+
+  for (k = 0; k < nexch; ++k)
+    {
+      const double a = window[network[k][0]];
+      const double b = window[network[k][1]];
+
+      window[network[k][0]] = GSL_MIN(a, b);
+      window[network[k][1]] = GSL_MAX(a, b);
+    }
+
+  return window[K * K / 2];
+}
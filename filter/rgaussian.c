@@ -0,0 +1,428 @@
+/* filter/rgaussian.c
+ *
+ * Recursive Gaussian filter
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This module approximates convolution with a Gaussian by a third order
+ * recursive filter, applied forward and then backward over the signal,
+ * following
+ *
+ * [1] I. T. Young and L. J. van Vliet, Recursive implementation of the
+ * Gaussian filter, Signal Processing, 44, 1995.
+ *
+ * The cost is 14 operations per sample, independent of sigma. The
+ * coefficients are computed from the poles of the filter given in
+ *
+ * [2] I. T. Young, L. J. van Vliet and M. van Ginkel, Recursive Gabor
+ * filtering, IEEE Transactions on Signal Processing, 50(11), 2002.
+ *
+ * Derivative filters are obtained as in
+ *
+ * [3] L. J. van Vliet, I. T. Young and P. W. Verbeek, Recursive Gaussian
+ * derivative filters, Proc. 14th International Conference on Pattern
+ * Recognition, 1998.
+ *
+ * by applying the central difference (x_{n+1} - x_{n-1}) / 2 or the second
+ * difference x_{n+1} - 2 x_n + x_{n-1} to the input of the forward pass,
+ * with the same recursion coefficients. Both differences are applied in
+ * the forward pass, rather than splitting the second difference between
+ * the passes, so that the input of the backward pass is the output of
+ * the forward pass, as assumed by the boundary conditions below.
+ *
+ * The signal is extended beyond its ends with zeros or the end values.
+ * The initial state of the forward pass is the steady state for the
+ * extension before the first sample. The initial state of the backward
+ * pass is the response of both passes to the extension after the last
+ * sample, which is a linear function of the final state of the forward
+ * pass, given in closed form in
+ *
+ * [4] B. Triggs and M. Sdika, Boundary conditions for Young - van Vliet
+ * recursive filtering, IEEE Transactions on Signal Processing, 54(6), 2006.
+ *
+ * The differenced extension is zero except at samples -1 and n, so for
+ * derivatives the forward pass starts from rest at sample -1, and runs
+ * to sample n before the boundary conditions for a zero extension are
+ * applied.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_filter.h>
+
+/* maximum derivative order allowed for recursive Gaussian filter */
+#define GSL_FILTER_RGAUSSIAN_MAX_ORDER    2
+
+typedef struct
+{
+  double a[3];    /* feedback coefficients, a_k = b_k / b_0 */
+  double B;       /* input coefficient */
+  double M[3][3]; /* initial backward state in terms of final forward state, eq. 12 of [4] */
+} rgaussian_coeffs;
+
+static int rgaussian_init(const double sigma, rgaussian_coeffs * c);
+static void rgaussian_apply(const gsl_filter_end_t endtype, const size_t order, const rgaussian_coeffs * c,
+                            const gsl_vector * x, gsl_vector * y);
+static double rgaussian_diff(const size_t order, const double xprev, const double xi, const double xnext);
+
+gsl_filter_rgaussian_workspace *
+gsl_filter_rgaussian_alloc(const size_t n)
+{
+  gsl_filter_rgaussian_workspace *w;
+
+  w = calloc(1, sizeof(gsl_filter_rgaussian_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  if (n > 0)
+    {
+      w->work = malloc((2 * GSL_FILTER_RGAUSSIAN_MAX_ORDER + 1) * n * sizeof(double));
+      if (w->work == 0)
+        {
+          gsl_filter_rgaussian_free(w);
+          GSL_ERROR_NULL ("failed to allocate space for work", GSL_ENOMEM);
+        }
+    }
+
+  return w;
+}
+
+void
+gsl_filter_rgaussian_free(gsl_filter_rgaussian_workspace * w)
+{
+  if (w->work)
+    free(w->work);
+
+  free(w);
+}
+
+/*
+gsl_filter_rgaussian()
+  Apply a recursive approximation of the Gaussian filter, or of its
+first or second derivative, to an input vector
+
+Inputs: endtype - end point handling
+        sigma   - standard deviation of Gaussian in samples, >= 0.5
+        order   - derivative order of Gaussian (0, 1 or 2)
+        x       - input vector, size n
+        y       - (output) filtered vector, size n
+        w       - workspace, of size at least n
+
+Return: success/error
+
+Notes:
+1) For GSL_FILTER_END_TRUNCATE, the smoothed output h = f / g is the
+smoothed signal extended with zeros, f, divided by the smoothed indicator
+of the samples of x, g, so that each output is a weighted average of
+the samples of x only. Its derivatives are found with the quotient rule,
+
+h' = (f' - h g') / g
+h'' = (f'' - 2 h' g' - h g'') / g
+
+where f', f'', g' and g'' are computed with the derivative filters
+
+2) It is allowed to have x = y
+*/
+
+int
+gsl_filter_rgaussian(const gsl_filter_end_t endtype, const double sigma, const size_t order,
+                     const gsl_vector * x, gsl_vector * y, gsl_filter_rgaussian_workspace * w)
+{
+  const size_t n = x->size;
+
+  if (n != y->size)
+    {
+      GSL_ERROR("input and output vectors must have same length", GSL_EBADLEN);
+    }
+  else if (n > w->n)
+    {
+      GSL_ERROR("input vector is longer than workspace", GSL_EBADLEN);
+    }
+  else if (sigma < 0.5)
+    {
+      GSL_ERROR("sigma must be at least 0.5", GSL_EDOM);
+    }
+  else if (order > GSL_FILTER_RGAUSSIAN_MAX_ORDER)
+    {
+      GSL_ERROR("derivative order is too large", GSL_EDOM);
+    }
+  else
+    {
+      rgaussian_coeffs c;
+
+      if (n == 0)
+        return GSL_SUCCESS;
+
+      rgaussian_init(sigma, &c);
+
+      if (endtype == GSL_FILTER_END_TRUNCATE)
+        {
+          gsl_vector_view g = gsl_vector_view_array(w->work, n);          /* g */
+          gsl_vector_view g1 = gsl_vector_view_array(w->work + n, n);     /* g' */
+          gsl_vector_view g2 = gsl_vector_view_array(w->work + 2 * n, n); /* g'' */
+          gsl_vector_view f1 = gsl_vector_view_array(w->work + 3 * n, n); /* f' */
+          gsl_vector_view f2 = gsl_vector_view_array(w->work + 4 * n, n); /* f'' */
+          size_t k, i;
+
+          /* response to the indicator of x(0:n-1), and its derivatives */
+          for (k = 0; k <= order; ++k)
+            {
+              gsl_vector * v = (k == 0) ? &g.vector : (k == 1) ? &g1.vector : &g2.vector;
+
+              gsl_vector_set_all(v, 1.0);
+              rgaussian_apply(GSL_FILTER_END_PADZERO, k, &c, v, v);
+            }
+
+          /* derivatives of f first, since y may equal x */
+          if (order >= 1)
+            rgaussian_apply(GSL_FILTER_END_PADZERO, 1, &c, x, &f1.vector);
+
+          if (order >= 2)
+            rgaussian_apply(GSL_FILTER_END_PADZERO, 2, &c, x, &f2.vector);
+
+          rgaussian_apply(GSL_FILTER_END_PADZERO, 0, &c, x, y);
+
+          for (i = 0; i < n; ++i)
+            {
+              const double gi = gsl_vector_get(&g.vector, i);
+              const double hi = gsl_vector_get(y, i) / gi;
+              double h1, h2;
+
+              if (order == 0)
+                {
+                  gsl_vector_set(y, i, hi);
+                }
+              else
+                {
+                  h1 = (gsl_vector_get(&f1.vector, i) - hi * gsl_vector_get(&g1.vector, i)) / gi;
+
+                  if (order == 1)
+                    {
+                      gsl_vector_set(y, i, h1);
+                    }
+                  else
+                    {
+                      h2 = (gsl_vector_get(&f2.vector, i) - 2.0 * h1 * gsl_vector_get(&g1.vector, i) -
+                            hi * gsl_vector_get(&g2.vector, i)) / gi;
+                      gsl_vector_set(y, i, h2);
+                    }
+                }
+            }
+        }
+      else
+        {
+          rgaussian_apply(endtype, order, &c, x, y);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+rgaussian_init()
+  Compute filter coefficients for a given sigma
+
+Notes:
+1) The forward pass is
+
+w_n = B x_n + a_1 w_{n-1} + a_2 w_{n-2} + a_3 w_{n-3}
+
+and the backward pass is
+
+y_n = B w_n + a_1 y_{n+1} + a_2 y_{n+2} + a_3 y_{n+3}
+
+2) For a signal of length N extended with the constant u,
+
+(y_{N-1}, y_N, y_{N+1})^T = u + M (w_{N-1} - u, w_{N-2} - u, w_{N-3} - u)^T
+*/
+
+static int
+rgaussian_init(const double sigma, rgaussian_coeffs * c)
+{
+  const double m0 = 1.16680;
+  const double m1 = 1.10783;
+  const double m2 = 1.40586;
+  double q, q2, q3, b0;
+  double a1, a2, a3, scale;
+  size_t i, j;
+
+  /* eqs 11b and 11c of [1] */
+  if (sigma >= 2.5)
+    q = 0.98711 * sigma - 0.96330;
+  else
+    q = 3.97156 - 4.14554 * sqrt(1.0 - 0.26891 * sigma);
+
+  q2 = q * q;
+  q3 = q2 * q;
+
+  /*
+   * eq 8c of [1], written in terms of the poles of [2]; the rounded
+   * coefficients of [1] do not sum exactly to 1 - B, which distorts
+   * the response for large sigma
+   */
+  b0 = (m0 + q) * (m1 * m1 + m2 * m2 + 2.0 * m1 * q + q2);
+  a1 = q * (2.0 * m0 * m1 + m1 * m1 + m2 * m2 + (2.0 * m0 + 4.0 * m1) * q + 3.0 * q2) / b0;
+  a2 = -q2 * (m0 + 2.0 * m1 + 3.0 * q) / b0;
+  a3 = q3 / b0;
+
+  c->a[0] = a1;
+  c->a[1] = a2;
+  c->a[2] = a3;
+  c->B = m0 * (m1 * m1 + m2 * m2) / b0;
+
+  /* eq. 12 of [4], scaled by B since both passes here have gain B */
+  c->M[0][0] = -a3 * a1 + 1.0 - a3 * a3 - a2;
+  c->M[0][1] = (a3 + a1) * (a2 + a3 * a1);
+  c->M[0][2] = a3 * (a1 + a3 * a2);
+  c->M[1][0] = a1 + a3 * a2;
+  c->M[1][1] = -(a2 - 1.0) * (a2 + a3 * a1);
+  c->M[1][2] = -(a3 * a1 + a3 * a3 + a2 - 1.0) * a3;
+  c->M[2][0] = a3 * a1 + a2 + a1 * a1 - a2 * a2;
+  c->M[2][1] = a1 * a2 + a3 * a2 * a2 - a1 * a3 * a3 - a3 * a3 * a3 - a3 * a2 + a3;
+  c->M[2][2] = a3 * (a1 + a3 * a2);
+
+  scale = c->B / ((1.0 + a1 - a2 + a3) * (1.0 - a1 - a2 - a3) * (1.0 + a2 + (a1 - a3) * a3));
+
+  for (i = 0; i < 3; ++i)
+    {
+      for (j = 0; j < 3; ++j)
+        c->M[i][j] *= scale;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+rgaussian_apply()
+  Apply forward and backward passes to x, with the difference operator of
+the given order applied to the input of the forward pass, storing the
+result in y
+
+Inputs: endtype - end point handling, PADZERO or PADVALUE
+        order   - derivative order (0, 1 or 2)
+        c       - filter coefficients
+        x       - input vector, size n > 0
+        y       - (output) filtered vector, size n; may equal x
+*/
+
+static void
+rgaussian_apply(const gsl_filter_end_t endtype, const size_t order, const rgaussian_coeffs * c,
+                const gsl_vector * x, gsl_vector * y)
+{
+  const size_t n = x->size;
+  const double a1 = c->a[0];
+  const double a2 = c->a[1];
+  const double a3 = c->a[2];
+  const double B = c->B;
+  const double x0 = (endtype == GSL_FILTER_END_PADVALUE) ? gsl_vector_get(x, 0) : 0.0;
+  const double u = (endtype == GSL_FILTER_END_PADVALUE) ? gsl_vector_get(x, n - 1) : 0.0;
+  double xprev = x0;               /* x_{i-1} of the extended signal */
+  double xi = gsl_vector_get(x, 0); /* x_i, saved since y may equal x */
+  double v;                        /* value of the extension of the forward pass output */
+  double w1, w2, w3, s[3];
+  size_t i, j;
+
+  if (order == 0)
+    {
+      /* forward pass, starting in steady state for the constant x0 */
+      w1 = w2 = w3 = x0;
+    }
+  else
+    {
+      /* forward pass, starting from rest at sample -1 */
+      w1 = B * rgaussian_diff(order, x0, x0, xi);
+      w2 = w3 = 0.0;
+    }
+
+  for (i = 0; i < n; ++i)
+    {
+      const double xnext = (i + 1 < n) ? gsl_vector_get(x, i + 1) : u;
+      const double wi = B * rgaussian_diff(order, xprev, xi, xnext) + a1 * w1 + a2 * w2 + a3 * w3;
+
+      gsl_vector_set(y, i, wi);
+      w3 = w2;
+      w2 = w1;
+      w1 = wi;
+      xprev = xi;
+      xi = xnext;
+    }
+
+  if (order == 0)
+    {
+      /* the extension after sample n-1 is the constant u */
+      v = u;
+      j = n - 1;
+    }
+  else
+    {
+      /* input at sample n, after which the differenced extension is zero */
+      const double wn = B * rgaussian_diff(order, xprev, u, u) + a1 * w1 + a2 * w2 + a3 * w3;
+
+      w3 = w2;
+      w2 = w1;
+      w1 = wn;
+      v = 0.0;
+      j = n;
+    }
+
+  /* state of the backward pass at sample j, after the extension with v */
+  s[0] = w1 - v;
+  s[1] = w2 - v;
+  s[2] = w3 - v;
+
+  w1 = v + c->M[0][0] * s[0] + c->M[0][1] * s[1] + c->M[0][2] * s[2];
+  w2 = v + c->M[1][0] * s[0] + c->M[1][1] * s[1] + c->M[1][2] * s[2];
+  w3 = v + c->M[2][0] * s[0] + c->M[2][1] * s[1] + c->M[2][2] * s[2];
+
+  if (j < n)
+    gsl_vector_set(y, j, w1);
+
+  /* backward pass */
+  for (i = j; i > 0; --i)
+    {
+      const double yi = B * gsl_vector_get(y, i - 1) + a1 * w1 + a2 * w2 + a3 * w3;
+
+      gsl_vector_set(y, i - 1, yi);
+      w3 = w2;
+      w2 = w1;
+      w1 = yi;
+    }
+}
+
+/* difference operator of given order at x_i, applied to the input of the forward pass */
+
+static double
+rgaussian_diff(const size_t order, const double xprev, const double xi, const double xnext)
+{
+  if (order == 0)
+    return xi;
+  else if (order == 1)
+    return 0.5 * (xnext - xprev);
+  else
+    return xnext - 2.0 * xi + xprev;
+}
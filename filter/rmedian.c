@@ -48,6 +48,7 @@ static int rmedian_init(const size_t n, void * vstate);
 static int rmedian_insert(const double x, void * vstate);
 static int rmedian_delete(void * vstate);
 static int rmedian_get(void * params, double * result, const void * vstate);
+static double rmedian_stream_first(const size_t n, gsl_filter_rmedian_stream * s);
 
 static const gsl_movstat_accum rmedian_accum_type;
 
@@ -152,6 +153,244 @@ gsl_filter_rmedian(const gsl_filter_end_t endtype, const gsl_vector * x, gsl_vec
     }
 }
 
+/*
+gsl_filter_rmedian_stream_alloc()
+  Allocate a stream for the recursive median filter of a signal received
+in pieces
+
+Inputs: endtype - end point handling
+        K       - number of samples in window; if even, it is rounded up to
+                  the next odd, to have a symmetric window
+
+Return: pointer to stream
+
+Notes:
+1) The output lags the input by K / 2 samples
+*/
+
+gsl_filter_rmedian_stream *
+gsl_filter_rmedian_stream_alloc(const gsl_filter_end_t endtype, const size_t K)
+{
+  gsl_filter_rmedian_stream *s;
+
+  s = calloc(1, sizeof(gsl_filter_rmedian_stream));
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  s->endtype = endtype;
+  s->H = K / 2;
+  s->K = 2*s->H + 1;
+
+  s->xfirst = malloc((s->H + 1) * sizeof(double));
+  if (s->xfirst == NULL)
+    {
+      gsl_filter_rmedian_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for initial samples", GSL_ENOMEM);
+    }
+
+  s->window = malloc(s->K * sizeof(double));
+  if (s->window == NULL)
+    {
+      gsl_filter_rmedian_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for window", GSL_ENOMEM);
+    }
+
+  /* the movstat stream processes x[2:end], as in gsl_filter_rmedian() */
+  s->movstat_stream_p = gsl_movstat_stream_alloc((gsl_movstat_end_t) endtype, &rmedian_accum_type,
+                                                 (void *) &(s->yprev), 0, s->H);
+  if (!s->movstat_stream_p)
+    {
+      gsl_filter_rmedian_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for movstat stream", GSL_ENOMEM);
+    }
+
+  s->n = 0;
+  s->yprev = 0.0;
+
+  return s;
+}
+
+void
+gsl_filter_rmedian_stream_free(gsl_filter_rmedian_stream * s)
+{
+  if (s->xfirst)
+    free(s->xfirst);
+
+  if (s->window)
+    free(s->window);
+
+  if (s->movstat_stream_p)
+    gsl_movstat_stream_free(s->movstat_stream_p);
+
+  free(s);
+}
+
+int
+gsl_filter_rmedian_stream_reset(gsl_filter_rmedian_stream * s)
+{
+  s->n = 0;
+  s->yprev = 0.0;
+
+  return gsl_movstat_stream_reset(s->movstat_stream_p);
+}
+
+/*
+gsl_filter_rmedian_stream_push()
+  Apply the recursive median filter to the next piece of a signal
+
+Inputs: x  - next samples of input signal
+        y  - (output) next samples of filtered signal, size >= x->size
+        ny - (output) number of samples stored in y
+        s  - stream
+
+Notes:
+1) The first output sample is the median of the first window, which
+is available once the first H + 1 samples have been received; the
+remaining samples are passed to the recursive filter
+
+2) It is allowed to have x = y
+*/
+
+int
+gsl_filter_rmedian_stream_push(const gsl_vector * x, gsl_vector * y, size_t * ny, gsl_filter_rmedian_stream * s)
+{
+  const size_t m = x->size;
+
+  if (y->size < m)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = GSL_SUCCESS;
+      size_t nfirst = 0; /* number of samples of x belonging to the first window */
+      size_t nout;
+      int emit = 0;      /* y0 is computed during this call */
+      double y0 = 0.0;
+
+      *ny = 0;
+
+      if (s->n <= s->H)
+        {
+          /* sample 0 initializes the filter and is not passed to the movstat stream */
+          const size_t i0 = (s->n == 0 && m > 0) ? 1 : 0;
+          size_t i;
+
+          nfirst = GSL_MIN(m, s->H + 1 - s->n);
+
+          for (i = 0; i < nfirst; ++i)
+            s->xfirst[s->n + i] = gsl_vector_get(x, i);
+
+          if (nfirst > i0)
+            {
+              /* these samples complete windows which are not yet available */
+              gsl_vector_const_view xv = gsl_vector_const_subvector(x, i0, nfirst - i0);
+              gsl_vector_view yv = gsl_vector_subvector(y, i0, nfirst - i0);
+
+              status = gsl_movstat_stream_push(&xv.vector, &yv.vector, NULL, &nout, s->movstat_stream_p);
+              if (status)
+                return status;
+            }
+
+          s->n += nfirst;
+
+          if (s->n == s->H + 1)
+            {
+              /* find median of first window to initialize filter */
+              y0 = rmedian_stream_first(s->n, s);
+              s->yprev = y0;
+              emit = 1;
+            }
+        }
+
+      if (m > nfirst)
+        {
+          gsl_vector_const_view xv = gsl_vector_const_subvector(x, nfirst, m - nfirst);
+          gsl_vector_view yv = gsl_vector_subvector(y, emit, y->size - emit);
+
+          status = gsl_movstat_stream_push(&xv.vector, &yv.vector, NULL, &nout, s->movstat_stream_p);
+          if (status)
+            return status;
+
+          s->n += m - nfirst;
+          *ny += nout;
+        }
+
+      /* y0 is stored last since x_0 may be overwritten for in-place filtering */
+      if (emit)
+        {
+          gsl_vector_set(y, 0, y0);
+          ++(*ny);
+        }
+
+      return status;
+    }
+}
+
+/*
+gsl_filter_rmedian_stream_finish()
+  Compute the final samples of the filtered signal and reset the stream
+
+Inputs: y  - (output) final samples of filtered signal, size >= K / 2
+        ny - (output) number of samples stored in y
+        s  - stream
+*/
+
+int
+gsl_filter_rmedian_stream_finish(gsl_vector * y, size_t * ny, gsl_filter_rmedian_stream * s)
+{
+  const size_t nout = GSL_MIN(s->n, s->H);
+
+  if (y->size < nout)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else
+    {
+      int status = GSL_SUCCESS;
+      int emit = 0;
+
+      *ny = 0;
+
+      if (s->n == 0)
+        return GSL_SUCCESS;
+
+      if (s->n <= s->H)
+        {
+          /* signal is shorter than the first window */
+          s->yprev = rmedian_stream_first(s->n, s);
+          gsl_vector_set(y, 0, s->yprev);
+          emit = 1;
+        }
+
+      if (s->n > 1 && y->size > (size_t) emit)
+        {
+          gsl_vector_view yv = gsl_vector_subvector(y, emit, y->size - emit);
+
+          status = gsl_movstat_stream_finish(&yv.vector, NULL, ny, s->movstat_stream_p);
+          if (status)
+            return status;
+        }
+
+      *ny += emit;
+
+      return gsl_filter_rmedian_stream_reset(s);
+    }
+}
+
+/* median of the first window, from the first n samples of the signal */
+
+static double
+rmedian_stream_first(const size_t n, gsl_filter_rmedian_stream * s)
+{
+  gsl_vector_view xv = gsl_vector_view_array(s->xfirst, n);
+  size_t wsize = gsl_movstat_fill((gsl_movstat_end_t) s->endtype, &xv.vector, 0, s->H, s->H, s->window);
+
+  return gsl_stats_median(s->window, 1, wsize);
+}
+
 static size_t
 rmedian_size(const size_t n)
 {
@@ -62,8 +62,12 @@ random_vector(gsl_vector * v, gsl_rng * r)
 
 #include "test_impulse.c"
 #include "test_gaussian.c"
+#include "test_gaussiannd.c"
 #include "test_median.c"
+#include "test_median2d.c"
+#include "test_rgaussian.c"
 #include "test_rmedian.c"
+#include "test_stream.c"
 
 int
 main()
@@ -75,6 +79,10 @@ main()
   test_impulse(r);
   test_median(r);
   test_rmedian(r);
+  test_stream(r);
+  test_gaussiannd(r);
+  test_median2d(r);
+  test_rgaussian(r);
 
   gsl_rng_free(r);
 
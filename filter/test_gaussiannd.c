@@ -0,0 +1,190 @@
+/* filter/test_gaussiannd.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_filter.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+
+/* filter the n lines of length len starting at data + k*dist, with stride, using the 1D filter */
+static void
+slow_gaussiannd_lines(const gsl_filter_end_t etype, const double alpha, const size_t order,
+                      double * data, const size_t len, const size_t stride, const size_t n,
+                      const size_t dist, gsl_filter_gaussian_workspace * w)
+{
+  gsl_vector * y = gsl_vector_alloc(len);
+  size_t k;
+
+  for (k = 0; k < n; ++k)
+    {
+      gsl_vector_view x = gsl_vector_view_array_with_stride(data + k * dist, stride, len);
+      gsl_filter_gaussian(etype, alpha, order, &x.vector, y, w);
+      gsl_vector_memcpy(&x.vector, y);
+    }
+
+  gsl_vector_free(y);
+}
+
+/* compare 2D filter with 1D filter applied to rows, then columns; X is a view with tda > n2 */
+static void
+test_gaussian2d_proc(const double tol, const size_t n1, const size_t n2, const size_t K,
+                     const double alpha, const size_t order1, const size_t order2,
+                     const gsl_filter_end_t etype, gsl_rng * r)
+{
+  gsl_filter_gaussian_nd_workspace * w = gsl_filter_gaussian_nd_alloc(K, GSL_MAX(n1, n2));
+  gsl_filter_gaussian_workspace * w1 = gsl_filter_gaussian_alloc(K);
+  gsl_matrix * A = gsl_matrix_alloc(n1, n2 + 3);
+  gsl_matrix_view X = gsl_matrix_submatrix(A, 0, 2, n1, n2);
+  gsl_matrix * Y = gsl_matrix_alloc(n1, n2);
+  gsl_matrix * Z = gsl_matrix_alloc(n1, n2);
+  size_t i, j;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2 + 3; ++j)
+        gsl_matrix_set(A, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+    }
+
+  gsl_filter_gaussian2d(etype, alpha, order1, order2, &X.matrix, Y, w);
+
+  gsl_matrix_memcpy(Z, &X.matrix);
+  slow_gaussiannd_lines(etype, alpha, order2, Z->data, n2, 1, n1, Z->tda, w1);
+  slow_gaussiannd_lines(etype, alpha, order1, Z->data, n1, Z->tda, n2, 1, w1);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_test_abs(gsl_matrix_get(Y, i, j), gsl_matrix_get(Z, i, j), tol,
+                       "gaussian2d n1=%zu n2=%zu K=%zu order=%zu,%zu endtype=%u i=%zu j=%zu",
+                       n1, n2, K, order1, order2, etype, i, j);
+        }
+    }
+
+  /* in-place */
+  gsl_filter_gaussian2d(etype, alpha, order1, order2, &X.matrix, &X.matrix, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_test_abs(gsl_matrix_get(&X.matrix, i, j), gsl_matrix_get(Y, i, j), tol,
+                       "gaussian2d in-place n1=%zu n2=%zu K=%zu order=%zu,%zu endtype=%u i=%zu j=%zu",
+                       n1, n2, K, order1, order2, etype, i, j);
+        }
+    }
+
+  gsl_filter_gaussian_nd_free(w);
+  gsl_filter_gaussian_free(w1);
+  gsl_matrix_free(A);
+  gsl_matrix_free(Y);
+  gsl_matrix_free(Z);
+}
+
+/* compare 3D filter of a subvolume with 1D filter applied along each dimension */
+static void
+test_gaussian3d_proc(const double tol, const size_t n1, const size_t n2, const size_t n3, const size_t K,
+                     const double alpha, const size_t order1, const size_t order2, const size_t order3,
+                     const gsl_filter_end_t etype, gsl_rng * r)
+{
+  const size_t stride2 = n3 + 2;
+  const size_t stride1 = (n2 + 1) * stride2;
+  const size_t size = n1 * stride1;
+  gsl_filter_gaussian_nd_workspace * w = gsl_filter_gaussian_nd_alloc(K, GSL_MAX(n1, GSL_MAX(n2, n3)));
+  gsl_filter_gaussian_workspace * w1 = gsl_filter_gaussian_alloc(K);
+  double * x = malloc(size * sizeof(double));
+  double * y = malloc(size * sizeof(double));
+  double * z = malloc(size * sizeof(double));
+  size_t i, j, k;
+
+  for (i = 0; i < size; ++i)
+    {
+      x[i] = 2.0 * gsl_rng_uniform(r) - 1.0;
+      y[i] = x[i];
+      z[i] = x[i];
+    }
+
+  gsl_filter_gaussian3d(etype, alpha, order1, order2, order3, x, y, n1, n2, n3, stride1, stride2, w);
+
+  for (i = 0; i < n1; ++i)
+    slow_gaussiannd_lines(etype, alpha, order3, z + i * stride1, n3, 1, n2, stride2, w1);
+
+  for (i = 0; i < n1; ++i)
+    slow_gaussiannd_lines(etype, alpha, order2, z + i * stride1, n2, stride2, n3, 1, w1);
+
+  for (j = 0; j < n2; ++j)
+    slow_gaussiannd_lines(etype, alpha, order1, z + j * stride2, n1, stride1, n3, 1, w1);
+
+  for (i = 0; i < size; ++i)
+    {
+      gsl_test_abs(y[i], z[i], tol, "gaussian3d n=%zu,%zu,%zu K=%zu order=%zu,%zu,%zu endtype=%u index=%zu",
+                   n1, n2, n3, K, order1, order2, order3, etype, i);
+    }
+
+  /* in-place */
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          for (k = 0; k < n3; ++k)
+            z[i * stride1 + j * stride2 + k] = x[i * stride1 + j * stride2 + k];
+        }
+    }
+
+  gsl_filter_gaussian3d(etype, alpha, order1, order2, order3, z, z, n1, n2, n3, stride1, stride2, w);
+
+  for (i = 0; i < size; ++i)
+    {
+      gsl_test_abs(z[i], y[i], tol, "gaussian3d in-place n=%zu,%zu,%zu K=%zu order=%zu,%zu,%zu endtype=%u index=%zu",
+                   n1, n2, n3, K, order1, order2, order3, etype, i);
+    }
+
+  gsl_filter_gaussian_nd_free(w);
+  gsl_filter_gaussian_free(w1);
+  free(x);
+  free(y);
+  free(z);
+}
+
+static void
+test_gaussiannd(gsl_rng * r)
+{
+  const gsl_filter_end_t etypes[] = { GSL_FILTER_END_PADZERO, GSL_FILTER_END_PADVALUE,
+                                      GSL_FILTER_END_TRUNCATE };
+  const double tol = 1.0e-12;
+  size_t k;
+
+  for (k = 0; k < 3; ++k)
+    {
+      test_gaussian2d_proc(tol, 1, 1, 5, 3.0, 0, 0, etypes[k], r);
+      test_gaussian2d_proc(tol, 7, 4, 9, 2.5, 0, 0, etypes[k], r);
+      test_gaussian2d_proc(tol, 50, 70, 11, 3.0, 0, 0, etypes[k], r);
+      test_gaussian2d_proc(tol, 50, 70, 11, 3.0, 1, 0, etypes[k], r);
+      test_gaussian2d_proc(tol, 50, 70, 11, 3.0, 0, 2, etypes[k], r);
+      test_gaussian2d_proc(tol, 40, 100, 1, 3.0, 0, 0, etypes[k], r);
+      test_gaussian2d_proc(tol, 100, 33, 21, 4.0, 1, 1, etypes[k], r);
+
+      test_gaussian3d_proc(tol, 1, 1, 1, 3, 3.0, 0, 0, 0, etypes[k], r);
+      test_gaussian3d_proc(tol, 10, 12, 14, 5, 3.0, 0, 0, 0, etypes[k], r);
+      test_gaussian3d_proc(tol, 10, 12, 40, 7, 3.0, 1, 0, 2, etypes[k], r);
+      test_gaussian3d_proc(tol, 3, 35, 6, 9, 2.0, 0, 1, 0, etypes[k], r);
+    }
+}
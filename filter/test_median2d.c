@@ -0,0 +1,251 @@
+/* filter/test_median2d.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_filter.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+
+/* store window of pixel (i,j) of X in window and return its size */
+static size_t
+slow_median2d_window(const gsl_filter_end_t etype, const gsl_matrix * X, const size_t i, const size_t j,
+                     const size_t H, double * window)
+{
+  const int n1 = (int) X->size1;
+  const int n2 = (int) X->size2;
+  size_t m = 0;
+  int r, c;
+
+  for (r = (int) i - (int) H; r <= (int) (i + H); ++r)
+    {
+      for (c = (int) j - (int) H; c <= (int) (j + H); ++c)
+        {
+          int rc = GSL_MIN(GSL_MAX(r, 0), n1 - 1);
+          int cc = GSL_MIN(GSL_MAX(c, 0), n2 - 1);
+          int inside = (r == rc && c == cc);
+
+          if (inside || etype == GSL_FILTER_END_PADVALUE)
+            window[m++] = gsl_matrix_get(X, rc, cc);
+          else if (etype == GSL_FILTER_END_PADZERO)
+            window[m++] = 0.0;
+        }
+    }
+
+  return m;
+}
+
+/* compare 2D median filter of doubles with the median of each window */
+static void
+test_median2d_proc(const size_t n1, const size_t n2, const size_t K, const gsl_filter_end_t etype,
+                   gsl_rng * r)
+{
+  const size_t H = K / 2;
+  gsl_filter_median2d_workspace * w = gsl_filter_median2d_alloc(K);
+  gsl_matrix * A = gsl_matrix_alloc(n1, n2 + 2);
+  gsl_matrix_view X = gsl_matrix_submatrix(A, 0, 1, n1, n2);
+  gsl_matrix * Y = gsl_matrix_alloc(n1, n2);
+  double * window = malloc((2 * H + 1) * (2 * H + 1) * sizeof(double));
+  size_t i, j;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2 + 2; ++j)
+        {
+          /* include ties */
+          double aij = (j % 3 == 0) ? floor(4.0 * gsl_rng_uniform(r)) : 2.0 * gsl_rng_uniform(r) - 1.0;
+          gsl_matrix_set(A, i, j, aij);
+        }
+    }
+
+  gsl_filter_median2d(etype, &X.matrix, Y, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          size_t m = slow_median2d_window(etype, &X.matrix, i, j, H, window);
+          double expected = gsl_stats_median(window, 1, m);
+
+          gsl_test_rel(gsl_matrix_get(Y, i, j), expected, 0.0,
+                       "median2d n1=%zu n2=%zu K=%zu endtype=%u i=%zu j=%zu",
+                       n1, n2, K, etype, i, j);
+        }
+    }
+
+  gsl_filter_median2d_free(w);
+  gsl_matrix_free(A);
+  gsl_matrix_free(Y);
+  free(window);
+}
+
+/* compare 2D median filter of 8 and 16 bit images with the lower median of each window */
+static void
+test_median2d_int_proc(const size_t nbits, const size_t n1, const size_t n2, const size_t K,
+                       const gsl_filter_end_t etype, gsl_rng * r)
+{
+  const size_t H = K / 2;
+  /* for 16 bit images with even n1, use few values to exercise ties */
+  const unsigned long range = (nbits == 8) ? 256 : ((n1 % 2) ? 65536 : 300);
+  gsl_filter_median2d_workspace * w = gsl_filter_median2d_alloc(K);
+  gsl_matrix_uchar * A8 = gsl_matrix_uchar_alloc(n1, n2);
+  gsl_matrix_uchar * B8 = gsl_matrix_uchar_alloc(n1, n2);
+  gsl_matrix_ushort * A16 = gsl_matrix_ushort_alloc(n1, n2);
+  gsl_matrix_ushort * B16 = gsl_matrix_ushort_alloc(n1, n2);
+  gsl_matrix * X = gsl_matrix_alloc(n1, n2);
+  double * window = malloc((2 * H + 1) * (2 * H + 1) * sizeof(double));
+  size_t i, j;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          unsigned long v = gsl_rng_uniform_int(r, range);
+
+          gsl_matrix_uchar_set(A8, i, j, (unsigned char) v);
+          gsl_matrix_ushort_set(A16, i, j, (unsigned short) v);
+          gsl_matrix_set(X, i, j, (double) v);
+        }
+    }
+
+  if (nbits == 8)
+    gsl_filter_median2d_uchar(etype, A8, B8, w);
+  else
+    gsl_filter_median2d_ushort(etype, A16, B16, w);
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          size_t m = slow_median2d_window(etype, X, i, j, H, window);
+          double expected, yij;
+
+          gsl_sort(window, 1, m);
+          expected = window[(m - 1) / 2];
+
+          yij = (nbits == 8) ? gsl_matrix_uchar_get(B8, i, j) : gsl_matrix_ushort_get(B16, i, j);
+
+          gsl_test_rel(yij, expected, 0.0, "median2d %zu-bit n1=%zu n2=%zu K=%zu endtype=%u i=%zu j=%zu",
+                       nbits, n1, n2, K, etype, i, j);
+        }
+    }
+
+  gsl_filter_median2d_free(w);
+  gsl_matrix_uchar_free(A8);
+  gsl_matrix_uchar_free(B8);
+  gsl_matrix_ushort_free(A16);
+  gsl_matrix_ushort_free(B16);
+  gsl_matrix_free(X);
+  free(window);
+}
+
+/* use one workspace for 8, 16 and again 8 bit images, whose histograms are allocated on demand */
+static void
+test_median2d_reuse(const size_t n1, const size_t n2, const size_t K, const gsl_filter_end_t etype,
+                    gsl_rng * r)
+{
+  gsl_filter_median2d_workspace * w = gsl_filter_median2d_alloc(K);
+  gsl_filter_median2d_workspace * w8 = gsl_filter_median2d_alloc(K);
+  gsl_filter_median2d_workspace * w16 = gsl_filter_median2d_alloc(K);
+  gsl_matrix_uchar * A8 = gsl_matrix_uchar_alloc(n1, n2);
+  gsl_matrix_uchar * B8 = gsl_matrix_uchar_alloc(n1, n2);
+  gsl_matrix_uchar * C8 = gsl_matrix_uchar_alloc(n1, n2);
+  gsl_matrix_ushort * A16 = gsl_matrix_ushort_alloc(n1, n2);
+  gsl_matrix_ushort * B16 = gsl_matrix_ushort_alloc(n1, n2);
+  gsl_matrix_ushort * C16 = gsl_matrix_ushort_alloc(n1, n2);
+  size_t pass, i, j;
+
+  for (i = 0; i < n1; ++i)
+    {
+      for (j = 0; j < n2; ++j)
+        {
+          gsl_matrix_uchar_set(A8, i, j, (unsigned char) gsl_rng_uniform_int(r, 256));
+          gsl_matrix_ushort_set(A16, i, j, (unsigned short) gsl_rng_uniform_int(r, 65536));
+        }
+    }
+
+  gsl_filter_median2d_uchar(etype, A8, C8, w8);
+  gsl_filter_median2d_ushort(etype, A16, C16, w16);
+
+  for (pass = 0; pass < 3; ++pass)
+    {
+      if (pass == 1)
+        gsl_filter_median2d_ushort(etype, A16, B16, w);
+      else
+        gsl_filter_median2d_uchar(etype, A8, B8, w);
+
+      for (i = 0; i < n1; ++i)
+        {
+          for (j = 0; j < n2; ++j)
+            {
+              if (pass == 1)
+                gsl_test_int(gsl_matrix_ushort_get(B16, i, j), gsl_matrix_ushort_get(C16, i, j),
+                             "median2d reuse pass=%zu n1=%zu n2=%zu K=%zu endtype=%u i=%zu j=%zu",
+                             pass, n1, n2, K, etype, i, j);
+              else
+                gsl_test_int(gsl_matrix_uchar_get(B8, i, j), gsl_matrix_uchar_get(C8, i, j),
+                             "median2d reuse pass=%zu n1=%zu n2=%zu K=%zu endtype=%u i=%zu j=%zu",
+                             pass, n1, n2, K, etype, i, j);
+            }
+        }
+    }
+
+  gsl_filter_median2d_free(w);
+  gsl_filter_median2d_free(w8);
+  gsl_filter_median2d_free(w16);
+  gsl_matrix_uchar_free(A8);
+  gsl_matrix_uchar_free(B8);
+  gsl_matrix_uchar_free(C8);
+  gsl_matrix_ushort_free(A16);
+  gsl_matrix_ushort_free(B16);
+  gsl_matrix_ushort_free(C16);
+}
+
+static void
+test_median2d(gsl_rng * r)
+{
+  const gsl_filter_end_t etypes[] = { GSL_FILTER_END_PADZERO, GSL_FILTER_END_PADVALUE,
+                                      GSL_FILTER_END_TRUNCATE };
+  const size_t windows[] = { 1, 3, 5, 7, 11 };
+  size_t i, k;
+
+  for (k = 0; k < 3; ++k)
+    {
+      for (i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i)
+        {
+          const size_t K = windows[i];
+
+          test_median2d_proc(1, 1, K, etypes[k], r);
+          test_median2d_proc(4, 3, K, etypes[k], r);
+          test_median2d_proc(30, 45, K, etypes[k], r);
+
+          test_median2d_int_proc(8, 1, 1, K, etypes[k], r);
+          test_median2d_int_proc(8, 3, 2, K, etypes[k], r);
+          test_median2d_int_proc(8, 40, 75, K, etypes[k], r);
+          test_median2d_int_proc(16, 2, 5, K, etypes[k], r);
+          test_median2d_int_proc(16, 21, 70, K, etypes[k], r);
+          test_median2d_int_proc(16, 30, 40, K, etypes[k], r);
+        }
+    }
+
+  for (k = 0; k < 3; ++k)
+    test_median2d_reuse(25, 70, 7, etypes[k], r);
+}
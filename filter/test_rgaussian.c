@@ -0,0 +1,304 @@
+/* filter/test_rgaussian.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_filter.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+
+/* compute Gaussian filter by explicit convolution; TRUNCATE uses normalized weights */
+static void
+slow_rgaussian(const gsl_filter_end_t etype, const double sigma, const gsl_vector * x, gsl_vector * y)
+{
+  const int n = (int) x->size;
+  const int H = (int) ceil(8.0 * sigma);
+  int i, j;
+
+  for (i = 0; i < n; ++i)
+    {
+      double sum = 0.0, wsum = 0.0;
+
+      for (j = i - H; j <= i + H; ++j)
+        {
+          const double t = (double) (i - j) / sigma;
+          const double g = exp(-0.5 * t * t);
+          double xj;
+
+          if (j >= 0 && j < n)
+            xj = gsl_vector_get(x, j);
+          else if (etype == GSL_FILTER_END_PADVALUE)
+            xj = gsl_vector_get(x, (j < 0) ? 0 : n - 1);
+          else if (etype == GSL_FILTER_END_PADZERO)
+            xj = 0.0;
+          else
+            continue;
+
+          sum += g * xj;
+          wsum += g;
+        }
+
+      gsl_vector_set(y, i, sum / wsum);
+    }
+}
+
+/* random walk, so the signal has structure at all scales */
+static void
+test_rgaussian_signal(gsl_vector * x, gsl_rng * r)
+{
+  double xi = 0.0;
+  size_t i;
+
+  for (i = 0; i < x->size; ++i)
+    {
+      xi += 2.0 * gsl_rng_uniform(r) - 1.0;
+      gsl_vector_set(x, i, xi);
+    }
+}
+
+/*
+ * compare impulse responses with the sampled Gaussian and its derivatives;
+ * the impulse is far from the ends, so all end types give the same response
+ */
+static void
+test_rgaussian_impulse(const double tol, const double sigma, const size_t order,
+                       const gsl_filter_end_t etype)
+{
+  const size_t n = 2 * (size_t) (20.0 * sigma) + 101;
+  const size_t c = n / 2;
+  gsl_filter_rgaussian_workspace * w = gsl_filter_rgaussian_alloc(n);
+  gsl_vector * x = gsl_vector_calloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * z = gsl_vector_alloc(n);
+  double sum = 0.0, zmax;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      const double t = ((double) i - (double) c) / sigma;
+      const double g = exp(-0.5 * t * t) / (sqrt(2.0 * M_PI) * sigma);
+      double zi;
+
+      if (order == 0)
+        zi = g;
+      else if (order == 1)
+        zi = -t / sigma * g;
+      else
+        zi = (t * t - 1.0) / (sigma * sigma) * g;
+
+      gsl_vector_set(z, i, zi);
+    }
+
+  gsl_vector_set(x, c, 1.0);
+  gsl_filter_rgaussian(etype, sigma, order, x, y, w);
+
+  zmax = GSL_MAX(gsl_vector_max(z), -gsl_vector_min(z));
+
+  for (i = 0; i < n; ++i)
+    {
+      /* skip far tails, where the Gaussian underflows */
+      if (fabs((double) i - (double) c) <= 10.0 * sigma)
+        {
+          gsl_test_abs(gsl_vector_get(y, i) / zmax, gsl_vector_get(z, i) / zmax, tol,
+                       "rgaussian impulse sigma=%g order=%zu endtype=%u i=%zu", sigma, order, etype, i);
+        }
+
+      sum += gsl_vector_get(y, i);
+    }
+
+  gsl_test_abs(sum, (order == 0) ? 1.0 : 0.0, 1.0e-8,
+               "rgaussian impulse sum sigma=%g order=%zu endtype=%u", sigma, order, etype);
+
+  gsl_filter_rgaussian_free(w);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+}
+
+/* compare smoothed random walk with explicit convolution */
+static void
+test_rgaussian_proc(const double tol, const size_t n, const double sigma,
+                    const gsl_filter_end_t etype, gsl_rng * r)
+{
+  gsl_filter_rgaussian_workspace * w = gsl_filter_rgaussian_alloc(n);
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * z = gsl_vector_alloc(n);
+  double xmax;
+  size_t i;
+
+  test_rgaussian_signal(x, r);
+  xmax = GSL_MAX(gsl_vector_max(x), -gsl_vector_min(x));
+
+  gsl_filter_rgaussian(etype, sigma, 0, x, y, w);
+  slow_rgaussian(etype, sigma, x, z);
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_test_abs(gsl_vector_get(y, i) / xmax, gsl_vector_get(z, i) / xmax, tol,
+                   "rgaussian n=%zu sigma=%g endtype=%u i=%zu", n, sigma, etype, i);
+    }
+
+  /* in-place */
+  gsl_filter_rgaussian(etype, sigma, 0, x, x, w);
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_test_rel(gsl_vector_get(x, i), gsl_vector_get(y, i), 0.0,
+                   "rgaussian in-place n=%zu sigma=%g endtype=%u i=%zu", n, sigma, etype, i);
+    }
+
+  gsl_filter_rgaussian_free(w);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+}
+
+/*
+ * check the boundary conditions: padding a signal explicitly with many end
+ * values should not change the output
+ */
+static void
+test_rgaussian_ends(const double tol, const size_t n, const double sigma, const size_t order,
+                    const gsl_filter_end_t etype, gsl_rng * r)
+{
+  const size_t npad = (size_t) (40.0 * sigma) + 50;
+  const size_t N = n + 2 * npad;
+  gsl_filter_rgaussian_workspace * w = gsl_filter_rgaussian_alloc(N);
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * xpad = gsl_vector_alloc(N);
+  gsl_vector * ypad = gsl_vector_alloc(N);
+  double xmax;
+  size_t i;
+
+  test_rgaussian_signal(x, r);
+  xmax = GSL_MAX(gsl_vector_max(x), -gsl_vector_min(x));
+
+  for (i = 0; i < N; ++i)
+    {
+      double xi;
+
+      if (i < npad)
+        xi = (etype == GSL_FILTER_END_PADVALUE) ? gsl_vector_get(x, 0) : 0.0;
+      else if (i >= npad + n)
+        xi = (etype == GSL_FILTER_END_PADVALUE) ? gsl_vector_get(x, n - 1) : 0.0;
+      else
+        xi = gsl_vector_get(x, i - npad);
+
+      gsl_vector_set(xpad, i, xi);
+    }
+
+  gsl_filter_rgaussian(etype, sigma, order, x, y, w);
+  gsl_filter_rgaussian(etype, sigma, order, xpad, ypad, w);
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_test_abs(gsl_vector_get(y, i) / xmax, gsl_vector_get(ypad, i + npad) / xmax, tol,
+                   "rgaussian ends n=%zu sigma=%g order=%zu endtype=%u i=%zu",
+                   n, sigma, order, etype, i);
+    }
+
+  gsl_filter_rgaussian_free(w);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(xpad);
+  gsl_vector_free(ypad);
+}
+
+/* a truncated window average of a constant signal is that constant */
+static void
+test_rgaussian_const(const size_t n, const double sigma, const size_t order)
+{
+  const double value = 3.5;
+  gsl_filter_rgaussian_workspace * w = gsl_filter_rgaussian_alloc(n);
+  gsl_vector * x = gsl_vector_alloc(n);
+  size_t i;
+
+  gsl_vector_set_all(x, value);
+  gsl_filter_rgaussian(GSL_FILTER_END_TRUNCATE, sigma, order, x, x, w);
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_test_abs(gsl_vector_get(x, i), (order == 0) ? value : 0.0, 1.0e-9,
+                   "rgaussian constant n=%zu sigma=%g order=%zu i=%zu", n, sigma, order, i);
+    }
+
+  gsl_filter_rgaussian_free(w);
+  gsl_vector_free(x);
+}
+
+static void
+test_rgaussian(gsl_rng * r)
+{
+  const gsl_filter_end_t etypes[] = { GSL_FILTER_END_PADZERO, GSL_FILTER_END_PADVALUE,
+                                      GSL_FILTER_END_TRUNCATE };
+  size_t k, order;
+
+  /* the approximation is less accurate for small sigma and for derivatives */
+  for (k = 0; k < 3; ++k)
+    {
+      test_rgaussian_impulse(0.1, 0.5, 0, etypes[k]);
+      test_rgaussian_impulse(0.1, 1.0, 0, etypes[k]);
+      test_rgaussian_impulse(0.05, 3.0, 0, etypes[k]);
+      test_rgaussian_impulse(0.02, 20.0, 0, etypes[k]);
+      test_rgaussian_impulse(0.02, 300.0, 0, etypes[k]);
+
+      test_rgaussian_impulse(0.35, 1.0, 1, etypes[k]);
+      test_rgaussian_impulse(0.16, 2.0, 1, etypes[k]);
+      test_rgaussian_impulse(0.13, 3.0, 1, etypes[k]);
+      test_rgaussian_impulse(0.1, 5.0, 1, etypes[k]);
+      test_rgaussian_impulse(0.07, 20.0, 1, etypes[k]);
+      test_rgaussian_impulse(0.07, 50.0, 1, etypes[k]);
+      test_rgaussian_impulse(0.07, 300.0, 1, etypes[k]);
+
+      test_rgaussian_impulse(0.22, 1.0, 2, etypes[k]);
+      test_rgaussian_impulse(0.45, 2.0, 2, etypes[k]);
+      test_rgaussian_impulse(0.45, 3.0, 2, etypes[k]);
+      test_rgaussian_impulse(0.25, 5.0, 2, etypes[k]);
+      test_rgaussian_impulse(0.17, 20.0, 2, etypes[k]);
+      test_rgaussian_impulse(0.17, 50.0, 2, etypes[k]);
+      test_rgaussian_impulse(0.17, 300.0, 2, etypes[k]);
+    }
+
+  for (order = 0; order <= 2; ++order)
+    {
+      test_rgaussian_const(1, 2.0, order);
+      test_rgaussian_const(100, 1.0, order);
+      test_rgaussian_const(100, 50.0, order);
+
+      for (k = 0; k < 2; ++k)
+        {
+          test_rgaussian_ends(1.0e-10, 1, 2.0, order, etypes[k], r);
+          test_rgaussian_ends(1.0e-10, 2, 0.5, order, etypes[k], r);
+          test_rgaussian_ends(1.0e-10, 100, 5.0, order, etypes[k], r);
+          test_rgaussian_ends(1.0e-10, 30, 10.0, order, etypes[k], r);
+          test_rgaussian_ends(1.0e-6, 500, 100.0, order, etypes[k], r);
+        }
+    }
+
+  for (k = 0; k < 3; ++k)
+    {
+      test_rgaussian_proc(0.05, 500, 1.0, etypes[k], r);
+      test_rgaussian_proc(0.05, 500, 3.0, etypes[k], r);
+      test_rgaussian_proc(0.05, 1000, 20.0, etypes[k], r);
+      test_rgaussian_proc(0.05, 3000, 200.0, etypes[k], r);
+      test_rgaussian_proc(0.05, 50, 100.0, etypes[k], r);
+    }
+}
@@ -0,0 +1,308 @@
+/* filter/test_stream.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+
+/* filters applied to signals received in pieces */
+enum
+{
+  TEST_STREAM_GAUSSIAN,
+  TEST_STREAM_MEDIAN,
+  TEST_STREAM_RMEDIAN,
+  TEST_STREAM_IMPULSE
+};
+
+/* push piece x through stream s; for impulse filters, also output window medians, scales and outliers */
+static size_t
+test_stream_push(const int type, void * s, const gsl_vector * x, gsl_vector * y, gsl_vector * xmedian,
+                 gsl_vector * xsigma, size_t * noutlier, gsl_vector_int * ioutlier)
+{
+  size_t ny = 0;
+
+  switch (type)
+    {
+      case TEST_STREAM_GAUSSIAN:
+        gsl_filter_gaussian_stream_push(x, y, &ny, (gsl_filter_gaussian_stream *) s);
+        break;
+
+      case TEST_STREAM_MEDIAN:
+        gsl_filter_median_stream_push(x, y, &ny, (gsl_filter_median_stream *) s);
+        break;
+
+      case TEST_STREAM_RMEDIAN:
+        gsl_filter_rmedian_stream_push(x, y, &ny, (gsl_filter_rmedian_stream *) s);
+        break;
+
+      default:
+        gsl_filter_impulse_stream_push(x, y, xmedian, xsigma, &ny, noutlier, ioutlier,
+                                       (gsl_filter_impulse_stream *) s);
+        break;
+    }
+
+  return ny;
+}
+
+static size_t
+test_stream_finish(const int type, void * s, gsl_vector * y, gsl_vector * xmedian,
+                   gsl_vector * xsigma, size_t * noutlier, gsl_vector_int * ioutlier)
+{
+  size_t ny = 0;
+
+  switch (type)
+    {
+      case TEST_STREAM_GAUSSIAN:
+        gsl_filter_gaussian_stream_finish(y, &ny, (gsl_filter_gaussian_stream *) s);
+        break;
+
+      case TEST_STREAM_MEDIAN:
+        gsl_filter_median_stream_finish(y, &ny, (gsl_filter_median_stream *) s);
+        break;
+
+      case TEST_STREAM_RMEDIAN:
+        gsl_filter_rmedian_stream_finish(y, &ny, (gsl_filter_rmedian_stream *) s);
+        break;
+
+      default:
+        gsl_filter_impulse_stream_finish(y, xmedian, xsigma, &ny, noutlier, ioutlier,
+                                         (gsl_filter_impulse_stream *) s);
+        break;
+    }
+
+  return ny;
+}
+
+/*
+ * compare filter applied to x in random pieces with the filter applied to
+ * the whole signal; the outputs must be identical
+ */
+static void
+test_stream_proc(const int type, const gsl_filter_scale_t scale_type, const size_t order,
+                 const size_t n, const size_t K, const gsl_filter_end_t etype, gsl_rng * rng_p)
+{
+  const char *names[] = { "gaussian", "median", "rmedian", "impulse" };
+  const double alpha = 2.5;
+  const double t = 2.0;
+  void *s;
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * xmedian = gsl_vector_alloc(n);
+  gsl_vector * xsigma = gsl_vector_alloc(n);
+  gsl_vector_int * ioutlier = gsl_vector_int_alloc(n);
+  gsl_vector * u = gsl_vector_alloc(n);
+  gsl_vector * umedian = gsl_vector_alloc(n);
+  gsl_vector * usigma = gsl_vector_alloc(n);
+  gsl_vector_int * uoutlier = gsl_vector_int_alloc(n);
+  gsl_vector * buf = gsl_vector_alloc(n);
+  gsl_vector * bmedian = gsl_vector_alloc(n);
+  gsl_vector * bsigma = gsl_vector_alloc(n);
+  gsl_vector_int * boutlier = gsl_vector_int_alloc(n);
+  size_t noutlier = 0;
+  int inplace;
+  size_t i, j;
+
+  random_vector(x, rng_p);
+
+  /* add some outliers */
+  for (i = 0; i < n; i += 7)
+    gsl_vector_set(x, i, 10.0 * gsl_vector_get(x, i));
+
+  switch (type)
+    {
+      case TEST_STREAM_GAUSSIAN:
+        {
+          gsl_filter_gaussian_workspace * w = gsl_filter_gaussian_alloc(K);
+          gsl_filter_gaussian(etype, alpha, order, x, y, w);
+          gsl_filter_gaussian_free(w);
+          s = gsl_filter_gaussian_stream_alloc(etype, alpha, order, K);
+          break;
+        }
+
+      case TEST_STREAM_MEDIAN:
+        {
+          gsl_filter_median_workspace * w = gsl_filter_median_alloc(K);
+          gsl_filter_median(etype, x, y, w);
+          gsl_filter_median_free(w);
+          s = gsl_filter_median_stream_alloc(etype, K);
+          break;
+        }
+
+      case TEST_STREAM_RMEDIAN:
+        {
+          gsl_filter_rmedian_workspace * w = gsl_filter_rmedian_alloc(K);
+          gsl_filter_rmedian(etype, x, y, w);
+          gsl_filter_rmedian_free(w);
+          s = gsl_filter_rmedian_stream_alloc(etype, K);
+          break;
+        }
+
+      default:
+        {
+          gsl_filter_impulse_workspace * w = gsl_filter_impulse_alloc(K);
+          gsl_filter_impulse(etype, scale_type, t, x, y, xmedian, xsigma, &noutlier, ioutlier, w);
+          gsl_filter_impulse_free(w);
+          s = gsl_filter_impulse_stream_alloc(etype, scale_type, t, K);
+          break;
+        }
+    }
+
+  for (inplace = 0; inplace <= 1; ++inplace)
+    {
+      size_t nout = 0, nout_total = 0, nb, ny;
+
+      i = 0;
+      while (i < n)
+        {
+          size_t m = 1 + gsl_rng_uniform_int(rng_p, GSL_MIN(n - i, 2 * K + 3));
+          gsl_vector_const_view xv = gsl_vector_const_subvector(x, i, m);
+          gsl_vector_view bv = gsl_vector_subvector(buf, 0, m);
+
+          if (inplace)
+            {
+              gsl_vector_memcpy(&bv.vector, &xv.vector);
+              ny = test_stream_push(type, s, &bv.vector, &bv.vector, bmedian, bsigma, &nb, boutlier);
+            }
+          else
+            {
+              ny = test_stream_push(type, s, &xv.vector, &bv.vector, bmedian, bsigma, &nb, boutlier);
+            }
+
+          for (j = 0; j < ny; ++j)
+            {
+              gsl_vector_set(u, nout + j, gsl_vector_get(buf, j));
+              gsl_vector_set(umedian, nout + j, gsl_vector_get(bmedian, j));
+              gsl_vector_set(usigma, nout + j, gsl_vector_get(bsigma, j));
+              gsl_vector_int_set(uoutlier, nout + j, gsl_vector_int_get(boutlier, j));
+            }
+
+          i += m;
+          nout += ny;
+          if (type == TEST_STREAM_IMPULSE)
+            nout_total += nb;
+        }
+
+      ny = test_stream_finish(type, s, buf, bmedian, bsigma, &nb, boutlier);
+
+      for (j = 0; j < ny; ++j)
+        {
+          gsl_vector_set(u, nout + j, gsl_vector_get(buf, j));
+          gsl_vector_set(umedian, nout + j, gsl_vector_get(bmedian, j));
+          gsl_vector_set(usigma, nout + j, gsl_vector_get(bsigma, j));
+          gsl_vector_int_set(uoutlier, nout + j, gsl_vector_int_get(boutlier, j));
+        }
+
+      gsl_test_int(nout + ny, n, "stream %s output length n=%zu K=%zu endtype=%u", names[type], n, K, etype);
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_test_rel(gsl_vector_get(u, i), gsl_vector_get(y, i), 0.0,
+                       "stream %s inplace=%d order=%zu n=%zu K=%zu endtype=%u scale=%u i=%zu",
+                       names[type], inplace, order, n, K, etype, scale_type, i);
+        }
+
+      if (type == TEST_STREAM_IMPULSE)
+        {
+          nout_total += nb;
+          gsl_test_int(nout_total, noutlier, "stream impulse noutlier n=%zu K=%zu endtype=%u scale=%u",
+                       n, K, etype, scale_type);
+
+          for (i = 0; i < n; ++i)
+            {
+              gsl_test_rel(gsl_vector_get(umedian, i), gsl_vector_get(xmedian, i), 0.0,
+                           "stream impulse xmedian inplace=%d n=%zu K=%zu endtype=%u scale=%u i=%zu",
+                           inplace, n, K, etype, scale_type, i);
+              gsl_test_rel(gsl_vector_get(usigma, i), gsl_vector_get(xsigma, i), 0.0,
+                           "stream impulse xsigma inplace=%d n=%zu K=%zu endtype=%u scale=%u i=%zu",
+                           inplace, n, K, etype, scale_type, i);
+              gsl_test_int(gsl_vector_int_get(uoutlier, i), gsl_vector_int_get(ioutlier, i),
+                           "stream impulse ioutlier inplace=%d n=%zu K=%zu endtype=%u scale=%u i=%zu",
+                           inplace, n, K, etype, scale_type, i);
+            }
+        }
+    }
+
+  switch (type)
+    {
+      case TEST_STREAM_GAUSSIAN:
+        gsl_filter_gaussian_stream_free((gsl_filter_gaussian_stream *) s);
+        break;
+
+      case TEST_STREAM_MEDIAN:
+        gsl_filter_median_stream_free((gsl_filter_median_stream *) s);
+        break;
+
+      case TEST_STREAM_RMEDIAN:
+        gsl_filter_rmedian_stream_free((gsl_filter_rmedian_stream *) s);
+        break;
+
+      default:
+        gsl_filter_impulse_stream_free((gsl_filter_impulse_stream *) s);
+        break;
+    }
+
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(xmedian);
+  gsl_vector_free(xsigma);
+  gsl_vector_int_free(ioutlier);
+  gsl_vector_free(u);
+  gsl_vector_free(umedian);
+  gsl_vector_free(usigma);
+  gsl_vector_int_free(uoutlier);
+  gsl_vector_free(buf);
+  gsl_vector_free(bmedian);
+  gsl_vector_free(bsigma);
+  gsl_vector_int_free(boutlier);
+}
+
+static void
+test_stream(gsl_rng * rng_p)
+{
+  const gsl_filter_end_t etypes[] = { GSL_FILTER_END_PADZERO, GSL_FILTER_END_PADVALUE,
+                                      GSL_FILTER_END_TRUNCATE };
+  const gsl_filter_scale_t scale_types[] = { GSL_FILTER_SCALE_MAD, GSL_FILTER_SCALE_IQR,
+                                             GSL_FILTER_SCALE_SN, GSL_FILTER_SCALE_QN };
+  const size_t windows[] = { 1, 3, 4, 11, 31 };
+  const size_t lengths[] = { 1, 2, 5, 200 };
+  size_t i, k, l, order;
+
+  for (k = 0; k < 3; ++k)
+    {
+      for (i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i)
+        {
+          for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+            {
+              const size_t K = windows[i];
+              const size_t n = lengths[l];
+              size_t j;
+
+              for (order = 0; order <= 2; ++order)
+                test_stream_proc(TEST_STREAM_GAUSSIAN, GSL_FILTER_SCALE_MAD, order, n, K, etypes[k], rng_p);
+
+              test_stream_proc(TEST_STREAM_MEDIAN, GSL_FILTER_SCALE_MAD, 0, n, K, etypes[k], rng_p);
+              test_stream_proc(TEST_STREAM_RMEDIAN, GSL_FILTER_SCALE_MAD, 0, n, K, etypes[k], rng_p);
+
+              for (j = 0; j < 4; ++j)
+                test_stream_proc(TEST_STREAM_IMPULSE, scale_types[j], 0, n, K, etypes[k], rng_p);
+            }
+        }
+    }
+}
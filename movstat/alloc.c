@@ -120,6 +120,7 @@ gsl_movstat_alloc_with_size(const size_t accum_state_size, const size_t H, const
       state_size = GSL_MAX(state_size, (gsl_movstat_accum_Qn->size)(w->K));     /* Q_n accumulator */
       state_size = GSL_MAX(state_size, (gsl_movstat_accum_qqr->size)(w->K));    /* QQR accumulator */
       state_size = GSL_MAX(state_size, (gsl_movstat_accum_Sn->size)(w->K));     /* S_n accumulator */
+      state_size = GSL_MAX(state_size, (gsl_movstat_accum_trmean->size)(w->K)); /* trimmed mean accumulator */
     }
 
   w->state = malloc(state_size);
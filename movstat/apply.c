@@ -41,6 +41,9 @@ Inputs: endtype      - end point handling criteria
 
 Notes:
 1) It is allowed to have x = y for in-place moving statistics
+
+2) This is equivalent to passing x to gsl_movstat_stream_push() as a
+single piece, followed by gsl_movstat_stream_finish()
 */
 
 int
@@ -62,131 +65,179 @@ gsl_movstat_apply_accum(const gsl_movstat_end_t endtype,
     }
   else
     {
-      const int n = (int) x->size;
-      const int H = w->H; /* number of samples to left of current sample */
-      const int J = w->J; /* number of samples to right of current sample */
-      int i;
-      double x1 = 0.0;    /* pad values for data edges */
-      double xN = 0.0;
-      double result[2];
-
-      /* initialize accumulator */
-      (accum->init)(w->K, w->state);
-
-      /* pad initial window if necessary */
-      if (endtype != GSL_MOVSTAT_END_TRUNCATE)
-        {
-          if (endtype == GSL_MOVSTAT_END_PADZERO)
-            {
-              x1 = 0.0;
-              xN = 0.0;
-            }
-          else if (endtype == GSL_MOVSTAT_END_PADVALUE)
-            {
-              x1 = gsl_vector_get(x, 0);
-              xN = gsl_vector_get(x, n - 1);
-            }
-
-          /* pad initial windows with H values */
-          for (i = 0; i < H; ++i)
-            (accum->insert)(x1, w->state);
-        }
-      else if (accum->delete_oldest == NULL) /* FIXME XXX */
-        {
-          /* save last K - 1 samples of x for later (needed for in-place input/output) */
-          int idx1 = GSL_MAX(n - J - H, 0);
-          int idx2 = n - 1;
+      const size_t n = x->size;
+      gsl_movstat_stream s;
+      size_t ny;
+      int status;
 
-          for (i = idx1; i <= idx2; ++i)
-            w->work[i - idx1] = gsl_vector_get(x, i);
-        }
+      /* process the whole vector as a single piece of a stream */
+      s.endtype = endtype;
+      s.accum = accum;
+      s.accum_params = accum_params;
+      s.H = w->H;
+      s.J = w->J;
+      s.K = w->K;
+      s.work = w->work;
+      s.state = w->state;
+
+      gsl_movstat_stream_reset(&s);
 
       /* process input vector and fill y(0:n - J - 1) */
-      for (i = 0; i < n; ++i)
-        {
-          double xi = gsl_vector_get(x, i);
-          int idx = i - J;
+      status = gsl_movstat_stream_push(x, y, z, &ny, &s);
+      if (status)
+        return status;
 
-          (accum->insert)(xi, w->state);
+      if (ny < n)
+        {
+          /* fill y(n-J:n-1) */
+          gsl_vector_view yv = gsl_vector_subvector(y, ny, n - ny);
+          gsl_vector_view zv;
+          size_t nfinish;
 
-          if (idx >= 0)
-            {
-              (accum->get)(accum_params, result, w->state);
-              gsl_vector_set(y, idx, result[0]);
+          if (z != NULL)
+            zv = gsl_vector_subvector(z, ny, n - ny);
 
-              if (z != NULL)
-                gsl_vector_set(z, idx, result[1]);
-            }
+          status = gsl_movstat_stream_finish(&yv.vector, (z != NULL) ? &zv.vector : NULL, &nfinish, &s);
         }
 
-      if (endtype == GSL_MOVSTAT_END_TRUNCATE)
+      return status;
+    }
+}
+
+/*
+gsl_movstat_apply_accum_range()
+  Apply moving window statistic to input vector, computing only the
+outputs y(first:last-1). Calls for disjoint ranges are independent, so
+that a long vector may be divided into ranges which are processed
+concurrently by different threads.
+
+Inputs: endtype      - end point handling criteria
+        x            - input vector, size n
+        accum        - accumulator to apply moving window statistic
+        accum_params - parameters to pass to accumulator
+        first        - first output index
+        last         - one past the last output index, first <= last <= n
+        y            - output vector, size n; only y(first:last-1) is modified
+        z            - second output vector (i.e. minmax), size n; can be NULL
+        w            - workspace; each concurrent call needs its own workspace
+
+Notes:
+1) The windows of outputs first, ..., last-1 only contain the samples
+x(first-H:last-1+J), so the range is processed as a stream which starts
+before sample first-H, storing only the outputs in the range. The
+windows are then identical to those of gsl_movstat_apply_accum(),
+including the padded or truncated windows at the ends of x
+
+2) The mean, variance and sum accumulators update a running sum as the
+window moves, and recompute it from the window after every K-th
+insertion. The stream therefore starts at a multiple of K, at most 2K
+samples before first+J, so that it passes through a recomputation with
+a window of samples of x before output first, after which its
+accumulator state is identical to that of gsl_movstat_apply_accum().
+Results are then identical to gsl_movstat_apply_accum() for all
+built-in accumulators, and for user accumulators whose output depends
+only on the samples in the window
+
+3) Since other ranges may read any part of x, x and y must not overlap
+*/
+
+int
+gsl_movstat_apply_accum_range(const gsl_movstat_end_t endtype,
+                              const gsl_vector * x,
+                              const gsl_movstat_accum * accum,
+                              void * accum_params,
+                              const size_t first,
+                              const size_t last,
+                              gsl_vector * y,
+                              gsl_vector * z,
+                              gsl_movstat_workspace * w)
+{
+  if (x->size != y->size)
+    {
+      GSL_ERROR("input and output vectors must have same length", GSL_EBADLEN);
+    }
+  else if (z != NULL && x->size != z->size)
+    {
+      GSL_ERROR("input and output vectors must have same length", GSL_EBADLEN);
+    }
+  else if (first > last || last > x->size)
+    {
+      GSL_ERROR("invalid output range", GSL_EINVAL);
+    }
+  else if (first == last)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t n = x->size;
+      const size_t nrange = last - first;
+      const size_t K = w->K;
+      const size_t iend = GSL_MIN(n, last + w->J);             /* one past last sample needed */
+      const size_t iout = GSL_MIN(first + w->J, n - 1);        /* last sample pushed before output first */
+      gsl_movstat_stream s;
+      size_t istart = 0;                                       /* first sample pushed */
+      size_t i, nout = 0;
+      int status = GSL_SUCCESS;
+
+      /*
+       * start at a multiple of K, so that K windows of samples of x end in
+       * x(istart+K-1:iout), one of them at a recomputation of the accumulator
+       */
+      if (iout + 2 >= 2 * K)
+        istart = K * ((iout + 2 - 2 * K) / K);
+
+      s.endtype = endtype;
+      s.accum = accum;
+      s.accum_params = accum_params;
+      s.H = w->H;
+      s.J = w->J;
+      s.K = w->K;
+      s.work = w->work;
+      s.state = w->state;
+
+      gsl_movstat_stream_reset(&s);
+
+      /* the stream starts at sample istart; only store outputs first, ..., last-1 */
+      s.ifirst = first - istart;
+      s.ilast = last - istart;
+
+      /*
+       * push x(istart:iend-1) in pieces no longer than the remaining part of
+       * the output range, so that the outputs can be stored directly in y
+       */
+      i = istart;
+      while (i < iend && status == GSL_SUCCESS)
         {
-          /* need to fill y(n-J:n-1) using shrinking windows */
-          int idx1 = GSL_MAX(n - J, 0);
-          int idx2 = n - 1;
-
-          if (accum->delete_oldest == NULL)
-            {
-              int wsize = n - GSL_MAX(n - J - H, 0); /* size of work array */
-
-              for (i = idx1; i <= idx2; ++i)
-                {
-                  int nsamp = n - GSL_MAX(i - H, 0); /* number of samples in this window */
-                  int j;
-
-                  (accum->init)(w->K, w->state);
-
-                  for (j = wsize - nsamp; j < wsize; ++j)
-                    (accum->insert)(w->work[j], w->state);
-
-                  /* yi = acc_get [ work(i:K-2) ] */
-                  (accum->get)(accum_params, result, w->state);
-                  gsl_vector_set(y, i, result[0]);
-
-                  if (z != NULL)
-                    gsl_vector_set(z, i, result[1]);
-                }
-            }
-          else
-            {
-              for (i = idx1; i <= idx2; ++i)
-                {
-                  if (i - H > 0)
-                    {
-                      /* delete oldest window sample as we move closer to edge */
-                      (accum->delete_oldest)(w->state);
-                    }
-
-                  /* yi = acc_get [ work(i:K-2) ] */
-                  (accum->get)(accum_params, result, w->state);
-                  gsl_vector_set(y, i, result[0]);
-
-                  if (z != NULL)
-                    gsl_vector_set(z, i, result[1]);
-                }
-            }
+          const size_t m = GSL_MIN(iend - i, nrange - nout);
+          gsl_vector_const_view xv = gsl_vector_const_subvector(x, i, m);
+          gsl_vector_view yv = gsl_vector_subvector(y, first + nout, m);
+          gsl_vector_view zv;
+          size_t ny;
+
+          if (z != NULL)
+            zv = gsl_vector_subvector(z, first + nout, m);
+
+          status = gsl_movstat_stream_push(&xv.vector, &yv.vector, (z != NULL) ? &zv.vector : NULL, &ny, &s);
+
+          i += m;
+          nout += ny;
         }
-      else
+
+      if (status == GSL_SUCCESS && nout < nrange)
         {
-          /* pad final windows and fill y(n-J:n-1) */
-          for (i = 0; i < J; ++i)
-            {
-              int idx = n - J + i;
-
-              (accum->insert)(xN, w->state);
-
-              if (idx >= 0)
-                {
-                  (accum->get)(accum_params, result, w->state);
-                  gsl_vector_set(y, idx, result[0]);
-
-                  if (z != NULL)
-                    gsl_vector_set(z, idx, result[1]);
-                }
-            }
+          /* the range includes the final windows of x */
+          gsl_vector_view yv = gsl_vector_subvector(y, first + nout, nrange - nout);
+          gsl_vector_view zv;
+          size_t ny;
+
+          if (z != NULL)
+            zv = gsl_vector_subvector(z, first + nout, nrange - nout);
+
+          status = gsl_movstat_stream_finish(&yv.vector, (z != NULL) ? &zv.vector : NULL, &ny, &s);
         }
 
-      return GSL_SUCCESS;
+      return status;
     }
 }
 
@@ -22,6 +22,7 @@
 
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -79,6 +80,37 @@ typedef struct
   size_t state_size; /* bytes allocated for 'state' */
 } gsl_movstat_workspace;
 
+/* stream for moving window statistics of signals received in pieces */
+
+typedef struct
+{
+  gsl_movstat_end_t endtype;       /* end point handling criteria */
+  const gsl_movstat_accum * accum; /* accumulator */
+  void * accum_params;             /* parameters passed to accumulator */
+  size_t H;                        /* number of previous samples in window */
+  size_t J;                        /* number of after samples in window */
+  size_t K;                        /* window size K = H + J + 1 */
+  size_t n;                        /* number of samples received */
+  size_t ifirst;                   /* only outputs ifirst <= i < ilast are stored */
+  size_t ilast;
+  double x1;                       /* value for padding initial windows */
+  double xN;                       /* value for padding final windows */
+  double *work;                    /* last K samples received, size K */
+  void *state;                     /* accumulator state */
+} gsl_movstat_stream;
+
+/* workspace for moving window statistics of multi-channel signals */
+
+typedef struct
+{
+  size_t H;                                   /* number of previous samples in window */
+  size_t J;                                   /* number of after samples in window */
+  size_t K;                                   /* window size K = H + J + 1 */
+  size_t p;                                   /* number of channels */
+  double *work;                               /* workspace, size (3*K + 4)*p */
+  gsl_movstat_workspace *movstat_workspace_p; /* single-channel workspace */
+} gsl_movstat_matrix_workspace;
+
 /* alloc.c */
 
 gsl_movstat_workspace *gsl_movstat_alloc(const size_t K);
@@ -91,6 +123,11 @@ int gsl_movstat_apply_accum(const gsl_movstat_end_t endtype, const gsl_vector *
                             const gsl_movstat_accum * accum, void * accum_params,
                             gsl_vector * y, gsl_vector * z,
                             gsl_movstat_workspace * w);
+int gsl_movstat_apply_accum_range(const gsl_movstat_end_t endtype, const gsl_vector * x,
+                                  const gsl_movstat_accum * accum, void * accum_params,
+                                  const size_t first, const size_t last,
+                                  gsl_vector * y, gsl_vector * z,
+                                  gsl_movstat_workspace * w);
 int gsl_movstat_apply(const gsl_movstat_end_t endtype, const gsl_movstat_function * F,
                       const gsl_vector * x, gsl_vector * y, gsl_movstat_workspace * w);
 
@@ -111,12 +148,45 @@ int gsl_movstat_mad(const gsl_movstat_end_t endtype, const gsl_vector * x, gsl_v
                     gsl_vector * xmad, gsl_movstat_workspace * w);
 int gsl_movstat_qqr(const gsl_movstat_end_t endtype, const gsl_vector * x, const double q,
                     gsl_vector * xqqr, gsl_movstat_workspace * w);
+int gsl_movstat_quantile(const gsl_movstat_end_t endtype, const gsl_vector * x, const double q,
+                         gsl_vector * xquantile, gsl_movstat_workspace * w);
+int gsl_movstat_trmean(const gsl_movstat_end_t endtype, const gsl_vector * x, const double alpha,
+                       gsl_vector * y, gsl_movstat_workspace * w);
+int gsl_movstat_winsorized_mean(const gsl_movstat_end_t endtype, const gsl_vector * x, const double alpha,
+                                gsl_vector * y, gsl_movstat_workspace * w);
 int gsl_movstat_Sn(const gsl_movstat_end_t endtype, const gsl_vector * x,
                    gsl_vector * xscale, gsl_movstat_workspace * w);
 int gsl_movstat_Qn(const gsl_movstat_end_t endtype, const gsl_vector * x,
                    gsl_vector * xscale, gsl_movstat_workspace * w);
 int gsl_movstat_sum(const gsl_movstat_end_t endtype, const gsl_vector * x, gsl_vector * y, gsl_movstat_workspace * w);
 
+/* stream.c */
+gsl_movstat_stream *gsl_movstat_stream_alloc(const gsl_movstat_end_t endtype, const gsl_movstat_accum * accum,
+                                             void * accum_params, const size_t H, const size_t J);
+void gsl_movstat_stream_free(gsl_movstat_stream * s);
+int gsl_movstat_stream_reset(gsl_movstat_stream * s);
+size_t gsl_movstat_stream_delay(const gsl_movstat_stream * s);
+int gsl_movstat_stream_push(const gsl_vector * x, gsl_vector * y, gsl_vector * z, size_t * ny,
+                            gsl_movstat_stream * s);
+int gsl_movstat_stream_finish(gsl_vector * y, gsl_vector * z, size_t * ny, gsl_movstat_stream * s);
+
+/* matrix.c */
+gsl_movstat_matrix_workspace *gsl_movstat_matrix_alloc(const size_t K, const size_t p);
+gsl_movstat_matrix_workspace *gsl_movstat_matrix_alloc2(const size_t H, const size_t J, const size_t p);
+void gsl_movstat_matrix_free(gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_apply_accum(const gsl_movstat_end_t endtype, const gsl_matrix * X,
+                                   const gsl_movstat_accum * accum, void * accum_params,
+                                   gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_mean(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_variance(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_sd(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_sum(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_min(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_max(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_minmax(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y_min, gsl_matrix * Y_max,
+                              gsl_movstat_matrix_workspace * w);
+int gsl_movstat_matrix_median(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+
 /* accumulator variables */
 
 GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_mad;
@@ -130,8 +200,11 @@ GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_Sn;
 GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_sum;
 GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_Qn;
 GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_qqr;
+GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_quantile;
+GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_trmean;
 GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_userfunc;
 GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_variance;
+GSL_VAR const gsl_movstat_accum * gsl_movstat_accum_winsorized_mean;
 
 __END_DECLS
 
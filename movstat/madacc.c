@@ -32,16 +32,16 @@
 
 typedef double madacc_type_t;
 typedef madacc_type_t ringbuf_type_t;
+typedef madacc_type_t skiplist_type_t;
 
 #include "ringbuf.c"
+#include "skiplist.c"
 
 typedef struct
 {
   size_t n;                        /* window size */
-  const gsl_movstat_accum *medacc; /* median accumulator */
-  void *median_state;              /* median accumulator workspace */
   ringbuf *rbuf;                   /* ring buffer storing current window, size n */
-  madacc_type_t *work;             /* workspace, size n */
+  skiplist *slist;                 /* current window in sorted order, size n */
 } madacc_state_t;
 
 static size_t madacc_size(const size_t n);
@@ -49,17 +49,18 @@ static int madacc_init(const size_t n, void * vstate);
 static int madacc_insert(const madacc_type_t x, void * vstate);
 static int madacc_delete(void * vstate);
 static int madacc_medmad(void * params, madacc_type_t * result, const void * vstate);
+static double madacc_select(const int k, const double median, const int p, const skiplist * slist);
+static double madacc_get(const int i, const skiplist * slist);
+static int madacc_rank(const double x, const skiplist * slist);
 
 static size_t
 madacc_size(const size_t n)
 {
   size_t size = 0;
-  const gsl_movstat_accum * acc = gsl_movstat_accum_median;
 
   size += sizeof(madacc_state_t);
-  size += (acc->size)(n);            /* median accumulator */
   size += ringbuf_size(n);           /* rbuf */
-  size += n * sizeof(madacc_type_t); /* work */
+  size += skiplist_size(n);          /* slist */
 
   return size;
 }
@@ -70,14 +71,12 @@ madacc_init(const size_t n, void * vstate)
   madacc_state_t * state = (madacc_state_t *) vstate;
 
   state->n = n;
-  state->medacc = gsl_movstat_accum_median;
 
-  state->median_state = (void *) ((unsigned char *) vstate + sizeof(madacc_state_t));
-  state->rbuf = (ringbuf *) ((unsigned char *) state->median_state + (state->medacc->size)(n));
-  state->work = (madacc_type_t *) ((unsigned char *) state->rbuf + ringbuf_size(n));
+  state->rbuf = (ringbuf *) ((unsigned char *) vstate + sizeof(madacc_state_t));
+  state->slist = (skiplist *) ((unsigned char *) state->rbuf + ringbuf_size(n));
 
-  (state->medacc->init)(n, state->median_state);
   ringbuf_init(n, state->rbuf);
+  skiplist_init(n, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -87,11 +86,13 @@ madacc_insert(const madacc_type_t x, void * vstate)
 {
   madacc_state_t * state = (madacc_state_t *) vstate;
 
-  /* insert element into median accumulator */
-  (state->medacc->insert)(x, state->median_state);
+  /* remove oldest element from sorted window if it is about to be overwritten */
+  if (ringbuf_is_full(state->rbuf))
+    skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
 
-  /* insert element into ring buffer */
+  /* insert element into ring buffer and sorted window */
   ringbuf_insert(x, state->rbuf);
+  skiplist_insert(x, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -102,7 +103,10 @@ madacc_delete(void * vstate)
   madacc_state_t * state = (madacc_state_t *) vstate;
 
   if (!ringbuf_is_empty(state->rbuf))
-    ringbuf_pop_back(state->rbuf);
+    {
+      skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+      ringbuf_pop_back(state->rbuf);
+    }
 
   return GSL_SUCCESS;
 }
@@ -118,26 +122,31 @@ madacc_medmad(void * params, madacc_type_t * result, const void * vstate)
     }
   else
     {
-      int status;
       const double scale = *(double *) params;
-      const int n = ringbuf_n(state->rbuf);
-      int i;
-      double median, mad;
+      const int n = state->slist->n;
+      const int lhs = (n - 1) / 2;
+      const int rhs = n / 2;
+      double median, mad, mid[2];
+      int p;
 
-      /* compute median of current window */
-      status = (state->medacc->get)(NULL, &median, state->median_state);
-      if (status)
-        return status;
+      /* compute median of current window, as in gsl_stats_median_from_sorted_data() */
+      skiplist_copy(lhs, rhs - lhs + 1, mid, state->slist);
+      median = (lhs == rhs) ? mid[0] : (mid[0] + mid[1]) / 2.0;
 
-      /* compute current window absolute deviations from median */
-      for (i = 0; i < n; ++i)
+      /* number of window samples less than the median */
+      p = madacc_rank(median, state->slist);
+
+      /* compute MAD of current window, as the median of the absolute deviations */
+      if (lhs == rhs)
         {
-          double xi = state->rbuf->array[(state->rbuf->head + i) % state->rbuf->size];
-          state->work[i] = fabs(xi - median);
+          mad = madacc_select(lhs, median, p, state->slist);
+        }
+      else
+        {
+          double a = madacc_select(lhs, median, p, state->slist);
+          double b = madacc_select(rhs, median, p, state->slist);
+          mad = 0.5 * (a + b);
         }
-
-      /* compute MAD of current window */
-      mad = gsl_stats_median(state->work, 1, n);
 
       result[0] = median;
       result[1] = scale * mad;
@@ -146,12 +155,97 @@ madacc_medmad(void * params, madacc_type_t * result, const void * vstate)
     }
 }
 
+/*
+madacc_select()
+  Find the k-th smallest absolute deviation |x_i - median| of the window
+
+Inputs: k      - index of absolute deviation, 0 <= k < n
+        median - window median
+        p      - number of window samples less than median
+        slist  - sorted window x_0 <= ... <= x_{n-1}
+
+Notes:
+1) The deviations of the samples below the median, L_i = median - x_{p-1-i},
+and of the remaining samples, R_j = x_{p+j} - median, form two sorted sequences,
+so the k-th smallest of their union is found by a binary search on the number
+of elements taken from L, in O(log^2 n) operations
+*/
+
+static double
+madacc_select(const int k, const double median, const int p, const skiplist * slist)
+{
+  const int nL = p;
+  const int nR = slist->n - p;
+  int lo = GSL_MAX(0, k + 1 - nR);
+  int hi = GSL_MIN(k + 1, nL);
+  double result = 0.0;
+
+  /* find the number of elements i taken from L for the k+1 smallest deviations */
+  while (lo < hi)
+    {
+      int i = (lo + hi) / 2;
+      int j = k + 1 - i;
+      double Li = median - madacc_get(p - 1 - i, slist);
+      double Rj = madacc_get(p + j - 1, slist) - median;
+
+      if (Li < Rj)
+        lo = i + 1;
+      else
+        hi = i;
+    }
+
+  /* the k-th smallest deviation is the largest of the last elements taken */
+  if (lo > 0)
+    result = median - madacc_get(p - lo, slist);
+
+  if (k + 1 - lo > 0)
+    {
+      double Rj = madacc_get(p + k - lo, slist) - median;
+      if (lo == 0 || Rj > result)
+        result = Rj;
+    }
+
+  return result;
+}
+
+/* return i-th smallest element of window */
+static double
+madacc_get(const int i, const skiplist * slist)
+{
+  double x;
+  skiplist_copy(i, 1, &x, slist);
+  return x;
+}
+
+/* return number of window samples less than x */
+static int
+madacc_rank(const double x, const skiplist * slist)
+{
+  const int L = slist->nlevels;
+  int node = 0;
+  int rank = 0;
+  int l;
+
+  for (l = L - 1; l >= 0; --l)
+    {
+      int next;
+
+      while ((next = slist->next[node * L + l]) != SKIPLIST_NIL && skiplist_lt(slist->value[next], x))
+        {
+          rank += slist->width[node * L + l];
+          node = next;
+        }
+    }
+
+  return rank;
+}
+
 static const gsl_movstat_accum mad_accum_type =
 {
   madacc_size,
   madacc_init,
   madacc_insert,
-  NULL, /*XXX*/
+  madacc_delete,
   madacc_medmad
 };
 
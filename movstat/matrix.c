@@ -0,0 +1,862 @@
+/* movstat/matrix.c
+ *
+ * Moving window statistics of multi-channel signals
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * The input is an n-by-p matrix X whose columns are p channels sampled
+ * at the same times, so that row i holds sample i of every channel.
+ * The sum, mean and variance accumulators process a whole row at a time,
+ * with the same operations applied to every channel, so the inner loops
+ * over channels are contiguous in memory and can be vectorized by the
+ * compiler. These accumulators perform exactly the same arithmetic as
+ * the single-channel accumulators in sumacc.c and mvacc.c.
+ *
+ * The minimum and maximum use the algorithm of van Herk and Gil-Werman,
+ * which computes prefix and suffix extrema over blocks of K samples and
+ * needs three comparisons per sample and channel, independent of the
+ * data, instead of the data-dependent deques of mmacc.c.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_movstat.h>
+
+/* row-wise accumulators */
+enum
+{
+  MATRIX_ACCUM_SUM,
+  MATRIX_ACCUM_MEAN,
+  MATRIX_ACCUM_VARIANCE,
+  MATRIX_ACCUM_SD
+};
+
+/* ring buffer of the rows in the current window */
+typedef struct
+{
+  size_t n;         /* window size */
+  size_t k;         /* number of rows in window */
+  size_t count;     /* number of rows inserted */
+  size_t tail;      /* index of oldest row */
+  size_t p;         /* number of channels */
+  double *rows;     /* window rows, n-by-p */
+  double *acc0;     /* sum or mean of each channel, size p */
+  double *acc1;     /* M2 of each channel, size p */
+} matrix_accum_state;
+
+static int matrix_apply_accum(const gsl_movstat_end_t endtype, const int type, const gsl_matrix * X,
+                              gsl_matrix * Y, gsl_movstat_matrix_workspace * w);
+static void matrix_accum_insert(const int type, const double * x, matrix_accum_state * state);
+static void matrix_accum_recompute(const int type, matrix_accum_state * state);
+static void matrix_accum_delete(const int type, matrix_accum_state * state);
+static void matrix_accum_get(const int type, const matrix_accum_state * state, double * y);
+static void matrix_pad_rows(const gsl_movstat_end_t endtype, const gsl_matrix * X,
+                            gsl_movstat_matrix_workspace * w);
+static const double * matrix_minmax_row(const gsl_movstat_end_t endtype, const size_t t,
+                                        const gsl_matrix * X, const gsl_movstat_matrix_workspace * w);
+static int matrix_hasnan(const gsl_matrix * X);
+static int matrix_minmax_columns(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y_min,
+                                 gsl_matrix * Y_max, gsl_movstat_matrix_workspace * w);
+
+/*
+gsl_movstat_matrix_alloc()
+  Allocate a workspace for moving window statistics of multi-channel
+signals, with the window
+
+W_i^{H,J} = {x_{i-H},...,x_i,...x_{i+J}}
+
+of total size K = H + J + 1
+
+Inputs: K - total samples in window (H = J = K / 2)
+        p - number of channels
+
+Return: pointer to workspace
+
+Notes:
+1) If K is even, it is rounded up to the next odd
+*/
+
+gsl_movstat_matrix_workspace *
+gsl_movstat_matrix_alloc(const size_t K, const size_t p)
+{
+  const size_t H = K / 2;
+  return gsl_movstat_matrix_alloc2(H, H, p);
+}
+
+/*
+gsl_movstat_matrix_alloc2()
+  Allocate a workspace for moving window statistics of multi-channel
+signals
+
+Inputs: H - number of samples before current sample
+        J - number of samples after current sample
+        p - number of channels
+
+Return: pointer to workspace
+*/
+
+gsl_movstat_matrix_workspace *
+gsl_movstat_matrix_alloc2(const size_t H, const size_t J, const size_t p)
+{
+  gsl_movstat_matrix_workspace *w;
+
+  if (p == 0)
+    {
+      GSL_ERROR_NULL ("number of channels must be positive", GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_movstat_matrix_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->H = H;
+  w->J = J;
+  w->K = H + J + 1;
+  w->p = p;
+
+  w->work = malloc((3 * w->K + 4) * p * sizeof(double));
+  if (w->work == 0)
+    {
+      gsl_movstat_matrix_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for work", GSL_ENOMEM);
+    }
+
+  w->movstat_workspace_p = gsl_movstat_alloc2(H, J);
+  if (w->movstat_workspace_p == 0)
+    {
+      gsl_movstat_matrix_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for movstat workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_movstat_matrix_free(gsl_movstat_matrix_workspace * w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->work)
+    free(w->work);
+
+  if (w->movstat_workspace_p)
+    gsl_movstat_free(w->movstat_workspace_p);
+
+  free(w);
+}
+
+/*
+gsl_movstat_matrix_mean()
+  Apply moving mean to each channel of a multi-channel signal
+
+Inputs: endtype - end point handling criteria
+        X       - input signal, n-by-p, one channel per column
+        Y       - (output) moving mean, n-by-p
+        w       - workspace
+
+Notes:
+1) It is allowed to have X = Y for in-place moving statistics
+*/
+
+int
+gsl_movstat_matrix_mean(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                        gsl_movstat_matrix_workspace * w)
+{
+  return matrix_apply_accum(endtype, MATRIX_ACCUM_MEAN, X, Y, w);
+}
+
+int
+gsl_movstat_matrix_variance(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                            gsl_movstat_matrix_workspace * w)
+{
+  return matrix_apply_accum(endtype, MATRIX_ACCUM_VARIANCE, X, Y, w);
+}
+
+int
+gsl_movstat_matrix_sd(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                      gsl_movstat_matrix_workspace * w)
+{
+  return matrix_apply_accum(endtype, MATRIX_ACCUM_SD, X, Y, w);
+}
+
+int
+gsl_movstat_matrix_sum(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                       gsl_movstat_matrix_workspace * w)
+{
+  return matrix_apply_accum(endtype, MATRIX_ACCUM_SUM, X, Y, w);
+}
+
+/*
+gsl_movstat_matrix_minmax()
+  Apply moving minimum and maximum to each channel of a multi-channel
+signal
+
+Inputs: endtype - end point handling criteria
+        X       - input signal, n-by-p, one channel per column
+        Y_min   - (output) moving minimum, n-by-p; can be NULL
+        Y_max   - (output) moving maximum, n-by-p; can be NULL
+        w       - workspace
+
+Notes:
+1) It is allowed to have X = Y_min or X = Y_max
+
+2) The extended signal e_t = x_{t-H}, t = 0,...,n+H+J-1, includes the
+padding at both ends; for truncated windows the padding rows are
+skipped, which does not change the extrema. Output i is the extremum of
+e_i,...,e_{i+K-1}. With e split into blocks of K rows, this window
+covers the end of one block and the start of the next, so
+
+y_i = min( S(i), P(i + K - 1) )
+
+where S is the suffix minimum within a block and P the prefix minimum.
+The blocks are processed in order, keeping the suffix extrema of the
+previous block in the workspace, so each output is written after the
+input rows it overwrites have been read.
+
+3) The block extrema do not give the same result as the deques of
+mmacc.c when a window contains NaN, so if X contains NaN each channel
+is processed with gsl_movstat_minmax() instead
+*/
+
+int
+gsl_movstat_matrix_minmax(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y_min,
+                          gsl_matrix * Y_max, gsl_movstat_matrix_workspace * w)
+{
+  const size_t n = X->size1;
+  const size_t p = X->size2;
+
+  if (p != w->p)
+    {
+      GSL_ERROR("number of columns of X must match workspace", GSL_EBADLEN);
+    }
+  else if (Y_min != NULL && (Y_min->size1 != n || Y_min->size2 != p))
+    {
+      GSL_ERROR("Y_min must have same dimensions as X", GSL_EBADLEN);
+    }
+  else if (Y_max != NULL && (Y_max->size1 != n || Y_max->size2 != p))
+    {
+      GSL_ERROR("Y_max must have same dimensions as X", GSL_EBADLEN);
+    }
+  else if (n == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else if (matrix_hasnan(X))
+    {
+      return matrix_minmax_columns(endtype, X, Y_min, Y_max, w);
+    }
+  else
+    {
+      const size_t K = w->K;
+      double *B = w->work;               /* rows of current block, K-by-p */
+      double *Smin = B + K * p;          /* suffix minima of previous block, K-by-p */
+      double *Smax = Smin + K * p;       /* suffix maxima of previous block, K-by-p */
+      double *Pmin = Smax + K * p;       /* prefix minima of current block, size p */
+      double *Pmax = Pmin + p;           /* prefix maxima of current block, size p */
+      size_t b, r, j;
+
+      matrix_pad_rows(endtype, X, w);
+
+      for (b = 0; b == 0 || (b - 1) * K < n; ++b)
+        {
+          if (b > 0)
+            {
+              /* first window of previous block is the whole block */
+              const size_t i = (b - 1) * K;
+
+              if (Y_min != NULL)
+                memcpy(gsl_matrix_ptr(Y_min, i, 0), Smin, p * sizeof(double));
+
+              if (Y_max != NULL)
+                memcpy(gsl_matrix_ptr(Y_max, i, 0), Smax, p * sizeof(double));
+            }
+
+          for (r = 0; r < K; ++r)
+            {
+              const double *e = matrix_minmax_row(endtype, b * K + r, X, w);
+              double *Br = B + r * p;
+
+              if (e == NULL)
+                {
+                  /* row outside the signal, which does not change the extrema */
+                  if (r == 0)
+                    {
+                      for (j = 0; j < p; ++j)
+                        {
+                          Pmin[j] = GSL_POSINF;
+                          Pmax[j] = GSL_NEGINF;
+                        }
+                    }
+                }
+              else
+                {
+                  memcpy(Br, e, p * sizeof(double));
+
+                  if (r == 0)
+                    {
+                      memcpy(Pmin, Br, p * sizeof(double));
+                      memcpy(Pmax, Br, p * sizeof(double));
+                    }
+                  else
+                    {
+                      for (j = 0; j < p; ++j)
+                        {
+                          Pmin[j] = GSL_MIN(Pmin[j], Br[j]);
+                          Pmax[j] = GSL_MAX(Pmax[j], Br[j]);
+                        }
+                    }
+                }
+
+              if (b > 0 && r + 1 < K && (b - 1) * K + r + 1 < n)
+                {
+                  /* window i covers rows r+1,...,K-1 of previous block and 0,...,r of this one */
+                  const size_t i = (b - 1) * K + r + 1;
+
+                  if (Y_min != NULL)
+                    {
+                      double *y = gsl_matrix_ptr(Y_min, i, 0);
+                      const double *s = Smin + (r + 1) * p;
+
+                      for (j = 0; j < p; ++j)
+                        y[j] = GSL_MIN(s[j], Pmin[j]);
+                    }
+
+                  if (Y_max != NULL)
+                    {
+                      double *y = gsl_matrix_ptr(Y_max, i, 0);
+                      const double *s = Smax + (r + 1) * p;
+
+                      for (j = 0; j < p; ++j)
+                        y[j] = GSL_MAX(s[j], Pmax[j]);
+                    }
+                }
+            }
+
+          /* suffix extrema of this block */
+          for (r = K; r-- > 0; )
+            {
+              const double *Br = B + r * p;
+              double *smin = Smin + r * p;
+              double *smax = Smax + r * p;
+
+              if (matrix_minmax_row(endtype, b * K + r, X, w) == NULL)
+                {
+                  for (j = 0; j < p; ++j)
+                    {
+                      smin[j] = (r + 1 < K) ? smin[j + p] : GSL_POSINF;
+                      smax[j] = (r + 1 < K) ? smax[j + p] : GSL_NEGINF;
+                    }
+                }
+              else if (r + 1 == K)
+                {
+                  memcpy(smin, Br, p * sizeof(double));
+                  memcpy(smax, Br, p * sizeof(double));
+                }
+              else
+                {
+                  for (j = 0; j < p; ++j)
+                    {
+                      smin[j] = GSL_MIN(Br[j], smin[j + p]);
+                      smax[j] = GSL_MAX(Br[j], smax[j + p]);
+                    }
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_movstat_matrix_min(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                       gsl_movstat_matrix_workspace * w)
+{
+  return gsl_movstat_matrix_minmax(endtype, X, Y, NULL, w);
+}
+
+int
+gsl_movstat_matrix_max(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                       gsl_movstat_matrix_workspace * w)
+{
+  return gsl_movstat_matrix_minmax(endtype, X, NULL, Y, w);
+}
+
+/*
+gsl_movstat_matrix_apply_accum()
+  Apply a single-channel accumulator to each channel of a multi-channel
+signal
+
+Inputs: endtype      - end point handling criteria
+        X            - input signal, n-by-p, one channel per column
+        accum        - accumulator to apply moving window statistic
+        accum_params - parameters to pass to accumulator
+        Y            - (output) moving statistic, n-by-p
+        w            - workspace
+
+Notes:
+1) Column j of Y is computed by gsl_movstat_apply_accum() on column j
+of X, so this provides all the single-channel statistics (median, MAD,
+quantile ranges, Sn and Qn) for multi-channel signals
+*/
+
+int
+gsl_movstat_matrix_apply_accum(const gsl_movstat_end_t endtype, const gsl_matrix * X,
+                               const gsl_movstat_accum * accum, void * accum_params,
+                               gsl_matrix * Y, gsl_movstat_matrix_workspace * w)
+{
+  if (X->size2 != w->p)
+    {
+      GSL_ERROR("number of columns of X must match workspace", GSL_EBADLEN);
+    }
+  else if (X->size1 != Y->size1 || X->size2 != Y->size2)
+    {
+      GSL_ERROR("X and Y must have the same dimensions", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t j;
+
+      for (j = 0; j < w->p; ++j)
+        {
+          gsl_vector_const_view x = gsl_matrix_const_column(X, j);
+          gsl_vector_view y = gsl_matrix_column(Y, j);
+          int status = gsl_movstat_apply_accum(endtype, &x.vector, accum, accum_params,
+                                               &y.vector, NULL, w->movstat_workspace_p);
+
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_movstat_matrix_median(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y,
+                          gsl_movstat_matrix_workspace * w)
+{
+  return gsl_movstat_matrix_apply_accum(endtype, X, gsl_movstat_accum_median, NULL, Y, w);
+}
+
+/*
+matrix_apply_accum()
+  Apply a row-wise accumulator to a multi-channel signal; this follows
+gsl_movstat_apply_accum() step by step, so that each column of the
+output is identical to the single-channel result
+
+Inputs: endtype - end point handling criteria
+        type    - MATRIX_ACCUM_xxx
+        X       - input signal, n-by-p
+        Y       - (output) moving statistic, n-by-p
+        w       - workspace
+*/
+
+static int
+matrix_apply_accum(const gsl_movstat_end_t endtype, const int type, const gsl_matrix * X,
+                   gsl_matrix * Y, gsl_movstat_matrix_workspace * w)
+{
+  if (X->size2 != w->p)
+    {
+      GSL_ERROR("number of columns of X must match workspace", GSL_EBADLEN);
+    }
+  else if (X->size1 != Y->size1 || X->size2 != Y->size2)
+    {
+      GSL_ERROR("X and Y must have the same dimensions", GSL_EBADLEN);
+    }
+  else
+    {
+      const int n = (int) X->size1;
+      const int H = w->H;
+      const int J = w->J;
+      const size_t p = w->p;
+      double *pad1 = w->work + (3 * w->K + 2) * p;
+      double *pad2 = pad1 + p;
+      matrix_accum_state state;
+      int i;
+
+      if (n == 0)
+        return GSL_SUCCESS;
+
+      state.n = w->K;
+      state.k = 0;
+      state.count = 0;
+      state.tail = 0;
+      state.p = p;
+      state.rows = w->work;
+      state.acc0 = w->work + w->K * p;
+      state.acc1 = state.acc0 + p;
+
+      memset(state.acc0, 0, 2 * p * sizeof(double));
+
+      /* save pad values, which may be overwritten for in-place outputs */
+      matrix_pad_rows(endtype, X, w);
+
+      if (endtype != GSL_MOVSTAT_END_TRUNCATE)
+        {
+          for (i = 0; i < H; ++i)
+            matrix_accum_insert(type, pad1, &state);
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          int idx = i - J;
+
+          matrix_accum_insert(type, gsl_matrix_const_ptr(X, i, 0), &state);
+
+          if (idx >= 0)
+            matrix_accum_get(type, &state, gsl_matrix_ptr(Y, idx, 0));
+        }
+
+      if (endtype == GSL_MOVSTAT_END_TRUNCATE)
+        {
+          for (i = GSL_MAX(n - J, 0); i < n; ++i)
+            {
+              if (i - H > 0)
+                matrix_accum_delete(type, &state);
+
+              matrix_accum_get(type, &state, gsl_matrix_ptr(Y, i, 0));
+            }
+        }
+      else
+        {
+          for (i = 0; i < J; ++i)
+            {
+              int idx = n - J + i;
+
+              matrix_accum_insert(type, pad2, &state);
+
+              if (idx >= 0)
+                matrix_accum_get(type, &state, gsl_matrix_ptr(Y, idx, 0));
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* insert a row into the window, removing the oldest row if the window is full */
+
+static void
+matrix_accum_insert(const int type, const double * x, matrix_accum_state * state)
+{
+  const size_t p = state->p;
+  double *mean = state->acc0;
+  double *M2 = state->acc1;
+  double *row;
+  size_t j;
+
+  if (state->k == state->n)
+    {
+      row = state->rows + state->tail * p;
+
+      if (type == MATRIX_ACCUM_SUM)
+        {
+          for (j = 0; j < p; ++j)
+            {
+              mean[j] -= row[j];
+              mean[j] += x[j];
+            }
+        }
+      else
+        {
+          for (j = 0; j < p; ++j)
+            {
+              const double old = row[j];
+              const double prev_mean = mean[j];
+
+              mean[j] += (x[j] - old) / (double) state->n;
+              M2[j] += ((old - prev_mean) + (x[j] - mean[j])) * (x[j] - old);
+            }
+        }
+
+      state->tail = (state->tail + 1) % state->n;
+    }
+  else
+    {
+      row = state->rows + ((state->tail + state->k) % state->n) * p;
+      ++(state->k);
+
+      if (type == MATRIX_ACCUM_SUM)
+        {
+          for (j = 0; j < p; ++j)
+            mean[j] += x[j];
+        }
+      else
+        {
+          for (j = 0; j < p; ++j)
+            {
+              const double delta = x[j] - mean[j];
+
+              mean[j] += delta / (double) state->k;
+              M2[j] += delta * (x[j] - mean[j]);
+            }
+        }
+    }
+
+  memcpy(row, x, p * sizeof(double));
+
+  /* recompute from the window every n rows, as in sumacc.c and mvacc.c */
+  if (++(state->count) % state->n == 0)
+    matrix_accum_recompute(type, state);
+}
+
+/*
+recompute the sum, or the mean and M2, of each channel from the rows in
+the window, visiting them from newest to oldest like ringbuf_peek()
+*/
+
+static void
+matrix_accum_recompute(const int type, matrix_accum_state * state)
+{
+  const size_t p = state->p;
+  double *mean = state->acc0;
+  double *M2 = state->acc1;
+  size_t i, j;
+
+  memset(mean, 0, p * sizeof(double));
+
+  for (i = state->k; i-- > 0; )
+    {
+      const double *row = state->rows + ((state->tail + i) % state->n) * p;
+
+      for (j = 0; j < p; ++j)
+        mean[j] += row[j];
+    }
+
+  if (type == MATRIX_ACCUM_SUM)
+    return;
+
+  for (j = 0; j < p; ++j)
+    mean[j] /= state->k;
+
+  memset(M2, 0, p * sizeof(double));
+
+  for (i = state->k; i-- > 0; )
+    {
+      const double *row = state->rows + ((state->tail + i) % state->n) * p;
+
+      for (j = 0; j < p; ++j)
+        {
+          const double delta = row[j] - mean[j];
+          M2[j] += delta * delta;
+        }
+    }
+}
+
+/* delete the oldest row from the window */
+
+static void
+matrix_accum_delete(const int type, matrix_accum_state * state)
+{
+  const size_t p = state->p;
+  const double *row = state->rows + state->tail * p;
+  double *mean = state->acc0;
+  double *M2 = state->acc1;
+  size_t j;
+
+  if (state->k == 0)
+    return;
+
+  if (type == MATRIX_ACCUM_SUM)
+    {
+      for (j = 0; j < p; ++j)
+        mean[j] -= row[j];
+    }
+  else if (state->k > 1)
+    {
+      for (j = 0; j < p; ++j)
+        {
+          const double old = row[j];
+          const double delta = mean[j] - old;
+
+          mean[j] += delta / (state->k - 1.0);
+          M2[j] -= delta * (mean[j] - old);
+        }
+    }
+  else
+    {
+      memset(mean, 0, p * sizeof(double));
+      memset(M2, 0, p * sizeof(double));
+    }
+
+  state->tail = (state->tail + 1) % state->n;
+  --(state->k);
+}
+
+static void
+matrix_accum_get(const int type, const matrix_accum_state * state, double * y)
+{
+  const size_t p = state->p;
+  size_t j;
+
+  if (type == MATRIX_ACCUM_SUM || type == MATRIX_ACCUM_MEAN)
+    {
+      memcpy(y, state->acc0, p * sizeof(double));
+    }
+  else if (state->k < 2)
+    {
+      for (j = 0; j < p; ++j)
+        y[j] = 0.0;
+    }
+  else
+    {
+      const double *M2 = state->acc1;
+
+      for (j = 0; j < p; ++j)
+        y[j] = M2[j] / (state->k - 1.0);
+
+      if (type == MATRIX_ACCUM_SD)
+        {
+          for (j = 0; j < p; ++j)
+            y[j] = sqrt(y[j]);
+        }
+    }
+}
+
+/*
+matrix_pad_rows()
+  Store the values used to pad windows before the first sample and after
+the last sample of each channel in the workspace; they are not used
+for truncated windows
+*/
+
+static void
+matrix_pad_rows(const gsl_movstat_end_t endtype, const gsl_matrix * X,
+                gsl_movstat_matrix_workspace * w)
+{
+  const size_t p = w->p;
+  const size_t n = X->size1;
+  double *pad1 = w->work + (3 * w->K + 2) * p;
+  double *pad2 = pad1 + p;
+  size_t j;
+
+  if (endtype == GSL_MOVSTAT_END_PADVALUE)
+    {
+      memcpy(pad1, gsl_matrix_const_ptr(X, 0, 0), p * sizeof(double));
+      memcpy(pad2, gsl_matrix_const_ptr(X, n - 1, 0), p * sizeof(double));
+    }
+  else
+    {
+      for (j = 0; j < p; ++j)
+        {
+          pad1[j] = 0.0;
+          pad2[j] = 0.0;
+        }
+    }
+}
+
+/*
+matrix_minmax_row()
+  Return row t of the extended signal e_t = x_{t-H} used by the
+minimum/maximum, or NULL if the row lies outside a truncated window or
+past the end of the extended signal
+*/
+
+static const double *
+matrix_minmax_row(const gsl_movstat_end_t endtype, const size_t t,
+                  const gsl_matrix * X, const gsl_movstat_matrix_workspace * w)
+{
+  const size_t n = X->size1;
+  const double *pad1 = w->work + (3 * w->K + 2) * w->p;
+  const double *pad2 = pad1 + w->p;
+
+  if (t >= w->H && t - w->H < n)
+    return gsl_matrix_const_ptr(X, t - w->H, 0);
+  else if (endtype == GSL_MOVSTAT_END_TRUNCATE || t >= n + w->H + w->J)
+    return NULL;
+  else if (t < w->H)
+    return pad1;
+  else
+    return pad2;
+}
+
+/* return 1 if any element of X is NaN */
+
+static int
+matrix_hasnan(const gsl_matrix * X)
+{
+  size_t i, j;
+
+  for (i = 0; i < X->size1; ++i)
+    {
+      const double *x = gsl_matrix_const_ptr(X, i, 0);
+
+      for (j = 0; j < X->size2; ++j)
+        {
+          if (gsl_isnan(x[j]))
+            return 1;
+        }
+    }
+
+  return 0;
+}
+
+/*
+matrix_minmax_columns()
+  Compute the moving minimum and maximum of each channel with the
+single-channel routines, so that the output is identical to
+gsl_movstat_min() and gsl_movstat_max() for any input
+*/
+
+static int
+matrix_minmax_columns(const gsl_movstat_end_t endtype, const gsl_matrix * X, gsl_matrix * Y_min,
+                      gsl_matrix * Y_max, gsl_movstat_matrix_workspace * w)
+{
+  size_t j;
+
+  if (Y_min == NULL && Y_max == NULL)
+    return GSL_SUCCESS;
+
+  for (j = 0; j < w->p; ++j)
+    {
+      gsl_vector_const_view x = gsl_matrix_const_column(X, j);
+      int status;
+
+      if (Y_min != NULL && Y_max != NULL)
+        {
+          gsl_vector_view ymin = gsl_matrix_column(Y_min, j);
+          gsl_vector_view ymax = gsl_matrix_column(Y_max, j);
+          status = gsl_movstat_minmax(endtype, &x.vector, &ymin.vector, &ymax.vector,
+                                      w->movstat_workspace_p);
+        }
+      else if (Y_min != NULL)
+        {
+          gsl_vector_view y = gsl_matrix_column(Y_min, j);
+          status = gsl_movstat_min(endtype, &x.vector, &y.vector, w->movstat_workspace_p);
+        }
+      else
+        {
+          gsl_vector_view y = gsl_matrix_column(Y_max, j);
+          status = gsl_movstat_max(endtype, &x.vector, &y.vector, w->movstat_workspace_p);
+        }
+
+      if (status)
+        return status;
+    }
+
+  return GSL_SUCCESS;
+}
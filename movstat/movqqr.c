@@ -1,6 +1,6 @@
 /* movstat/movqqr.c
  *
- * Compute moving q-quantile range
+ * Compute moving q-quantiles and q-quantile ranges
  * 
  * Copyright (C) 2018 Patrick Alken
  * 
@@ -60,3 +60,39 @@ gsl_movstat_qqr(const gsl_movstat_end_t endtype, const gsl_vector * x, const dou
       return status;
     }
 }
+
+/*
+gsl_movstat_quantile()
+  Apply a moving q-quantile to an input vector
+
+Inputs: endtype   - how to handle end points
+        x         - input vector, size n
+        q         - quantile \in [0,1]
+        xquantile - (output) vector of q-quantiles of x, size n
+                    xquantile_i = q-quantile of i-th window
+        w         - workspace
+
+Notes:
+1) The windows are maintained in sorted order, so each quantile requires
+O(log K) operations
+*/
+
+int
+gsl_movstat_quantile(const gsl_movstat_end_t endtype, const gsl_vector * x, const double q,
+                     gsl_vector * xquantile, gsl_movstat_workspace * w)
+{
+  if (x->size != xquantile->size)
+    {
+      GSL_ERROR("x and xquantile vectors must have same length", GSL_EBADLEN);
+    }
+  else if (q < 0.0 || q > 1.0)
+    {
+      GSL_ERROR("q must be between 0 and 1", GSL_EDOM);
+    }
+  else
+    {
+      double qq = q;
+      int status = gsl_movstat_apply_accum(endtype, x, gsl_movstat_accum_quantile, (void *) &qq, xquantile, NULL, w);
+      return status;
+    }
+}
@@ -0,0 +1,104 @@
+/* movstat/movtrmean.c
+ *
+ * Compute moving trimmed and Winsorized means
+ * 
+ * Copyright (C) 2021 Patrick Alken
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+ 
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_movstat.h>
+
+/*
+gsl_movstat_trmean()
+  Apply a moving trimmed mean to an input vector
+
+Inputs: endtype - how to handle end points
+        x       - input vector, size n
+        alpha   - trimming fraction \in [0,0.5]
+        y       - (output) vector of trimmed means of x, size n
+                  y_i = trimmed mean of i-th window
+        w       - workspace
+
+Notes:
+1) The trimmed mean of each window is defined as for
+gsl_stats_trmean_from_sorted_data(); the floor(alpha*n) smallest and
+largest samples of a window of n samples are discarded
+
+2) The windows are maintained in sorted order, so each window update
+requires O(log K) operations, and each output O(log K + m) operations
+for m retained samples
+*/
+
+int
+gsl_movstat_trmean(const gsl_movstat_end_t endtype, const gsl_vector * x, const double alpha,
+                   gsl_vector * y, gsl_movstat_workspace * w)
+{
+  if (x->size != y->size)
+    {
+      GSL_ERROR("x and y vectors must have same length", GSL_EBADLEN);
+    }
+  else if (alpha < 0.0 || alpha > 0.5)
+    {
+      GSL_ERROR("alpha must be between 0 and 0.5", GSL_EDOM);
+    }
+  else
+    {
+      double a = alpha;
+      int status = gsl_movstat_apply_accum(endtype, x, gsl_movstat_accum_trmean, (void *) &a, y, NULL, w);
+      return status;
+    }
+}
+
+/*
+gsl_movstat_winsorized_mean()
+  Apply a moving Winsorized mean to an input vector
+
+Inputs: endtype - how to handle end points
+        x       - input vector, size n
+        alpha   - Winsorizing fraction \in [0,0.5]
+        y       - (output) vector of Winsorized means of x, size n
+                  y_i = Winsorized mean of i-th window
+        w       - workspace
+
+Notes:
+1) In a window of n samples, the g = floor(alpha*n) smallest samples are
+replaced by the (g+1)-th smallest and the g largest by the (g+1)-th
+largest before computing the mean; for alpha = 0.5 this is the median
+*/
+
+int
+gsl_movstat_winsorized_mean(const gsl_movstat_end_t endtype, const gsl_vector * x, const double alpha,
+                            gsl_vector * y, gsl_movstat_workspace * w)
+{
+  if (x->size != y->size)
+    {
+      GSL_ERROR("x and y vectors must have same length", GSL_EBADLEN);
+    }
+  else if (alpha < 0.0 || alpha > 0.5)
+    {
+      GSL_ERROR("alpha must be between 0 and 0.5", GSL_EDOM);
+    }
+  else
+    {
+      double a = alpha;
+      int status = gsl_movstat_apply_accum(endtype, x, gsl_movstat_accum_winsorized_mean, (void *) &a, y, NULL, w);
+      return status;
+    }
+}
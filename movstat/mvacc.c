@@ -36,11 +36,14 @@ typedef struct
 {
   size_t n;      /* window size */
   size_t k;      /* number of samples currently in window */
+  size_t count;  /* number of samples inserted since init */
   double mean;   /* current window mean */
   double M2;     /* current window M2 */
   ringbuf *rbuf; /* ring buffer storing current window */
 } mvacc_state_t;
 
+static int mvacc_recompute(mvacc_state_t * state);
+
 static size_t
 mvacc_size(const size_t n)
 {
@@ -59,6 +62,7 @@ mvacc_init(const size_t n, void * vstate)
 
   state->n = n;
   state->k = 0;
+  state->count = 0;
   state->mean = 0.0;
   state->M2 = 0.0;
 
@@ -101,6 +105,15 @@ mvacc_insert(const double x, void * vstate)
   /* add new element to ring buffer */
   ringbuf_insert(x, state->rbuf);
 
+  /*
+   * recompute the window mean and M2 from scratch every n samples; this
+   * bounds the rounding error of the running update, and makes the state
+   * after each recomputation depend only on the window contents, so that
+   * gsl_movstat_apply_accum_range() can reproduce it (see apply.c)
+   */
+  if (++(state->count) % state->n == 0)
+    mvacc_recompute(state);
+
   return GSL_SUCCESS;
 }
 
@@ -138,6 +151,34 @@ mvacc_delete(void * vstate)
   return GSL_SUCCESS;
 }
 
+/* compute mean and M2 of the samples in the ring buffer with two passes */
+static int
+mvacc_recompute(mvacc_state_t * state)
+{
+  const int k = ringbuf_n(state->rbuf);
+  double sum = 0.0;
+  double M2 = 0.0;
+  double mean;
+  int i;
+
+  for (i = 0; i < k; ++i)
+    sum += ringbuf_peek(i, state->rbuf);
+
+  mean = sum / k;
+
+  for (i = 0; i < k; ++i)
+    {
+      double delta = ringbuf_peek(i, state->rbuf) - mean;
+      M2 += delta * delta;
+    }
+
+  state->k = (size_t) k;
+  state->mean = mean;
+  state->M2 = M2;
+
+  return GSL_SUCCESS;
+}
+
 static int
 mvacc_mean(void * params, double * result, const void * vstate)
 {
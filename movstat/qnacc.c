@@ -24,13 +24,14 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_movstat.h>
-#include <gsl/gsl_sort.h>
 #include <gsl/gsl_statistics.h>
 
 typedef double qnacc_type_t;
 typedef qnacc_type_t ringbuf_type_t;
+typedef qnacc_type_t skiplist_type_t;
 
 #include "ringbuf.c"
+#include "skiplist.c"
 
 typedef struct
 {
@@ -38,6 +39,7 @@ typedef struct
   qnacc_type_t *work;   /* workspace, length 3*n */
   int *work_int;        /* integer workspace, length 5*n */
   ringbuf *rbuf;        /* ring buffer storing current window */
+  skiplist *slist;      /* current window in sorted order */
 } qnacc_state_t;
 
 static size_t
@@ -50,6 +52,7 @@ qnacc_size(const size_t n)
   size += 3 * n * sizeof(qnacc_type_t); /* work */
   size += 5 * n * sizeof(int);          /* work_int */
   size += ringbuf_size(n);
+  size += skiplist_size(n);
 
   return size;
 }
@@ -61,10 +64,12 @@ qnacc_init(const size_t n, void * vstate)
 
   state->window = (qnacc_type_t *) ((unsigned char *) vstate + sizeof(qnacc_state_t));
   state->work = (qnacc_type_t *) ((unsigned char *) state->window + n * sizeof(qnacc_type_t));
-  state->work_int = (int *) ((unsigned char *) state->work + 3 * n * sizeof(qnacc_type_t));
-  state->rbuf = (ringbuf *) ((unsigned char *) state->work_int + 5 * n * sizeof(int));
+  state->rbuf = (ringbuf *) ((unsigned char *) state->work + 3 * n * sizeof(qnacc_type_t));
+  state->slist = (skiplist *) ((unsigned char *) state->rbuf + ringbuf_size(n));
+  state->work_int = (int *) ((unsigned char *) state->slist + skiplist_size(n));
 
   ringbuf_init(n, state->rbuf);
+  skiplist_init(n, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -74,8 +79,13 @@ qnacc_insert(const qnacc_type_t x, void * vstate)
 {
   qnacc_state_t * state = (qnacc_state_t *) vstate;
 
-  /* add new element to ring buffer */
+  /* remove oldest element from sorted window if it is about to be overwritten */
+  if (ringbuf_is_full(state->rbuf))
+    skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+
+  /* add new element to ring buffer and sorted window */
   ringbuf_insert(x, state->rbuf);
+  skiplist_insert(x, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -86,21 +96,25 @@ qnacc_delete(void * vstate)
   qnacc_state_t * state = (qnacc_state_t *) vstate;
 
   if (!ringbuf_is_empty(state->rbuf))
-    ringbuf_pop_back(state->rbuf);
+    {
+      skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+      ringbuf_pop_back(state->rbuf);
+    }
 
   return GSL_SUCCESS;
 }
 
-/* FIXME XXX: this is inefficient - could be improved by maintaining a sorted ring buffer */
+/* the sorted window is copied from the skiplist in O(n), rather than sorted */
 static int
 qnacc_get(void * params, qnacc_type_t * result, const void * vstate)
 {
   const qnacc_state_t * state = (const qnacc_state_t *) vstate;
-  size_t n = ringbuf_copy(state->window, state->rbuf);
+  const size_t n = (size_t) state->slist->n;
 
   (void) params;
 
-  gsl_sort(state->window, 1, n);
+  skiplist_copy(0, (int) n, state->window, state->slist);
+
   *result = gsl_stats_Qn_from_sorted_data(state->window, 1, n, state->work, state->work_int);
 
   return GSL_SUCCESS;
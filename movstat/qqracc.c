@@ -1,6 +1,6 @@
 /* movstat/qqracc.c
  *
- * Moving window QQR accumulator
+ * Moving window QQR and quantile accumulators
  * 
  * Copyright (C) 2018 Patrick Alken
  * 
@@ -24,28 +24,30 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_movstat.h>
-#include <gsl/gsl_sort.h>
-#include <gsl/gsl_statistics.h>
 
 typedef double qqracc_type_t;
 typedef qqracc_type_t ringbuf_type_t;
+typedef qqracc_type_t skiplist_type_t;
 
 #include "ringbuf.c"
+#include "skiplist.c"
 
 typedef struct
 {
-  qqracc_type_t *window; /* linear array for current window */
   ringbuf *rbuf;         /* ring buffer storing current window */
+  skiplist *slist;       /* current window in sorted order */
 } qqracc_state_t;
 
+static double qqracc_quant(const double f, const skiplist * slist);
+
 static size_t
 qqracc_size(const size_t n)
 {
   size_t size = 0;
 
   size += sizeof(qqracc_state_t);
-  size += n * sizeof(qqracc_type_t);
   size += ringbuf_size(n);
+  size += skiplist_size(n);
 
   return size;
 }
@@ -55,10 +57,11 @@ qqracc_init(const size_t n, void * vstate)
 {
   qqracc_state_t * state = (qqracc_state_t *) vstate;
 
-  state->window = (qqracc_type_t *) ((unsigned char *) vstate + sizeof(qqracc_state_t));
-  state->rbuf = (ringbuf *) ((unsigned char *) state->window + n * sizeof(qqracc_type_t));
+  state->rbuf = (ringbuf *) ((unsigned char *) vstate + sizeof(qqracc_state_t));
+  state->slist = (skiplist *) ((unsigned char *) state->rbuf + ringbuf_size(n));
 
   ringbuf_init(n, state->rbuf);
+  skiplist_init(n, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -68,8 +71,13 @@ qqracc_insert(const qqracc_type_t x, void * vstate)
 {
   qqracc_state_t * state = (qqracc_state_t *) vstate;
 
-  /* add new element to ring buffer */
+  /* remove oldest element from sorted window if it is about to be overwritten */
+  if (ringbuf_is_full(state->rbuf))
+    skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+
+  /* add new element to ring buffer and sorted window */
   ringbuf_insert(x, state->rbuf);
+  skiplist_insert(x, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -80,25 +88,24 @@ qqracc_delete(void * vstate)
   qqracc_state_t * state = (qqracc_state_t *) vstate;
 
   if (!ringbuf_is_empty(state->rbuf))
-    ringbuf_pop_back(state->rbuf);
+    {
+      skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+      ringbuf_pop_back(state->rbuf);
+    }
 
   return GSL_SUCCESS;
 }
 
-/* FIXME XXX: this is inefficient - could be improved by maintaining a sorted ring buffer */
 static int
 qqracc_get(void * params, qqracc_type_t * result, const void * vstate)
 {
   const qqracc_state_t * state = (const qqracc_state_t *) vstate;
   double q = *(double *) params;
-  size_t n = ringbuf_copy(state->window, state->rbuf);
   double quant1, quant2;
 
-  gsl_sort(state->window, 1, n);
-
   /* compute q-quantile and (1-q)-quantile */
-  quant1 = gsl_stats_quantile_from_sorted_data(state->window, 1, n, q);
-  quant2 = gsl_stats_quantile_from_sorted_data(state->window, 1, n, 1.0 - q);
+  quant1 = qqracc_quant(q, state->slist);
+  quant2 = qqracc_quant(1.0 - q, state->slist);
 
   /* compute q-quantile range */
   *result = quant2 - quant1;
@@ -106,6 +113,42 @@ qqracc_get(void * params, qqracc_type_t * result, const void * vstate)
   return GSL_SUCCESS;
 }
 
+static int
+qqracc_quantile(void * params, qqracc_type_t * result, const void * vstate)
+{
+  const qqracc_state_t * state = (const qqracc_state_t *) vstate;
+  double q = *(double *) params;
+
+  *result = qqracc_quant(q, state->slist);
+
+  return GSL_SUCCESS;
+}
+
+/* f-quantile of window, as in gsl_stats_quantile_from_sorted_data() */
+static double
+qqracc_quant(const double f, const skiplist * slist)
+{
+  const int n = slist->n;
+  const double index = f * (n - 1);
+  const int lhs = (int) index;
+  const double delta = index - lhs;
+  double x[2];
+
+  if (n == 0)
+    return 0.0;
+
+  if (lhs == n - 1)
+    {
+      skiplist_copy(lhs, 1, x, slist);
+      return x[0];
+    }
+  else
+    {
+      skiplist_copy(lhs, 2, x, slist);
+      return (1 - delta) * x[0] + delta * x[1];
+    }
+}
+
 static const gsl_movstat_accum qqr_accum_type =
 {
   qqracc_size,
@@ -116,3 +159,14 @@ static const gsl_movstat_accum qqr_accum_type =
 };
 
 const gsl_movstat_accum *gsl_movstat_accum_qqr = &qqr_accum_type;
+
+static const gsl_movstat_accum quantile_accum_type =
+{
+  qqracc_size,
+  qqracc_init,
+  qqracc_insert,
+  qqracc_delete,
+  qqracc_quantile
+};
+
+const gsl_movstat_accum *gsl_movstat_accum_quantile = &quantile_accum_type;
@@ -0,0 +1,311 @@
+/* movstat/skiplist.c
+ *
+ * Indexable skiplist module
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This module implements an indexable skiplist, which stores a multiset
+ * of values in sorted order and supports insertion, deletion and access
+ * to the i-th smallest value in O(log n) expected time. Each link stores
+ * the number of elements it skips over, as described in
+ *
+ * [1] W. Pugh, Skip Lists: A Probabilistic Alternative to Balanced Trees,
+ * Communications of the ACM, 33(6), 1990.
+ *
+ * All storage is contained in a single block of size skiplist_size(n),
+ * so that it can be embedded in an accumulator state. Node 0 is the head
+ * of the list; nodes 1..n hold the values. A node is promoted to the next
+ * level with probability 1/4, using a deterministic random number generator,
+ * so that results are reproducible.
+ */
+
+#ifndef __GSL_SKIPLIST_C__
+#define __GSL_SKIPLIST_C__
+
+/*typedef double skiplist_type_t;*/
+
+#define SKIPLIST_MAX_LEVELS 16
+#define SKIPLIST_NIL        (-1)
+
+typedef struct
+{
+  int size;               /* maximum number of elements */
+  int nlevels;            /* number of levels */
+  int n;                  /* number of elements stored */
+  int free_node;          /* first node of free list */
+  unsigned long seed;     /* state of random level generator */
+  skiplist_type_t *value; /* node values, size + 1 */
+  int *next;              /* next[k*nlevels + l] = node following node k on level l */
+  int *width;             /* width[k*nlevels + l] = number of elements spanned by link */
+  int *height;            /* height[k] = number of levels of node k */
+} skiplist;
+
+static size_t skiplist_size(const size_t n);
+static int skiplist_init(const size_t n, skiplist * s);
+static int skiplist_empty(skiplist * s);
+static int skiplist_insert(const skiplist_type_t x, skiplist * s);
+static int skiplist_delete(const skiplist_type_t x, skiplist * s);
+static void skiplist_copy(const int i, const int m, skiplist_type_t * dest, const skiplist * s);
+static int skiplist_nlevels(const size_t n);
+static int skiplist_random_height(skiplist * s);
+static int skiplist_lt(const skiplist_type_t a, const skiplist_type_t b);
+
+static size_t
+skiplist_size(const size_t n)
+{
+  const size_t nlevels = (size_t) skiplist_nlevels(n);
+  size_t size = 0;
+  size_t nint = 0;
+
+  nint += 2 * (n + 1) * nlevels; /* next, width */
+  nint += n + 1;                 /* height */
+
+  size += sizeof(skiplist);
+  size += (n + 1) * sizeof(skiplist_type_t); /* value */
+  size += nint * sizeof(int);
+
+  /* keep any data following the skiplist aligned */
+  size = (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+
+  return size;
+}
+
+static int
+skiplist_init(const size_t n, skiplist * s)
+{
+  s->size = (int) n;
+  s->nlevels = skiplist_nlevels(n);
+
+  s->value = (skiplist_type_t *) ((unsigned char *) s + sizeof(skiplist));
+  s->next = (int *) ((unsigned char *) s->value + (n + 1) * sizeof(skiplist_type_t));
+  s->width = s->next + (n + 1) * s->nlevels;
+  s->height = s->width + (n + 1) * s->nlevels;
+
+  return skiplist_empty(s);
+}
+
+/* remove all elements */
+static int
+skiplist_empty(skiplist * s)
+{
+  int k, l;
+
+  s->n = 0;
+  s->seed = 1;
+
+  s->height[0] = s->nlevels;
+  for (l = 0; l < s->nlevels; ++l)
+    {
+      s->next[l] = SKIPLIST_NIL;
+      s->width[l] = 1;
+    }
+
+  /* free list of nodes, linked through level 0 */
+  s->free_node = (s->size > 0) ? 1 : SKIPLIST_NIL;
+  for (k = 1; k <= s->size; ++k)
+    s->next[k * s->nlevels] = (k < s->size) ? k + 1 : SKIPLIST_NIL;
+
+  return GSL_SUCCESS;
+}
+
+/* insert x after any elements equal to x */
+static int
+skiplist_insert(const skiplist_type_t x, skiplist * s)
+{
+  if (s->n >= s->size)
+    {
+      GSL_ERROR("skiplist is full", GSL_EOVRFLW);
+    }
+  else
+    {
+      const int L = s->nlevels;
+      int chain[SKIPLIST_MAX_LEVELS]; /* last node before x on each level */
+      int steps[SKIPLIST_MAX_LEVELS]; /* number of elements passed on each level */
+      int node = 0;
+      int newnode, h, l, nsteps;
+
+      for (l = L - 1; l >= 0; --l)
+        {
+          int next;
+
+          steps[l] = 0;
+
+          while ((next = s->next[node * L + l]) != SKIPLIST_NIL && !skiplist_lt(x, s->value[next]))
+            {
+              steps[l] += s->width[node * L + l];
+              node = next;
+            }
+
+          chain[l] = node;
+        }
+
+      newnode = s->free_node;
+      s->free_node = s->next[newnode * L];
+
+      h = skiplist_random_height(s);
+      s->value[newnode] = x;
+      s->height[newnode] = h;
+
+      nsteps = 0;
+      for (l = 0; l < h; ++l)
+        {
+          const int prev = chain[l];
+
+          s->next[newnode * L + l] = s->next[prev * L + l];
+          s->next[prev * L + l] = newnode;
+          s->width[newnode * L + l] = s->width[prev * L + l] - nsteps;
+          s->width[prev * L + l] = nsteps + 1;
+          nsteps += steps[l];
+        }
+
+      for (l = h; l < L; ++l)
+        ++(s->width[chain[l] * L + l]);
+
+      ++(s->n);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* delete one element equal to x */
+static int
+skiplist_delete(const skiplist_type_t x, skiplist * s)
+{
+  const int L = s->nlevels;
+  int chain[SKIPLIST_MAX_LEVELS];
+  int node = 0;
+  int target, l;
+
+  for (l = L - 1; l >= 0; --l)
+    {
+      int next;
+
+      while ((next = s->next[node * L + l]) != SKIPLIST_NIL && skiplist_lt(s->value[next], x))
+        node = next;
+
+      chain[l] = node;
+    }
+
+  target = s->next[chain[0] * L];
+  if (target == SKIPLIST_NIL || skiplist_lt(x, s->value[target]))
+    {
+      GSL_ERROR("element not found in skiplist", GSL_EINVAL);
+    }
+
+  for (l = 0; l < s->height[target]; ++l)
+    {
+      const int prev = chain[l];
+
+      s->width[prev * L + l] += s->width[target * L + l] - 1;
+      s->next[prev * L + l] = s->next[target * L + l];
+    }
+
+  for (l = s->height[target]; l < L; ++l)
+    --(s->width[chain[l] * L + l]);
+
+  /* return node to free list */
+  s->next[target * L] = s->free_node;
+  s->free_node = target;
+
+  --(s->n);
+
+  return GSL_SUCCESS;
+}
+
+/*
+skiplist_copy()
+  Copy the elements of rank i, ..., i + m - 1 to dest in sorted order;
+the node of rank i is found in O(log n) operations, and the following
+nodes by walking the bottom level, so the cost is O(log n + m)
+*/
+
+static void
+skiplist_copy(const int i, const int m, skiplist_type_t * dest, const skiplist * s)
+{
+  const int L = s->nlevels;
+  int pos = i + 1;
+  int node = 0;
+  int k, l;
+
+  if (m <= 0)
+    return;
+
+  for (l = L - 1; l >= 0; --l)
+    {
+      while (s->width[node * L + l] <= pos)
+        {
+          pos -= s->width[node * L + l];
+          node = s->next[node * L + l];
+        }
+    }
+
+  for (k = 0; k < m; ++k)
+    {
+      dest[k] = s->value[node];
+      node = s->next[node * L];
+    }
+}
+
+/* ordering of elements, with NaNs placed after all other values */
+static int
+skiplist_lt(const skiplist_type_t a, const skiplist_type_t b)
+{
+  return (a < b) || (b != b && a == a);
+}
+
+/* number of levels needed for n elements with promotion probability 1/4 */
+static int
+skiplist_nlevels(const size_t n)
+{
+  int nlevels = 1;
+  size_t m = 1;
+
+  while (m < n && nlevels < SKIPLIST_MAX_LEVELS)
+    {
+      m *= 4;
+      ++nlevels;
+    }
+
+  return nlevels;
+}
+
+/* choose height of a new node; each level is kept with probability 1/4 */
+static int
+skiplist_random_height(skiplist * s)
+{
+  unsigned long r;
+  int h = 1;
+
+  /* xorshift generator */
+  r = s->seed;
+  r ^= (r << 13) & 0xffffffffUL;
+  r ^= r >> 17;
+  r ^= (r << 5) & 0xffffffffUL;
+  s->seed = r;
+
+  while (h < s->nlevels && (r & 3) == 0)
+    {
+      ++h;
+      r >>= 2;
+    }
+
+  return h;
+}
+
+#endif /* __GSL_SKIPLIST_C__ */
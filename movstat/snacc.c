@@ -24,19 +24,21 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_movstat.h>
-#include <gsl/gsl_sort.h>
 #include <gsl/gsl_statistics.h>
 
 typedef double snacc_type_t;
 typedef snacc_type_t ringbuf_type_t;
+typedef snacc_type_t skiplist_type_t;
 
 #include "ringbuf.c"
+#include "skiplist.c"
 
 typedef struct
 {
   snacc_type_t *window; /* linear array for current window */
   snacc_type_t *work;   /* workspace */
   ringbuf *rbuf;        /* ring buffer storing current window */
+  skiplist *slist;      /* current window in sorted order */
 } snacc_state_t;
 
 static size_t
@@ -47,6 +49,7 @@ snacc_size(const size_t n)
   size += sizeof(snacc_state_t);
   size += 2 * n * sizeof(snacc_type_t);
   size += ringbuf_size(n);
+  size += skiplist_size(n);
 
   return size;
 }
@@ -59,8 +62,10 @@ snacc_init(const size_t n, void * vstate)
   state->window = (snacc_type_t *) ((unsigned char *) vstate + sizeof(snacc_state_t));
   state->work = (snacc_type_t *) ((unsigned char *) state->window + n * sizeof(snacc_type_t));
   state->rbuf = (ringbuf *) ((unsigned char *) state->work + n * sizeof(snacc_type_t));
+  state->slist = (skiplist *) ((unsigned char *) state->rbuf + ringbuf_size(n));
 
   ringbuf_init(n, state->rbuf);
+  skiplist_init(n, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -70,8 +75,13 @@ snacc_insert(const snacc_type_t x, void * vstate)
 {
   snacc_state_t * state = (snacc_state_t *) vstate;
 
-  /* add new element to ring buffer */
+  /* remove oldest element from sorted window if it is about to be overwritten */
+  if (ringbuf_is_full(state->rbuf))
+    skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+
+  /* add new element to ring buffer and sorted window */
   ringbuf_insert(x, state->rbuf);
+  skiplist_insert(x, state->slist);
 
   return GSL_SUCCESS;
 }
@@ -82,21 +92,25 @@ snacc_delete(void * vstate)
   snacc_state_t * state = (snacc_state_t *) vstate;
 
   if (!ringbuf_is_empty(state->rbuf))
-    ringbuf_pop_back(state->rbuf);
+    {
+      skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+      ringbuf_pop_back(state->rbuf);
+    }
 
   return GSL_SUCCESS;
 }
 
-/* FIXME XXX: this is inefficient - could be improved by maintaining a sorted ring buffer */
+/* the sorted window is copied from the skiplist in O(n), rather than sorted */
 static int
 snacc_get(void * params, snacc_type_t * result, const void * vstate)
 {
   const snacc_state_t * state = (const snacc_state_t *) vstate;
-  size_t n = ringbuf_copy(state->window, state->rbuf);
+  const size_t n = (size_t) state->slist->n;
 
   (void) params;
 
-  gsl_sort(state->window, 1, n);
+  skiplist_copy(0, (int) n, state->window, state->slist);
+
   *result = gsl_stats_Sn_from_sorted_data(state->window, 1, n, state->work);
 
   return GSL_SUCCESS;
@@ -0,0 +1,320 @@
+/* movstat/stream.c
+ *
+ * Moving window statistics of signals received in pieces
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_movstat.h>
+
+static int stream_output(const size_t idx, gsl_vector * y, gsl_vector * z, size_t * ny, gsl_movstat_stream * s);
+
+/*
+gsl_movstat_stream_alloc()
+  Allocate a stream for computing a moving window statistic of a signal
+which is received in pieces of arbitrary length
+
+Inputs: endtype      - end point handling criteria
+        accum        - accumulator to apply moving window statistic
+        accum_params - parameters to pass to accumulator; this pointer
+                       must remain valid while the stream is used
+        H            - number of samples before current sample
+        J            - number of samples after current sample
+
+Return: pointer to stream
+*/
+
+gsl_movstat_stream *
+gsl_movstat_stream_alloc(const gsl_movstat_end_t endtype, const gsl_movstat_accum * accum,
+                         void * accum_params, const size_t H, const size_t J)
+{
+  gsl_movstat_stream *s;
+
+  s = calloc(1, sizeof(gsl_movstat_stream));
+  if (s == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for stream", GSL_ENOMEM);
+    }
+
+  s->endtype = endtype;
+  s->accum = accum;
+  s->accum_params = accum_params;
+  s->H = H;
+  s->J = J;
+  s->K = H + J + 1;
+
+  s->work = malloc(s->K * sizeof(double));
+  if (s->work == 0)
+    {
+      gsl_movstat_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for work", GSL_ENOMEM);
+    }
+
+  s->state = malloc((accum->size)(s->K));
+  if (s->state == 0)
+    {
+      gsl_movstat_stream_free(s);
+      GSL_ERROR_NULL ("failed to allocate space for accumulator state", GSL_ENOMEM);
+    }
+
+  gsl_movstat_stream_reset(s);
+
+  return s;
+}
+
+void
+gsl_movstat_stream_free(gsl_movstat_stream * s)
+{
+  RETURN_IF_NULL(s);
+
+  if (s->work)
+    free(s->work);
+
+  if (s->state)
+    free(s->state);
+
+  free(s);
+}
+
+/* prepare the stream for a new signal */
+
+int
+gsl_movstat_stream_reset(gsl_movstat_stream * s)
+{
+  s->n = 0;
+  s->ifirst = 0;
+  s->ilast = (size_t) -1;
+  s->x1 = 0.0;
+  s->xN = 0.0;
+
+  return (s->accum->init)(s->K, s->state);
+}
+
+/* number of samples by which the output lags the input */
+
+size_t
+gsl_movstat_stream_delay(const gsl_movstat_stream * s)
+{
+  return s->J;
+}
+
+/*
+gsl_movstat_stream_push()
+  Process the next piece of the input signal
+
+Inputs: x  - next samples of input signal
+        y  - (output) next samples of moving statistic, size >= x->size
+        z  - (output) second output (i.e. minmax), size >= x->size; can be NULL
+        ny - (output) number of samples stored in y (and z)
+        s  - stream
+
+Return: success/error
+
+Notes:
+1) Output sample i of the signal is available once sample i + J has been
+received, so the first J samples of the signal produce no output; the
+last J outputs are produced by gsl_movstat_stream_finish()
+
+2) It is allowed to have x = y
+*/
+
+int
+gsl_movstat_stream_push(const gsl_vector * x, gsl_vector * y, gsl_vector * z, size_t * ny,
+                        gsl_movstat_stream * s)
+{
+  if (y->size < x->size)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else if (z != NULL && z->size < x->size)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t i;
+
+      *ny = 0;
+
+      for (i = 0; i < x->size; ++i)
+        {
+          const double xi = gsl_vector_get(x, i);
+
+          if (s->n == 0)
+            {
+              size_t j;
+
+              /* pad initial window if necessary */
+              if (s->endtype == GSL_MOVSTAT_END_PADVALUE)
+                s->x1 = xi;
+
+              if (s->endtype != GSL_MOVSTAT_END_TRUNCATE)
+                {
+                  for (j = 0; j < s->H; ++j)
+                    (s->accum->insert)(s->x1, s->state);
+                }
+            }
+
+          (s->accum->insert)(xi, s->state);
+
+          /* save last K samples for shrinking windows at the end */
+          s->work[s->n % s->K] = xi;
+
+          if (s->endtype == GSL_MOVSTAT_END_PADVALUE)
+            s->xN = xi;
+
+          ++(s->n);
+
+          if (s->n > s->J)
+            {
+              stream_output(s->n - s->J - 1, y, z, ny, s);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_movstat_stream_finish()
+  Compute the final outputs of the signal after the last piece has been
+received, and reset the stream for a new signal
+
+Inputs: y  - (output) final samples of moving statistic, size >= min(J, n)
+        z  - (output) second output (i.e. minmax); can be NULL
+        ny - (output) number of samples stored in y (and z)
+        s  - stream
+
+Return: success/error
+*/
+
+int
+gsl_movstat_stream_finish(gsl_vector * y, gsl_vector * z, size_t * ny, gsl_movstat_stream * s)
+{
+  const int n = (int) s->n;
+  const int H = (int) s->H;
+  const int J = (int) s->J;
+  const size_t ilo = GSL_MAX(s->ifirst, s->n - GSL_MIN(s->n, s->J));
+  const size_t ihi = GSL_MIN(s->ilast, s->n);
+  const size_t nout = (ihi > ilo) ? ihi - ilo : 0; /* number of outputs to store */
+
+  if (y->size < nout)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else if (z != NULL && z->size < nout)
+    {
+      GSL_ERROR("output vector is too short", GSL_EBADLEN);
+    }
+  else
+    {
+      int i;
+
+      *ny = 0;
+
+      if (n == 0)
+        return GSL_SUCCESS;
+
+      if (s->endtype == GSL_MOVSTAT_END_TRUNCATE)
+        {
+          /* fill y(n-J:n-1) using shrinking windows */
+          int idx1 = GSL_MAX(n - J, 0);
+          int idx2 = n - 1;
+
+          if (s->accum->delete_oldest == NULL)
+            {
+              for (i = idx1; i <= idx2; ++i)
+                {
+                  int nsamp = n - GSL_MAX(i - H, 0); /* number of samples in this window */
+                  int j;
+
+                  /* the window holds the last nsamp samples, which are saved in work */
+                  (s->accum->init)(s->K, s->state);
+
+                  for (j = n - nsamp; j < n; ++j)
+                    (s->accum->insert)(s->work[j % s->K], s->state);
+
+                  stream_output(i, y, z, ny, s);
+                }
+            }
+          else
+            {
+              for (i = idx1; i <= idx2; ++i)
+                {
+                  if (i - H > 0)
+                    {
+                      /* delete oldest window sample as we move closer to edge */
+                      (s->accum->delete_oldest)(s->state);
+                    }
+
+                  stream_output(i, y, z, ny, s);
+                }
+            }
+        }
+      else
+        {
+          /* pad final windows */
+          for (i = 0; i < J; ++i)
+            {
+              (s->accum->insert)(s->xN, s->state);
+
+              if (n - J + i >= 0)
+                {
+                  stream_output(n - J + i, y, z, ny, s);
+                }
+            }
+        }
+
+      return gsl_movstat_stream_reset(s);
+    }
+}
+
+/*
+stream_output()
+  Store the accumulator value for output sample idx in y(*ny) and z(*ny)
+and increment *ny; outputs outside [ifirst, ilast) are discarded without
+being computed
+*/
+
+static int
+stream_output(const size_t idx, gsl_vector * y, gsl_vector * z, size_t * ny, gsl_movstat_stream * s)
+{
+  if (idx < s->ifirst || idx >= s->ilast)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      double result[2];
+      int status = (s->accum->get)(s->accum_params, result, s->state);
+
+      gsl_vector_set(y, *ny, result[0]);
+
+      if (z != NULL)
+        gsl_vector_set(z, *ny, result[1]);
+
+      ++(*ny);
+
+      return status;
+    }
+}
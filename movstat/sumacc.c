@@ -31,6 +31,8 @@ typedef double ringbuf_type_t;
 
 typedef struct
 {
+  size_t n;       /* window size */
+  size_t count;   /* number of samples inserted since init */
   double sum;     /* current window sum */
   ringbuf *rbuf;  /* ring buffer storing current window */
 } sumacc_state_t;
@@ -51,6 +53,8 @@ sumacc_init(const size_t n, void * vstate)
 {
   sumacc_state_t * state = (sumacc_state_t *) vstate;
 
+  state->n = n;
+  state->count = 0;
   state->sum = 0.0;
 
   state->rbuf = (ringbuf *) ((unsigned char *) vstate + sizeof(sumacc_state_t));
@@ -74,6 +78,17 @@ sumacc_insert(const double x, void * vstate)
   state->sum += x;
   ringbuf_insert(x, state->rbuf);
 
+  /* recompute the sum from scratch every n samples, as in mvacc.c */
+  if (++(state->count) % state->n == 0)
+    {
+      const int k = ringbuf_n(state->rbuf);
+      int i;
+
+      state->sum = 0.0;
+      for (i = 0; i < k; ++i)
+        state->sum += ringbuf_peek(i, state->rbuf);
+    }
+
   return GSL_SUCCESS;
 }
 
@@ -140,6 +140,35 @@ test_mad_proc(const double tol, const size_t n, const size_t H, const size_t J,
   gsl_movstat_free(w);
 }
 
+/* test moving MAD of input with many repeated values */
+static void
+test_mad_ties(const double tol, const size_t n, const size_t H, const size_t J,
+              const gsl_movstat_end_t etype, gsl_rng *rng_p)
+{
+  gsl_movstat_workspace *w = gsl_movstat_alloc2(H, J);
+  gsl_vector *x = gsl_vector_alloc(n);
+  gsl_vector *y = gsl_vector_alloc(n);
+  gsl_vector *z = gsl_vector_alloc(n);
+  gsl_vector *med = gsl_vector_alloc(n);
+  char buf[2048];
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    gsl_vector_set(x, i, (double) gsl_rng_uniform_int(rng_p, 5));
+
+  slow_movmad(etype, x, y, H, J);
+  gsl_movstat_mad0(etype, x, med, z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u MAD0 ties", n, H, J, etype);
+  compare_vectors(tol, z, y, buf);
+
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+  gsl_vector_free(med);
+  gsl_movstat_free(w);
+}
+
 static void
 test_mad(gsl_rng * rng_p)
 {
@@ -175,4 +204,12 @@ test_mad(gsl_rng * rng_p)
   test_mad_proc(GSL_DBL_EPSILON, 50, 100, 150, GSL_MOVSTAT_END_TRUNCATE, rng_p);
   test_mad_proc(GSL_DBL_EPSILON, 50, 150, 100, GSL_MOVSTAT_END_TRUNCATE, rng_p);
   test_mad_proc(GSL_DBL_EPSILON, 50, 100, 100, GSL_MOVSTAT_END_TRUNCATE, rng_p);
+
+  test_mad_ties(GSL_DBL_EPSILON, 1000, 4, 4, GSL_MOVSTAT_END_PADZERO, rng_p);
+  test_mad_ties(GSL_DBL_EPSILON, 1000, 7, 2, GSL_MOVSTAT_END_PADVALUE, rng_p);
+  test_mad_ties(GSL_DBL_EPSILON, 1000, 2, 7, GSL_MOVSTAT_END_TRUNCATE, rng_p);
+
+  /* large windows */
+  test_mad_proc(GSL_DBL_EPSILON, 300, 1000, 1000, GSL_MOVSTAT_END_PADZERO, rng_p);
+  test_mad_proc(GSL_DBL_EPSILON, 300, 1000, 1000, GSL_MOVSTAT_END_TRUNCATE, rng_p);
 }
@@ -0,0 +1,214 @@
+/* movstat/test_matrix.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_movstat.h>
+
+/* multi-channel statistics */
+enum
+{
+  TEST_MATRIX_MEAN,
+  TEST_MATRIX_VARIANCE,
+  TEST_MATRIX_SD,
+  TEST_MATRIX_SUM,
+  TEST_MATRIX_MIN,
+  TEST_MATRIX_MAX,
+  TEST_MATRIX_MEDIAN
+};
+
+static int
+test_matrix_apply(const int type, const gsl_movstat_end_t etype, const gsl_matrix * X, gsl_matrix * Y,
+                  gsl_movstat_matrix_workspace * w)
+{
+  switch (type)
+    {
+      case TEST_MATRIX_MEAN:
+        return gsl_movstat_matrix_mean(etype, X, Y, w);
+
+      case TEST_MATRIX_VARIANCE:
+        return gsl_movstat_matrix_variance(etype, X, Y, w);
+
+      case TEST_MATRIX_SD:
+        return gsl_movstat_matrix_sd(etype, X, Y, w);
+
+      case TEST_MATRIX_SUM:
+        return gsl_movstat_matrix_sum(etype, X, Y, w);
+
+      case TEST_MATRIX_MIN:
+        return gsl_movstat_matrix_min(etype, X, Y, w);
+
+      case TEST_MATRIX_MAX:
+        return gsl_movstat_matrix_max(etype, X, Y, w);
+
+      default:
+        return gsl_movstat_matrix_median(etype, X, Y, w);
+    }
+}
+
+static int
+test_matrix_vector(const int type, const gsl_movstat_end_t etype, const gsl_vector * x, gsl_vector * y,
+                   gsl_movstat_workspace * w)
+{
+  switch (type)
+    {
+      case TEST_MATRIX_MEAN:
+        return gsl_movstat_mean(etype, x, y, w);
+
+      case TEST_MATRIX_VARIANCE:
+        return gsl_movstat_variance(etype, x, y, w);
+
+      case TEST_MATRIX_SD:
+        return gsl_movstat_sd(etype, x, y, w);
+
+      case TEST_MATRIX_SUM:
+        return gsl_movstat_sum(etype, x, y, w);
+
+      case TEST_MATRIX_MIN:
+        return gsl_movstat_min(etype, x, y, w);
+
+      case TEST_MATRIX_MAX:
+        return gsl_movstat_max(etype, x, y, w);
+
+      default:
+        return gsl_movstat_median(etype, x, y, w);
+    }
+}
+
+/*
+ * compare each channel with the single-channel routine; X is a view with tda > p;
+ * if nancol is set, the last channel contains isolated NaNs and a window of NaNs
+ */
+static void
+test_matrix_proc(const double tol, const int type, const size_t n, const size_t p,
+                 const size_t H, const size_t J, const gsl_movstat_end_t etype,
+                 const int nancol, gsl_rng * rng_p)
+{
+  const char *names[] = { "mean", "variance", "sd", "sum", "min", "max", "median" };
+  gsl_movstat_matrix_workspace * w = gsl_movstat_matrix_alloc2(H, J, p);
+  gsl_movstat_workspace * wv = gsl_movstat_alloc2(H, J);
+  gsl_matrix * A = gsl_matrix_alloc(n, p + 3);
+  gsl_matrix_view X = gsl_matrix_submatrix(A, 0, 1, n, p);
+  gsl_matrix * Y = gsl_matrix_alloc(n, p);
+  gsl_matrix * Z = gsl_matrix_alloc(n, p);
+  gsl_vector * y = gsl_vector_alloc(n);
+  size_t i, j;
+
+  for (i = 0; i < n; ++i)
+    {
+      for (j = 0; j < p + 3; ++j)
+        gsl_matrix_set(A, i, j, 2.0 * gsl_rng_uniform(rng_p) - 1.0);
+    }
+
+  if (nancol)
+    {
+      for (i = 0; i < n; ++i)
+        {
+          if (i % 7 == 3 || (i >= n / 2 && i <= n / 2 + H + J))
+            gsl_matrix_set(&X.matrix, i, p - 1, GSL_NAN);
+        }
+    }
+
+  test_matrix_apply(type, etype, &X.matrix, Y, w);
+
+  for (j = 0; j < p; ++j)
+    {
+      gsl_vector_const_view x = gsl_matrix_const_column(&X.matrix, j);
+
+      test_matrix_vector(type, etype, &x.vector, y, wv);
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_test_rel(gsl_matrix_get(Y, i, j), gsl_vector_get(y, i), tol,
+                       "matrix %s n=%zu p=%zu H=%zu J=%zu endtype=%u i=%zu j=%zu",
+                       names[type], n, p, H, J, etype, i, j);
+        }
+    }
+
+  /* in-place */
+  gsl_matrix_memcpy(Z, &X.matrix);
+  test_matrix_apply(type, etype, Z, Z, w);
+
+  for (i = 0; i < n; ++i)
+    {
+      for (j = 0; j < p; ++j)
+        {
+          gsl_test_rel(gsl_matrix_get(Z, i, j), gsl_matrix_get(Y, i, j), tol,
+                       "matrix %s in-place n=%zu p=%zu H=%zu J=%zu endtype=%u i=%zu j=%zu",
+                       names[type], n, p, H, J, etype, i, j);
+        }
+    }
+
+  gsl_movstat_matrix_free(w);
+  gsl_movstat_free(wv);
+  gsl_matrix_free(A);
+  gsl_matrix_free(Y);
+  gsl_matrix_free(Z);
+  gsl_vector_free(y);
+}
+
+static void
+test_matrix(gsl_rng * rng_p)
+{
+  const gsl_movstat_end_t etypes[] = { GSL_MOVSTAT_END_PADZERO, GSL_MOVSTAT_END_PADVALUE,
+                                       GSL_MOVSTAT_END_TRUNCATE };
+  const size_t windows[][2] = { { 0, 0 }, { 3, 3 }, { 0, 5 }, { 5, 0 }, { 10, 4 }, { 4, 10 },
+                                { 50, 50 }, { 10, 50 }, { 50, 10 } };
+  const double tol = 1.0e-12;
+  size_t i, k;
+  int type;
+
+  for (type = TEST_MATRIX_MEAN; type <= TEST_MATRIX_MEDIAN; ++type)
+    {
+      for (k = 0; k < 3; ++k)
+        {
+          for (i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i)
+            {
+              const size_t H = windows[i][0];
+              const size_t J = windows[i][1];
+
+              test_matrix_proc(tol, type, 200, 5, H, J, etypes[k], 0, rng_p);
+              test_matrix_proc(tol, type, 20, 3, H, J, etypes[k], 0, rng_p);
+              test_matrix_proc(tol, type, 1, 4, H, J, etypes[k], 0, rng_p);
+            }
+
+          test_matrix_proc(tol, type, 1000, 1, 7, 7, etypes[k], 0, rng_p);
+          test_matrix_proc(tol, type, 100, 17, 9, 2, etypes[k], 0, rng_p);
+        }
+    }
+
+  /* NaN in one channel */
+  for (type = TEST_MATRIX_MEAN; type <= TEST_MATRIX_MEDIAN; ++type)
+    {
+      for (k = 0; k < 3; ++k)
+        {
+          for (i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i)
+            {
+              const size_t H = windows[i][0];
+              const size_t J = windows[i][1];
+
+              test_matrix_proc(tol, type, 200, 5, H, J, etypes[k], 1, rng_p);
+              test_matrix_proc(tol, type, 20, 1, H, J, etypes[k], 1, rng_p);
+            }
+        }
+    }
+}
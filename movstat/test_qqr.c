@@ -50,6 +50,29 @@ slow_movqqr(const gsl_movstat_end_t etype, const double q, const gsl_vector * x,
   return GSL_SUCCESS;
 }
 
+/* compute moving quantile by explicitely constructing window and computing quantile */
+int
+slow_movquantile(const gsl_movstat_end_t etype, const double q, const gsl_vector * x,
+                 gsl_vector * y, const int H, const int J)
+{
+  const size_t n = x->size;
+  const int K = H + J + 1;
+  double *window = malloc(K * sizeof(double));
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      size_t wsize = gsl_movstat_fill(etype, x, i, H, J, window);
+
+      gsl_sort(window, 1, wsize);
+      gsl_vector_set(y, i, gsl_stats_quantile_from_sorted_data(window, 1, wsize, q));
+    }
+
+  free(window);
+
+  return GSL_SUCCESS;
+}
+
 static double
 func_qqr(const size_t n, double x[], void * params)
 {
@@ -110,6 +133,57 @@ test_qqr_proc(const double tol, const double q, const size_t n, const size_t H,
   gsl_vector_free(z);
 }
 
+/* test moving quantile; if ties is set, the input has many repeated values */
+static void
+test_quantile_proc(const double tol, const double q, const size_t n, const size_t H, const size_t J,
+                   const gsl_movstat_end_t etype, const int ties, gsl_rng * rng_p)
+{
+  gsl_movstat_workspace * w = gsl_movstat_alloc2(H, J);
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * z = gsl_vector_alloc(n);
+  char buf[2048];
+  size_t i;
+
+  random_vector(x, rng_p);
+
+  if (ties)
+    {
+      for (i = 0; i < n; ++i)
+        gsl_vector_set(x, i, floor(4.0 * gsl_vector_get(x, i)));
+    }
+
+  /* y = quantile(x) with slow brute force method */
+  slow_movquantile(etype, q, x, y, H, J);
+
+  /* z = quantile(x) with fast method */
+  gsl_movstat_quantile(etype, x, q, z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u ties=%d quantile q=%g random", n, H, J, etype, ties, q);
+  compare_vectors(tol, z, y, buf);
+
+  /* z = quantile(x) in-place */
+  gsl_vector_memcpy(z, x);
+  gsl_movstat_quantile(etype, z, q, z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u ties=%d quantile q=%g random in-place", n, H, J, etype, ties, q);
+  compare_vectors(tol, z, y, buf);
+
+  /* y = QQR(x) with slow brute force method */
+  slow_movqqr(etype, GSL_MIN(q, 1.0 - q), x, y, H, J);
+
+  /* z = QQR(x) with fast method */
+  gsl_movstat_qqr(etype, x, GSL_MIN(q, 1.0 - q), z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u ties=%d QQR q=%g random", n, H, J, etype, ties, q);
+  compare_vectors(tol, z, y, buf);
+
+  gsl_movstat_free(w);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+}
+
 static void
 test_qqr(gsl_rng * rng_p)
 {
@@ -144,4 +218,25 @@ test_qqr(gsl_rng * rng_p)
   test_qqr_proc(eps, 0.25, 20, 50, 50, GSL_MOVSTAT_END_TRUNCATE, rng_p);
   test_qqr_proc(eps, 0.25, 20, 10, 50, GSL_MOVSTAT_END_TRUNCATE, rng_p);
   test_qqr_proc(eps, 0.25, 20, 50, 10, GSL_MOVSTAT_END_TRUNCATE, rng_p);
+
+  {
+    const gsl_movstat_end_t etypes[] = { GSL_MOVSTAT_END_PADZERO, GSL_MOVSTAT_END_PADVALUE,
+                                         GSL_MOVSTAT_END_TRUNCATE };
+    size_t k;
+    int ties;
+
+    for (k = 0; k < 3; ++k)
+      {
+        for (ties = 0; ties <= 1; ++ties)
+          {
+            test_quantile_proc(eps, 0.0, 100, 0, 0, etypes[k], ties, rng_p);
+            test_quantile_proc(eps, 1.0, 500, 3, 3, etypes[k], ties, rng_p);
+            test_quantile_proc(eps, 0.5, 500, 0, 5, etypes[k], ties, rng_p);
+            test_quantile_proc(eps, 0.9, 500, 5, 0, etypes[k], ties, rng_p);
+            test_quantile_proc(eps, 0.37, 1000, 40, 25, etypes[k], ties, rng_p);
+            test_quantile_proc(eps, 0.25, 20, 50, 10, etypes[k], ties, rng_p);
+            test_quantile_proc(eps, 0.05, 300, 1000, 1000, etypes[k], ties, rng_p);
+          }
+      }
+  }
 }
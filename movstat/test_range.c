@@ -0,0 +1,139 @@
+/* movstat/test_range.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_movstat.h>
+
+static double
+test_range_func(const size_t n, double x[], void * params)
+{
+  size_t i;
+  double sum = 0.0;
+
+  (void) params;
+
+  /* weight samples by position in window */
+  for (i = 0; i < n; ++i)
+    sum += (i + 1.0) * x[i];
+
+  return sum;
+}
+
+/* check that outputs computed over random disjoint ranges are identical to gsl_movstat_apply_accum() */
+static void
+test_range_proc(const char * desc, const gsl_movstat_accum * accum, void * accum_params,
+                const int second, const size_t n, const size_t H, const size_t J,
+                const gsl_movstat_end_t etype, gsl_rng * rng_p)
+{
+  gsl_movstat_workspace * w = gsl_movstat_alloc2(H, J);
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * z = gsl_vector_alloc(n);
+  gsl_vector * u = gsl_vector_alloc(n);
+  gsl_vector * v = gsl_vector_alloc(n);
+  size_t first = 0;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    gsl_vector_set(x, i, 2.0 * gsl_rng_uniform(rng_p) - 1.0);
+
+  gsl_movstat_apply_accum(etype, x, accum, accum_params, y, second ? z : NULL, w);
+
+  gsl_vector_set_all(u, GSL_NAN);
+  gsl_vector_set_all(v, GSL_NAN);
+
+  /* ranges are processed in decreasing order, with a single workspace */
+  while (first < n)
+    {
+      size_t last = first + 1 + gsl_rng_uniform_int(rng_p, GSL_MIN(n - first, 3 * (H + J) + 5));
+      gsl_movstat_apply_accum_range(etype, x, accum, accum_params, n - last, n - first,
+                                    u, second ? v : NULL, w);
+      first = last;
+    }
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_test_abs(gsl_vector_get(u, i), gsl_vector_get(y, i), 0.0,
+                   "range %s n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                   desc, n, H, J, etype, i);
+
+      if (second)
+        {
+          gsl_test_abs(gsl_vector_get(v, i), gsl_vector_get(z, i), 0.0,
+                       "range %s second output n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                       desc, n, H, J, etype, i);
+        }
+    }
+
+  gsl_movstat_free(w);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+  gsl_vector_free(u);
+  gsl_vector_free(v);
+}
+
+static void
+test_range(gsl_rng * rng_p)
+{
+  const gsl_movstat_end_t etypes[] = { GSL_MOVSTAT_END_PADZERO, GSL_MOVSTAT_END_PADVALUE,
+                                       GSL_MOVSTAT_END_TRUNCATE };
+  const size_t windows[][2] = { { 0, 0 }, { 3, 3 }, { 0, 5 }, { 5, 0 }, { 10, 4 }, { 4, 10 }, { 40, 25 } };
+  const size_t lengths[] = { 1, 2, 7, 100, 1000 };
+  double scale = 1.482602218505602;
+  double q = 0.25;
+  double alpha = 0.1;
+  gsl_movstat_function F;
+  size_t i, k, l;
+
+  F.function = test_range_func;
+  F.params = NULL;
+
+  for (k = 0; k < 3; ++k)
+    {
+      for (i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i)
+        {
+          const size_t H = windows[i][0];
+          const size_t J = windows[i][1];
+
+          for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+            {
+              const size_t n = lengths[l];
+
+              test_range_proc("mean", gsl_movstat_accum_mean, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("variance", gsl_movstat_accum_variance, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("sd", gsl_movstat_accum_sd, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("sum", gsl_movstat_accum_sum, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("minmax", gsl_movstat_accum_minmax, NULL, 1, n, H, J, etypes[k], rng_p);
+              test_range_proc("median", gsl_movstat_accum_median, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("mad", gsl_movstat_accum_mad, &scale, 1, n, H, J, etypes[k], rng_p);
+              test_range_proc("qqr", gsl_movstat_accum_qqr, &q, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("quantile", gsl_movstat_accum_quantile, &q, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("trmean", gsl_movstat_accum_trmean, &alpha, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("winsorized", gsl_movstat_accum_winsorized_mean, &alpha, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("Sn", gsl_movstat_accum_Sn, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("Qn", gsl_movstat_accum_Qn, NULL, 0, n, H, J, etypes[k], rng_p);
+              test_range_proc("user", gsl_movstat_accum_userfunc, &F, 0, n, H, J, etypes[k], rng_p);
+            }
+        }
+    }
+}
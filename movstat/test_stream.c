@@ -0,0 +1,238 @@
+/* movstat/test_stream.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_movstat.h>
+
+/* process x through stream s in random pieces, storing the outputs in y and z */
+static void
+test_stream_chunks(const int inplace, const gsl_vector * x, gsl_vector * y, gsl_vector * z,
+                   gsl_movstat_stream * s, gsl_rng * rng_p)
+{
+  const size_t n = x->size;
+  gsl_vector * buf = gsl_vector_alloc(n);
+  gsl_vector * zbuf = gsl_vector_alloc(n);
+  size_t i = 0, nout = 0, ny, j;
+
+  while (i < n)
+    {
+      size_t m = 1 + gsl_rng_uniform_int(rng_p, GSL_MIN(n - i, 2 * s->K + 3));
+      gsl_vector_const_view xv = gsl_vector_const_subvector(x, i, m);
+      gsl_vector_view bv = gsl_vector_subvector(buf, 0, m);
+      gsl_vector_view zv = gsl_vector_subvector(zbuf, 0, m);
+
+      if (inplace)
+        {
+          gsl_vector_memcpy(&bv.vector, &xv.vector);
+          gsl_movstat_stream_push(&bv.vector, &bv.vector, z ? &zv.vector : NULL, &ny, s);
+        }
+      else
+        {
+          gsl_movstat_stream_push(&xv.vector, &bv.vector, z ? &zv.vector : NULL, &ny, s);
+        }
+
+      for (j = 0; j < ny; ++j)
+        {
+          gsl_vector_set(y, nout + j, gsl_vector_get(buf, j));
+          if (z)
+            gsl_vector_set(z, nout + j, gsl_vector_get(zbuf, j));
+        }
+
+      i += m;
+      nout += ny;
+    }
+
+  gsl_movstat_stream_finish(buf, z ? zbuf : NULL, &ny, s);
+
+  for (j = 0; j < ny; ++j)
+    {
+      gsl_vector_set(y, nout + j, gsl_vector_get(buf, j));
+      if (z)
+        gsl_vector_set(z, nout + j, gsl_vector_get(zbuf, j));
+    }
+
+  gsl_test_int(nout + ny, n, "stream output length n=%zu H=%zu J=%zu", n, s->H, s->J);
+
+  gsl_vector_free(buf);
+  gsl_vector_free(zbuf);
+}
+
+/* compute y_i = F(W_i) by explicitely constructing each window */
+static void
+slow_movfunc(const gsl_movstat_end_t etype, const gsl_movstat_function * F, const gsl_vector * x,
+             gsl_vector * y, const size_t H, const size_t J)
+{
+  const size_t n = x->size;
+  double *window = malloc((H + J + 1) * sizeof(double));
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      size_t wsize = gsl_movstat_fill(etype, x, i, H, J, window);
+      gsl_vector_set(y, i, GSL_MOVSTAT_FN_EVAL(F, wsize, window));
+    }
+
+  free(window);
+}
+
+/* scaled MAD, with scale factor in params */
+static double
+func_stream_mad(const size_t n, double x[], void * params)
+{
+  return *(double *) params * func_mad(n, x, NULL);
+}
+
+/*
+ * compare a stream fed in random pieces with gsl_movstat_apply_accum(), and both
+ * with the brute force statistics F1 (first output) and F2 (second output, or NULL)
+ */
+static void
+test_stream_proc(const char * desc, const gsl_movstat_accum * accum, void * accum_params,
+                 const gsl_movstat_function * F1, const gsl_movstat_function * F2,
+                 const size_t n, const size_t H, const size_t J, const gsl_movstat_end_t etype,
+                 gsl_rng * rng_p)
+{
+  const double tol = 1.0e-10;
+  const int second = (F2 != NULL);
+  gsl_movstat_workspace * w = gsl_movstat_alloc2(H, J);
+  gsl_movstat_stream * s = gsl_movstat_stream_alloc(etype, accum, accum_params, H, J);
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * z = gsl_vector_alloc(n);
+  gsl_vector * u = gsl_vector_alloc(n);
+  gsl_vector * v = gsl_vector_alloc(n);
+  gsl_vector * y_slow = gsl_vector_alloc(n);
+  gsl_vector * z_slow = gsl_vector_alloc(n);
+  int inplace;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    gsl_vector_set(x, i, 2.0 * gsl_rng_uniform(rng_p) - 1.0);
+
+  gsl_movstat_apply_accum(etype, x, accum, accum_params, y, second ? z : NULL, w);
+
+  slow_movfunc(etype, F1, x, y_slow, H, J);
+  if (second)
+    slow_movfunc(etype, F2, x, z_slow, H, J);
+
+  for (i = 0; i < n; ++i)
+    {
+      gsl_test_rel(gsl_vector_get(y, i), gsl_vector_get(y_slow, i), tol,
+                   "one-shot %s n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                   desc, n, H, J, etype, i);
+
+      if (second)
+        {
+          gsl_test_rel(gsl_vector_get(z, i), gsl_vector_get(z_slow, i), tol,
+                       "one-shot %s second output n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                       desc, n, H, J, etype, i);
+        }
+    }
+
+  for (inplace = 0; inplace <= 1; ++inplace)
+    {
+      test_stream_chunks(inplace, x, u, second ? v : NULL, s, rng_p);
+
+      for (i = 0; i < n; ++i)
+        {
+          gsl_test_rel(gsl_vector_get(u, i), gsl_vector_get(y, i), 0.0,
+                       "stream %s inplace=%d n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                       desc, inplace, n, H, J, etype, i);
+          gsl_test_rel(gsl_vector_get(u, i), gsl_vector_get(y_slow, i), tol,
+                       "stream %s brute force inplace=%d n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                       desc, inplace, n, H, J, etype, i);
+
+          if (second)
+            {
+              gsl_test_rel(gsl_vector_get(v, i), gsl_vector_get(z, i), 0.0,
+                           "stream %s second output inplace=%d n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                           desc, inplace, n, H, J, etype, i);
+              gsl_test_rel(gsl_vector_get(v, i), gsl_vector_get(z_slow, i), tol,
+                           "stream %s second output brute force inplace=%d n=%zu H=%zu J=%zu endtype=%u i=%zu",
+                           desc, inplace, n, H, J, etype, i);
+            }
+        }
+    }
+
+  gsl_movstat_free(w);
+  gsl_movstat_stream_free(s);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+  gsl_vector_free(u);
+  gsl_vector_free(v);
+  gsl_vector_free(y_slow);
+  gsl_vector_free(z_slow);
+}
+
+static void
+test_stream(gsl_rng * rng_p)
+{
+  const gsl_movstat_end_t etypes[] = { GSL_MOVSTAT_END_PADZERO, GSL_MOVSTAT_END_PADVALUE,
+                                       GSL_MOVSTAT_END_TRUNCATE };
+  const size_t windows[][2] = { { 0, 0 }, { 3, 3 }, { 0, 5 }, { 5, 0 }, { 10, 4 }, { 4, 10 } };
+  const size_t lengths[] = { 1, 2, 7, 100 };
+  double scale = 1.482602218505602;
+  double q = 0.25;
+  gsl_movstat_function F_mean, F_var, F_sum, F_min, F_max, F_median, F_mad, F_qqr, F_Sn, F_Qn;
+  size_t i, k, l;
+
+  F_mean.function = func_mean;
+  F_var.function = func_var;
+  F_sum.function = func_sum;
+  F_min.function = func_min;
+  F_max.function = func_max;
+  F_median.function = func_median;
+  F_mad.function = func_stream_mad;
+  F_qqr.function = func_qqr;
+  F_Sn.function = func_Sn;
+  F_Qn.function = func_Qn;
+
+  F_mean.params = F_var.params = F_sum.params = F_min.params = F_max.params = NULL;
+  F_median.params = F_Sn.params = F_Qn.params = NULL;
+  F_mad.params = &scale;
+  F_qqr.params = &q;
+
+  for (k = 0; k < 3; ++k)
+    {
+      for (i = 0; i < sizeof(windows) / sizeof(windows[0]); ++i)
+        {
+          const size_t H = windows[i][0];
+          const size_t J = windows[i][1];
+
+          for (l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l)
+            {
+              const size_t n = lengths[l];
+
+              test_stream_proc("mean", gsl_movstat_accum_mean, NULL, &F_mean, NULL, n, H, J, etypes[k], rng_p);
+              test_stream_proc("variance", gsl_movstat_accum_variance, NULL, &F_var, NULL, n, H, J, etypes[k], rng_p);
+              test_stream_proc("sum", gsl_movstat_accum_sum, NULL, &F_sum, NULL, n, H, J, etypes[k], rng_p);
+              test_stream_proc("minmax", gsl_movstat_accum_minmax, NULL, &F_min, &F_max, n, H, J, etypes[k], rng_p);
+              test_stream_proc("median", gsl_movstat_accum_median, NULL, &F_median, NULL, n, H, J, etypes[k], rng_p);
+              test_stream_proc("mad", gsl_movstat_accum_mad, &scale, &F_median, &F_mad, n, H, J, etypes[k], rng_p);
+              test_stream_proc("qqr", gsl_movstat_accum_qqr, &q, &F_qqr, NULL, n, H, J, etypes[k], rng_p);
+              test_stream_proc("Sn", gsl_movstat_accum_Sn, NULL, &F_Sn, NULL, n, H, J, etypes[k], rng_p);
+              test_stream_proc("Qn", gsl_movstat_accum_Qn, NULL, &F_Qn, NULL, n, H, J, etypes[k], rng_p);
+            }
+        }
+    }
+}
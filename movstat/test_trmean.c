@@ -0,0 +1,164 @@
+/* movstat/test_trmean.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics.h>
+#include <gsl/gsl_movstat.h>
+
+/* compute moving trimmed mean by explicitely constructing and sorting window */
+int
+slow_movtrmean(const gsl_movstat_end_t etype, const double alpha, const gsl_vector * x,
+               gsl_vector * y, const int H, const int J)
+{
+  const size_t n = x->size;
+  const int K = H + J + 1;
+  double *window = malloc(K * sizeof(double));
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      size_t wsize = gsl_movstat_fill(etype, x, i, H, J, window);
+
+      gsl_sort(window, 1, wsize);
+      gsl_vector_set(y, i, gsl_stats_trmean_from_sorted_data(alpha, window, 1, wsize));
+    }
+
+  free(window);
+
+  return GSL_SUCCESS;
+}
+
+/* compute moving Winsorized mean by explicitely constructing, sorting and Winsorizing window */
+int
+slow_movwinsorized(const gsl_movstat_end_t etype, const double alpha, const gsl_vector * x,
+                   gsl_vector * y, const int H, const int J)
+{
+  const size_t n = x->size;
+  const int K = H + J + 1;
+  double *window = malloc(K * sizeof(double));
+  size_t i, j;
+
+  for (i = 0; i < n; ++i)
+    {
+      size_t wsize = gsl_movstat_fill(etype, x, i, H, J, window);
+      size_t g = (size_t) floor(alpha * wsize);
+
+      gsl_sort(window, 1, wsize);
+
+      if (alpha >= 0.5)
+        {
+          gsl_vector_set(y, i, gsl_stats_median_from_sorted_data(window, 1, wsize));
+        }
+      else
+        {
+          for (j = 0; j < g; ++j)
+            {
+              window[j] = window[g];
+              window[wsize - 1 - j] = window[wsize - 1 - g];
+            }
+
+          gsl_vector_set(y, i, gsl_stats_mean(window, 1, wsize));
+        }
+    }
+
+  free(window);
+
+  return GSL_SUCCESS;
+}
+
+/* test moving trimmed and Winsorized means; if ties is set, the input has many repeated
+ * values, shifted away from 0 so the relative comparison is meaningful */
+static void
+test_trmean_proc(const double tol, const double alpha, const size_t n, const size_t H, const size_t J,
+                 const gsl_movstat_end_t etype, const int ties, gsl_rng * rng_p)
+{
+  gsl_movstat_workspace * w = gsl_movstat_alloc2(H, J);
+  gsl_vector * x = gsl_vector_alloc(n);
+  gsl_vector * y = gsl_vector_alloc(n);
+  gsl_vector * z = gsl_vector_alloc(n);
+  char buf[2048];
+  size_t i;
+
+  random_vector(x, rng_p);
+
+  if (ties)
+    {
+      for (i = 0; i < n; ++i)
+        gsl_vector_set(x, i, floor(4.0 * gsl_vector_get(x, i)) + 5.0);
+    }
+
+  /* y = trimmed mean(x) with slow brute force method */
+  slow_movtrmean(etype, alpha, x, y, H, J);
+
+  /* z = trimmed mean(x) with fast method */
+  gsl_movstat_trmean(etype, x, alpha, z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u ties=%d trmean alpha=%g random", n, H, J, etype, ties, alpha);
+  compare_vectors(tol, z, y, buf);
+
+  /* z = trimmed mean(x) in-place */
+  gsl_vector_memcpy(z, x);
+  gsl_movstat_trmean(etype, z, alpha, z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u ties=%d trmean alpha=%g random in-place", n, H, J, etype, ties, alpha);
+  compare_vectors(tol, z, y, buf);
+
+  /* y = Winsorized mean(x) with slow brute force method */
+  slow_movwinsorized(etype, alpha, x, y, H, J);
+
+  /* z = Winsorized mean(x) with fast method */
+  gsl_movstat_winsorized_mean(etype, x, alpha, z, w);
+
+  sprintf(buf, "n=%zu H=%zu J=%zu endtype=%u ties=%d winsorized alpha=%g random", n, H, J, etype, ties, alpha);
+  compare_vectors(tol, z, y, buf);
+
+  gsl_movstat_free(w);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+  gsl_vector_free(z);
+}
+
+static void
+test_trmean(gsl_rng * rng_p)
+{
+  const gsl_movstat_end_t etypes[] = { GSL_MOVSTAT_END_PADZERO, GSL_MOVSTAT_END_PADVALUE,
+                                       GSL_MOVSTAT_END_TRUNCATE };
+  const double eps = 1.0e-10;
+  size_t k;
+  int ties;
+
+  for (k = 0; k < 3; ++k)
+    {
+      for (ties = 0; ties <= 1; ++ties)
+        {
+          test_trmean_proc(eps, 0.0, 100, 0, 0, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.1, 500, 3, 3, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.2, 500, 0, 5, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.25, 500, 5, 0, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.3, 1000, 40, 25, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.5, 500, 10, 4, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.05, 20, 50, 10, etypes[k], ties, rng_p);
+          test_trmean_proc(eps, 0.1, 300, 1000, 1000, etypes[k], ties, rng_p);
+        }
+    }
+}
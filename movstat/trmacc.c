@@ -0,0 +1,249 @@
+/* movstat/trmacc.c
+ *
+ * Moving window trimmed and Winsorized mean accumulators
+ * 
+ * Copyright (C) 2021 Patrick Alken
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * The window is kept in sorted order in a skiplist, as for the quantile
+ * accumulators. The retained samples, of rank floor(alpha*n) to
+ * n - floor(alpha*n) - 1, are read from the skiplist in O(log n + m)
+ * operations for m retained samples, instead of sorting the window.
+ */
+
+#include <config.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_movstat.h>
+
+typedef double trmacc_type_t;
+typedef trmacc_type_t ringbuf_type_t;
+typedef trmacc_type_t skiplist_type_t;
+
+#include "ringbuf.c"
+#include "skiplist.c"
+
+typedef struct
+{
+  trmacc_type_t *window; /* retained samples of current window, size n */
+  ringbuf *rbuf;         /* ring buffer storing current window */
+  skiplist *slist;       /* current window in sorted order */
+} trmacc_state_t;
+
+static size_t trmacc_size(const size_t n);
+static int trmacc_init(const size_t n, void * vstate);
+static int trmacc_insert(const trmacc_type_t x, void * vstate);
+static int trmacc_delete(void * vstate);
+static int trmacc_trmean(void * params, trmacc_type_t * result, const void * vstate);
+static int trmacc_winsorized(void * params, trmacc_type_t * result, const void * vstate);
+static int trmacc_middle(const double alpha, const trmacc_state_t * state, int * g);
+static double trmacc_mean(const double * x, const int n);
+
+static size_t
+trmacc_size(const size_t n)
+{
+  size_t size = 0;
+
+  size += sizeof(trmacc_state_t);
+  size += n * sizeof(trmacc_type_t);
+  size += ringbuf_size(n);
+  size += skiplist_size(n);
+
+  return size;
+}
+
+static int
+trmacc_init(const size_t n, void * vstate)
+{
+  trmacc_state_t * state = (trmacc_state_t *) vstate;
+
+  state->window = (trmacc_type_t *) ((unsigned char *) vstate + sizeof(trmacc_state_t));
+  state->rbuf = (ringbuf *) ((unsigned char *) state->window + n * sizeof(trmacc_type_t));
+  state->slist = (skiplist *) ((unsigned char *) state->rbuf + ringbuf_size(n));
+
+  ringbuf_init(n, state->rbuf);
+  skiplist_init(n, state->slist);
+
+  return GSL_SUCCESS;
+}
+
+static int
+trmacc_insert(const trmacc_type_t x, void * vstate)
+{
+  trmacc_state_t * state = (trmacc_state_t *) vstate;
+
+  /* remove oldest element from sorted window if it is about to be overwritten */
+  if (ringbuf_is_full(state->rbuf))
+    skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+
+  /* add new element to ring buffer and sorted window */
+  ringbuf_insert(x, state->rbuf);
+  skiplist_insert(x, state->slist);
+
+  return GSL_SUCCESS;
+}
+
+static int
+trmacc_delete(void * vstate)
+{
+  trmacc_state_t * state = (trmacc_state_t *) vstate;
+
+  if (!ringbuf_is_empty(state->rbuf))
+    {
+      skiplist_delete(ringbuf_peek_back(state->rbuf), state->slist);
+      ringbuf_pop_back(state->rbuf);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* trimmed mean of window, as in gsl_stats_trmean_from_sorted_data() */
+static int
+trmacc_trmean(void * params, trmacc_type_t * result, const void * vstate)
+{
+  const trmacc_state_t * state = (const trmacc_state_t *) vstate;
+  const double alpha = *(double *) params;
+  int g;
+  int m = trmacc_middle(alpha, state, &g);
+
+  if (m == 0)
+    *result = 0.0;
+  else if (alpha >= 0.5)
+    *result = (m == 1) ? state->window[0] : (state->window[0] + state->window[1]) / 2.0;
+  else
+    *result = trmacc_mean(state->window, m);
+
+  return GSL_SUCCESS;
+}
+
+/*
+trmacc_winsorized()
+  Winsorized mean of window: the g = floor(alpha*n) smallest samples are
+replaced by the sample of rank g and the g largest by the sample of rank
+n - g - 1 before the mean is computed
+*/
+
+static int
+trmacc_winsorized(void * params, trmacc_type_t * result, const void * vstate)
+{
+  const trmacc_state_t * state = (const trmacc_state_t *) vstate;
+  const double alpha = *(double *) params;
+  int g;
+  int m = trmacc_middle(alpha, state, &g);
+
+  if (m == 0)
+    {
+      *result = 0.0;
+    }
+  else if (alpha >= 0.5)
+    {
+      *result = (m == 1) ? state->window[0] : (state->window[0] + state->window[1]) / 2.0;
+    }
+  else
+    {
+      const double lo = state->window[0];
+      const double hi = state->window[m - 1];
+      double mean = trmacc_mean(state->window, m);
+
+      /* combine with the g replaced samples at each end */
+      mean += (g * (lo - mean) + g * (hi - mean)) / (m + 2.0 * g);
+
+      *result = mean;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+trmacc_middle()
+  Copy the retained samples of the window, of rank g to n - g - 1 with
+g = floor(alpha*n), to state->window; for alpha >= 1/2, the one or two
+middle samples are copied
+
+Return: number of samples copied, 0 for an empty window
+*/
+
+static int
+trmacc_middle(const double alpha, const trmacc_state_t * state, int * g)
+{
+  const int n = state->slist->n;
+  int lo, m;
+
+  if (n == 0)
+    {
+      *g = 0;
+      return 0;
+    }
+  else if (alpha >= 0.5)
+    {
+      lo = (n - 1) / 2;
+      m = n / 2 - lo + 1;
+    }
+  else
+    {
+      lo = (int) floor(alpha * n);
+      m = n - 2 * lo;
+    }
+
+  *g = lo;
+  skiplist_copy(lo, m, state->window, state->slist);
+
+  return m;
+}
+
+/* mean of x, with the recurrence of gsl_stats_trmean_from_sorted_data() */
+static double
+trmacc_mean(const double * x, const int n)
+{
+  double mean = 0.0;
+  double k = 0.0;
+  int i;
+
+  for (i = 0; i < n; ++i)
+    {
+      double delta = x[i] - mean;
+      k += 1.0;
+      mean += delta / k;
+    }
+
+  return mean;
+}
+
+static const gsl_movstat_accum trmean_accum_type =
+{
+  trmacc_size,
+  trmacc_init,
+  trmacc_insert,
+  trmacc_delete,
+  trmacc_trmean
+};
+
+const gsl_movstat_accum *gsl_movstat_accum_trmean = &trmean_accum_type;
+
+static const gsl_movstat_accum winsorized_mean_accum_type =
+{
+  trmacc_size,
+  trmacc_init,
+  trmacc_insert,
+  trmacc_delete,
+  trmacc_winsorized
+};
+
+const gsl_movstat_accum *gsl_movstat_accum_winsorized_mean = &winsorized_mean_accum_type;
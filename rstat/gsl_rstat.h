@@ -21,6 +21,7 @@
 #define __GSL_RSTAT_H__
 
 #include <stdlib.h>
+#include <stdio.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -48,8 +49,40 @@ gsl_rstat_quantile_workspace *gsl_rstat_quantile_alloc(const double p);
 void gsl_rstat_quantile_free(gsl_rstat_quantile_workspace *w);
 int gsl_rstat_quantile_reset(gsl_rstat_quantile_workspace *w);
 int gsl_rstat_quantile_add(const double x, gsl_rstat_quantile_workspace *w);
+int gsl_rstat_quantile_merge(const gsl_rstat_quantile_workspace *src,
+                             gsl_rstat_quantile_workspace *w);
 double gsl_rstat_quantile_get(gsl_rstat_quantile_workspace *w);
 
+typedef struct
+{
+  double delta;        /* compression parameter */
+  size_t size;         /* maximum number of centroids */
+  size_t ncentroid;    /* number of centroids */
+  double *mean;        /* centroid means in increasing order, size 'size' */
+  double *weight;      /* centroid weights, size 'size' */
+  double *work_mean;   /* workspace, size 'size' */
+  double *work_weight; /* workspace, size 'size' */
+  size_t bufsize;      /* size of buffer */
+  size_t nbuf;         /* number of data in buffer */
+  double *buf;         /* data not yet merged into centroids, size 'bufsize' */
+  double min;          /* minimum value added */
+  double max;          /* maximum value added */
+  size_t n;            /* number of data added */
+} gsl_rstat_tdigest_workspace;
+
+gsl_rstat_tdigest_workspace *gsl_rstat_tdigest_alloc(const double delta);
+void gsl_rstat_tdigest_free(gsl_rstat_tdigest_workspace *w);
+int gsl_rstat_tdigest_reset(gsl_rstat_tdigest_workspace *w);
+size_t gsl_rstat_tdigest_n(const gsl_rstat_tdigest_workspace *w);
+int gsl_rstat_tdigest_add(const double x, gsl_rstat_tdigest_workspace *w);
+int gsl_rstat_tdigest_add_array(const double data[], const size_t stride, const size_t n,
+                                gsl_rstat_tdigest_workspace *w);
+int gsl_rstat_tdigest_merge(const gsl_rstat_tdigest_workspace *src,
+                            gsl_rstat_tdigest_workspace *w);
+double gsl_rstat_tdigest_quantile(const double p, gsl_rstat_tdigest_workspace *w);
+int gsl_rstat_tdigest_fwrite(FILE * stream, const gsl_rstat_tdigest_workspace *w);
+int gsl_rstat_tdigest_fread(FILE * stream, gsl_rstat_tdigest_workspace *w);
+
 typedef struct
 {
   double min;      /* minimum value added */
@@ -66,6 +99,9 @@ gsl_rstat_workspace *gsl_rstat_alloc(void);
 void gsl_rstat_free(gsl_rstat_workspace *w);
 size_t gsl_rstat_n(const gsl_rstat_workspace *w);
 int gsl_rstat_add(const double x, gsl_rstat_workspace *w);
+int gsl_rstat_add_array(const double data[], const size_t stride, const size_t n,
+                        gsl_rstat_workspace *w);
+int gsl_rstat_merge(const gsl_rstat_workspace *src, gsl_rstat_workspace *w);
 double gsl_rstat_min(const gsl_rstat_workspace *w);
 double gsl_rstat_max(const gsl_rstat_workspace *w);
 double gsl_rstat_mean(const gsl_rstat_workspace *w);
@@ -35,6 +35,7 @@
 
 static double calc_psq(const double qp1, const double q, const double qm1,
                        const double d, const double np1, const double n, const double nm1);
+static double quantile_count(const double x, const gsl_rstat_quantile_workspace *w);
 
 gsl_rstat_quantile_workspace *
 gsl_rstat_quantile_alloc(const double p)
@@ -180,6 +181,127 @@ gsl_rstat_quantile_add(const double x, gsl_rstat_quantile_workspace *w)
   return GSL_SUCCESS;
 } /* gsl_rstat_quantile_add() */
 
+/*
+gsl_rstat_quantile_merge()
+  Merge the quantile estimate of src into w, so that w estimates the
+p-quantile of all data added to either workspace
+
+Inputs: src - workspace to merge, not modified
+        w   - (input/output) workspace
+
+Return: success/error
+
+Notes:
+1) While a workspace holds 5 points or fewer, it stores the points
+themselves, which are added to the other workspace with
+gsl_rstat_quantile_add()
+
+2) Otherwise, the number of points up to each marker height of either
+workspace is interpolated linearly between markers. The heights of the
+merged middle markers are found by inverting the sum of these counts at
+their desired positions, so the result is only an estimate
+*/
+
+int
+gsl_rstat_quantile_merge(const gsl_rstat_quantile_workspace *src,
+                         gsl_rstat_quantile_workspace *w)
+{
+  if (src->p != w->p)
+    {
+      GSL_ERROR("workspaces must estimate the same quantile", GSL_EINVAL);
+    }
+  else if (src->n <= 5)
+    {
+      size_t i;
+
+      for (i = 0; i < src->n; ++i)
+        {
+          int status = gsl_rstat_quantile_add(src->q[i], w);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+  else if (w->n <= 5)
+    {
+      gsl_rstat_quantile_workspace tmp = *src;
+      size_t i;
+
+      for (i = 0; i < w->n; ++i)
+        {
+          int status = gsl_rstat_quantile_add(w->q[i], &tmp);
+          if (status)
+            return status;
+        }
+
+      *w = tmp;
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const double p = w->p;
+      const size_t n = w->n + src->n;
+      const double dp[5] = { 0.0, 0.5 * p, p, 0.5 * (1.0 + p), 1.0 };
+      double x[10], c[10];
+      double q[5];
+      int npos[5];
+      size_t i, k;
+
+      /* cumulative counts at the marker heights of both workspaces */
+      for (i = 0; i < 5; ++i)
+        {
+          x[i] = w->q[i];
+          x[i + 5] = src->q[i];
+        }
+
+      gsl_sort(x, 1, 10);
+
+      for (k = 0; k < 10; ++k)
+        c[k] = quantile_count(x[k], w) + quantile_count(x[k], src);
+
+      q[0] = x[0];
+      q[4] = x[9];
+      npos[0] = 1;
+      npos[4] = (int) n;
+
+      for (i = 1; i <= 3; ++i)
+        {
+          const double np = 1.0 + (n - 1.0) * dp[i];
+          int ni = (int) floor(np + 0.5);
+
+          /* invert the piecewise linear count at the desired position */
+          for (k = 1; k < 9 && c[k] < np; ++k)
+            ;
+
+          if (c[k] > c[k - 1])
+            q[i] = x[k - 1] + (np - c[k - 1]) / (c[k] - c[k - 1]) * (x[k] - x[k - 1]);
+          else
+            q[i] = x[k];
+
+          q[i] = GSL_MAX(q[i], q[i - 1]);
+          q[i] = GSL_MIN(q[i], q[4]);
+
+          /* marker positions must be distinct */
+          ni = GSL_MAX(ni, npos[i - 1] + 1);
+          ni = GSL_MIN(ni, (int) n - 4 + (int) i);
+          npos[i] = ni;
+        }
+
+      for (i = 0; i < 5; ++i)
+        {
+          w->q[i] = q[i];
+          w->npos[i] = npos[i];
+          w->np[i] = 1.0 + (n - 1.0) * dp[i];
+        }
+
+      w->n = n;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_rstat_quantile_merge() */
+
 double
 gsl_rstat_quantile_get(gsl_rstat_quantile_workspace *w)
 {
@@ -205,3 +327,23 @@ calc_psq(const double qp1, const double q, const double qm1,
 
   return q + outer * (inner_left + inner_right);
 } /* calc_psq() */
+
+/* number of points <= x, interpolated linearly between marker heights */
+static double
+quantile_count(const double x, const gsl_rstat_quantile_workspace *w)
+{
+  size_t i;
+
+  if (x < w->q[0])
+    return 0.0;
+  else if (x >= w->q[4])
+    return (double) w->n;
+
+  for (i = 0; i < 3 && x >= w->q[i + 1]; ++i)
+    ;
+
+  if (w->q[i + 1] > w->q[i])
+    return w->npos[i] + (x - w->q[i]) / (w->q[i + 1] - w->q[i]) * (w->npos[i + 1] - w->npos[i]);
+  else
+    return (double) w->npos[i];
+} /* quantile_count() */
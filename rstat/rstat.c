@@ -24,6 +24,12 @@
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_rstat.h>
 
+/* number of samples processed per block in gsl_rstat_add_array() */
+#define RSTAT_BLOCK_SIZE     256
+
+static int rstat_merge_moments(const size_t nb, const double meanb, const double M2b,
+                               const double M3b, const double M4b, gsl_rstat_workspace *w);
+
 gsl_rstat_workspace *
 gsl_rstat_alloc(void)
 {
@@ -102,6 +108,131 @@ gsl_rstat_add(const double x, gsl_rstat_workspace *w)
   return GSL_SUCCESS;
 } /* gsl_rstat_add() */
 
+/*
+gsl_rstat_add_array()
+  Add an array of data points to the running totals
+
+Inputs: data   - data points
+        stride - stride of data
+        n      - number of data points
+        w      - workspace
+
+Return: success/error
+
+Notes:
+1) The moments of each block of RSTAT_BLOCK_SIZE points are computed
+with two passes over the block, whose loops have no dependencies between
+iterations, and then merged into the running totals; the result equals
+that of calling gsl_rstat_add() for each point, up to rounding errors
+
+2) The median estimate is updated one point at a time, and is identical
+to that of calling gsl_rstat_add() for each point
+*/
+
+int
+gsl_rstat_add_array(const double data[], const size_t stride, const size_t n,
+                    gsl_rstat_workspace *w)
+{
+  size_t i;
+
+  for (i = 0; i < n; i += RSTAT_BLOCK_SIZE)
+    {
+      const size_t nb = GSL_MIN(RSTAT_BLOCK_SIZE, n - i);
+      const double *x = data + i * stride;
+      double sum = 0.0, M2 = 0.0, M3 = 0.0, M4 = 0.0;
+      double mean, xmin = x[0], xmax = x[0];
+      size_t j;
+
+      for (j = 0; j < nb; ++j)
+        sum += x[j * stride];
+
+      mean = sum / (double) nb;
+
+      for (j = 0; j < nb; ++j)
+        {
+          const double xj = x[j * stride];
+          const double d = xj - mean;
+          const double d2 = d * d;
+
+          M2 += d2;
+          M3 += d2 * d;
+          M4 += d2 * d2;
+
+          if (xj < xmin)
+            xmin = xj;
+          if (xj > xmax)
+            xmax = xj;
+        }
+
+      if (w->n == 0)
+        {
+          w->min = xmin;
+          w->max = xmax;
+        }
+      else
+        {
+          if (xmin < w->min)
+            w->min = xmin;
+          if (xmax > w->max)
+            w->max = xmax;
+        }
+
+      rstat_merge_moments(nb, mean, M2, M3, M4, w);
+
+      /* update median */
+      for (j = 0; j < nb; ++j)
+        gsl_rstat_quantile_add(x[j * stride], w->median_workspace_p);
+    }
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_add_array() */
+
+/*
+gsl_rstat_merge()
+  Merge the running totals of src into w, so that w contains the
+statistics of all data added to either workspace
+
+Inputs: src - workspace to merge, not modified
+        w   - (input/output) workspace
+
+Return: success/error
+
+Notes:
+1) The mean, variance, skewness and kurtosis are combined with the
+formulas of Chan et al, and are exact up to rounding errors
+
+2) The median is combined with gsl_rstat_quantile_merge(), and is
+only an estimate when both workspaces contain more than 5 points
+*/
+
+int
+gsl_rstat_merge(const gsl_rstat_workspace *src, gsl_rstat_workspace *w)
+{
+  if (src->n == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      if (w->n == 0)
+        {
+          w->min = src->min;
+          w->max = src->max;
+        }
+      else
+        {
+          if (src->min < w->min)
+            w->min = src->min;
+          if (src->max > w->max)
+            w->max = src->max;
+        }
+
+      rstat_merge_moments(src->n, src->mean, src->M2, src->M3, src->M4, w);
+
+      return gsl_rstat_quantile_merge(src->median_workspace_p, w->median_workspace_p);
+    }
+} /* gsl_rstat_merge() */
+
 double
 gsl_rstat_min(const gsl_rstat_workspace *w)
 {
@@ -219,3 +350,50 @@ gsl_rstat_reset(gsl_rstat_workspace *w)
 
   return status;
 } /* gsl_rstat_reset() */
+
+/*
+rstat_merge_moments()
+  Merge the count, mean and central moment sums of a second set of
+data into the running totals, using the pairwise formulas of
+
+[1] T. F. Chan, G. H. Golub and R. J. LeVeque, Updating formulae and a
+pairwise algorithm for computing sample variances, Stanford University
+Technical Report STAN-CS-79-773, 1979.
+
+[2] P. Pebay, Formulas for robust, one-pass parallel computation of
+covariances and arbitrary-order statistical moments, Sandia Report
+SAND2008-6212, 2008.
+
+Inputs: nb    - number of points in second set, > 0
+        meanb - mean of second set
+        M2b   - sum of (x_i - meanb)^2 over second set
+        M3b   - sum of (x_i - meanb)^3 over second set
+        M4b   - sum of (x_i - meanb)^4 over second set
+        w     - workspace
+*/
+
+static int
+rstat_merge_moments(const size_t nb, const double meanb, const double M2b,
+                    const double M3b, const double M4b, gsl_rstat_workspace *w)
+{
+  const double na = (double) w->n;
+  const double dnb = (double) nb;
+  const double n = na + dnb;
+  const double M2a = w->M2;
+  const double M3a = w->M3;
+  const double delta = meanb - w->mean;
+  const double delta_n = delta / n;
+  const double delta_nsq = delta_n * delta_n;
+  const double term1 = delta * delta_n * na * dnb;
+
+  w->mean += dnb * delta_n;
+  w->M4 += M4b + term1 * delta_nsq * (na * na - na * dnb + dnb * dnb) +
+           6.0 * delta_nsq * (na * na * M2b + dnb * dnb * M2a) +
+           4.0 * delta_n * (na * M3b - dnb * M3a);
+  w->M3 += M3b + term1 * delta_n * (na - dnb) +
+           3.0 * delta_n * (na * M2b - dnb * M2a);
+  w->M2 += M2b + term1;
+  w->n += nb;
+
+  return GSL_SUCCESS;
+} /* rstat_merge_moments() */
@@ -0,0 +1,664 @@
+/* rstat/tdigest.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_block.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_rstat.h>
+
+/*
+ * Running estimation of all quantiles with a merging t-digest, based on
+ *
+ * [1] T. Dunning and O. Ertl, "Computing extremely accurate quantiles
+ *     using t-digests", arXiv:1902.04023, 2019
+ *
+ * The data are summarized by a sorted list of centroids (mean and
+ * weight). New data are collected in a buffer, which is sorted and merged
+ * with the centroids when it is full. During the merge, adjacent points
+ * are combined into one centroid as long as the centroid spans at most
+ * one unit of the scale function
+ *
+ * k(q) = delta / Z * log(q / (1 - q)),   Z = 4 log(n) + 24
+ *
+ * (k_2 of [1]), so that centroids near the tails hold few points, and the
+ * extreme quantiles are accurate. Between q = 1/n and q = 1 - 1/n, k spans
+ * less than delta / 2 units. Since each pair of adjacent centroids spans
+ * more than one unit, there are fewer than delta + 4 centroids. The
+ * normalization Z of [1] uses log(n / delta) in place of log(n), which
+ * does not bound the number of centroids by a multiple of delta.
+ *
+ * In practice about delta / 2 centroids are used (52 to 58 for delta = 100
+ * and n = 1e6), and the middle centroids each hold 15-20% of the data.
+ */
+
+/* number of buffered data per centroid */
+#define TDIGEST_BUFFER_FACTOR      5
+
+static int tdigest_flush(gsl_rstat_tdigest_workspace *w);
+static int tdigest_compress(const double *mean1, const double *weight1, const size_t n1,
+                            const double *mean2, const double *weight2, const size_t n2,
+                            gsl_rstat_tdigest_workspace *w);
+static double tdigest_qlimit(const double q0, const double delta, const double n);
+static int tdigest_iscount(const double x);
+
+gsl_rstat_tdigest_workspace *
+gsl_rstat_tdigest_alloc(const double delta)
+{
+  gsl_rstat_tdigest_workspace *w;
+
+  if (delta <= 0.0)
+    {
+      GSL_ERROR_NULL ("delta must be positive", GSL_EDOM);
+    }
+
+  w = calloc(1, sizeof(gsl_rstat_tdigest_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->delta = delta;
+  w->size = (size_t) ceil(delta) + 4;
+  w->bufsize = TDIGEST_BUFFER_FACTOR * w->size;
+
+  w->mean = malloc(w->size * sizeof(double));
+  w->weight = malloc(w->size * sizeof(double));
+  w->work_mean = malloc(w->size * sizeof(double));
+  w->work_weight = malloc(w->size * sizeof(double));
+  if (w->mean == 0 || w->weight == 0 || w->work_mean == 0 || w->work_weight == 0)
+    {
+      gsl_rstat_tdigest_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for centroids", GSL_ENOMEM);
+    }
+
+  w->buf = malloc(w->bufsize * sizeof(double));
+  if (w->buf == 0)
+    {
+      gsl_rstat_tdigest_free(w);
+      GSL_ERROR_NULL ("failed to allocate space for buffer", GSL_ENOMEM);
+    }
+
+  gsl_rstat_tdigest_reset(w);
+
+  return w;
+} /* gsl_rstat_tdigest_alloc() */
+
+void
+gsl_rstat_tdigest_free(gsl_rstat_tdigest_workspace *w)
+{
+  if (w->mean)
+    free(w->mean);
+
+  if (w->weight)
+    free(w->weight);
+
+  if (w->work_mean)
+    free(w->work_mean);
+
+  if (w->work_weight)
+    free(w->work_weight);
+
+  if (w->buf)
+    free(w->buf);
+
+  free(w);
+} /* gsl_rstat_tdigest_free() */
+
+int
+gsl_rstat_tdigest_reset(gsl_rstat_tdigest_workspace *w)
+{
+  w->ncentroid = 0;
+  w->nbuf = 0;
+  w->min = 0.0;
+  w->max = 0.0;
+  w->n = 0;
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_tdigest_reset() */
+
+size_t
+gsl_rstat_tdigest_n(const gsl_rstat_tdigest_workspace *w)
+{
+  return w->n;
+} /* gsl_rstat_tdigest_n() */
+
+int
+gsl_rstat_tdigest_add(const double x, gsl_rstat_tdigest_workspace *w)
+{
+  if (gsl_isnan(x))
+    {
+      GSL_ERROR ("invalid input argument x", GSL_EINVAL);
+    }
+
+  if (w->n == 0)
+    {
+      w->min = x;
+      w->max = x;
+    }
+  else
+    {
+      if (x < w->min)
+        w->min = x;
+      if (x > w->max)
+        w->max = x;
+    }
+
+  w->buf[w->nbuf++] = x;
+  ++(w->n);
+
+  if (w->nbuf == w->bufsize)
+    return tdigest_flush(w);
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_tdigest_add() */
+
+/*
+gsl_rstat_tdigest_add_array()
+  Add an array of data to the t-digest
+
+Inputs: data   - data to add
+        stride - stride of data
+        n      - number of data
+        w      - workspace
+
+Return: success/error
+
+Notes:
+1) The data are copied directly into the buffer, which is merged with
+the centroids each time it fills up; the result is identical to that
+of calling gsl_rstat_tdigest_add() for each point
+*/
+
+int
+gsl_rstat_tdigest_add_array(const double data[], const size_t stride, const size_t n,
+                            gsl_rstat_tdigest_workspace *w)
+{
+  size_t i = 0;
+
+  if (n > 0 && w->n == 0)
+    {
+      w->min = data[0];
+      w->max = data[0];
+    }
+
+  while (i < n)
+    {
+      const size_t nb = GSL_MIN(w->bufsize - w->nbuf, n - i);
+      double *buf = w->buf + w->nbuf;
+      double xmin = w->min, xmax = w->max;
+      size_t j;
+
+      for (j = 0; j < nb; ++j)
+        {
+          const double x = data[(i + j) * stride];
+
+          if (gsl_isnan(x))
+            {
+              GSL_ERROR ("invalid input argument x", GSL_EINVAL);
+            }
+
+          buf[j] = x;
+
+          if (x < xmin)
+            xmin = x;
+          if (x > xmax)
+            xmax = x;
+        }
+
+      w->min = xmin;
+      w->max = xmax;
+      w->nbuf += nb;
+      w->n += nb;
+      i += nb;
+
+      if (w->nbuf == w->bufsize)
+        {
+          int status = tdigest_flush(w);
+          if (status)
+            return status;
+        }
+    }
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_tdigest_add_array() */
+
+/*
+gsl_rstat_tdigest_merge()
+  Merge the t-digest src into w, so that w summarizes all data
+added to either workspace
+
+Inputs: src - t-digest to merge, not modified
+        w   - (input/output) t-digest
+
+Return: success/error
+
+Notes:
+1) The workspaces may have different values of delta; the merged
+centroids satisfy the size limit of w
+
+2) The centroids of src are read while those of w are rewritten, so
+src and w must be different workspaces; GSL_EINVAL is returned if
+src == w
+*/
+
+int
+gsl_rstat_tdigest_merge(const gsl_rstat_tdigest_workspace *src, gsl_rstat_tdigest_workspace *w)
+{
+  if (src == w)
+    {
+      GSL_ERROR ("cannot merge a t-digest with itself", GSL_EINVAL);
+    }
+  else if (src->n == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      int status;
+      size_t i;
+
+      status = tdigest_flush(w);
+      if (status)
+        return status;
+
+      if (w->n == 0)
+        {
+          w->min = src->min;
+          w->max = src->max;
+        }
+
+      if (src->ncentroid > 0)
+        {
+          const size_t nsrc = src->n - src->nbuf; /* weight of centroids of src */
+
+          memcpy(w->work_mean, w->mean, w->ncentroid * sizeof(double));
+          memcpy(w->work_weight, w->weight, w->ncentroid * sizeof(double));
+
+          w->n += nsrc;
+
+          status = tdigest_compress(w->work_mean, w->work_weight, w->ncentroid,
+                                    src->mean, src->weight, src->ncentroid, w);
+          if (status)
+            return status;
+        }
+
+      /* buffered data of src are added individually */
+      for (i = 0; i < src->nbuf; ++i)
+        {
+          status = gsl_rstat_tdigest_add(src->buf[i], w);
+          if (status)
+            return status;
+        }
+
+      if (src->min < w->min)
+        w->min = src->min;
+      if (src->max > w->max)
+        w->max = src->max;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_rstat_tdigest_merge() */
+
+/*
+gsl_rstat_tdigest_quantile()
+  Estimate the p-quantile of the data added to the t-digest
+
+Inputs: p - quantile, 0 <= p <= 1
+        w - workspace
+
+Return: estimate of p-quantile
+
+Notes:
+1) Each centroid is placed at the rank of its middle point, and the
+minimum and maximum at ranks 0 and n - 1. The quantile is interpolated
+linearly between these points at rank p (n - 1). When all centroids
+hold a single point, this is identical to
+gsl_stats_quantile_from_sorted_data()
+*/
+
+double
+gsl_rstat_tdigest_quantile(const double p, gsl_rstat_tdigest_workspace *w)
+{
+  if (p < 0.0 || p > 1.0)
+    {
+      GSL_ERROR_VAL ("p must be between 0 and 1", GSL_EDOM, GSL_NAN);
+    }
+  else if (w->n == 0)
+    {
+      return 0.0;
+    }
+  else
+    {
+      const double rank = p * (w->n - 1.0);
+      double rprev = 0.0;     /* rank of previous point */
+      double xprev = w->min;  /* value of previous point */
+      double cumw = 0.0;      /* weight of centroids before centroid i */
+      size_t i;
+
+      tdigest_flush(w);
+
+      for (i = 0; i < w->ncentroid; ++i)
+        {
+          const double ri = cumw + 0.5 * (w->weight[i] - 1.0);
+
+          if (ri >= rank)
+            {
+              const double t = (ri > rprev) ? (rank - rprev) / (ri - rprev) : 1.0;
+              return (1.0 - t) * xprev + t * w->mean[i];
+            }
+
+          rprev = ri;
+          xprev = w->mean[i];
+          cumw += w->weight[i];
+        }
+
+      {
+        const double t = (w->n - 1.0 > rprev) ? (rank - rprev) / (w->n - 1.0 - rprev) : 1.0;
+        return (1.0 - t) * xprev + t * w->max;
+      }
+    }
+} /* gsl_rstat_tdigest_quantile() */
+
+/*
+gsl_rstat_tdigest_fwrite()
+  Write the t-digest to a stream in binary format
+
+Notes:
+1) The centroids and the buffered data are written as they are, so
+that the t-digest read by gsl_rstat_tdigest_fread() is identical
+*/
+
+int
+gsl_rstat_tdigest_fwrite(FILE * stream, const gsl_rstat_tdigest_workspace *w)
+{
+  double header[5];
+  int status;
+
+  header[0] = (double) w->n;
+  header[1] = w->min;
+  header[2] = w->max;
+  header[3] = (double) w->ncentroid;
+  header[4] = (double) w->nbuf;
+
+  status = gsl_block_raw_fwrite(stream, header, 5, 1);
+  if (status)
+    return status;
+
+  status = gsl_block_raw_fwrite(stream, w->mean, w->ncentroid, 1);
+  if (status)
+    return status;
+
+  status = gsl_block_raw_fwrite(stream, w->weight, w->ncentroid, 1);
+  if (status)
+    return status;
+
+  status = gsl_block_raw_fwrite(stream, w->buf, w->nbuf, 1);
+
+  return status;
+} /* gsl_rstat_tdigest_fwrite() */
+
+/*
+gsl_rstat_tdigest_fread()
+  Read a t-digest written by gsl_rstat_tdigest_fwrite() into w
+
+Notes:
+1) w must be large enough to hold the centroids and buffered data,
+which is the case if it was allocated with a value of delta at least
+as large as that of the t-digest written
+
+2) The data read are checked for consistency before w is modified:
+the counts must be non-negative integers, the centroid weights
+positive integers summing with the number of buffered data to n, and
+no value may be NaN. If an error is returned, w is unchanged
+*/
+
+int
+gsl_rstat_tdigest_fread(FILE * stream, gsl_rstat_tdigest_workspace *w)
+{
+  double header[5];
+  double *buf = NULL;
+  double sum = 0.0;
+  size_t ncentroid, nbuf, i;
+  int status;
+
+  status = gsl_block_raw_fread(stream, header, 5, 1);
+  if (status)
+    return status;
+
+  if (!tdigest_iscount(header[0]) || !tdigest_iscount(header[3]) ||
+      !tdigest_iscount(header[4]))
+    {
+      GSL_ERROR ("invalid t-digest header", GSL_EINVAL);
+    }
+  else if (header[3] > (double) w->size || header[4] > (double) w->bufsize)
+    {
+      GSL_ERROR ("t-digest is too large for workspace", GSL_EBADLEN);
+    }
+  else if (header[0] > 0.0 && !(header[1] <= header[2]))
+    {
+      GSL_ERROR ("invalid t-digest minimum and maximum", GSL_EINVAL);
+    }
+
+  ncentroid = (size_t) header[3];
+  nbuf = (size_t) header[4];
+
+  /* read centroids into the work arrays until they are validated */
+  status = gsl_block_raw_fread(stream, w->work_mean, ncentroid, 1);
+  if (status)
+    return status;
+
+  status = gsl_block_raw_fread(stream, w->work_weight, ncentroid, 1);
+  if (status)
+    return status;
+
+  for (i = 0; i < ncentroid; ++i)
+    {
+      if (!tdigest_iscount(w->work_weight[i]) || w->work_weight[i] < 1.0 ||
+          gsl_isnan(w->work_mean[i]))
+        {
+          GSL_ERROR ("invalid t-digest centroids", GSL_EINVAL);
+        }
+
+      sum += w->work_weight[i];
+    }
+
+  if (sum + (double) nbuf != header[0])
+    {
+      GSL_ERROR ("t-digest weights do not sum to n", GSL_EINVAL);
+    }
+
+  if (nbuf > 0)
+    {
+      buf = malloc(nbuf * sizeof(double));
+      if (buf == 0)
+        {
+          GSL_ERROR ("failed to allocate space for buffer", GSL_ENOMEM);
+        }
+
+      status = gsl_block_raw_fread(stream, buf, nbuf, 1);
+      if (status)
+        {
+          free(buf);
+          return status;
+        }
+
+      for (i = 0; i < nbuf; ++i)
+        {
+          if (gsl_isnan(buf[i]))
+            {
+              free(buf);
+              GSL_ERROR ("invalid t-digest buffered data", GSL_EINVAL);
+            }
+        }
+
+      memcpy(w->buf, buf, nbuf * sizeof(double));
+      free(buf);
+    }
+
+  memcpy(w->mean, w->work_mean, ncentroid * sizeof(double));
+  memcpy(w->weight, w->work_weight, ncentroid * sizeof(double));
+
+  w->n = (size_t) header[0];
+  w->min = header[1];
+  w->max = header[2];
+  w->ncentroid = ncentroid;
+  w->nbuf = nbuf;
+
+  /* the buffer must not be full, see gsl_rstat_tdigest_add() */
+  if (w->nbuf == w->bufsize)
+    return tdigest_flush(w);
+
+  return GSL_SUCCESS;
+} /* gsl_rstat_tdigest_fread() */
+
+/* merge buffered data into centroids */
+static int
+tdigest_flush(gsl_rstat_tdigest_workspace *w)
+{
+  if (w->nbuf == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      int status;
+
+      memcpy(w->work_mean, w->mean, w->ncentroid * sizeof(double));
+      memcpy(w->work_weight, w->weight, w->ncentroid * sizeof(double));
+
+      gsl_sort(w->buf, 1, w->nbuf);
+
+      status = tdigest_compress(w->work_mean, w->work_weight, w->ncentroid,
+                                w->buf, NULL, w->nbuf, w);
+
+      w->nbuf = 0;
+
+      return status;
+    }
+}
+
+/*
+tdigest_compress()
+  Merge two sorted lists of centroids into the centroids of w
+
+Inputs: mean1   - means of first list, sorted
+        weight1 - weights of first list
+        n1      - length of first list
+        mean2   - means of second list, sorted
+        weight2 - weights of second list; NULL if all weights are 1
+        n2      - length of second list
+        w       - workspace; w->n must equal the total weight of both lists
+
+Notes:
+1) The lists must not overlap w->mean or w->weight
+*/
+
+static int
+tdigest_compress(const double *mean1, const double *weight1, const size_t n1,
+                 const double *mean2, const double *weight2, const size_t n2,
+                 gsl_rstat_tdigest_workspace *w)
+{
+  const double W = (double) w->n;
+  double cmean = 0.0, cweight = 0.0; /* current centroid */
+  double wsofar = 0.0;               /* weight of completed centroids */
+  double qlimit = tdigest_qlimit(0.0, w->delta, W);
+  size_t i1 = 0, i2 = 0, m = 0;
+
+  while (i1 < n1 || i2 < n2)
+    {
+      double xm, xw;
+
+      /* take the next point in sorted order */
+      if (i2 >= n2 || (i1 < n1 && mean1[i1] <= mean2[i2]))
+        {
+          xm = mean1[i1];
+          xw = weight1[i1];
+          ++i1;
+        }
+      else
+        {
+          xm = mean2[i2];
+          xw = (weight2 != NULL) ? weight2[i2] : 1.0;
+          ++i2;
+        }
+
+      if (cweight == 0.0)
+        {
+          cmean = xm;
+          cweight = xw;
+        }
+      else if ((wsofar + cweight + xw) / W <= qlimit || m + 1 >= w->size)
+        {
+          /* add point to current centroid */
+          cweight += xw;
+          cmean += (xm - cmean) * xw / cweight;
+        }
+      else
+        {
+          /* start a new centroid */
+          w->mean[m] = cmean;
+          w->weight[m] = cweight;
+          ++m;
+
+          wsofar += cweight;
+          qlimit = tdigest_qlimit(wsofar / W, w->delta, W);
+
+          cmean = xm;
+          cweight = xw;
+        }
+    }
+
+  if (cweight > 0.0)
+    {
+      w->mean[m] = cmean;
+      w->weight[m] = cweight;
+      ++m;
+    }
+
+  w->ncentroid = m;
+
+  return GSL_SUCCESS;
+}
+
+/* largest q such that k(q) - k(q0) <= 1, for n data */
+static double
+tdigest_qlimit(const double q0, const double delta, const double n)
+{
+  const double Z = 4.0 * log(n) + 24.0;
+
+  if (q0 <= 0.0)
+    return 0.0;
+  else if (q0 >= 1.0)
+    return 1.0;
+  else
+    return q0 / (q0 + (1.0 - q0) * exp(-Z / delta));
+}
+
+/* test if x is an integer in [0, 2^53], which can be converted to size_t */
+static int
+tdigest_iscount(const double x)
+{
+  return (x >= 0.0 && x <= 9007199254740992.0 && x == floor(x));
+}
@@ -22,6 +22,7 @@
 #include <math.h>
 #include <string.h>
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_rstat.h>
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_statistics.h>
@@ -135,6 +136,370 @@ test_quantile(const double p, const double data[], const size_t n,
   gsl_rstat_quantile_free(w);
 }
 
+/* compare gsl_rstat_add_array() with gsl_rstat_add() */
+void
+test_add_array(const size_t n, const size_t stride, const double data[], const char * desc)
+{
+  gsl_rstat_workspace *w1 = gsl_rstat_alloc();
+  gsl_rstat_workspace *w2 = gsl_rstat_alloc();
+  const double tol = 1.0e-10;
+  size_t i;
+
+  /* start with a few points so the array is added to existing totals */
+  for (i = 0; i < 3; ++i)
+    {
+      gsl_rstat_add(data[i], w1);
+      gsl_rstat_add(data[i], w2);
+    }
+
+  for (i = 0; i < n; ++i)
+    gsl_rstat_add(data[(i + 3) * stride], w1);
+
+  gsl_rstat_add_array(data + 3 * stride, stride, n, w2);
+
+  gsl_test_int(gsl_rstat_n(w2), gsl_rstat_n(w1), "%s add_array n n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_min(w2), gsl_rstat_min(w1), 0.0, "%s add_array min n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_max(w2), gsl_rstat_max(w1), 0.0, "%s add_array max n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_mean(w2), gsl_rstat_mean(w1), tol, "%s add_array mean n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_variance(w2), gsl_rstat_variance(w1), tol, "%s add_array variance n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_skew(w2), gsl_rstat_skew(w1), tol, "%s add_array skew n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_kurtosis(w2), gsl_rstat_kurtosis(w1), tol, "%s add_array kurtosis n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_median(w2), gsl_rstat_median(w1), 0.0, "%s add_array median n=%zu", desc, n);
+
+  gsl_rstat_free(w1);
+  gsl_rstat_free(w2);
+}
+
+/* split data into nshard pieces of unequal sizes, accumulate each one separately and merge */
+void
+test_merge(const size_t nshard, const size_t n, const double data[], const double tol,
+           const double tol_median, const char * desc)
+{
+  gsl_rstat_workspace **w = malloc(nshard * sizeof(gsl_rstat_workspace *));
+  size_t k;
+
+  for (k = 0; k < nshard; ++k)
+    {
+      const size_t i1 = n * k * k / (nshard * nshard);
+      const size_t i2 = n * (k + 1) * (k + 1) / (nshard * nshard);
+      size_t i;
+
+      w[k] = gsl_rstat_alloc();
+
+      if (k % 2 == 0)
+        {
+          for (i = i1; i < i2; ++i)
+            gsl_rstat_add(data[i], w[k]);
+        }
+      else
+        {
+          gsl_rstat_add_array(data + i1, 1, i2 - i1, w[k]);
+        }
+    }
+
+  /* reduce pairwise, as would be done over threads */
+  for (k = 1; k < nshard; k *= 2)
+    {
+      size_t j;
+
+      for (j = 0; j + k < nshard; j += 2 * k)
+        gsl_rstat_merge(w[j + k], w[j]);
+    }
+
+  gsl_test_int(gsl_rstat_n(w[0]), n, "%s merge n nshard=%zu n=%zu", desc, nshard, n);
+
+  if (n > 0)
+    {
+      double * data_copy = malloc(n * sizeof(double));
+      double expected_median;
+
+      memcpy(data_copy, data, n * sizeof(double));
+      gsl_sort(data_copy, 1, n);
+      expected_median = gsl_stats_median_from_sorted_data(data_copy, 1, n);
+
+      gsl_test_rel(gsl_rstat_min(w[0]), data_copy[0], 0.0, "%s merge min nshard=%zu n=%zu", desc, nshard, n);
+      gsl_test_rel(gsl_rstat_max(w[0]), data_copy[n - 1], 0.0, "%s merge max nshard=%zu n=%zu", desc, nshard, n);
+      gsl_test_rel(gsl_rstat_mean(w[0]), gsl_stats_mean(data, 1, n), tol,
+                   "%s merge mean nshard=%zu n=%zu", desc, nshard, n);
+      gsl_test_abs(gsl_rstat_median(w[0]), expected_median, tol_median,
+                   "%s merge median nshard=%zu n=%zu", desc, nshard, n);
+
+      if (n > 1)
+        {
+          gsl_test_rel(gsl_rstat_variance(w[0]), gsl_stats_variance(data, 1, n), tol,
+                       "%s merge variance nshard=%zu n=%zu", desc, nshard, n);
+          gsl_test_rel(gsl_rstat_skew(w[0]), gsl_stats_skew(data, 1, n), tol,
+                       "%s merge skew nshard=%zu n=%zu", desc, nshard, n);
+          gsl_test_rel(gsl_rstat_kurtosis(w[0]), gsl_stats_kurtosis(data, 1, n), tol,
+                       "%s merge kurtosis nshard=%zu n=%zu", desc, nshard, n);
+        }
+
+      free(data_copy);
+    }
+
+  for (k = 0; k < nshard; ++k)
+    gsl_rstat_free(w[k]);
+
+  free(w);
+}
+
+/* fraction of sorted data less than x */
+double
+tdigest_rank(const double x, const double sorted[], const size_t n)
+{
+  size_t lo = 0, hi = n;
+
+  while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+
+      if (sorted[mid] < x)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return (double) lo / (double) n;
+}
+
+/* check the quantiles estimated by a t-digest against the data */
+void
+test_tdigest_quantiles(gsl_rstat_tdigest_workspace *w, const size_t n, const double data[],
+                       const double tol, const char * desc)
+{
+  const double p[] = { 1.0e-5, 1.0e-4, 1.0e-3, 0.01, 0.1, 0.25, 0.5,
+                       0.75, 0.9, 0.99, 0.999, 0.9999, 0.99999 };
+  double * sorted = malloc(n * sizeof(double));
+  size_t i;
+
+  memcpy(sorted, data, n * sizeof(double));
+  gsl_sort(sorted, 1, n);
+
+  gsl_test_int(gsl_rstat_tdigest_n(w), n, "%s tdigest n n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_tdigest_quantile(0.0, w), sorted[0], 0.0, "%s tdigest min n=%zu", desc, n);
+  gsl_test_rel(gsl_rstat_tdigest_quantile(1.0, w), sorted[n - 1], 0.0, "%s tdigest max n=%zu", desc, n);
+
+  for (i = 0; i < sizeof(p) / sizeof(double); ++i)
+    {
+      const double q = gsl_rstat_tdigest_quantile(p[i], w);
+
+      if (n <= 20)
+        {
+          /* all centroids hold a single point */
+          const double expected = gsl_stats_quantile_from_sorted_data(sorted, 1, n, p[i]);
+          gsl_test_rel(q, expected, 1.0e-12, "%s tdigest quantile n=%zu p=%g", desc, n, p[i]);
+        }
+      else
+        {
+          /* error in rank, relative to the standard deviation of the empirical quantile */
+          const double rank = tdigest_rank(q, sorted, n);
+          gsl_test_abs(rank, p[i], tol * sqrt(p[i] * (1.0 - p[i])) + 2.0 / n,
+                       "%s tdigest quantile rank n=%zu p=%g", desc, n, p[i]);
+        }
+    }
+
+  free(sorted);
+}
+
+void
+test_tdigest(const double delta, const size_t n, const double data[], const double tol,
+             const char * desc)
+{
+  gsl_rstat_tdigest_workspace *w1 = gsl_rstat_tdigest_alloc(delta);
+  gsl_rstat_tdigest_workspace *w2 = gsl_rstat_tdigest_alloc(delta);
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    gsl_rstat_tdigest_add(data[i], w1);
+
+  test_tdigest_quantiles(w1, n, data, tol, desc);
+
+  gsl_test(w1->ncentroid > w1->size, "%s tdigest ncentroid=%zu n=%zu", desc, w1->ncentroid, n);
+
+  /* add_array should give identical results */
+  gsl_rstat_tdigest_add_array(data, 1, n, w2);
+
+  for (i = 0; i <= 100; ++i)
+    {
+      const double p = i / 100.0;
+      gsl_test_rel(gsl_rstat_tdigest_quantile(p, w2), gsl_rstat_tdigest_quantile(p, w1), 0.0,
+                   "%s tdigest add_array n=%zu p=%g", desc, n, p);
+    }
+
+  gsl_rstat_tdigest_free(w1);
+  gsl_rstat_tdigest_free(w2);
+}
+
+/* split data into nshard pieces of unequal sizes, accumulate each one separately and merge */
+void
+test_tdigest_merge(const double delta, const size_t nshard, const size_t n, const double data[],
+                   const double tol, const char * desc)
+{
+  gsl_rstat_tdigest_workspace **w = malloc(nshard * sizeof(gsl_rstat_tdigest_workspace *));
+  size_t k;
+
+  for (k = 0; k < nshard; ++k)
+    {
+      const size_t i1 = n * k * k / (nshard * nshard);
+      const size_t i2 = n * (k + 1) * (k + 1) / (nshard * nshard);
+
+      w[k] = gsl_rstat_tdigest_alloc(delta);
+      gsl_rstat_tdigest_add_array(data + i1, 1, i2 - i1, w[k]);
+    }
+
+  /* reduce pairwise, as would be done over threads */
+  for (k = 1; k < nshard; k *= 2)
+    {
+      size_t j;
+
+      for (j = 0; j + k < nshard; j += 2 * k)
+        gsl_rstat_tdigest_merge(w[j + k], w[j]);
+    }
+
+  test_tdigest_quantiles(w[0], n, data, tol, desc);
+
+  for (k = 0; k < nshard; ++k)
+    gsl_rstat_tdigest_free(w[k]);
+
+  free(w);
+}
+
+/* write t-digest to file and read it back */
+void
+test_tdigest_file(const double delta, const size_t n, const double data[], const char * desc)
+{
+  gsl_rstat_tdigest_workspace *w1 = gsl_rstat_tdigest_alloc(delta);
+  gsl_rstat_tdigest_workspace *w2 = gsl_rstat_tdigest_alloc(delta);
+  size_t i;
+
+  gsl_rstat_tdigest_add_array(data, 1, n, w1);
+
+  {
+    FILE *f = fopen("test.dat", "wb");
+    int status = gsl_rstat_tdigest_fwrite(f, w1);
+    gsl_test(status, "%s tdigest fwrite n=%zu", desc, n);
+    fclose(f);
+  }
+
+  {
+    FILE *f = fopen("test.dat", "rb");
+    int status = gsl_rstat_tdigest_fread(f, w2);
+    gsl_test(status, "%s tdigest fread n=%zu", desc, n);
+    fclose(f);
+  }
+
+  gsl_test_int(gsl_rstat_tdigest_n(w2), n, "%s tdigest fread n n=%zu", desc, n);
+
+  for (i = 0; i <= 100; ++i)
+    {
+      const double p = i / 100.0;
+      gsl_test_rel(gsl_rstat_tdigest_quantile(p, w2), gsl_rstat_tdigest_quantile(p, w1), 0.0,
+                   "%s tdigest fread n=%zu p=%g", desc, n, p);
+    }
+
+  gsl_rstat_tdigest_free(w1);
+  gsl_rstat_tdigest_free(w2);
+}
+
+/* write a t-digest file with the given header and centroids, and check that it is rejected */
+static void
+test_tdigest_badfile(const double header[5], const double mean[], const double weight[],
+                     const size_t ncentroid, const char * desc)
+{
+  gsl_rstat_tdigest_workspace *w = gsl_rstat_tdigest_alloc(100.0);
+  size_t i;
+  int status;
+
+  for (i = 0; i < 7; ++i)
+    gsl_rstat_tdigest_add((double) i, w);
+
+  {
+    FILE *f = fopen("test.dat", "wb");
+    fwrite(header, sizeof(double), 5, f);
+    fwrite(mean, sizeof(double), ncentroid, f);
+    fwrite(weight, sizeof(double), ncentroid, f);
+    fclose(f);
+  }
+
+  {
+    FILE *f = fopen("test.dat", "rb");
+    status = gsl_rstat_tdigest_fread(f, w);
+    fclose(f);
+  }
+
+  gsl_test(status == GSL_SUCCESS, "%s tdigest fread rejects invalid file", desc);
+
+  /* w must be unchanged */
+  gsl_test_int(gsl_rstat_tdigest_n(w), 7, "%s tdigest fread unchanged n", desc);
+  gsl_test_rel(gsl_rstat_tdigest_quantile(0.5, w), 3.0, 0.0,
+               "%s tdigest fread unchanged median", desc);
+
+  gsl_rstat_tdigest_free(w);
+}
+
+static void
+test_tdigest_invalid(void)
+{
+  const double mean[2] = { 1.0, 2.0 };
+  const double weight[2] = { 3.0, 4.0 };
+  gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
+
+  {
+    const double header[5] = { 10.0, 0.0, 3.0, 0.0, 0.0 };
+    test_tdigest_badfile(header, mean, weight, 0, "test10 no data");
+  }
+
+  {
+    const double header[5] = { 10.0, 0.0, 3.0, 2.0, 0.0 };
+    test_tdigest_badfile(header, mean, weight, 2, "test10 weight sum");
+  }
+
+  {
+    const double header[5] = { 7.0, 0.0, 3.0, -2.0, 0.0 };
+    test_tdigest_badfile(header, mean, weight, 0, "test10 negative count");
+  }
+
+  {
+    const double header[5] = { 7.0, 0.0, 3.0, 1.5, 0.0 };
+    test_tdigest_badfile(header, mean, weight, 2, "test10 non-integer count");
+  }
+
+  {
+    const double header[5] = { GSL_NAN, 0.0, 3.0, 2.0, 0.0 };
+    test_tdigest_badfile(header, mean, weight, 2, "test10 NaN count");
+  }
+
+  {
+    const double header[5] = { 7.0, 0.0, 3.0, 2.0, 0.0 };
+    const double badmean[2] = { 1.0, GSL_NAN };
+    test_tdigest_badfile(header, badmean, weight, 2, "test10 NaN mean");
+  }
+
+  {
+    const double header[5] = { 7.0, 0.0, 3.0, 2.0, 0.0 };
+    const double badweight[2] = { 7.5, -0.5 };
+    test_tdigest_badfile(header, mean, badweight, 2, "test10 negative weight");
+  }
+
+  /* a t-digest cannot be merged with itself */
+  {
+    gsl_rstat_tdigest_workspace *w = gsl_rstat_tdigest_alloc(100.0);
+    size_t i;
+    int status;
+
+    for (i = 0; i < 1000; ++i)
+      gsl_rstat_tdigest_add((double) i, w);
+
+    status = gsl_rstat_tdigest_merge(w, w);
+    gsl_test_int(status, GSL_EINVAL, "test10 tdigest self merge");
+    gsl_test_int(gsl_rstat_tdigest_n(w), 1000, "test10 tdigest self merge n");
+
+    gsl_rstat_tdigest_free(w);
+  }
+
+  gsl_set_error_handler(old_handler);
+}
+
 int
 main()
 {
@@ -253,6 +618,71 @@ main()
     gsl_rstat_free(rstat_workspace_p);
   }
 
+  {
+    const size_t N = 100000;
+    double *data = malloc(N * sizeof(double));
+    size_t i;
+
+    random_data(N, data, r);
+
+    /* test add_array */
+    test_add_array(1, 1, data, "test4");
+    test_add_array(255, 1, data, "test4");
+    test_add_array(256, 1, data, "test4");
+    test_add_array(1000, 3, data, "test4");
+    test_add_array(N / 2 - 3, 2, data, "test4");
+
+    /* test merge: the median is exact for at most 5 points in total */
+    for (i = 0; i <= 5; ++i)
+      test_merge(3, i, data, tol1, 1.0e-12, "test5");
+
+    test_merge(2, 6, data, tol1, 1.0, "test5");
+    test_merge(2, 12, data, tol1, 1.0, "test5");
+    test_merge(5, 1000, data, tol1, 5.0e-3, "test5");
+    test_merge(16, N, data, tol1, 5.0e-3, "test5");
+    test_merge(7, N, data, tol1, 5.0e-3, "test5");
+
+    /* add large constant */
+    for (i = 0; i < N; ++i)
+      data[i] += 1.0e6;
+
+    test_merge(8, N, data, 1.0e-6, 5.0e-3, "test6");
+
+    free(data);
+  }
+
+  {
+    const size_t N = 200000;
+    double *data = malloc(N * sizeof(double));
+    size_t i;
+
+    for (i = 0; i < N; ++i)
+      data[i] = gsl_ran_gaussian(r, 1.0);
+
+    /* test7: t-digest, exact for small datasets */
+    for (i = 1; i <= 20; ++i)
+      test_tdigest(100.0, i, data, 0.0, "test7");
+
+    test_tdigest(100.0, 1000, data, 0.05, "test7");
+    test_tdigest(100.0, N, data, 0.05, "test7");
+    test_tdigest(300.0, N, data, 0.02, "test7");
+
+    /* test8: merged t-digests */
+    test_tdigest_merge(100.0, 5, 20, data, 0.0, "test8");
+    test_tdigest_merge(100.0, 7, 10000, data, 0.05, "test8");
+    test_tdigest_merge(100.0, 16, N, data, 0.05, "test8");
+    test_tdigest_merge(300.0, 8, N, data, 0.02, "test8");
+
+    /* test9: t-digest written to file */
+    test_tdigest_file(100.0, 10, data, "test9");
+    test_tdigest_file(100.0, 12345, data, "test9");
+
+    /* test10: invalid t-digest files and arguments */
+    test_tdigest_invalid();
+
+    free(data);
+  }
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
@@ -40,6 +40,22 @@
 
 __BEGIN_DECLS
 
+/* workspace for level-scheduled sparse triangular solves */
+typedef struct
+{
+  size_t n;          /* matrix dimension */
+  size_t nz;         /* number of off-diagonal elements in triangle */
+  size_t nzmax;      /* allocated size of Li and Lx */
+  size_t nlevels;    /* number of levels */
+  size_t *level_ptr; /* rows in level k are row_order[level_ptr[k]..level_ptr[k+1]-1], size n+1 */
+  size_t *row_order; /* rows sorted by level, size n */
+  size_t *level;     /* level of each row, size n */
+  int *Lp;           /* row pointers of strict triangle of op(A), size n+1 */
+  int *Li;           /* column indices of strict triangle of op(A), size nzmax */
+  double *Lx;        /* values of strict triangle of op(A), size nzmax */
+  double *diag;      /* diagonal of op(A), size n */
+} gsl_spblas_trsv_workspace;
+
 /*
  * Prototypes
  */
@@ -53,6 +69,20 @@ size_t gsl_spblas_scatter(const gsl_spmatrix *A, const size_t j,
                           const double alpha, int *w, double *x,
                           const int mark, gsl_spmatrix *C, size_t nz);
 
+/* triangular solves */
+
+int gsl_spblas_dtrsv(const CBLAS_UPLO_t Uplo, const CBLAS_TRANSPOSE_t TransA,
+                     const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+                     gsl_vector *x);
+gsl_spblas_trsv_workspace *gsl_spblas_trsv_alloc(const size_t n);
+void gsl_spblas_trsv_free(gsl_spblas_trsv_workspace *w);
+int gsl_spblas_dtrsv_analyze(const CBLAS_UPLO_t Uplo, const CBLAS_TRANSPOSE_t TransA,
+                             const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+                             gsl_spblas_trsv_workspace *w);
+int gsl_spblas_dtrsv_solve(gsl_vector *x, const gsl_spblas_trsv_workspace *w);
+int gsl_spblas_dtrsv_rows(const size_t k1, const size_t k2, gsl_vector *x,
+                          const gsl_spblas_trsv_workspace *w);
+
 __END_DECLS
 
 #endif /* __GSL_SPBLAS_H__ */
@@ -0,0 +1,512 @@
+/* sptrsv.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_blas.h>
+
+/*
+gsl_spblas_dtrsv()
+  Solve a sparse triangular system
+
+Inputs: Uplo   - CblasLower or CblasUpper; which triangle of A to use
+        TransA - CblasNoTrans or CblasTrans
+        Diag   - CblasUnit or CblasNonUnit
+        A      - square sparse matrix in CSC or CSR format
+        x      - (input/output) on input, right hand side b;
+                 on output, solution of op(A) x = b
+
+Return: success/error
+
+Notes:
+1) Elements of A outside the requested triangle are ignored,
+so the same matrix may be used for lower and upper solves. Elements
+within a column or row need not be sorted.
+
+2) If op(A) is accessed by rows (CSR with CblasNoTrans, CSC with
+CblasTrans), each x_i is computed by a sparse dot product; otherwise
+the solution is computed column by column with sparse axpy updates.
+*/
+
+int
+gsl_spblas_dtrsv(const CBLAS_UPLO_t Uplo, const CBLAS_TRANSPOSE_t TransA,
+                 const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+                 gsl_vector *x)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR("invalid length of x vector", GSL_EBADLEN);
+    }
+  else if (!GSL_SPMATRIX_ISCSC(A) && !GSL_SPMATRIX_ISCSR(A))
+    {
+      GSL_ERROR("matrix must be in CSC or CSR format", GSL_EINVAL);
+    }
+  else
+    {
+      const int *Ap = A->p;
+      const int *Ai = A->i;
+      const double *Ad = A->data;
+      double *X = x->data;
+      const size_t incX = x->stride;
+      const int nonunit = (Diag == CblasNonUnit);
+      const int byrow = (GSL_SPMATRIX_ISCSR(A) && TransA == CblasNoTrans) ||
+                        (GSL_SPMATRIX_ISCSC(A) && TransA == CblasTrans);
+      /* op(A) is lower triangular if A is lower and not transposed, or vice versa */
+      const int lower = (Uplo == CblasLower) == (TransA == CblasNoTrans);
+      size_t k;
+      int p;
+
+      for (k = 0; k < N; ++k)
+        {
+          /* process rows/columns forward for lower triangular, backward for upper */
+          const int j = lower ? (int) k : (int) (N - k - 1);
+          double d = 0.0; /* a missing diagonal element is a zero pivot */
+
+          if (byrow)
+            {
+              /* x_j := (x_j - sum_{i != j} op(A)_{ji} x_i) / op(A)_{jj} */
+              double sum = X[j * incX];
+
+              for (p = Ap[j]; p < Ap[j + 1]; ++p)
+                {
+                  int i = Ai[p];
+
+                  if (i == j)
+                    d = Ad[p];
+                  else if ((lower && i < j) || (!lower && i > j))
+                    sum -= Ad[p] * X[i * incX];
+                }
+
+              if (nonunit)
+                {
+                  if (d == 0.0)
+                    {
+                      GSL_ERROR("matrix is singular", GSL_ESING);
+                    }
+
+                  sum /= d;
+                }
+
+              X[j * incX] = sum;
+            }
+          else
+            {
+              /* x_j := x_j / op(A)_{jj}, then x_i := x_i - op(A)_{ij} x_j */
+              double xj;
+
+              if (nonunit)
+                {
+                  for (p = Ap[j]; p < Ap[j + 1]; ++p)
+                    {
+                      if (Ai[p] == j)
+                        d = Ad[p];
+                    }
+
+                  if (d == 0.0)
+                    {
+                      GSL_ERROR("matrix is singular", GSL_ESING);
+                    }
+
+                  X[j * incX] /= d;
+                }
+
+              xj = X[j * incX];
+
+              if (xj != 0.0)
+                {
+                  for (p = Ap[j]; p < Ap[j + 1]; ++p)
+                    {
+                      int i = Ai[p];
+
+                      if ((lower && i > j) || (!lower && i < j))
+                        X[i * incX] -= Ad[p] * xj;
+                    }
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dtrsv() */
+
+gsl_spblas_trsv_workspace *
+gsl_spblas_trsv_alloc(const size_t n)
+{
+  gsl_spblas_trsv_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension must be positive", GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_spblas_trsv_workspace));
+  if (!w)
+    {
+      GSL_ERROR_NULL("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->level_ptr = malloc((n + 1) * sizeof(size_t));
+  if (!w->level_ptr)
+    {
+      gsl_spblas_trsv_free(w);
+      GSL_ERROR_NULL("failed to allocate level_ptr", GSL_ENOMEM);
+    }
+
+  w->row_order = malloc(n * sizeof(size_t));
+  if (!w->row_order)
+    {
+      gsl_spblas_trsv_free(w);
+      GSL_ERROR_NULL("failed to allocate row_order", GSL_ENOMEM);
+    }
+
+  w->Lp = malloc((n + 1) * sizeof(int));
+  if (!w->Lp)
+    {
+      gsl_spblas_trsv_free(w);
+      GSL_ERROR_NULL("failed to allocate Lp", GSL_ENOMEM);
+    }
+
+  w->diag = malloc(n * sizeof(double));
+  if (!w->diag)
+    {
+      gsl_spblas_trsv_free(w);
+      GSL_ERROR_NULL("failed to allocate diag", GSL_ENOMEM);
+    }
+
+  w->level = malloc(n * sizeof(size_t));
+  if (!w->level)
+    {
+      gsl_spblas_trsv_free(w);
+      GSL_ERROR_NULL("failed to allocate level", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_spblas_trsv_free(gsl_spblas_trsv_workspace *w)
+{
+  RETURN_IF_NULL(w);
+
+  if (w->level_ptr)
+    free(w->level_ptr);
+
+  if (w->row_order)
+    free(w->row_order);
+
+  if (w->Lp)
+    free(w->Lp);
+
+  if (w->Li)
+    free(w->Li);
+
+  if (w->Lx)
+    free(w->Lx);
+
+  if (w->diag)
+    free(w->diag);
+
+  if (w->level)
+    free(w->level);
+
+  free(w);
+}
+
+/*
+gsl_spblas_dtrsv_analyze()
+  Analysis phase of a level-scheduled sparse triangular solve
+
+Inputs: Uplo   - CblasLower or CblasUpper; which triangle of A to use
+        TransA - CblasNoTrans or CblasTrans
+        Diag   - CblasUnit or CblasNonUnit
+        A      - square sparse matrix in CSC or CSR format
+        w      - workspace
+
+Return: success/error
+
+Notes:
+1) The strict triangle of op(A) is copied into w in row-oriented
+(CSR) form, and its diagonal into w->diag, so that every solve uses
+sparse dot products regardless of the storage format of A.
+
+2) Row i of op(A) depends on the rows j with op(A)_{ij} != 0 in the
+strict triangle. The level of row i is one more than the largest level
+of the rows it depends on, so all rows in the same level may be solved
+independently once the previous levels are complete. On output, the rows
+in level k are
+
+w->row_order[w->level_ptr[k]], ..., w->row_order[w->level_ptr[k+1] - 1]
+
+for 0 <= k < w->nlevels.
+*/
+
+int
+gsl_spblas_dtrsv_analyze(const CBLAS_UPLO_t Uplo, const CBLAS_TRANSPOSE_t TransA,
+                         const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+                         gsl_spblas_trsv_workspace *w)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != w->n)
+    {
+      GSL_ERROR("matrix does not match workspace", GSL_EBADLEN);
+    }
+  else if (!GSL_SPMATRIX_ISCSC(A) && !GSL_SPMATRIX_ISCSR(A))
+    {
+      GSL_ERROR("matrix must be in CSC or CSR format", GSL_EINVAL);
+    }
+  else
+    {
+      const int *Ap = A->p;
+      const int *Ai = A->i;
+      const double *Ad = A->data;
+      const int byrow = (GSL_SPMATRIX_ISCSR(A) && TransA == CblasNoTrans) ||
+                        (GSL_SPMATRIX_ISCSC(A) && TransA == CblasTrans);
+      /* op(A) is lower triangular if A is lower and not transposed, or vice versa */
+      const int lower = (Uplo == CblasLower) == (TransA == CblasNoTrans);
+      int *Lp = w->Lp;
+      size_t *level = w->level;
+      size_t *count = w->level_ptr;
+      size_t pass, k, nz = 0;
+      int p;
+
+      for (k = 0; k < N; ++k)
+        {
+          Lp[k] = 0;
+          w->diag[k] = (Diag == CblasNonUnit) ? 0.0 : 1.0;
+        }
+
+      Lp[N] = 0;
+
+      /* pass 0 counts entries in each row of op(A), pass 1 scatters them */
+      for (pass = 0; pass < 2; ++pass)
+        {
+          if (pass == 1)
+            {
+              gsl_spmatrix_cumsum(N, Lp);
+              nz = (size_t) Lp[N];
+
+              if (nz > w->nzmax)
+                {
+                  void *ptr;
+
+                  ptr = realloc(w->Li, GSL_MAX(nz, 1) * sizeof(int));
+                  if (!ptr)
+                    {
+                      GSL_ERROR("failed to allocate Li", GSL_ENOMEM);
+                    }
+
+                  w->Li = ptr;
+
+                  ptr = realloc(w->Lx, GSL_MAX(nz, 1) * sizeof(double));
+                  if (!ptr)
+                    {
+                      GSL_ERROR("failed to allocate Lx", GSL_ENOMEM);
+                    }
+
+                  w->Lx = ptr;
+                  w->nzmax = nz;
+                }
+
+              /* use level[] as the insertion pointer for each row */
+              for (k = 0; k < N; ++k)
+                level[k] = (size_t) Lp[k];
+            }
+
+          for (k = 0; k < N; ++k)
+            {
+              for (p = Ap[k]; p < Ap[k + 1]; ++p)
+                {
+                  /* (row, col) of this element in op(A) */
+                  const size_t row = byrow ? k : (size_t) Ai[p];
+                  const size_t col = byrow ? (size_t) Ai[p] : k;
+
+                  if (row == col)
+                    {
+                      if (Diag == CblasNonUnit)
+                        w->diag[row] = Ad[p];
+                    }
+                  else if ((lower && col < row) || (!lower && col > row))
+                    {
+                      if (pass == 0)
+                        {
+                          Lp[row]++;
+                        }
+                      else
+                        {
+                          size_t q = level[row]++;
+                          w->Li[q] = (int) col;
+                          w->Lx[q] = Ad[p];
+                        }
+                    }
+                }
+            }
+        }
+
+      w->nz = nz;
+
+      if (Diag == CblasNonUnit)
+        {
+          for (k = 0; k < N; ++k)
+            {
+              if (w->diag[k] == 0.0)
+                {
+                  GSL_ERROR("matrix is singular", GSL_ESING);
+                }
+            }
+        }
+
+      /* compute levels, visiting rows in dependency order */
+      w->nlevels = 0;
+      for (k = 0; k < N; ++k)
+        {
+          const size_t i = lower ? k : N - k - 1;
+          size_t lev = 0;
+
+          for (p = Lp[i]; p < Lp[i + 1]; ++p)
+            lev = GSL_MAX(lev, level[w->Li[p]] + 1);
+
+          level[i] = lev;
+          w->nlevels = GSL_MAX(w->nlevels, lev + 1);
+        }
+
+      /* counting sort of rows by level */
+      for (k = 0; k <= w->nlevels; ++k)
+        count[k] = 0;
+
+      for (k = 0; k < N; ++k)
+        count[level[k] + 1]++;
+
+      for (k = 0; k < w->nlevels; ++k)
+        count[k + 1] += count[k];
+
+      for (k = 0; k < N; ++k)
+        {
+          const size_t i = lower ? k : N - k - 1;
+          w->row_order[count[level[i]]++] = i;
+        }
+
+      /* count[k] now points to the end of level k; shift to obtain level pointers */
+      for (k = w->nlevels; k > 0; --k)
+        count[k] = count[k - 1];
+
+      count[0] = 0;
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dtrsv_analyze() */
+
+/*
+gsl_spblas_dtrsv_rows()
+  Solve for a subset of the rows of an analyzed triangular system
+
+Inputs: k1 - first index into w->row_order
+        k2 - one past the last index into w->row_order
+        x  - (input/output) right hand side / solution
+        w  - workspace from gsl_spblas_dtrsv_analyze()
+
+Return: success/error
+
+Notes:
+1) the rows w->row_order[k1..k2-1] must belong to levels whose
+preceding levels have already been solved. Calls for disjoint ranges
+within a single level update disjoint elements of x and may be run
+concurrently.
+*/
+
+int
+gsl_spblas_dtrsv_rows(const size_t k1, const size_t k2, gsl_vector *x,
+                      const gsl_spblas_trsv_workspace *w)
+{
+  if (x->size != w->n)
+    {
+      GSL_ERROR("invalid length of x vector", GSL_EBADLEN);
+    }
+  else if (k1 > k2 || k2 > w->n)
+    {
+      GSL_ERROR("invalid row range", GSL_EINVAL);
+    }
+  else
+    {
+      const int *Lp = w->Lp;
+      const int *Li = w->Li;
+      const double *Lx = w->Lx;
+      double *X = x->data;
+      const size_t incX = x->stride;
+      size_t k;
+      int p;
+
+      for (k = k1; k < k2; ++k)
+        {
+          const size_t i = w->row_order[k];
+          double sum = X[i * incX];
+
+          for (p = Lp[i]; p < Lp[i + 1]; ++p)
+            sum -= Lx[p] * X[Li[p] * incX];
+
+          X[i * incX] = sum / w->diag[i];
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dtrsv_rows() */
+
+/*
+gsl_spblas_dtrsv_solve()
+  Solve a triangular system using the level schedule computed
+by gsl_spblas_dtrsv_analyze()
+
+Inputs: x - (input/output) on input, right hand side b;
+            on output, solution of op(A) x = b
+        w - workspace
+*/
+
+int
+gsl_spblas_dtrsv_solve(gsl_vector *x, const gsl_spblas_trsv_workspace *w)
+{
+  size_t k;
+
+  for (k = 0; k < w->nlevels; ++k)
+    {
+      int status = gsl_spblas_dtrsv_rows(w->level_ptr[k], w->level_ptr[k + 1], x, w);
+      if (status)
+        return status;
+    }
+
+  return GSL_SUCCESS;
+} /* gsl_spblas_dtrsv_solve() */
@@ -229,6 +229,164 @@ test_dgemm(const double alpha, const size_t M, const size_t N,
   gsl_matrix_free(C_dense);
 } /* test_dgemm() */
 
+static void
+test_dtrsv_eps(const CBLAS_UPLO_t Uplo, const CBLAS_TRANSPOSE_t TransA,
+               const CBLAS_DIAG_t Diag, const gsl_spmatrix *A,
+               const gsl_vector *b, const gsl_vector *x_gsl,
+               gsl_spblas_trsv_workspace *w, const char *desc)
+{
+  const size_t N = A->size1;
+  gsl_vector *x = gsl_vector_alloc(N);
+  size_t k, i;
+
+  /* direct solve */
+  gsl_vector_memcpy(x, b);
+  gsl_spblas_dtrsv(Uplo, TransA, Diag, A, x);
+  test_vectors(x, (gsl_vector *) x_gsl, 1.0e-10, desc);
+
+  /* level-scheduled solve */
+  gsl_spblas_dtrsv_analyze(Uplo, TransA, Diag, A, w);
+  gsl_vector_memcpy(x, b);
+  gsl_spblas_dtrsv_solve(x, w);
+  test_vectors(x, (gsl_vector *) x_gsl, 1.0e-10, desc);
+
+  /* solve one row at a time within each level, in reverse order */
+  gsl_vector_memcpy(x, b);
+  for (k = 0; k < w->nlevels; ++k)
+    {
+      for (i = w->level_ptr[k + 1]; i > w->level_ptr[k]; --i)
+        gsl_spblas_dtrsv_rows(i - 1, i, x, w);
+    }
+
+  test_vectors(x, (gsl_vector *) x_gsl, 1.0e-10, desc);
+
+  gsl_vector_free(x);
+}
+
+static void
+test_dtrsv(const size_t N, const gsl_rng *r)
+{
+  const CBLAS_UPLO_t Uplo[] = { CblasLower, CblasUpper };
+  const CBLAS_TRANSPOSE_t Trans[] = { CblasNoTrans, CblasTrans };
+  const CBLAS_DIAG_t Diag[] = { CblasNonUnit, CblasUnit };
+  gsl_spmatrix *T = create_random_sparse(N, N, 0.2, r);
+  gsl_spmatrix *A, *B;
+  gsl_matrix *A_dense = gsl_matrix_alloc(N, N);
+  gsl_vector *b = gsl_vector_alloc(N);
+  gsl_vector *x_gsl = gsl_vector_alloc(N);
+  gsl_spblas_trsv_workspace *w = gsl_spblas_trsv_alloc(N);
+  size_t i, j, k, l;
+
+  /* scale off-diagonal elements and make the diagonal dominant */
+  gsl_spmatrix_scale(T, 1.0 / (double) N);
+  for (i = 0; i < N; ++i)
+    gsl_spmatrix_set(T, i, i, 1.0 + gsl_rng_uniform(r));
+
+  A = gsl_spmatrix_ccs(T);
+  B = gsl_spmatrix_crs(T);
+  gsl_spmatrix_sp2d(A_dense, T);
+  create_random_vector(b, r);
+
+  for (i = 0; i < 2; ++i)
+    {
+      for (j = 0; j < 2; ++j)
+        {
+          for (k = 0; k < 2; ++k)
+            {
+              gsl_vector_memcpy(x_gsl, b);
+              gsl_blas_dtrsv(Uplo[i], Trans[j], Diag[k], A_dense, x_gsl);
+
+              for (l = 0; l < 2; ++l)
+                {
+                  char desc[64];
+
+                  sprintf(desc, "test_dtrsv: %s %s %s %s",
+                          l == 0 ? "CSC" : "CSR",
+                          i == 0 ? "lower" : "upper",
+                          j == 0 ? "notrans" : "trans",
+                          k == 0 ? "nonunit" : "unit");
+
+                  test_dtrsv_eps(Uplo[i], Trans[j], Diag[k], l == 0 ? A : B,
+                                 b, x_gsl, w, desc);
+                }
+            }
+        }
+    }
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(B);
+  gsl_matrix_free(A_dense);
+  gsl_vector_free(b);
+  gsl_vector_free(x_gsl);
+  gsl_spblas_trsv_free(w);
+} /* test_dtrsv() */
+
+/* check that a missing diagonal element is reported as singular */
+static void
+test_dtrsv_sing(void)
+{
+  const size_t N = 3;
+  const CBLAS_UPLO_t Uplo[] = { CblasLower, CblasUpper };
+  const CBLAS_TRANSPOSE_t Trans[] = { CblasNoTrans, CblasTrans };
+  gsl_spmatrix *T = gsl_spmatrix_alloc(N, N);
+  gsl_spmatrix *A, *B;
+  gsl_vector *x = gsl_vector_alloc(N);
+  gsl_spblas_trsv_workspace *w = gsl_spblas_trsv_alloc(N);
+  gsl_error_handler_t *old_handler = gsl_set_error_handler_off();
+  size_t i, j, l;
+
+  /* full matrix except for a structurally missing A(1,1) */
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          if (i != 1 || j != 1)
+            gsl_spmatrix_set(T, i, j, 2.0 + (double) (i + j));
+        }
+    }
+
+  A = gsl_spmatrix_ccs(T);
+  B = gsl_spmatrix_crs(T);
+
+  for (i = 0; i < 2; ++i)
+    {
+      for (j = 0; j < 2; ++j)
+        {
+          for (l = 0; l < 2; ++l)
+            {
+              const gsl_spmatrix *M = (l == 0) ? A : B;
+              const char *fmt = (l == 0) ? "CSC" : "CSR";
+              const char *uplo = (i == 0) ? "lower" : "upper";
+              const char *trans = (j == 0) ? "notrans" : "trans";
+              int status;
+
+              gsl_vector_set_all(x, 1.0);
+              status = gsl_spblas_dtrsv(Uplo[i], Trans[j], CblasNonUnit, M, x);
+              gsl_test_int(status, GSL_ESING, "test_dtrsv_sing: %s %s %s dtrsv",
+                           fmt, uplo, trans);
+
+              status = gsl_spblas_dtrsv_analyze(Uplo[i], Trans[j], CblasNonUnit, M, w);
+              gsl_test_int(status, GSL_ESING, "test_dtrsv_sing: %s %s %s analyze",
+                           fmt, uplo, trans);
+
+              /* unit diagonal does not reference the diagonal */
+              status = gsl_spblas_dtrsv(Uplo[i], Trans[j], CblasUnit, M, x);
+              gsl_test_int(status, GSL_SUCCESS, "test_dtrsv_sing: %s %s %s unit",
+                           fmt, uplo, trans);
+            }
+        }
+    }
+
+  gsl_set_error_handler(old_handler);
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(B);
+  gsl_vector_free(x);
+  gsl_spblas_trsv_free(w);
+} /* test_dtrsv_sing() */
+
 int
 main()
 {
@@ -256,6 +414,13 @@ main()
   test_dgemm(1.8, 12, 30, r);
   test_dgemm(0.4, 45, 35, r);
 
+  for (n = 1; n <= N_max; ++n)
+    test_dtrsv(n, r);
+
+  test_dtrsv(200, r);
+
+  test_dtrsv_sing();
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
@@ -0,0 +1,1079 @@
+/* splinalg/cholesky.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_permute_vector.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module computes the sparse Cholesky factorization
+ *
+ * P A P^T = L L^T
+ *
+ * of a symmetric positive definite matrix A, where P is a
+ * fill-reducing permutation supplied by the user, composed
+ * with a postordering of the elimination tree.
+ *
+ * The factorization is split into a symbolic phase, which
+ * depends only on the sparsity pattern of A, and a numeric
+ * phase. The symbolic phase computes the elimination tree,
+ * the column counts of L and partitions the columns of L into
+ * supernodes (sets of contiguous columns sharing the same
+ * sparsity pattern below the diagonal block). The numeric phase
+ * is a left-looking supernodal algorithm which stores each
+ * supernode as a dense block, so that the bulk of the work is
+ * carried out by the dense Level 3 BLAS and gsl_linalg_cholesky_decomp1.
+ *
+ * Supernode s consists of columns super[s], ..., super[s+1]-1 of L.
+ * Its row structure R_s (of length m_s, sorted in increasing order)
+ * is stored in Ri[Rp[s]:Rp[s+1]-1]. The first n_s = super[s+1]-super[s]
+ * entries of R_s are the columns of the supernode itself. The numerical
+ * values are stored row-major in the n_s-by-m_s block X_s starting at
+ * Lx[Lp[s]], with
+ *
+ *   X_s(j,r) = L(R_s[r], super[s] + j)
+ *
+ * so X_s = L_s^T and the diagonal block of X_s holds the upper
+ * triangular factor L_{ss}^T.
+ *
+ * References:
+ *
+ * [1] T. A. Davis, Direct Methods for Sparse Linear Systems, SIAM, 2006.
+ *
+ * [2] Y. Chen, T. A. Davis, W. W. Hager and S. Rajamanickam,
+ *     Algorithm 887: CHOLMOD, Supernodal Sparse Cholesky Factorization
+ *     and Update/Downdate, ACM Trans. Math. Softw. 35(3), 2008.
+ */
+
+static int spchol_permute(const gsl_spmatrix * A, const size_t * pinv,
+                          const size_t nzC, int * Cp, int * Ci, double * Cx,
+                          int * work);
+static size_t spchol_count(const gsl_spmatrix * A);
+static void spchol_etree(const size_t n, const int * Cp, const int * Ci,
+                         int * parent, int * ancestor);
+static void spchol_postorder(const size_t n, const int * parent, int * post,
+                             int * head, int * next, int * stack);
+static int spchol_alloc_pattern(const size_t nzC, gsl_splinalg_cholesky_workspace * w);
+static void spchol_free_pattern(gsl_splinalg_cholesky_workspace * w);
+
+/*
+gsl_splinalg_cholesky_alloc()
+  Allocate a workspace for the sparse Cholesky factorization
+of an n-by-n matrix
+
+Inputs: n - matrix dimension
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_cholesky_workspace *
+gsl_splinalg_cholesky_alloc(const size_t n)
+{
+  gsl_splinalg_cholesky_workspace *w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL("matrix dimension n must be a positive integer",
+                     GSL_EINVAL);
+    }
+
+  w = calloc(1, sizeof(gsl_splinalg_cholesky_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL("failed to allocate space for cholesky workspace",
+                     GSL_ENOMEM);
+    }
+
+  w->n = n;
+
+  w->perm = gsl_permutation_alloc(n);
+  if (w->perm == NULL)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate space for permutation", GSL_ENOMEM);
+    }
+
+  w->pinv = malloc(n * sizeof(size_t));
+  if (w->pinv == NULL)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate space for inverse permutation",
+                     GSL_ENOMEM);
+    }
+
+  w->parent = malloc(n * sizeof(int));
+  w->col2super = malloc(n * sizeof(int));
+  w->Cp = malloc((n + 1) * sizeof(int));
+  if (w->parent == NULL || w->col2super == NULL || w->Cp == NULL)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate space for symbolic arrays",
+                     GSL_ENOMEM);
+    }
+
+  /* integer workspace of size 4*n */
+  w->iwork = malloc(4 * n * sizeof(int));
+  if (w->iwork == NULL)
+    {
+      gsl_splinalg_cholesky_free(w);
+      GSL_ERROR_NULL("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->nsuper = 0;
+  w->nnz = 0;
+  w->factored = 0;
+
+  return w;
+}
+
+void
+gsl_splinalg_cholesky_free(gsl_splinalg_cholesky_workspace * w)
+{
+  RETURN_IF_NULL(w);
+
+  spchol_free_pattern(w);
+
+  if (w->perm)
+    gsl_permutation_free(w->perm);
+
+  if (w->pinv)
+    free(w->pinv);
+
+  if (w->parent)
+    free(w->parent);
+
+  if (w->col2super)
+    free(w->col2super);
+
+  if (w->Cp)
+    free(w->Cp);
+
+  if (w->iwork)
+    free(w->iwork);
+
+  free(w);
+}
+
+/*
+gsl_splinalg_cholesky_symbolic()
+  Perform the symbolic analysis of a sparse Cholesky
+factorization. Only the sparsity pattern of A is used, so the
+result may be reused for any number of numeric factorizations of
+matrices with the same pattern.
+
+Inputs: A - symmetric sparse matrix, n-by-n, in COO, CSC or CSR format;
+            only the lower triangle of A is referenced
+        p - fill-reducing permutation, or NULL to use the natural ordering
+        w - workspace
+
+Return: success/error
+
+Notes:
+1) The permutation p is composed with a postordering of the elimination
+tree, so that supernodes consist of contiguous columns; the final
+permutation is stored in w->perm
+*/
+
+int
+gsl_splinalg_cholesky_symbolic(const gsl_spmatrix * A,
+                               const gsl_permutation * p,
+                               gsl_splinalg_cholesky_workspace * w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (A->size1 != n)
+    {
+      GSL_ERROR("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (p != NULL && p->size != n)
+    {
+      GSL_ERROR("permutation size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      const size_t nzC = spchol_count(A);
+      int *head = w->iwork;
+      int *next = w->iwork + n;
+      int *stack = w->iwork + 2 * n;
+      int *post = w->iwork + 3 * n;
+      int *colcount, *flag, *rpos;
+      size_t *perm = w->perm->data;
+      size_t i, j, k, s;
+      size_t maxns = 0, maxms = 0;
+      int q;
+
+      w->factored = 0;
+
+      status = spchol_alloc_pattern(nzC, w);
+      if (status)
+        return status;
+
+      /* initial permutation */
+      if (p != NULL)
+        gsl_permutation_memcpy(w->perm, p);
+      else
+        gsl_permutation_init(w->perm);
+
+      for (i = 0; i < n; ++i)
+        w->pinv[perm[i]] = i;
+
+      /* compute elimination tree of P A P^T and its postorder */
+      spchol_permute(A, w->pinv, nzC, w->Cp, w->Ci, NULL, head);
+      spchol_etree(n, w->Cp, w->Ci, w->parent, head);
+      spchol_postorder(n, w->parent, post, head, next, stack);
+
+      /* compose permutation with postorder: perm_new[k] = perm[post[k]] */
+      for (k = 0; k < n; ++k)
+        next[k] = (int) perm[post[k]];
+
+      for (k = 0; k < n; ++k)
+        {
+          perm[k] = (size_t) next[k];
+          w->pinv[perm[k]] = k;
+        }
+
+      /* recompute pattern and elimination tree with final permutation */
+      spchol_permute(A, w->pinv, nzC, w->Cp, w->Ci, NULL, head);
+      spchol_etree(n, w->Cp, w->Ci, w->parent, head);
+
+      /* compute column counts of L by traversing the row subtrees */
+      colcount = head;
+      flag = next;
+
+      for (j = 0; j < n; ++j)
+        {
+          colcount[j] = 1;
+          flag[j] = -1;
+        }
+
+      for (k = 0; k < n; ++k)
+        {
+          flag[k] = (int) k;
+
+          for (q = w->Cp[k]; q < w->Cp[k + 1]; ++q)
+            {
+              int ii = w->Ci[q];
+
+              /* walk up the elimination tree from ii towards k */
+              while (ii < (int) k && flag[ii] != (int) k)
+                {
+                  colcount[ii]++;
+                  flag[ii] = (int) k;
+                  ii = w->parent[ii];
+                }
+            }
+        }
+
+      /*
+       * partition columns into supernodes: column j+1 is merged into the
+       * supernode of column j if it is the parent of j and has the same
+       * sparsity pattern below row j
+       */
+      w->nsuper = 0;
+      for (j = 0; j < n; ++j)
+        {
+          if (j == 0 || w->parent[j - 1] != (int) j ||
+              colcount[j] != colcount[j - 1] - 1)
+            {
+              stack[w->nsuper++] = (int) j;
+            }
+
+          w->col2super[j] = (int) w->nsuper - 1;
+        }
+
+      /* supernode boundaries, row structure pointers and block offsets */
+      w->Rp[0] = 0;
+      w->Lp[0] = 0;
+      for (s = 0; s < w->nsuper; ++s)
+        {
+          size_t f = (size_t) stack[s];
+          size_t l = (s + 1 < w->nsuper) ? (size_t) stack[s + 1] : n;
+          size_t ns = l - f;
+          size_t ms = (size_t) colcount[f];
+
+          w->super[s] = (int) f;
+          w->Rp[s + 1] = w->Rp[s] + ms;
+          w->Lp[s + 1] = w->Lp[s] + ns * ms;
+
+          maxns = GSL_MAX(maxns, ns);
+          maxms = GSL_MAX(maxms, ms);
+        }
+
+      w->super[w->nsuper] = (int) n;
+      w->nnz = w->Lp[w->nsuper];
+
+      /* allocate row structures, numerical blocks and update buffer */
+      w->Ri = malloc(w->Rp[w->nsuper] * sizeof(int));
+      w->Lx = malloc(w->nnz * sizeof(double));
+      w->work = malloc(maxns * maxms * sizeof(double));
+      if (w->Ri == NULL || w->Lx == NULL || w->work == NULL)
+        {
+          spchol_free_pattern(w);
+          GSL_ERROR("failed to allocate space for supernodes", GSL_ENOMEM);
+        }
+
+      /* row structure of supernode s is the structure of its first column */
+      rpos = post;
+      for (s = 0; s < w->nsuper; ++s)
+        {
+          w->Ri[w->Rp[s]] = w->super[s];
+          rpos[s] = (int) w->Rp[s] + 1;
+        }
+
+      for (j = 0; j < n; ++j)
+        flag[j] = -1;
+
+      for (k = 0; k < n; ++k)
+        {
+          flag[k] = (int) k;
+
+          for (q = w->Cp[k]; q < w->Cp[k + 1]; ++q)
+            {
+              int ii = w->Ci[q];
+
+              while (ii < (int) k && flag[ii] != (int) k)
+                {
+                  s = (size_t) w->col2super[ii];
+                  if (ii == w->super[s])
+                    w->Ri[rpos[s]++] = (int) k;
+
+                  flag[ii] = (int) k;
+                  ii = w->parent[ii];
+                }
+            }
+        }
+
+      /* allocate numeric workspace */
+      w->Cx = malloc(nzC * sizeof(double));
+      w->map = malloc(n * sizeof(int));
+      if (w->Cx == NULL || w->map == NULL)
+        {
+          spchol_free_pattern(w);
+          GSL_ERROR("failed to allocate space for numeric workspace",
+                    GSL_ENOMEM);
+        }
+
+      w->nzC = nzC;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_cholesky_numeric()
+  Compute the numeric sparse Cholesky factorization P A P^T = L L^T
+using a left-looking supernodal algorithm
+
+Inputs: A - symmetric positive definite sparse matrix, with the same
+            sparsity pattern as given to gsl_splinalg_cholesky_symbolic;
+            only the lower triangle of A is referenced
+        w - workspace
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_numeric(const gsl_spmatrix * A,
+                              gsl_splinalg_cholesky_workspace * w)
+{
+  const size_t n = w->n;
+
+  if (A->size1 != n || A->size2 != n)
+    {
+      GSL_ERROR("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (w->Lx == NULL)
+    {
+      GSL_ERROR("symbolic factorization must be computed first", GSL_EINVAL);
+    }
+  else
+    {
+      int status;
+      int *head = w->iwork;
+      int *next = w->iwork + n;
+      int *lpos = w->iwork + 2 * n;
+      int *map = w->map;
+      size_t j, s;
+
+      w->factored = 0;
+
+      status = spchol_permute(A, w->pinv, w->nzC, w->Cp, w->Ci, w->Cx, w->iwork);
+      if (status)
+        {
+          GSL_ERROR("sparsity pattern of A differs from symbolic analysis",
+                    GSL_EINVAL);
+        }
+
+      for (s = 0; s < w->nsuper; ++s)
+        head[s] = -1;
+
+      for (j = 0; j < n; ++j)
+        map[j] = -1;
+
+      for (s = 0; s < w->nsuper; ++s)
+        {
+          const size_t f = (size_t) w->super[s];
+          const size_t l = (size_t) w->super[s + 1];
+          const size_t ns = l - f;
+          const size_t ms = w->Rp[s + 1] - w->Rp[s];
+          const int *Rs = w->Ri + w->Rp[s];
+          double *Xs = w->Lx + w->Lp[s];
+          gsl_matrix_view X = gsl_matrix_view_array(Xs, ns, ms);
+          gsl_matrix_view D = gsl_matrix_submatrix(&X.matrix, 0, 0, ns, ns);
+          int d;
+          size_t r;
+
+          for (r = 0; r < ms; ++r)
+            map[Rs[r]] = (int) r;
+
+          /* assemble lower triangle of columns f:l-1 of P A P^T into X_s */
+          for (r = 0; r < ns * ms; ++r)
+            Xs[r] = 0.0;
+
+          for (j = f; j < l; ++j)
+            {
+              int q;
+
+              for (q = w->Cp[j]; q < w->Cp[j + 1]; ++q)
+                {
+                  int ii = w->Ci[q];
+
+                  if (ii < (int) j)
+                    continue;
+
+                  if (map[ii] < 0)
+                    {
+                      GSL_ERROR("sparsity pattern of A differs from symbolic analysis",
+                                GSL_EINVAL);
+                    }
+
+                  Xs[(j - f) * ms + map[ii]] = w->Cx[q];
+                }
+            }
+
+          /* apply updates from all descendant supernodes d with L(f:l-1,d) != 0 */
+          d = head[s];
+          while (d >= 0)
+            {
+              const int dnext = next[d];
+              const size_t nsd = (size_t) (w->super[d + 1] - w->super[d]);
+              const size_t md = w->Rp[d + 1] - w->Rp[d];
+              const int *Rd = w->Ri + w->Rp[d];
+              const size_t pdi = (size_t) lpos[d];
+              size_t pdend = pdi;
+              size_t ndrow1, ndrow2, ii, jj;
+
+              while (pdend < md && Rd[pdend] < (int) l)
+                ++pdend;
+
+              ndrow1 = pdend - pdi;
+              ndrow2 = md - pdi;
+
+              {
+                gsl_matrix_view Xd = gsl_matrix_view_array(w->Lx + w->Lp[d], nsd, md);
+                gsl_matrix_view X1 = gsl_matrix_submatrix(&Xd.matrix, 0, pdi, nsd, ndrow1);
+                gsl_matrix_view X2 = gsl_matrix_submatrix(&Xd.matrix, 0, pdi, nsd, ndrow2);
+                gsl_matrix_view T = gsl_matrix_view_array(w->work, ndrow1, ndrow2);
+
+                /* T = L(R1,d) L(R2,d)^T, where R1 = rows in f:l-1 and R2 = all rows >= f */
+                gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, &X1.matrix, &X2.matrix,
+                               0.0, &T.matrix);
+              }
+
+              /* scatter-subtract the update into X_s */
+              for (jj = 0; jj < ndrow1; ++jj)
+                {
+                  double *Xrow = Xs + (Rd[pdi + jj] - f) * ms;
+                  double *Trow = w->work + jj * ndrow2;
+
+                  for (ii = jj; ii < ndrow2; ++ii)
+                    Xrow[map[Rd[pdi + ii]]] -= Trow[ii];
+                }
+
+              /* link d to the next supernode it updates */
+              lpos[d] = (int) pdend;
+              if (pdend < md)
+                {
+                  int s2 = w->col2super[Rd[pdend]];
+                  next[d] = head[s2];
+                  head[s2] = d;
+                }
+
+              d = dnext;
+            }
+
+          head[s] = -1;
+
+          /*
+           * factor diagonal block: the upper triangle of D holds the lower
+           * triangle of the diagonal block of P A P^T, which is copied to the
+           * lower triangle of D before calling the dense Cholesky routine.
+           * On output, L_{ss}^T is copied back to the upper triangle of D
+           */
+          gsl_matrix_transpose_tricpy(CblasUpper, CblasUnit, &D.matrix, &D.matrix);
+
+          status = gsl_linalg_cholesky_decomp1(&D.matrix);
+          if (status)
+            return status;
+
+          gsl_matrix_transpose_tricpy(CblasLower, CblasUnit, &D.matrix, &D.matrix);
+
+          if (ms > ns)
+            {
+              gsl_matrix_view B = gsl_matrix_submatrix(&X.matrix, 0, ns, ns, ms - ns);
+              int s2;
+
+              /* L(R_s(ns:end),f:l-1) = A(R_s(ns:end),f:l-1) L_{ss}^{-T} */
+              gsl_blas_dtrsm(CblasLeft, CblasUpper, CblasTrans, CblasNonUnit,
+                             1.0, &D.matrix, &B.matrix);
+
+              /* link s to the first supernode it updates */
+              lpos[s] = (int) ns;
+              s2 = w->col2super[Rs[ns]];
+              next[s] = head[s2];
+              head[s2] = (int) s;
+            }
+
+          for (r = 0; r < ms; ++r)
+            map[Rs[r]] = -1;
+        }
+
+      w->factored = 1;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_cholesky_decomp()
+  Compute the sparse Cholesky factorization P A P^T = L L^T, by
+performing both the symbolic and numeric phases
+
+Inputs: A - symmetric positive definite sparse matrix; only the lower
+            triangle is referenced
+        p - fill-reducing permutation, or NULL to use the natural ordering
+        w - workspace
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_decomp(const gsl_spmatrix * A, const gsl_permutation * p,
+                             gsl_splinalg_cholesky_workspace * w)
+{
+  int status;
+
+  status = gsl_splinalg_cholesky_symbolic(A, p, w);
+  if (status)
+    return status;
+
+  status = gsl_splinalg_cholesky_numeric(A, w);
+
+  return status;
+}
+
+/*
+gsl_splinalg_cholesky_solve()
+  Solve A x = b using the sparse Cholesky factorization
+
+Inputs: b - right hand side vector
+        x - (output) solution vector
+        w - workspace containing Cholesky factorization
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_solve(const gsl_vector * b, gsl_vector * x,
+                            const gsl_splinalg_cholesky_workspace * w)
+{
+  if (w->n != b->size)
+    {
+      GSL_ERROR("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (w->n != x->size)
+    {
+      GSL_ERROR("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      /* copy x <- b */
+      gsl_vector_memcpy(x, b);
+
+      status = gsl_splinalg_cholesky_svx(x, w);
+
+      return status;
+    }
+}
+
+/*
+gsl_splinalg_cholesky_svx()
+  Solve A x = b in place using the sparse Cholesky factorization
+
+Inputs: x - (input) right hand side vector b
+            (output) solution vector x
+        w - workspace containing Cholesky factorization
+
+Return: success/error
+*/
+
+int
+gsl_splinalg_cholesky_svx(gsl_vector * x, const gsl_splinalg_cholesky_workspace * w)
+{
+  if (w->n != x->size)
+    {
+      GSL_ERROR("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else if (!w->factored)
+    {
+      GSL_ERROR("numeric factorization must be computed first", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t stride = x->stride;
+      double *y = x->data;
+      size_t s;
+
+      /* x := P b */
+      gsl_permute_vector(w->perm, x);
+
+      /* solve L y = P b */
+      for (s = 0; s < w->nsuper; ++s)
+        {
+          const size_t f = (size_t) w->super[s];
+          const size_t ns = (size_t) w->super[s + 1] - f;
+          const size_t ms = w->Rp[s + 1] - w->Rp[s];
+          const int *Rs = w->Ri + w->Rp[s];
+          const double *Xs = w->Lx + w->Lp[s];
+          size_t j, r;
+
+          for (j = 0; j < ns; ++j)
+            {
+              const double *Xrow = Xs + j * ms;
+              double yj = y[(f + j) * stride] / Xrow[j];
+
+              y[(f + j) * stride] = yj;
+
+              for (r = j + 1; r < ms; ++r)
+                y[Rs[r] * stride] -= Xrow[r] * yj;
+            }
+        }
+
+      /* solve L^T z = y */
+      for (s = w->nsuper; s-- > 0; )
+        {
+          const size_t f = (size_t) w->super[s];
+          const size_t ns = (size_t) w->super[s + 1] - f;
+          const size_t ms = w->Rp[s + 1] - w->Rp[s];
+          const int *Rs = w->Ri + w->Rp[s];
+          const double *Xs = w->Lx + w->Lp[s];
+          size_t j, r;
+
+          for (j = ns; j-- > 0; )
+            {
+              const double *Xrow = Xs + j * ms;
+              double yj = y[(f + j) * stride];
+
+              for (r = j + 1; r < ms; ++r)
+                yj -= Xrow[r] * y[Rs[r] * stride];
+
+              y[(f + j) * stride] = yj / Xrow[j];
+            }
+        }
+
+      /* x := P^T z */
+      gsl_permute_vector_inverse(w->perm, x);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+spchol_count()
+  Count the number of entries of the full symmetric matrix
+generated from the lower triangle of A
+*/
+
+static size_t
+spchol_count(const gsl_spmatrix * A)
+{
+  size_t nz = 0;
+  size_t k;
+  int q;
+
+  if (GSL_SPMATRIX_ISCOO(A))
+    {
+      for (k = 0; k < A->nz; ++k)
+        {
+          if (A->i[k] > A->p[k])
+            nz += 2;
+          else if (A->i[k] == A->p[k])
+            nz += 1;
+        }
+    }
+  else
+    {
+      const size_t N = GSL_SPMATRIX_ISCSC(A) ? A->size2 : A->size1;
+
+      for (k = 0; k < N; ++k)
+        {
+          for (q = A->p[k]; q < A->p[k + 1]; ++q)
+            {
+              if (A->i[q] == (int) k)
+                nz += 1;
+              else if ((GSL_SPMATRIX_ISCSC(A) && A->i[q] > (int) k) ||
+                       (GSL_SPMATRIX_ISCSR(A) && A->i[q] < (int) k))
+                nz += 2;
+            }
+        }
+    }
+
+  return nz;
+}
+
+/*
+spchol_permute()
+  Construct the full symmetric matrix C = P A P^T in compressed column
+format, using only the lower triangle of A
+
+Inputs: A    - sparse matrix in COO, CSC or CSR format
+        pinv - inverse permutation, C(pinv[i],pinv[j]) = A(i,j)
+        nzC  - number of non-zero entries of C, from spchol_count()
+        Cp   - (output) column pointers of C, length n + 1
+        Ci   - (output) row indices of C, length nzC
+        Cx   - (output) values of C, length nzC; may be NULL to
+               compute only the pattern
+        work - integer workspace, length n
+
+Return: success, or GSL_EINVAL if the number of entries of A
+does not match nzC
+*/
+
+static int
+spchol_permute(const gsl_spmatrix * A, const size_t * pinv, const size_t nzC,
+               int * Cp, int * Ci, double * Cx, int * work)
+{
+  const size_t n = A->size1;
+  int pass;
+  size_t k;
+
+  if (spchol_count(A) != nzC)
+    return GSL_EINVAL;
+
+  /* pass 0 counts column lengths of C, pass 1 stores the entries */
+  for (pass = 0; pass < 2; ++pass)
+    {
+      size_t N, kk;
+
+      if (pass == 0)
+        {
+          for (k = 0; k < n; ++k)
+            work[k] = 0;
+        }
+      else
+        {
+          Cp[0] = 0;
+          for (k = 0; k < n; ++k)
+            {
+              Cp[k + 1] = Cp[k] + work[k];
+              work[k] = Cp[k];
+            }
+        }
+
+      N = GSL_SPMATRIX_ISCOO(A) ? A->nz : (GSL_SPMATRIX_ISCSC(A) ? A->size2 : A->size1);
+
+      for (kk = 0; kk < N; ++kk)
+        {
+          int qstart, qend, q;
+
+          if (GSL_SPMATRIX_ISCOO(A))
+            {
+              qstart = (int) kk;
+              qend = qstart + 1;
+            }
+          else
+            {
+              qstart = A->p[kk];
+              qend = A->p[kk + 1];
+            }
+
+          for (q = qstart; q < qend; ++q)
+            {
+              size_t i, j, ci, cj;
+
+              if (GSL_SPMATRIX_ISCOO(A))
+                {
+                  i = (size_t) A->i[q];
+                  j = (size_t) A->p[q];
+                }
+              else if (GSL_SPMATRIX_ISCSC(A))
+                {
+                  i = (size_t) A->i[q];
+                  j = kk;
+                }
+              else
+                {
+                  i = kk;
+                  j = (size_t) A->i[q];
+                }
+
+              if (i < j)
+                continue; /* upper triangle is not referenced */
+
+              ci = pinv[i];
+              cj = pinv[j];
+
+              if (pass == 0)
+                {
+                  work[cj]++;
+                  if (i != j)
+                    work[ci]++;
+                }
+              else
+                {
+                  int idx = work[cj]++;
+
+                  Ci[idx] = (int) ci;
+                  if (Cx)
+                    Cx[idx] = A->data[q];
+
+                  if (i != j)
+                    {
+                      idx = work[ci]++;
+                      Ci[idx] = (int) cj;
+                      if (Cx)
+                        Cx[idx] = A->data[q];
+                    }
+                }
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+spchol_etree()
+  Compute the elimination tree of a symmetric matrix
+
+Inputs: n        - matrix dimension
+        Cp       - column pointers of symmetric matrix C
+        Ci       - row indices of C
+        parent   - (output) parent[j] = parent of node j, or -1 for a root
+        ancestor - workspace, length n
+
+Notes:
+1) based on CSparse routine cs_etree
+*/
+
+static void
+spchol_etree(const size_t n, const int * Cp, const int * Ci,
+             int * parent, int * ancestor)
+{
+  size_t k;
+
+  for (k = 0; k < n; ++k)
+    {
+      int q;
+
+      parent[k] = -1;
+      ancestor[k] = -1;
+
+      for (q = Cp[k]; q < Cp[k + 1]; ++q)
+        {
+          int i = Ci[q];
+
+          /* traverse from i to the root of its current subtree */
+          while (i != -1 && i < (int) k)
+            {
+              int inext = ancestor[i];
+
+              ancestor[i] = (int) k; /* path compression */
+              if (inext == -1)
+                parent[i] = (int) k;
+
+              i = inext;
+            }
+        }
+    }
+}
+
+/*
+spchol_postorder()
+  Compute a postordering of a forest
+
+Inputs: n      - number of nodes
+        parent - parent[j] = parent of node j, or -1 for a root
+        post   - (output) post[k] = k-th node in postorder
+        head   - workspace, length n
+        next   - workspace, length n
+        stack  - workspace, length n
+
+Notes:
+1) based on CSparse routines cs_post and cs_tdfs
+*/
+
+static void
+spchol_postorder(const size_t n, const int * parent, int * post,
+                 int * head, int * next, int * stack)
+{
+  size_t j, k = 0;
+
+  for (j = 0; j < n; ++j)
+    head[j] = -1;
+
+  /* build linked lists of children, in increasing order */
+  for (j = n; j-- > 0; )
+    {
+      if (parent[j] == -1)
+        continue;
+
+      next[j] = head[parent[j]];
+      head[parent[j]] = (int) j;
+    }
+
+  /* depth-first search of each tree */
+  for (j = 0; j < n; ++j)
+    {
+      int top = 0;
+
+      if (parent[j] != -1)
+        continue;
+
+      stack[0] = (int) j;
+      while (top >= 0)
+        {
+          int node = stack[top];
+          int child = head[node];
+
+          if (child == -1)
+            {
+              --top;
+              post[k++] = node;
+            }
+          else
+            {
+              head[node] = next[child];
+              stack[++top] = child;
+            }
+        }
+    }
+}
+
+/*
+spchol_alloc_pattern()
+  Allocate arrays which depend on the number of non-zeros of P A P^T
+and the number of supernodes. When called before the supernodes are
+known, only the pattern of C is allocated.
+*/
+
+static int
+spchol_alloc_pattern(const size_t nzC, gsl_splinalg_cholesky_workspace * w)
+{
+  if (w->Ci == NULL || w->nzC != nzC)
+    {
+      spchol_free_pattern(w);
+
+      w->Ci = malloc(GSL_MAX(nzC, 1) * sizeof(int));
+      w->super = malloc((w->n + 1) * sizeof(int));
+      w->Rp = malloc((w->n + 1) * sizeof(size_t));
+      w->Lp = malloc((w->n + 1) * sizeof(size_t));
+      if (w->Ci == NULL || w->super == NULL || w->Rp == NULL || w->Lp == NULL)
+        {
+          spchol_free_pattern(w);
+          GSL_ERROR("failed to allocate space for sparse pattern", GSL_ENOMEM);
+        }
+
+      w->nzC = nzC;
+    }
+  else
+    {
+      /* pattern arrays are reused; release the supernodal arrays */
+      if (w->Ri)
+        free(w->Ri);
+      if (w->Lx)
+        free(w->Lx);
+      if (w->work)
+        free(w->work);
+      if (w->Cx)
+        free(w->Cx);
+      if (w->map)
+        free(w->map);
+
+      w->Ri = NULL;
+      w->Lx = NULL;
+      w->work = NULL;
+      w->Cx = NULL;
+      w->map = NULL;
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+spchol_free_pattern(gsl_splinalg_cholesky_workspace * w)
+{
+  if (w->Ci)
+    free(w->Ci);
+  if (w->Cx)
+    free(w->Cx);
+  if (w->super)
+    free(w->super);
+  if (w->Rp)
+    free(w->Rp);
+  if (w->Lp)
+    free(w->Lp);
+  if (w->Ri)
+    free(w->Ri);
+  if (w->Lx)
+    free(w->Lx);
+  if (w->map)
+    free(w->map);
+  if (w->work)
+    free(w->work);
+
+  w->Ci = NULL;
+  w->Cx = NULL;
+  w->super = NULL;
+  w->Rp = NULL;
+  w->Lp = NULL;
+  w->Ri = NULL;
+  w->Lx = NULL;
+  w->map = NULL;
+  w->work = NULL;
+  w->nzC = 0;
+  w->nsuper = 0;
+  w->nnz = 0;
+}
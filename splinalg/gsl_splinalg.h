@@ -24,6 +24,7 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_permutation.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_types.h>
 
@@ -74,6 +75,49 @@ int gsl_splinalg_itersolve_iterate(const gsl_spmatrix *A,
                                    gsl_splinalg_itersolve *w);
 double gsl_splinalg_itersolve_normr(const gsl_splinalg_itersolve *w);
 
+/* sparse Cholesky factorization */
+
+typedef struct
+{
+  size_t n;                 /* matrix dimension */
+  size_t nsuper;            /* number of supernodes */
+  size_t nnz;               /* number of entries stored in supernodal blocks of L */
+  size_t nzC;               /* number of non-zeros in P A P^T */
+  gsl_permutation * perm;   /* fill-reducing permutation composed with etree postorder */
+  size_t * pinv;            /* inverse permutation */
+  int * parent;             /* elimination tree of P A P^T, length n */
+  int * col2super;          /* col2super[j] = supernode containing column j */
+  int * super;              /* supernode s is columns super[s]:super[s+1]-1, length nsuper+1 */
+  size_t * Rp;              /* row structure pointers, length nsuper+1 */
+  int * Ri;                 /* row structures of supernodes */
+  size_t * Lp;              /* supernodal block pointers, length nsuper+1 */
+  double * Lx;              /* supernodal blocks of L, length nnz */
+  int * Cp;                 /* column pointers of P A P^T, length n+1 */
+  int * Ci;                 /* row indices of P A P^T, length nzC */
+  double * Cx;              /* values of P A P^T, length nzC */
+  int * map;                /* row index map for supernode assembly, length n */
+  int * iwork;              /* integer workspace, length 4*n */
+  double * work;            /* dense update workspace */
+  int factored;             /* numeric factorization has been computed */
+} gsl_splinalg_cholesky_workspace;
+
+gsl_splinalg_cholesky_workspace * gsl_splinalg_cholesky_alloc(const size_t n);
+void gsl_splinalg_cholesky_free(gsl_splinalg_cholesky_workspace * w);
+int gsl_splinalg_cholesky_symbolic(const gsl_spmatrix * A, const gsl_permutation * p,
+                                   gsl_splinalg_cholesky_workspace * w);
+int gsl_splinalg_cholesky_numeric(const gsl_spmatrix * A, gsl_splinalg_cholesky_workspace * w);
+int gsl_splinalg_cholesky_decomp(const gsl_spmatrix * A, const gsl_permutation * p,
+                                 gsl_splinalg_cholesky_workspace * w);
+int gsl_splinalg_cholesky_solve(const gsl_vector * b, gsl_vector * x,
+                                const gsl_splinalg_cholesky_workspace * w);
+int gsl_splinalg_cholesky_svx(gsl_vector * x, const gsl_splinalg_cholesky_workspace * w);
+
+/* fill-reducing and bandwidth-reducing orderings */
+
+int gsl_splinalg_order_rcm(const gsl_spmatrix * A, gsl_permutation * p);
+int gsl_splinalg_order_amd(const gsl_spmatrix * A, gsl_permutation * p);
+int gsl_splinalg_order_nd(const gsl_spmatrix * A, gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPLINALG_H__ */
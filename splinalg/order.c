@@ -0,0 +1,1117 @@
+/* splinalg/order.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module contains fill-reducing and bandwidth-reducing
+ * orderings for sparse matrices. All orderings operate on the
+ * graph of A + A^T, ignoring the diagonal, and return a permutation
+ * p such that the matrix P A P^T, with (P A P^T)(i,j) = A(p[i],p[j]),
+ * has a small bandwidth (RCM) or produces little fill-in in its
+ * Cholesky factorization (AMD, nested dissection).
+ *
+ * References:
+ *
+ * [1] A. George and J. W. H. Liu, Computer Solution of Large Sparse
+ *     Positive Definite Systems, Prentice-Hall, 1981.
+ *
+ * [2] P. R. Amestoy, T. A. Davis and I. S. Duff, An approximate minimum
+ *     degree ordering algorithm, SIAM J. Matrix Anal. Appl. 17(4), 1996.
+ *
+ * [3] T. A. Davis, Direct Methods for Sparse Linear Systems, SIAM, 2006.
+ */
+
+/* flip an index for marking, as in CSparse */
+#define ORDER_FLIP(i)     (-(i) - 2)
+
+static int order_graph(const gsl_spmatrix * A, const size_t elbow,
+                       int ** Gp_out, int ** Gi_out, size_t * nzmax_out);
+static size_t order_bfs(const size_t root, const int * Gp, const int * Gi,
+                        const int * done, int * level, int * queue,
+                        size_t * nlevels, size_t * last_start);
+static size_t order_peripheral(size_t root, const int * Gp, const int * Gi,
+                               const int * done, int * level, int * queue);
+static int order_wclear(int mark, const int lemax, int * w, const size_t n);
+static size_t order_tdfs(const int j, size_t k, int * head, const int * next,
+                         size_t * post, int * stack);
+
+/*
+gsl_splinalg_order_rcm()
+  Compute the reverse Cuthill-McKee ordering of a sparse matrix,
+which reduces the bandwidth and profile of P A P^T
+
+Inputs: A - square sparse matrix in COO, CSC or CSR format; only the
+            sparsity pattern of A + A^T is used
+        p - (output) permutation
+
+Return: success/error
+
+Notes:
+1) each connected component is ordered by a breadth-first search
+starting from a pseudo-peripheral node, found with the algorithm of
+George and Liu; neighbors are visited in order of increasing degree
+*/
+
+int
+gsl_splinalg_order_rcm(const gsl_spmatrix * A, gsl_permutation * p)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (p->size != n)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      int *Gp, *Gi;
+      int *done, *mark, *queue;
+      size_t nzmax;
+      size_t nordered = 0;
+      size_t i;
+
+      status = order_graph(A, 0, &Gp, &Gi, &nzmax);
+      if (status)
+        return status;
+
+      done = malloc(3 * n * sizeof(int));
+      if (done == NULL)
+        {
+          free(Gp);
+          free(Gi);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      mark = done + n;
+      queue = done + 2 * n;
+
+      for (i = 0; i < n; ++i)
+        {
+          done[i] = 0;
+          mark[i] = -1;
+        }
+
+      while (nordered < n)
+        {
+          size_t root = n, start, head;
+          int mindeg = INT_MAX;
+
+          /* start from an unnumbered node of minimum degree */
+          for (i = 0; i < n; ++i)
+            {
+              int deg = Gp[i + 1] - Gp[i];
+
+              if (!done[i] && deg < mindeg)
+                {
+                  mindeg = deg;
+                  root = i;
+                }
+            }
+
+          /* find a pseudo-peripheral node of this component */
+          root = order_peripheral(root, Gp, Gi, done, mark, queue);
+
+          /* Cuthill-McKee ordering of the component starting from root */
+          start = nordered;
+          p->data[nordered++] = root;
+          done[root] = 1;
+
+          for (head = start; head < nordered; ++head)
+            {
+              const size_t node = p->data[head];
+              const size_t first = nordered;
+              int q;
+
+              for (q = Gp[node]; q < Gp[node + 1]; ++q)
+                {
+                  int j = Gi[q];
+
+                  if (!done[j])
+                    {
+                      done[j] = 1;
+                      p->data[nordered++] = (size_t) j;
+                    }
+                }
+
+              /* insertion sort of new nodes by increasing degree */
+              for (i = first + 1; i < nordered; ++i)
+                {
+                  size_t node_i = p->data[i];
+                  int deg_i = Gp[node_i + 1] - Gp[node_i];
+                  size_t k = i;
+
+                  while (k > first && Gp[p->data[k - 1] + 1] - Gp[p->data[k - 1]] > deg_i)
+                    {
+                      p->data[k] = p->data[k - 1];
+                      --k;
+                    }
+
+                  p->data[k] = node_i;
+                }
+            }
+        }
+
+      /* reverse the ordering */
+      gsl_permutation_reverse(p);
+
+      free(Gp);
+      free(Gi);
+      free(done);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_order_amd()
+  Compute the approximate minimum degree ordering of a
+symmetric sparse matrix, which reduces the fill-in of the
+Cholesky factor of P A P^T
+
+Inputs: A - square sparse matrix in COO, CSC or CSR format; only the
+            sparsity pattern of A + A^T is used
+        p - (output) permutation
+
+Return: success/error
+
+Notes:
+1) based on CSparse routine cs_amd, which uses a quotient graph
+representation with element absorption, mass elimination,
+supervariable detection and approximate external degrees; dense
+rows are ordered last
+*/
+
+int
+gsl_splinalg_order_amd(const gsl_spmatrix * A, gsl_permutation * p)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (p->size != n)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      int *Cp, *Ci, *W;
+      int *len, *nv, *next, *head, *elen, *degree, *w, *hhead, *last;
+      size_t *post;
+      size_t nzmax;
+      int dense, cnz, nel = 0, mindeg = 0, lemax = 0, mark;
+      int i, j, k, e, d, dk, dext, elenk, eln, nvi, nvj, nvk, wnvi, ok;
+      int k1, k2, k3, jlast, ln, pj, pk, pk1, pk2, pn, p1, p2, p3, p4, q;
+      int pp;
+      const int N = (int) n;
+
+      /* graph of A + A^T with elbow room for the quotient graph */
+      status = order_graph(A, 1, &Cp, &Ci, &nzmax);
+      if (status)
+        return status;
+
+      W = malloc(9 * (n + 1) * sizeof(int));
+      post = malloc((n + 1) * sizeof(size_t));
+      if (W == NULL || post == NULL)
+        {
+          free(Cp);
+          free(Ci);
+          if (W)
+            free(W);
+          if (post)
+            free(post);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      len = W;
+      nv = W + (n + 1);
+      next = W + 2 * (n + 1);
+      head = W + 3 * (n + 1);
+      elen = W + 4 * (n + 1);
+      degree = W + 5 * (n + 1);
+      w = W + 6 * (n + 1);
+      hhead = W + 7 * (n + 1);
+      last = W + 8 * (n + 1);
+
+      /* dense row threshold */
+      dense = (int) GSL_MAX(16.0, 10.0 * sqrt((double) n));
+      dense = GSL_MIN(N - 2, dense);
+
+      cnz = Cp[n];
+
+      /* initialize quotient graph */
+      for (k = 0; k < N; ++k)
+        len[k] = Cp[k + 1] - Cp[k];
+
+      len[n] = 0;
+
+      for (i = 0; i <= N; ++i)
+        {
+          head[i] = -1;   /* degree list i is empty */
+          last[i] = -1;
+          next[i] = -1;
+          hhead[i] = -1;  /* hash list i is empty */
+          nv[i] = 1;      /* node i is just one node */
+          w[i] = 1;       /* node i is alive */
+          elen[i] = 0;    /* Ek of node i is empty */
+          degree[i] = len[i];
+        }
+
+      mark = order_wclear(0, 0, w, n);
+      elen[n] = -2;       /* n is a dead element */
+      Cp[n] = -1;         /* n is a root of the assembly tree */
+      w[n] = 0;
+
+      /* initialize degree lists */
+      for (i = 0; i < N; ++i)
+        {
+          d = degree[i];
+
+          if (d == 0)
+            {
+              /* node i is empty */
+              elen[i] = -2;
+              nel++;
+              Cp[i] = -1;
+              w[i] = 0;
+            }
+          else if (d > dense)
+            {
+              /* node i is dense, absorb into element n */
+              nv[i] = 0;
+              elen[i] = -1;
+              nel++;
+              Cp[i] = ORDER_FLIP(N);
+              nv[n]++;
+            }
+          else
+            {
+              if (head[d] != -1)
+                last[head[d]] = i;
+
+              next[i] = head[d];
+              head[d] = i;
+            }
+        }
+
+      while (nel < N)
+        {
+          /* select node of minimum approximate degree */
+          for (k = -1; mindeg < N && (k = head[mindeg]) == -1; mindeg++)
+            ;
+
+          if (next[k] != -1)
+            last[next[k]] = -1;
+
+          head[mindeg] = next[k]; /* remove k from degree list */
+          elenk = elen[k];        /* elenk = |Ek| */
+          nvk = nv[k];            /* number of nodes k represents */
+          nel += nvk;
+
+          /* garbage collection */
+          if (elenk > 0 && cnz + mindeg >= (int) nzmax)
+            {
+              for (j = 0; j < N; ++j)
+                {
+                  if ((pp = Cp[j]) >= 0) /* j is a live node or element */
+                    {
+                      Cp[j] = Ci[pp];          /* save first entry of object */
+                      Ci[pp] = ORDER_FLIP(j);  /* first entry is now FLIP(j) */
+                    }
+                }
+
+              for (q = 0, pp = 0; pp < cnz; )
+                {
+                  if ((j = ORDER_FLIP(Ci[pp++])) >= 0) /* found object j */
+                    {
+                      Ci[q] = Cp[j];  /* restore first entry of object */
+                      Cp[j] = q++;    /* new pointer to object j */
+                      for (k3 = 0; k3 < len[j] - 1; k3++)
+                        Ci[q++] = Ci[pp++];
+                    }
+                }
+
+              cnz = q;
+            }
+
+          /* construct new element */
+          dk = 0;
+          nv[k] = -nvk;  /* flag k as in Lk */
+          pp = Cp[k];
+          pk1 = (elenk == 0) ? pp : cnz; /* do in place if elen[k] == 0 */
+          pk2 = pk1;
+
+          for (k1 = 1; k1 <= elenk + 1; k1++)
+            {
+              if (k1 > elenk)
+                {
+                  e = k;                /* search the nodes in k */
+                  pj = pp;              /* list of nodes starts at Ci[pj] */
+                  ln = len[k] - elenk;  /* length of list of nodes in k */
+                }
+              else
+                {
+                  e = Ci[pp++];         /* search the nodes in e */
+                  pj = Cp[e];
+                  ln = len[e];
+                }
+
+              for (k2 = 1; k2 <= ln; k2++)
+                {
+                  i = Ci[pj++];
+                  if ((nvi = nv[i]) <= 0)
+                    continue;            /* node i dead, or seen */
+
+                  dk += nvi;             /* degree[Lk] += size of node i */
+                  nv[i] = -nvi;          /* negate nv[i] to denote i in Lk */
+                  Ci[pk2++] = i;         /* place i in Lk */
+
+                  /* remove i from degree list */
+                  if (next[i] != -1)
+                    last[next[i]] = last[i];
+
+                  if (last[i] != -1)
+                    next[last[i]] = next[i];
+                  else
+                    head[degree[i]] = next[i];
+                }
+
+              if (e != k)
+                {
+                  Cp[e] = ORDER_FLIP(k);  /* absorb e into k */
+                  w[e] = 0;               /* e is now a dead element */
+                }
+            }
+
+          if (elenk != 0)
+            cnz = pk2;            /* Ci[cnz...nzmax] is free */
+
+          degree[k] = dk;         /* external degree of k - |Lk\i| */
+          Cp[k] = pk1;            /* element k is in Ci[pk1..pk2-1] */
+          len[k] = pk2 - pk1;
+          elen[k] = -2;           /* k is now an element */
+
+          /* find set differences */
+          mark = order_wclear(mark, lemax, w, n);
+          for (pk = pk1; pk < pk2; pk++)
+            {
+              i = Ci[pk];
+              if ((eln = elen[i]) <= 0)
+                continue;               /* skip if elen[i] empty */
+
+              nvi = -nv[i];             /* nv[i] was negated */
+              wnvi = mark - nvi;
+
+              for (pp = Cp[i]; pp <= Cp[i] + eln - 1; pp++)
+                {
+                  e = Ci[pp];
+                  if (w[e] >= mark)
+                    w[e] -= nvi;                 /* decrement |Le\Lk| */
+                  else if (w[e] != 0)
+                    w[e] = degree[e] + wnvi;     /* first time e seen */
+                }
+            }
+
+          /* degree update */
+          for (pk = pk1; pk < pk2; pk++)
+            {
+              unsigned long h = 0;
+
+              i = Ci[pk];               /* consider node i in Lk */
+              p1 = Cp[i];
+              p2 = p1 + elen[i] - 1;
+              pn = p1;
+              d = 0;
+
+              for (pp = p1; pp <= p2; pp++)
+                {
+                  e = Ci[pp];
+                  if (w[e] != 0)        /* e is an unabsorbed element */
+                    {
+                      dext = w[e] - mark; /* dext = |Le\Lk| */
+                      if (dext > 0)
+                        {
+                          d += dext;         /* sum up the set differences */
+                          Ci[pn++] = e;      /* keep e in Ei */
+                          h += (unsigned long) e;
+                        }
+                      else
+                        {
+                          Cp[e] = ORDER_FLIP(k); /* aggressive absorption */
+                          w[e] = 0;
+                        }
+                    }
+                }
+
+              elen[i] = pn - p1 + 1;    /* elen[i] = |Ei| */
+              p3 = pn;
+              p4 = p1 + len[i];
+
+              for (pp = p2 + 1; pp < p4; pp++) /* prune edges in Ai */
+                {
+                  j = Ci[pp];
+                  if ((nvj = nv[j]) <= 0)
+                    continue;             /* node j dead or in Lk */
+
+                  d += nvj;               /* degree(i) += |j| */
+                  Ci[pn++] = j;           /* place j in node list of i */
+                  h += (unsigned long) j;
+                }
+
+              if (d == 0)
+                {
+                  /* mass elimination: absorb i into k */
+                  Cp[i] = ORDER_FLIP(k);
+                  nvi = -nv[i];
+                  dk -= nvi;
+                  nvk += nvi;
+                  nel += nvi;
+                  nv[i] = 0;
+                  elen[i] = -1;           /* node i is dead */
+                }
+              else
+                {
+                  degree[i] = GSL_MIN(degree[i], d);
+                  Ci[pn] = Ci[p3];        /* move first node to end */
+                  Ci[p3] = Ci[p1];        /* move first element to end of Ei */
+                  Ci[p1] = k;             /* add k as first element of Ei */
+                  len[i] = pn - p1 + 1;
+                  h %= n;                 /* finalize hash of i */
+                  next[i] = hhead[h];     /* place i in hash bucket */
+                  hhead[h] = i;
+                  last[i] = (int) h;      /* save hash of i in last[i] */
+                }
+            }
+
+          degree[k] = dk;
+          lemax = GSL_MAX(lemax, dk);
+          mark = order_wclear(mark + lemax, lemax, w, n);
+
+          /* supernode detection */
+          for (pk = pk1; pk < pk2; pk++)
+            {
+              int h;
+
+              i = Ci[pk];
+              if (nv[i] >= 0)
+                continue;               /* skip if i is dead */
+
+              h = last[i];              /* scan hash bucket of node i */
+              i = hhead[h];
+              hhead[h] = -1;            /* hash bucket will be empty */
+
+              for (; i != -1 && next[i] != -1; i = next[i], mark++)
+                {
+                  ln = len[i];
+                  eln = elen[i];
+
+                  for (pp = Cp[i] + 1; pp <= Cp[i] + ln - 1; pp++)
+                    w[Ci[pp]] = mark;
+
+                  jlast = i;
+                  for (j = next[i]; j != -1; )
+                    {
+                      ok = (len[j] == ln) && (elen[j] == eln);
+
+                      for (pp = Cp[j] + 1; ok && pp <= Cp[j] + ln - 1; pp++)
+                        {
+                          if (w[Ci[pp]] != mark)
+                            ok = 0;
+                        }
+
+                      if (ok)
+                        {
+                          /* i and j are identical, absorb j into i */
+                          Cp[j] = ORDER_FLIP(i);
+                          nv[i] += nv[j];
+                          nv[j] = 0;
+                          elen[j] = -1;
+                          j = next[j];    /* delete j from hash bucket */
+                          next[jlast] = j;
+                        }
+                      else
+                        {
+                          jlast = j;
+                          j = next[j];
+                        }
+                    }
+                }
+            }
+
+          /* finalize new element */
+          for (pp = pk1, pk = pk1; pk < pk2; pk++)
+            {
+              i = Ci[pk];
+              if ((nvi = -nv[i]) <= 0)
+                continue;               /* skip if i is dead */
+
+              nv[i] = nvi;              /* restore nv[i] */
+              d = degree[i] + dk - nvi; /* compute external degree(i) */
+              d = GSL_MIN(d, N - nel - nvi);
+
+              if (head[d] != -1)
+                last[head[d]] = i;
+
+              next[i] = head[d];        /* put i back in degree list */
+              last[i] = -1;
+              head[d] = i;
+              mindeg = GSL_MIN(mindeg, d);
+              degree[i] = d;
+              Ci[pp++] = i;             /* place i in Lk */
+            }
+
+          nv[k] = nvk;                  /* number of nodes absorbed into k */
+          if ((len[k] = pp - pk1) == 0)
+            {
+              Cp[k] = -1;               /* k is a root of the tree */
+              w[k] = 0;                 /* k is now a dead element */
+            }
+
+          if (elenk != 0)
+            cnz = pp;                   /* free unused space in Lk */
+        }
+
+      /* postorder the assembly tree */
+      for (i = 0; i < N; ++i)
+        Cp[i] = ORDER_FLIP(Cp[i]);
+
+      for (j = 0; j <= N; ++j)
+        head[j] = -1;
+
+      /* place unordered nodes in lists */
+      for (j = N; j >= 0; j--)
+        {
+          if (nv[j] > 0)
+            continue;                   /* skip if j is an element */
+
+          next[j] = head[Cp[j]];        /* place j in list of its parent */
+          head[Cp[j]] = j;
+        }
+
+      /* place elements in lists */
+      for (e = N; e >= 0; e--)
+        {
+          if (nv[e] <= 0)
+            continue;                   /* skip unless e is an element */
+
+          if (Cp[e] != -1)
+            {
+              next[e] = head[Cp[e]];    /* place e in list of its parent */
+              head[Cp[e]] = e;
+            }
+        }
+
+      {
+        size_t kk = 0;
+
+        for (i = 0; i <= N; ++i)
+          {
+            if (Cp[i] == -1)
+              kk = order_tdfs(i, kk, head, next, post, w);
+          }
+      }
+
+      /* post[0..n-1] is the ordering, post[n] = n is the dense element */
+      for (i = 0; i < N; ++i)
+        p->data[i] = post[i];
+
+      free(Cp);
+      free(Ci);
+      free(W);
+      free(post);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_order_nd()
+  Compute a nested dissection ordering of a symmetric sparse
+matrix, which reduces the fill-in of the Cholesky factor of P A P^T
+
+Inputs: A - square sparse matrix in COO, CSC or CSR format; only the
+            sparsity pattern of A + A^T is used
+        p - (output) permutation
+
+Return: success/error
+
+Notes:
+1) this is the automatic nested dissection algorithm of George and
+Liu [1, Ch. 8]: a rooted level structure is built from a
+pseudo-peripheral node of a connected component, and the nodes of the
+middle level which are adjacent to the next level form a separator,
+which is numbered last. This is repeated on the remaining components
+until they have fewer than 3 levels, in which case all of their nodes
+are numbered
+*/
+
+int
+gsl_splinalg_order_nd(const gsl_spmatrix * A, gsl_permutation * p)
+{
+  const size_t n = A->size1;
+
+  if (n != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (p->size != n)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      int *Gp, *Gi;
+      int *done, *level, *queue;
+      size_t nzmax;
+      size_t num = n;     /* nodes are numbered from n - 1 down to 0 */
+      size_t i, k;
+
+      status = order_graph(A, 0, &Gp, &Gi, &nzmax);
+      if (status)
+        return status;
+
+      done = malloc(3 * n * sizeof(int));
+      if (done == NULL)
+        {
+          free(Gp);
+          free(Gi);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      level = done + n;
+      queue = done + 2 * n;
+
+      for (i = 0; i < n; ++i)
+        {
+          done[i] = 0;
+          level[i] = -1;
+        }
+
+      for (i = 0; i < n; ++i)
+        {
+          while (!done[i])
+            {
+              const size_t root = order_peripheral(i, Gp, Gi, done, level, queue);
+              size_t head = 0, tail = 0;
+              int depth, mid;
+
+              /* rooted level structure of the component of node i */
+              queue[tail++] = (int) root;
+              level[root] = 0;
+
+              while (head < tail)
+                {
+                  int node = queue[head++];
+                  int q;
+
+                  for (q = Gp[node]; q < Gp[node + 1]; ++q)
+                    {
+                      int j = Gi[q];
+
+                      if (!done[j] && level[j] < 0)
+                        {
+                          level[j] = level[node] + 1;
+                          queue[tail++] = j;
+                        }
+                    }
+                }
+
+              depth = level[queue[tail - 1]];
+              mid = (depth + 1) / 2;
+
+              if (depth < 2)
+                {
+                  /* fewer than 3 levels: number the whole component */
+                  for (k = tail; k > 0; --k)
+                    {
+                      const int node = queue[k - 1];
+                      p->data[--num] = (size_t) node;
+                      done[node] = 1;
+                    }
+                }
+              else
+                {
+                  /* separator: nodes of level mid adjacent to level mid + 1 */
+                  for (k = 0; k < tail; ++k)
+                    {
+                      const int node = queue[k];
+                      int q;
+
+                      if (level[node] != mid)
+                        continue;
+
+                      for (q = Gp[node]; q < Gp[node + 1]; ++q)
+                        {
+                          int j = Gi[q];
+
+                          if (!done[j] && level[j] == mid + 1)
+                            break;
+                        }
+
+                      if (q < Gp[node + 1])
+                        {
+                          p->data[--num] = (size_t) node;
+                          done[node] = 1;
+                        }
+                    }
+                }
+
+              /* restore workspace */
+              for (k = 0; k < tail; ++k)
+                level[queue[k]] = -1;
+            }
+        }
+
+      free(Gp);
+      free(Gi);
+      free(done);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+order_graph()
+  Construct the adjacency structure of the graph of A + A^T,
+excluding the diagonal, in compressed column format
+
+Inputs: A      - square sparse matrix
+        elbow  - if non-zero, allocate additional space for the
+                 quotient graph used by AMD
+        Gp_out - (output) column pointers, length n + 1
+        Gi_out - (output) row indices, length nzmax_out
+        nzmax_out - (output) allocated length of Gi_out
+
+Return: success/error
+*/
+
+static int
+order_graph(const gsl_spmatrix * A, const size_t elbow,
+            int ** Gp_out, int ** Gi_out, size_t * nzmax_out)
+{
+  const size_t n = A->size1;
+  int *Gp, *Gi, *work;
+  size_t nz = 0, nzmax;
+  size_t pass, k, kk, N;
+
+  Gp = malloc((n + 1) * sizeof(int));
+  work = malloc(n * sizeof(int));
+  if (Gp == NULL || work == NULL)
+    {
+      if (Gp)
+        free(Gp);
+      if (work)
+        free(work);
+      GSL_ERROR("failed to allocate graph", GSL_ENOMEM);
+    }
+
+  Gi = NULL;
+  nzmax = 0;
+  N = GSL_SPMATRIX_ISCOO(A) ? A->nz : (GSL_SPMATRIX_ISCSC(A) ? A->size2 : A->size1);
+
+  /* pass 0 counts, pass 1 fills entries (possibly with duplicates) */
+  for (pass = 0; pass < 2; ++pass)
+    {
+      if (pass == 0)
+        {
+          for (k = 0; k < n; ++k)
+            work[k] = 0;
+        }
+      else
+        {
+          Gp[0] = 0;
+          for (k = 0; k < n; ++k)
+            {
+              Gp[k + 1] = Gp[k] + work[k];
+              work[k] = Gp[k];
+            }
+
+          nz = (size_t) Gp[n];
+          nzmax = elbow ? nz + nz / 5 + 2 * n : nz;
+          Gi = malloc(GSL_MAX(nzmax, 1) * sizeof(int));
+          if (Gi == NULL)
+            {
+              free(Gp);
+              free(work);
+              GSL_ERROR("failed to allocate graph", GSL_ENOMEM);
+            }
+        }
+
+      for (kk = 0; kk < N; ++kk)
+        {
+          int qstart, qend, q;
+
+          if (GSL_SPMATRIX_ISCOO(A))
+            {
+              qstart = (int) kk;
+              qend = qstart + 1;
+            }
+          else
+            {
+              qstart = A->p[kk];
+              qend = A->p[kk + 1];
+            }
+
+          for (q = qstart; q < qend; ++q)
+            {
+              int i, j;
+
+              if (GSL_SPMATRIX_ISCOO(A))
+                {
+                  i = A->i[q];
+                  j = A->p[q];
+                }
+              else
+                {
+                  i = (int) kk;
+                  j = A->i[q];
+                }
+
+              if (i == j)
+                continue;
+
+              if (pass == 0)
+                {
+                  work[i]++;
+                  work[j]++;
+                }
+              else
+                {
+                  Gi[work[i]++] = j;
+                  Gi[work[j]++] = i;
+                }
+            }
+        }
+    }
+
+  /* remove duplicate entries, which arise when both A(i,j) and A(j,i) are present */
+  for (k = 0; k < n; ++k)
+    work[k] = -1;
+
+  nz = 0;
+  for (k = 0; k < n; ++k)
+    {
+      int q = Gp[k];
+      int qend = Gp[k + 1];
+
+      Gp[k] = (int) nz;
+      for (; q < qend; ++q)
+        {
+          int i = Gi[q];
+
+          if (work[i] != (int) k)
+            {
+              work[i] = (int) k;
+              Gi[nz++] = i;
+            }
+        }
+    }
+
+  Gp[n] = (int) nz;
+
+  free(work);
+
+  *Gp_out = Gp;
+  *Gi_out = Gi;
+  *nzmax_out = nzmax;
+
+  return GSL_SUCCESS;
+}
+
+/*
+order_bfs()
+  Breadth-first search of the unnumbered nodes reachable from root
+
+Inputs: root       - starting node
+        Gp         - graph column pointers
+        Gi         - graph row indices
+        done       - done[i] = 1 if node i has already been numbered
+        level      - workspace, length n, all entries -1 on input and
+                     on output
+        queue      - (output) nodes in order of discovery
+        nlevels    - (output) number of levels in the level structure
+        last_start - (output) index in queue of the first node of
+                     the last level
+
+Return: number of nodes visited
+*/
+
+static size_t
+order_bfs(const size_t root, const int * Gp, const int * Gi,
+          const int * done, int * level, int * queue,
+          size_t * nlevels, size_t * last_start)
+{
+  size_t head = 0, tail = 0, k;
+
+  queue[tail++] = (int) root;
+  level[root] = 0;
+  *last_start = 0;
+
+  while (head < tail)
+    {
+      int node = queue[head++];
+      int q;
+
+      for (q = Gp[node]; q < Gp[node + 1]; ++q)
+        {
+          int j = Gi[q];
+
+          if (!done[j] && level[j] < 0)
+            {
+              level[j] = level[node] + 1;
+              if (level[j] != level[queue[tail - 1]])
+                *last_start = tail;
+
+              queue[tail++] = j;
+            }
+        }
+    }
+
+  *nlevels = (size_t) level[queue[tail - 1]] + 1;
+
+  /* restore workspace */
+  for (k = 0; k < tail; ++k)
+    level[queue[k]] = -1;
+
+  return tail;
+}
+
+/*
+order_peripheral()
+  Find a pseudo-peripheral node in the component of root, with the
+algorithm of George and Liu [1]
+
+Inputs: root  - starting node
+        Gp    - graph column pointers
+        Gi    - graph row indices
+        done  - done[i] = 1 if node i has already been numbered
+        level - workspace, length n, all entries -1 on input and output
+        queue - workspace, length n
+
+Return: pseudo-peripheral node
+*/
+
+static size_t
+order_peripheral(size_t root, const int * Gp, const int * Gi,
+                 const int * done, int * level, int * queue)
+{
+  size_t nlevels, nlevels_new, last_start, len, i;
+
+  len = order_bfs(root, Gp, Gi, done, level, queue, &nlevels, &last_start);
+  while (1)
+    {
+      size_t x = root;
+      int mindeg = INT_MAX;
+
+      /* node of minimum degree in the last level */
+      for (i = last_start; i < len; ++i)
+        {
+          int node = queue[i];
+          int deg = Gp[node + 1] - Gp[node];
+
+          if (deg < mindeg)
+            {
+              mindeg = deg;
+              x = (size_t) node;
+            }
+        }
+
+      len = order_bfs(x, Gp, Gi, done, level, queue, &nlevels_new, &last_start);
+      if (nlevels_new > nlevels)
+        {
+          root = x;
+          nlevels = nlevels_new;
+        }
+      else
+        {
+          return root;
+        }
+    }
+}
+
+/* clear w if necessary; on output w[0..n-1] < mark */
+static int
+order_wclear(int mark, const int lemax, int * w, const size_t n)
+{
+  size_t k;
+
+  if (mark < 2 || lemax >= INT_MAX - mark)
+    {
+      for (k = 0; k < n; ++k)
+        {
+          if (w[k] != 0)
+            w[k] = 1;
+        }
+
+      mark = 2;
+    }
+
+  return mark;
+}
+
+/*
+order_tdfs()
+  Depth-first search and postorder of a tree rooted at node j
+
+Notes:
+1) based on CSparse routine cs_tdfs
+*/
+
+static size_t
+order_tdfs(const int j, size_t k, int * head, const int * next,
+           size_t * post, int * stack)
+{
+  int top = 0;
+
+  stack[0] = j;
+  while (top >= 0)
+    {
+      int pnode = stack[top];
+      int i = head[pnode];
+
+      if (i == -1)
+        {
+          top--;
+          post[k++] = (size_t) pnode;
+        }
+      else
+        {
+          head[pnode] = next[i];
+          stack[++top] = i;
+        }
+    }
+
+  return k;
+}
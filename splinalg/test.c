@@ -29,6 +29,8 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_permutation.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_spblas.h>
 #include <gsl/gsl_splinalg.h>
@@ -337,6 +339,304 @@ test_random(const size_t N, const gsl_rng *r, const int compress)
     gsl_spmatrix_free(B);
 } /* test_random() */
 
+/*
+create_random_spd()
+  Create a random symmetric positive definite sparse matrix
+A = B + B^T + 2 N I, where B is a random sparse matrix with
+entries in [0,1]
+*/
+
+static gsl_spmatrix *
+create_random_spd(const size_t N, const double density, const gsl_rng *r)
+{
+  gsl_spmatrix *B = create_random_sparse(N, N, density, r);
+  gsl_spmatrix *A = gsl_spmatrix_alloc(N, N);
+  size_t k;
+
+  for (k = 0; k < B->nz; ++k)
+    {
+      size_t i = B->i[k];
+      size_t j = B->p[k];
+      double x = B->data[k];
+
+      gsl_spmatrix_set(A, i, j, gsl_spmatrix_get(A, i, j) + x);
+      gsl_spmatrix_set(A, j, i, gsl_spmatrix_get(A, j, i) + x);
+    }
+
+  for (k = 0; k < N; ++k)
+    gsl_spmatrix_set(A, k, k, gsl_spmatrix_get(A, k, k) + 2.0 * N);
+
+  gsl_spmatrix_free(B);
+
+  return A;
+}
+
+/*
+create_laplacian()
+  Create the 5-point finite difference Laplacian on an
+N-by-N grid (negated, so the matrix is positive definite)
+*/
+
+static gsl_spmatrix *
+create_laplacian(const size_t N)
+{
+  const size_t n = N * N;
+  gsl_spmatrix *A = gsl_spmatrix_alloc_nzmax(n, n, 5 * n, GSL_SPMATRIX_COO);
+  size_t i, j;
+
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          size_t k = i * N + j;
+
+          gsl_spmatrix_set(A, k, k, 4.0);
+
+          if (i > 0)
+            gsl_spmatrix_set(A, k, k - N, -1.0);
+          if (i < N - 1)
+            gsl_spmatrix_set(A, k, k + N, -1.0);
+          if (j > 0)
+            gsl_spmatrix_set(A, k, k - 1, -1.0);
+          if (j < N - 1)
+            gsl_spmatrix_set(A, k, k + 1, -1.0);
+        }
+    }
+
+  return A;
+}
+
+/* solve A x = b with the sparse Cholesky solver and compare with dense Cholesky */
+static void
+test_cholesky_system(const char *desc, const gsl_spmatrix *A, const gsl_permutation *p,
+                     const double tol, const gsl_rng *r)
+{
+  const size_t n = A->size1;
+  const int sptype[] = { GSL_SPMATRIX_COO, GSL_SPMATRIX_CSC, GSL_SPMATRIX_CSR };
+  gsl_splinalg_cholesky_workspace *w = gsl_splinalg_cholesky_alloc(n);
+  gsl_matrix *D = gsl_matrix_alloc(n, n);
+  gsl_vector *b = gsl_vector_alloc(n);
+  gsl_vector *x = gsl_vector_alloc(n);
+  gsl_vector *x_expected = gsl_vector_alloc(n);
+  size_t k, i;
+  int status;
+
+  create_random_vector(b, r);
+
+  /* dense reference solution */
+  gsl_spmatrix_sp2d(D, A);
+  gsl_linalg_cholesky_decomp1(D);
+  gsl_linalg_cholesky_solve(D, b, x_expected);
+
+  for (k = 0; k < 3; ++k)
+    {
+      gsl_spmatrix *B = (sptype[k] == GSL_SPMATRIX_COO) ? (gsl_spmatrix *) A : gsl_spmatrix_compress(A, sptype[k]);
+
+      status = gsl_splinalg_cholesky_decomp(B, p, w);
+      gsl_test(status, "cholesky %s decomp status N=%zu type=%s", desc, n, gsl_spmatrix_type(B));
+
+      status = gsl_splinalg_cholesky_solve(b, x, w);
+      gsl_test(status, "cholesky %s solve status N=%zu type=%s", desc, n, gsl_spmatrix_type(B));
+
+      for (i = 0; i < n; ++i)
+        {
+          double xi = gsl_vector_get(x, i);
+          double yi = gsl_vector_get(x_expected, i);
+
+          gsl_test_rel(xi, yi, tol, "cholesky %s N=%zu type=%s i=%zu",
+                       desc, n, gsl_spmatrix_type(B), i);
+        }
+
+      /* refactor 2*A reusing symbolic analysis; solution should be x/2 */
+      {
+        gsl_spmatrix *B2 = gsl_spmatrix_alloc_nzmax(n, n, B->nz, B->sptype);
+
+        gsl_spmatrix_memcpy(B2, B);
+        gsl_spmatrix_scale(B2, 2.0);
+
+        status = gsl_splinalg_cholesky_numeric(B2, w);
+        gsl_test(status, "cholesky %s refactor status N=%zu type=%s", desc, n, gsl_spmatrix_type(B));
+
+        gsl_vector_memcpy(x, b);
+        gsl_splinalg_cholesky_svx(x, w);
+
+        for (i = 0; i < n; ++i)
+          {
+            double xi = gsl_vector_get(x, i);
+            double yi = 0.5 * gsl_vector_get(x_expected, i);
+
+            gsl_test_rel(xi, yi, tol, "cholesky %s refactor N=%zu type=%s i=%zu",
+                         desc, n, gsl_spmatrix_type(B), i);
+          }
+
+        gsl_spmatrix_free(B2);
+      }
+
+      if (B != A)
+        gsl_spmatrix_free(B);
+    }
+
+  gsl_splinalg_cholesky_free(w);
+  gsl_matrix_free(D);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+  gsl_vector_free(x_expected);
+}
+
+static void
+test_cholesky(const gsl_rng *r)
+{
+  size_t n;
+
+  for (n = 1; n <= 50; n += 7)
+    {
+      gsl_spmatrix *A = create_random_spd(n, 0.1, r);
+      gsl_permutation *p = gsl_permutation_calloc(n);
+      size_t i;
+
+      test_cholesky_system("random", A, NULL, 1.0e-10, r);
+
+      /* random permutation */
+      for (i = 0; i < n; ++i)
+        {
+          size_t j = i + (size_t) (gsl_rng_uniform(r) * (n - i));
+          gsl_permutation_swap(p, i, j);
+        }
+
+      test_cholesky_system("random permuted", A, p, 1.0e-10, r);
+
+      gsl_spmatrix_free(A);
+      gsl_permutation_free(p);
+    }
+
+  for (n = 2; n <= 20; n += 6)
+    {
+      gsl_spmatrix *A = create_laplacian(n);
+      test_cholesky_system("laplacian", A, NULL, 1.0e-10, r);
+      gsl_spmatrix_free(A);
+    }
+}
+
+/* apply a random symmetric permutation to A */
+static gsl_spmatrix *
+create_shuffled(const gsl_spmatrix *A, const gsl_rng *r)
+{
+  const size_t n = A->size1;
+  gsl_spmatrix *B = gsl_spmatrix_alloc_nzmax(n, n, A->nz, A->sptype);
+  gsl_permutation *p = gsl_permutation_alloc(n);
+  size_t i;
+
+  gsl_permutation_init(p);
+  for (i = 0; i < n; ++i)
+    {
+      size_t j = i + (size_t) (gsl_rng_uniform(r) * (n - i));
+      gsl_permutation_swap(p, i, j);
+    }
+
+  gsl_spmatrix_permute_sym(B, A, p);
+  gsl_permutation_free(p);
+
+  return B;
+}
+
+static void
+test_order_matrix(const char *desc, const gsl_spmatrix *A, const gsl_rng *r)
+{
+  const size_t n = A->size1;
+  gsl_permutation *p = gsl_permutation_alloc(n);
+  gsl_spmatrix *B = gsl_spmatrix_compress(A, GSL_SPMATRIX_CSC);
+  gsl_spmatrix *C = gsl_spmatrix_alloc_nzmax(n, n, B->nz, GSL_SPMATRIX_CSC);
+  gsl_splinalg_cholesky_workspace *w = gsl_splinalg_cholesky_alloc(n);
+  size_t lower, upper, lower_C, upper_C, nnz_natural;
+  int status;
+
+  gsl_spmatrix_bandwidth(B, &lower, &upper);
+
+  /* RCM */
+  status = gsl_splinalg_order_rcm(B, p);
+  gsl_test(status, "order_rcm %s status N=%zu", desc, n);
+
+  status = gsl_permutation_valid(p);
+  gsl_test(status, "order_rcm %s valid N=%zu", desc, n);
+
+  gsl_spmatrix_permute_sym(C, B, p);
+  gsl_spmatrix_bandwidth(C, &lower_C, &upper_C);
+  gsl_test(lower_C > lower, "order_rcm %s bandwidth N=%zu [%zu,%zu]", desc, n, lower_C, lower);
+
+  test_cholesky_system("rcm", A, p, 1.0e-10, r);
+
+  /* AMD */
+  gsl_splinalg_cholesky_symbolic(B, NULL, w);
+  nnz_natural = w->nnz;
+
+  status = gsl_splinalg_order_amd(B, p);
+  gsl_test(status, "order_amd %s status N=%zu", desc, n);
+
+  status = gsl_permutation_valid(p);
+  gsl_test(status, "order_amd %s valid N=%zu", desc, n);
+
+  gsl_splinalg_cholesky_symbolic(B, p, w);
+  gsl_test(w->nnz > nnz_natural, "order_amd %s fill N=%zu [%zu,%zu]", desc, n, w->nnz, nnz_natural);
+
+  test_cholesky_system("amd", A, p, 1.0e-10, r);
+
+  /* nested dissection */
+  status = gsl_splinalg_order_nd(B, p);
+  gsl_test(status, "order_nd %s status N=%zu", desc, n);
+
+  status = gsl_permutation_valid(p);
+  gsl_test(status, "order_nd %s valid N=%zu", desc, n);
+
+  gsl_splinalg_cholesky_symbolic(B, p, w);
+  gsl_test(w->nnz > nnz_natural, "order_nd %s fill N=%zu [%zu,%zu]", desc, n, w->nnz, nnz_natural);
+
+  test_cholesky_system("nd", A, p, 1.0e-10, r);
+
+  gsl_permutation_free(p);
+  gsl_spmatrix_free(B);
+  gsl_spmatrix_free(C);
+  gsl_splinalg_cholesky_free(w);
+}
+
+static void
+test_order(const gsl_rng *r)
+{
+  size_t n;
+
+  for (n = 2; n <= 22; n += 5)
+    {
+      gsl_spmatrix *A = create_laplacian(n);
+      gsl_spmatrix *B = create_shuffled(A, r);
+
+      test_order_matrix("laplacian shuffled", B, r);
+
+      gsl_spmatrix_free(A);
+      gsl_spmatrix_free(B);
+    }
+
+  for (n = 1; n <= 60; n += 11)
+    {
+      gsl_spmatrix *A = create_random_spd(n, 0.05, r);
+      gsl_permutation *p = gsl_permutation_alloc(n);
+      int status;
+
+      status = gsl_splinalg_order_rcm(A, p) || gsl_permutation_valid(p);
+      gsl_test(status, "order_rcm random valid N=%zu", n);
+      test_cholesky_system("random rcm", A, p, 1.0e-10, r);
+
+      status = gsl_splinalg_order_amd(A, p) || gsl_permutation_valid(p);
+      gsl_test(status, "order_amd random valid N=%zu", n);
+      test_cholesky_system("random amd", A, p, 1.0e-10, r);
+
+      status = gsl_splinalg_order_nd(A, p) || gsl_permutation_valid(p);
+      gsl_test(status, "order_nd random valid N=%zu", n);
+      test_cholesky_system("random nd", A, p, 1.0e-10, r);
+
+      gsl_spmatrix_free(A);
+      gsl_permutation_free(p);
+    }
+}
+
 int
 main()
 {
@@ -366,6 +666,9 @@ main()
       test_random(n, r, 1);
     }
 
+  test_cholesky(r);
+  test_order(r);
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary());
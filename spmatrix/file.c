@@ -1,8 +1,267 @@
 #include <config.h>
+#include <stdlib.h>
 #include <stddef.h>
+#include <limits.h>
+#include <string.h>
+#include <ctype.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_errno.h>
 
+#include "mapped.h"
+
+/* round offset up to next multiple of SPMATRIX_MAP_ALIGN */
+static size_t
+spmatrix_map_align(const size_t offset)
+{
+  return (offset + SPMATRIX_MAP_ALIGN - 1) / SPMATRIX_MAP_ALIGN * SPMATRIX_MAP_ALIGN;
+}
+
+/* write zero bytes to advance stream from offset 'from' to offset 'to' */
+static int
+spmatrix_map_pad(FILE * stream, const size_t from, const size_t to)
+{
+  static const char zeros[SPMATRIX_MAP_ALIGN] = { 0 };
+  size_t n = to - from;
+
+  while (n > 0)
+    {
+      size_t nwrite = n < SPMATRIX_MAP_ALIGN ? n : SPMATRIX_MAP_ALIGN;
+
+      if (fwrite(zeros, 1, nwrite, stream) != nwrite)
+        {
+          GSL_ERROR("fwrite failed on padding", GSL_EFAILED);
+        }
+
+      n -= nwrite;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Matrix Market data fields */
+#define SPMATRIX_MM_REAL         0
+#define SPMATRIX_MM_INTEGER      1
+#define SPMATRIX_MM_COMPLEX      2
+#define SPMATRIX_MM_PATTERN      3
+
+typedef struct
+{
+  int field;                          /* SPMATRIX_MM_xxx */
+  int symmetry;                       /* GSL_SPMATRIX_MM_xxx */
+  size_t size1;                       /* number of rows */
+  size_t size2;                       /* number of columns */
+  size_t nz;                          /* number of entries in file */
+  const char *entries;                /* start of entries in buffer */
+} spmatrix_mm_header;
+
+/*
+spmatrix_mm_slurp()
+  Read the remainder of a stream into a newly allocated,
+NUL-terminated buffer, which must be freed by the caller
+*/
+
+static char *
+spmatrix_mm_slurp(FILE * stream)
+{
+  size_t len = 0, size = 65536;
+  char *buf = malloc(size);
+
+  if (buf == NULL)
+    {
+      GSL_ERROR_NULL("failed to allocate buffer", GSL_ENOMEM);
+    }
+
+  while (1)
+    {
+      size_t nread;
+
+      if (size - len < 2)
+        {
+          char *tmp = realloc(buf, 2 * size);
+
+          if (tmp == NULL)
+            {
+              free(buf);
+              GSL_ERROR_NULL("failed to reallocate buffer", GSL_ENOMEM);
+            }
+
+          buf = tmp;
+          size *= 2;
+        }
+
+      nread = fread(buf + len, 1, size - len - 1, stream);
+      len += nread;
+
+      if (nread == 0)
+        break;
+    }
+
+  if (ferror(stream))
+    {
+      free(buf);
+      GSL_ERROR_NULL("fread failed", GSL_EFAILED);
+    }
+
+  buf[len] = '\0';
+
+  return buf;
+}
+
+/* case insensitive comparison of a token with a lower case keyword */
+static int
+spmatrix_mm_keyword(const char * token, const char * keyword)
+{
+  while (*token && *keyword)
+    {
+      if (tolower((unsigned char) *token) != *keyword)
+        return 0;
+
+      ++token;
+      ++keyword;
+    }
+
+  return *token == '\0' && *keyword == '\0';
+}
+
+/* parse an unsigned integer, skipping leading white space; returns 0 on failure */
+static int
+spmatrix_mm_index(const char ** s, size_t * val)
+{
+  const char *p = *s;
+  size_t x = 0;
+
+  while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+    ++p;
+
+  if (*p < '0' || *p > '9')
+    return 0;
+
+  while (*p >= '0' && *p <= '9')
+    {
+      const size_t d = (size_t) (*p++ - '0');
+
+      /* saturate on overflow, so that the caller's range checks reject the value */
+      if (x > ((size_t) -1 - d) / 10)
+        x = (size_t) -1;
+      else
+        x = 10 * x + d;
+    }
+
+  *val = x;
+  *s = p;
+
+  return 1;
+}
+
+/*
+spmatrix_mm_header_parse()
+  Parse the banner, comments and size line of a Matrix Market
+coordinate file
+
+Inputs: buf - NUL-terminated file contents
+        h   - (output) header information
+
+Return: success/error
+
+Notes:
+1) if the banner is missing, the file is assumed to be in the
+"coordinate real general" format written by gsl_spmatrix_fprintf()
+*/
+
+static int
+spmatrix_mm_header_parse(const char * buf, spmatrix_mm_header * h)
+{
+  const char *s = buf;
+
+  h->field = SPMATRIX_MM_REAL;
+  h->symmetry = GSL_SPMATRIX_MM_GENERAL;
+
+  if (strncmp(s, "%%MatrixMarket", 14) == 0)
+    {
+      char object[16], format[16], field[16], symmetry[16];
+      int c = sscanf(s + 14, "%15s %15s %15s %15s", object, format, field, symmetry);
+
+      if (c != 4)
+        {
+          GSL_ERROR("invalid Matrix Market banner", GSL_EFAILED);
+        }
+      else if (!spmatrix_mm_keyword(object, "matrix"))
+        {
+          GSL_ERROR("Matrix Market object must be 'matrix'", GSL_EFAILED);
+        }
+      else if (!spmatrix_mm_keyword(format, "coordinate"))
+        {
+          GSL_ERROR("only Matrix Market coordinate format is supported", GSL_EUNIMPL);
+        }
+
+      if (spmatrix_mm_keyword(field, "real") || spmatrix_mm_keyword(field, "double"))
+        h->field = SPMATRIX_MM_REAL;
+      else if (spmatrix_mm_keyword(field, "integer"))
+        h->field = SPMATRIX_MM_INTEGER;
+      else if (spmatrix_mm_keyword(field, "complex"))
+        h->field = SPMATRIX_MM_COMPLEX;
+      else if (spmatrix_mm_keyword(field, "pattern"))
+        h->field = SPMATRIX_MM_PATTERN;
+      else
+        {
+          GSL_ERROR("unknown Matrix Market field", GSL_EFAILED);
+        }
+
+      if (spmatrix_mm_keyword(symmetry, "general"))
+        h->symmetry = GSL_SPMATRIX_MM_GENERAL;
+      else if (spmatrix_mm_keyword(symmetry, "symmetric"))
+        h->symmetry = GSL_SPMATRIX_MM_SYMMETRIC;
+      else if (spmatrix_mm_keyword(symmetry, "skew-symmetric"))
+        h->symmetry = GSL_SPMATRIX_MM_SKEW_SYMMETRIC;
+      else if (spmatrix_mm_keyword(symmetry, "hermitian"))
+        h->symmetry = GSL_SPMATRIX_MM_HERMITIAN;
+      else
+        {
+          GSL_ERROR("unknown Matrix Market symmetry", GSL_EFAILED);
+        }
+    }
+
+  /* skip comments and blank lines */
+  while (*s == '%' || *s == '\n' || *s == '\r' || *s == ' ' || *s == '\t')
+    {
+      if (*s == '%')
+        {
+          while (*s != '\n' && *s != '\0')
+            ++s;
+        }
+      else
+        {
+          ++s;
+        }
+    }
+
+  if (!spmatrix_mm_index(&s, &(h->size1)) ||
+      !spmatrix_mm_index(&s, &(h->size2)) ||
+      !spmatrix_mm_index(&s, &(h->nz)))
+    {
+      GSL_ERROR("failed reading size line", GSL_EFAILED);
+    }
+
+  if (h->symmetry != GSL_SPMATRIX_MM_GENERAL && h->size1 != h->size2)
+    {
+      GSL_ERROR("symmetric matrix must be square", GSL_ENOTSQR);
+    }
+
+  /* indices are stored as int; off-diagonal entries of symmetric matrices are stored twice */
+  if (h->size1 > INT_MAX || h->size2 > INT_MAX)
+    {
+      GSL_ERROR("matrix dimensions exceed INT_MAX", GSL_EOVRFLW);
+    }
+  else if (h->nz > (h->symmetry == GSL_SPMATRIX_MM_GENERAL ? INT_MAX : INT_MAX / 2))
+    {
+      GSL_ERROR("number of non-zero elements exceeds INT_MAX", GSL_EOVRFLW);
+    }
+
+  h->entries = s;
+
+  return GSL_SUCCESS;
+}
+
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "file_source.c"
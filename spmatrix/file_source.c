@@ -291,6 +291,470 @@ FUNCTION (gsl_spmatrix, fscanf) (FILE * stream)
   return m;
 }
 
+/* parse a single floating point value, advancing *s; returns 0 on failure */
+static int
+FUNCTION (spmatrix_mm, value) (const char ** s, ATOMIC * x)
+{
+#if defined(BASE_LONG_DOUBLE) || defined(BASE_GSL_COMPLEX_LONG)
+  ATOMIC_IO tmp;
+  int nread = 0;
+
+  if (sscanf(*s, IN_FORMAT "%n", &tmp, &nread) < 1 || nread == 0)
+    return 0;
+
+  *x = (ATOMIC) tmp;
+  *s += nread;
+#else
+  char *end;
+  double tmp = strtod(*s, &end);
+
+  if (end == *s)
+    return 0;
+
+  *x = (ATOMIC) tmp;
+  *s = end;
+#endif
+
+  return 1;
+}
+
+/*
+gsl_spmatrix_fscanf_mm()
+  Read a sparse matrix in Matrix Market coordinate format
+
+Inputs: stream - input stream
+        sptype - storage format of output matrix (GSL_SPMATRIX_COO,
+                 GSL_SPMATRIX_CSC or GSL_SPMATRIX_CSR)
+
+Return: pointer to newly allocated matrix
+
+Notes:
+1) The entire stream is read into memory and parsed in a single pass,
+then the compressed matrix is assembled directly with a counting sort,
+so the cost is O(nnz + size1 + size2) rather than the O(nnz log nnz)
+binary tree insertions of gsl_spmatrix_fscanf()
+
+2) symmetric, skew-symmetric and hermitian matrices are expanded to
+full storage; pattern matrices have all stored values set to 1
+
+3) duplicate entries are summed
+
+4) dimensions or a number of entries which do not fit in an int are
+rejected with GSL_EOVRFLW, and indices outside [1,size1] x [1,size2]
+with GSL_EINVAL
+*/
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, fscanf_mm) (FILE * stream, const int sptype)
+{
+  int status;
+  char *buf;
+  spmatrix_mm_header h;
+  TYPE (gsl_spmatrix) * m;
+  int *Ti, *Tj;
+  ATOMIC *Tx;
+  size_t ntrip = 0, k, r;
+  const char *s;
+
+  if (sptype != GSL_SPMATRIX_COO && sptype != GSL_SPMATRIX_CSC && sptype != GSL_SPMATRIX_CSR)
+    {
+      GSL_ERROR_NULL("unknown sparse matrix type", GSL_EINVAL);
+    }
+
+  buf = spmatrix_mm_slurp(stream);
+  if (buf == NULL)
+    return NULL;
+
+  status = spmatrix_mm_header_parse(buf, &h);
+  if (status)
+    {
+      free(buf);
+      return NULL;
+    }
+
+#if !(defined(BASE_GSL_COMPLEX_LONG) || defined(BASE_GSL_COMPLEX) || defined(BASE_GSL_COMPLEX_FLOAT))
+  if (h.field == SPMATRIX_MM_COMPLEX)
+    {
+      free(buf);
+      GSL_ERROR_NULL("cannot read complex data into real matrix", GSL_EINVAL);
+    }
+#endif
+
+  {
+    /* off-diagonal entries of symmetric matrices are stored twice */
+    const size_t nmax = (h.symmetry == GSL_SPMATRIX_MM_GENERAL) ? h.nz : 2 * h.nz;
+
+    Ti = malloc(GSL_MAX(nmax, 1) * sizeof(int));
+    Tj = malloc(GSL_MAX(nmax, 1) * sizeof(int));
+    Tx = malloc(GSL_MAX(nmax, 1) * MULTIPLICITY * sizeof(ATOMIC));
+  }
+
+  if (Ti == NULL || Tj == NULL || Tx == NULL)
+    {
+      free(buf);
+      if (Ti)
+        free(Ti);
+      if (Tj)
+        free(Tj);
+      if (Tx)
+        free(Tx);
+      GSL_ERROR_NULL("failed to allocate triplet arrays", GSL_ENOMEM);
+    }
+
+  /* parse entries */
+  s = h.entries;
+  for (k = 0; k < h.nz; ++k)
+    {
+      size_t i, j;
+      ATOMIC x[2] = { (ATOMIC) 0, (ATOMIC) 0 };
+      int ok = spmatrix_mm_index(&s, &i) && spmatrix_mm_index(&s, &j);
+
+      if (ok)
+        {
+          if (h.field == SPMATRIX_MM_PATTERN)
+            x[0] = (ATOMIC) 1;
+          else if (h.field == SPMATRIX_MM_COMPLEX)
+            ok = FUNCTION (spmatrix_mm, value) (&s, &x[0]) && FUNCTION (spmatrix_mm, value) (&s, &x[1]);
+          else
+            ok = FUNCTION (spmatrix_mm, value) (&s, &x[0]);
+        }
+
+      if (!ok)
+        {
+          free(buf);
+          free(Ti);
+          free(Tj);
+          free(Tx);
+          GSL_ERROR_NULL ("error in input file format", GSL_EFAILED);
+        }
+      else if (i == 0 || j == 0 || i > h.size1 || j > h.size2)
+        {
+          free(buf);
+          free(Ti);
+          free(Tj);
+          free(Tx);
+          GSL_ERROR_NULL ("matrix index out of range", GSL_EINVAL);
+        }
+
+      /* subtract 1 from (i,j) since indexing starts at 1 */
+      Ti[ntrip] = (int) i - 1;
+      Tj[ntrip] = (int) j - 1;
+      for (r = 0; r < MULTIPLICITY; ++r)
+        Tx[MULTIPLICITY * ntrip + r] = x[r];
+      ++ntrip;
+
+      if (h.symmetry != GSL_SPMATRIX_MM_GENERAL && i != j)
+        {
+          Ti[ntrip] = (int) j - 1;
+          Tj[ntrip] = (int) i - 1;
+
+          if (h.symmetry == GSL_SPMATRIX_MM_SKEW_SYMMETRIC)
+            {
+              for (r = 0; r < MULTIPLICITY; ++r)
+                Tx[MULTIPLICITY * ntrip + r] = -x[r];
+            }
+          else
+            {
+              Tx[MULTIPLICITY * ntrip] = x[0];
+
+#if defined(BASE_GSL_COMPLEX_LONG) || defined(BASE_GSL_COMPLEX) || defined(BASE_GSL_COMPLEX_FLOAT)
+              Tx[MULTIPLICITY * ntrip + 1] = (h.symmetry == GSL_SPMATRIX_MM_HERMITIAN) ? -x[1] : x[1];
+#endif
+            }
+
+          ++ntrip;
+        }
+    }
+
+  free(buf);
+
+  /* assemble compressed matrix; COO output is assembled in CSR and converted */
+  m = FUNCTION (gsl_spmatrix, alloc_nzmax) (h.size1, h.size2, GSL_MAX(ntrip, 1),
+                                            (sptype == GSL_SPMATRIX_CSC) ? GSL_SPMATRIX_CSC : GSL_SPMATRIX_CSR);
+  if (m == NULL)
+    {
+      free(Ti);
+      free(Tj);
+      free(Tx);
+      GSL_ERROR_NULL("failed to allocate matrix", GSL_ENOMEM);
+    }
+
+  {
+    /* outer index is the column for CSC and the row for CSR */
+    const int *outer = GSL_SPMATRIX_ISCSC(m) ? Tj : Ti;
+    const int *inner = GSL_SPMATRIX_ISCSC(m) ? Ti : Tj;
+    const size_t nouter = GSL_SPMATRIX_ISCSC(m) ? h.size2 : h.size1;
+    const size_t ninner = GSL_SPMATRIX_ISCSC(m) ? h.size1 : h.size2;
+    int *Cp = m->p;
+    int *Ci = m->i;
+    ATOMIC *Cx = m->data;
+    int *w = m->work.work_int;
+    int nz = 0;
+    size_t j;
+
+    for (j = 0; j <= nouter; ++j)
+      Cp[j] = 0;
+
+    for (k = 0; k < ntrip; ++k)
+      Cp[outer[k]]++;
+
+    gsl_spmatrix_cumsum(nouter, Cp);
+
+    for (j = 0; j < nouter; ++j)
+      w[j] = Cp[j];
+
+    /* scatter triplets into compressed storage */
+    for (k = 0; k < ntrip; ++k)
+      {
+        int q = w[outer[k]]++;
+
+        Ci[q] = inner[k];
+        for (r = 0; r < MULTIPLICITY; ++r)
+          Cx[MULTIPLICITY * q + r] = Tx[MULTIPLICITY * k + r];
+      }
+
+    /* sum duplicate entries; w[i] is the position of inner index i in the current column/row */
+    for (j = 0; j < ninner; ++j)
+      w[j] = -1;
+
+    for (j = 0; j < nouter; ++j)
+      {
+        const int q0 = nz;
+        int q;
+
+        for (q = Cp[j]; q < Cp[j + 1]; ++q)
+          {
+            int i = Ci[q];
+
+            if (w[i] >= q0)
+              {
+                for (r = 0; r < MULTIPLICITY; ++r)
+                  Cx[MULTIPLICITY * w[i] + r] += Cx[MULTIPLICITY * q + r];
+              }
+            else
+              {
+                w[i] = nz;
+                Ci[nz] = i;
+                for (r = 0; r < MULTIPLICITY; ++r)
+                  Cx[MULTIPLICITY * nz + r] = Cx[MULTIPLICITY * q + r];
+                ++nz;
+              }
+          }
+
+        Cp[j] = q0;
+      }
+
+    Cp[nouter] = nz;
+    m->nz = (size_t) nz;
+  }
+
+  free(Ti);
+  free(Tj);
+  free(Tx);
+
+  if (sptype == GSL_SPMATRIX_COO)
+    {
+      TYPE (gsl_spmatrix) * C = FUNCTION (gsl_spmatrix, alloc_nzmax) (h.size1, h.size2, GSL_MAX(m->nz, 1), GSL_SPMATRIX_COO);
+      size_t i;
+      int q;
+
+      if (C == NULL)
+        {
+          FUNCTION (gsl_spmatrix, free) (m);
+          GSL_ERROR_NULL("failed to allocate matrix", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < h.size1; ++i)
+        {
+          for (q = m->p[i]; q < m->p[i + 1]; ++q)
+            {
+              C->i[q] = (int) i;
+              C->p[q] = m->i[q];
+              for (r = 0; r < MULTIPLICITY; ++r)
+                C->data[MULTIPLICITY * q + r] = m->data[MULTIPLICITY * q + r];
+            }
+        }
+
+      C->nz = m->nz;
+      FUNCTION (gsl_spmatrix, free) (m);
+
+      status = FUNCTION (gsl_spmatrix, tree_rebuild) (C);
+      if (status)
+        {
+          FUNCTION (gsl_spmatrix, free) (C);
+          return NULL;
+        }
+
+      return C;
+    }
+
+  return m;
+}
+
+/*
+gsl_spmatrix_fprintf_mm()
+  Write a sparse matrix in Matrix Market coordinate format
+
+Inputs: stream   - output stream
+        m        - sparse matrix
+        format   - format specifier for matrix elements
+        symmetry - GSL_SPMATRIX_MM_GENERAL: write all elements
+                   GSL_SPMATRIX_MM_SYMMETRIC: write lower triangle
+                   GSL_SPMATRIX_MM_SKEW_SYMMETRIC: write strict lower triangle
+                   GSL_SPMATRIX_MM_HERMITIAN: write lower triangle (complex only)
+
+Return: success/error
+
+Notes:
+1) the matrix is assumed to have the given symmetry, which is not checked
+*/
+
+int
+FUNCTION (gsl_spmatrix, fprintf_mm) (FILE * stream, const TYPE (gsl_spmatrix) * m,
+                                      const char * format, const int symmetry)
+{
+#if defined(BASE_GSL_COMPLEX_LONG) || defined(BASE_GSL_COMPLEX) || defined(BASE_GSL_COMPLEX_FLOAT)
+  const char *field = "complex";
+#elif defined(FP)
+  const char *field = "real";
+#else
+  const char *field = "integer";
+#endif
+  const char *symname[] = { "general", "symmetric", "skew-symmetric", "hermitian" };
+
+  if (symmetry < GSL_SPMATRIX_MM_GENERAL || symmetry > GSL_SPMATRIX_MM_HERMITIAN)
+    {
+      GSL_ERROR("unknown symmetry type", GSL_EINVAL);
+    }
+  else if (symmetry != GSL_SPMATRIX_MM_GENERAL && m->size1 != m->size2)
+    {
+      GSL_ERROR("symmetric matrix must be square", GSL_ENOTSQR);
+    }
+#if !(defined(BASE_GSL_COMPLEX_LONG) || defined(BASE_GSL_COMPLEX) || defined(BASE_GSL_COMPLEX_FLOAT))
+  else if (symmetry == GSL_SPMATRIX_MM_HERMITIAN)
+    {
+      GSL_ERROR("hermitian symmetry requires complex matrix", GSL_EINVAL);
+    }
+#endif
+  else if (!GSL_SPMATRIX_ISCOO(m) && !GSL_SPMATRIX_ISCSC(m) && !GSL_SPMATRIX_ISCSR(m))
+    {
+      GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+    }
+  else
+    {
+      /* for COO, each outer loop iteration processes one element */
+      const size_t nouter = GSL_SPMATRIX_ISCOO(m) ? m->nz : (GSL_SPMATRIX_ISCSC(m) ? m->size2 : m->size1);
+      size_t pass, nwrite = 0, k;
+      int status;
+
+      status = fprintf(stream, "%%%%MatrixMarket matrix coordinate %s %s\n", field, symname[symmetry]);
+      if (status < 0)
+        {
+          GSL_ERROR("fprintf failed for header", GSL_EFAILED);
+        }
+
+      /* pass 0 counts the elements to write, pass 1 writes them */
+      for (pass = 0; pass < 2; ++pass)
+        {
+          if (pass == 1)
+            {
+              status = fprintf(stream, "%u\t%u\t%u\n",
+                               (unsigned int) m->size1,
+                               (unsigned int) m->size2,
+                               (unsigned int) nwrite);
+              if (status < 0)
+                {
+                  GSL_ERROR("fprintf failed for dimension header", GSL_EFAILED);
+                }
+            }
+
+          for (k = 0; k < nouter; ++k)
+            {
+              int q, qstart, qend;
+
+              if (GSL_SPMATRIX_ISCOO(m))
+                {
+                  qstart = (int) k;
+                  qend = qstart + 1;
+                }
+              else
+                {
+                  qstart = m->p[k];
+                  qend = m->p[k + 1];
+                }
+
+              for (q = qstart; q < qend; ++q)
+                {
+                  int i, j;
+
+                  if (GSL_SPMATRIX_ISCOO(m))
+                    {
+                      i = m->i[q];
+                      j = m->p[q];
+                    }
+                  else if (GSL_SPMATRIX_ISCSC(m))
+                    {
+                      i = m->i[q];
+                      j = (int) k;
+                    }
+                  else
+                    {
+                      i = (int) k;
+                      j = m->i[q];
+                    }
+
+                  /* only the lower triangle is stored for symmetric matrices */
+                  if (symmetry != GSL_SPMATRIX_MM_GENERAL &&
+                      (i < j || (i == j && symmetry == GSL_SPMATRIX_MM_SKEW_SYMMETRIC)))
+                    continue;
+
+                  if (pass == 0)
+                    {
+                      ++nwrite;
+                      continue;
+                    }
+
+                  status = fprintf(stream, "%d\t%d\t", i + 1, j + 1);
+                  if (status < 0)
+                    {
+                      GSL_ERROR("fprintf failed", GSL_EFAILED);
+                    }
+
+                  status = fprintf(stream, format, m->data[MULTIPLICITY * q]);
+                  if (status < 0)
+                    {
+                      GSL_ERROR("fprintf failed", GSL_EFAILED);
+                    }
+
+#if defined(BASE_GSL_COMPLEX_LONG) || defined(BASE_GSL_COMPLEX) || defined(BASE_GSL_COMPLEX_FLOAT)
+
+                  status = putc('\t', stream);
+                  if (status == EOF)
+                    {
+                      GSL_ERROR("putc failed", GSL_EFAILED);
+                    }
+
+                  status = fprintf(stream, format, m->data[MULTIPLICITY * q + 1]);
+                  if (status < 0)
+                    {
+                      GSL_ERROR("fprintf failed", GSL_EFAILED);
+                    }
+
+#endif
+
+                  status = putc('\n', stream);
+                  if (status == EOF)
+                    {
+                      GSL_ERROR("putc failed", GSL_EFAILED);
+                    }
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
 int
 FUNCTION (gsl_spmatrix, fwrite) (FILE * stream, const TYPE (gsl_spmatrix) * m)
 {
@@ -445,3 +909,211 @@ FUNCTION (gsl_spmatrix, fread) (FILE * stream, TYPE (gsl_spmatrix) * m)
 
   return GSL_SUCCESS;
 }
+
+/*
+gsl_spmatrix_fwrite_mapped()
+  Write a compressed sparse matrix to a binary stream in a
+layout suitable for memory mapping with gsl_spmatrix_const_view_mapped()
+
+Inputs: stream - output stream
+        m      - sparse matrix in CSC or CSR format
+
+Return: success/error
+
+Notes:
+1) the header records the format version, byte order, element type
+and the sizes of the native types; the arrays p, i and data are
+aligned to SPMATRIX_MAP_ALIGN bytes relative to the start of the file
+*/
+
+int
+FUNCTION (gsl_spmatrix, fwrite_mapped) (FILE * stream, const TYPE (gsl_spmatrix) * m)
+{
+  if (!GSL_SPMATRIX_ISCSC(m) && !GSL_SPMATRIX_ISCSR(m))
+    {
+      GSL_ERROR("mapped format requires CSC or CSR storage", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t np = (GSL_SPMATRIX_ISCSC(m) ? m->size2 : m->size1) + 1;
+      spmatrix_map_header h;
+      size_t items;
+      int status;
+
+      memset(&h, 0, sizeof(spmatrix_map_header));
+      memcpy(h.magic, SPMATRIX_MAP_MAGIC, sizeof(h.magic));
+      strncpy(h.type, NAME (gsl_spmatrix), SPMATRIX_MAP_TYPELEN - 1);
+
+      h.sizes[0] = (unsigned char) sizeof(size_t);
+      h.sizes[1] = (unsigned char) sizeof(int);
+      h.sizes[2] = (unsigned char) sizeof(ATOMIC);
+      h.sizes[3] = (unsigned char) MULTIPLICITY;
+
+      h.byteorder = SPMATRIX_MAP_BYTEORDER;
+      h.version = SPMATRIX_MAP_VERSION;
+      h.sptype = (size_t) m->sptype;
+      h.size1 = m->size1;
+      h.size2 = m->size2;
+      h.nz = m->nz;
+      h.offset_p = spmatrix_map_align(sizeof(spmatrix_map_header));
+      h.offset_i = spmatrix_map_align(h.offset_p + np * sizeof(int));
+      h.offset_data = spmatrix_map_align(h.offset_i + m->nz * sizeof(int));
+      h.length = h.offset_data + m->nz * MULTIPLICITY * sizeof(ATOMIC);
+
+      items = fwrite(&h, sizeof(spmatrix_map_header), 1, stream);
+      if (items != 1)
+        {
+          GSL_ERROR("fwrite failed on header", GSL_EFAILED);
+        }
+
+      status = spmatrix_map_pad(stream, sizeof(spmatrix_map_header), h.offset_p);
+      if (status)
+        return status;
+
+      items = fwrite(m->p, sizeof(int), np, stream);
+      if (items != np)
+        {
+          GSL_ERROR("fwrite failed on pointers", GSL_EFAILED);
+        }
+
+      status = spmatrix_map_pad(stream, h.offset_p + np * sizeof(int), h.offset_i);
+      if (status)
+        return status;
+
+      items = fwrite(m->i, sizeof(int), m->nz, stream);
+      if (items != m->nz)
+        {
+          GSL_ERROR("fwrite failed on indices", GSL_EFAILED);
+        }
+
+      status = spmatrix_map_pad(stream, h.offset_i + m->nz * sizeof(int), h.offset_data);
+      if (status)
+        return status;
+
+      items = fwrite(m->data, MULTIPLICITY * sizeof(ATOMIC), m->nz, stream);
+      if (items != m->nz)
+        {
+          GSL_ERROR("fwrite failed on data", GSL_EFAILED);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_spmatrix_const_view_mapped()
+  Construct a read-only view of a sparse matrix stored in memory
+in the format written by gsl_spmatrix_fwrite_mapped()
+
+Inputs: base - pointer to start of matrix image, typically obtained
+               by memory mapping a file
+        len  - length of memory region in bytes
+
+Return: view of sparse matrix; the arrays of the matrix point directly
+into the memory region, and no data is copied
+
+Notes:
+1) the header is validated, but the indices are not, so that the pages
+of a large mapping are only touched when they are accessed
+
+2) the view has no workspace or binary tree, so it may only be used in
+read-only operations which do not require workspace of the input matrix
+*/
+
+VIEW (_gsl_spmatrix, const_view)
+FUNCTION (gsl_spmatrix, const_view_mapped) (const void * base, const size_t len)
+{
+  VIEW (_gsl_spmatrix, const_view) view;
+  const char * ptr = (const char *) base;
+  spmatrix_map_header h;
+
+  memset(&view, 0, sizeof(view));
+
+  if (len < sizeof(spmatrix_map_header))
+    {
+      GSL_ERROR_VAL("memory region too small for header", GSL_EBADLEN, view);
+    }
+
+  memcpy(&h, base, sizeof(spmatrix_map_header));
+
+  if (memcmp(h.magic, SPMATRIX_MAP_MAGIC, sizeof(h.magic)) != 0)
+    {
+      GSL_ERROR_VAL("not a mapped sparse matrix", GSL_EINVAL, view);
+    }
+  else if (h.sizes[0] != sizeof(size_t) || h.sizes[1] != sizeof(int) ||
+           h.byteorder != SPMATRIX_MAP_BYTEORDER)
+    {
+      GSL_ERROR_VAL("matrix was written on an incompatible platform", GSL_EINVAL, view);
+    }
+  else if (h.version != SPMATRIX_MAP_VERSION)
+    {
+      GSL_ERROR_VAL("unsupported mapped format version", GSL_EINVAL, view);
+    }
+  else if (strncmp(h.type, NAME (gsl_spmatrix), SPMATRIX_MAP_TYPELEN) != 0 ||
+           h.sizes[2] != sizeof(ATOMIC) || h.sizes[3] != MULTIPLICITY)
+    {
+      GSL_ERROR_VAL("matrix element type does not match", GSL_EINVAL, view);
+    }
+  else if (h.sptype != GSL_SPMATRIX_CSC && h.sptype != GSL_SPMATRIX_CSR)
+    {
+      GSL_ERROR_VAL("unknown sparse matrix type", GSL_EINVAL, view);
+    }
+  else
+    {
+      const size_t np = (h.sptype == GSL_SPMATRIX_CSC ? h.size2 : h.size1) + 1;
+      TYPE (gsl_spmatrix) * m = &(view.matrix);
+
+      /* the arrays must lie in order within [sizeof(header), length]; the
+       * sizes are compared against the gaps between offsets by division
+       * so that corrupt values cannot cause an overflow */
+      if (h.length > len ||
+          h.offset_p < sizeof(spmatrix_map_header) ||
+          h.offset_i < h.offset_p ||
+          h.offset_data < h.offset_i ||
+          h.length < h.offset_data ||
+          np == 0 ||
+          np > (h.offset_i - h.offset_p) / sizeof(int) ||
+          h.nz > (h.offset_data - h.offset_i) / sizeof(int) ||
+          h.nz > (h.length - h.offset_data) / (MULTIPLICITY * sizeof(ATOMIC)))
+        {
+          GSL_ERROR_VAL("memory region is truncated or corrupt", GSL_EBADLEN, view);
+        }
+
+      if (h.offset_p % SPMATRIX_MAP_ALIGN != 0 ||
+          h.offset_i % SPMATRIX_MAP_ALIGN != 0 ||
+          h.offset_data % SPMATRIX_MAP_ALIGN != 0)
+        {
+          GSL_ERROR_VAL("array offsets are not aligned", GSL_EINVAL, view);
+        }
+
+      m->p = (int *) (ptr + h.offset_p);
+      m->i = (int *) (ptr + h.offset_i);
+      m->data = (ATOMIC *) (ptr + h.offset_data);
+
+      if ((size_t) m->p % sizeof(int) != 0 ||
+          (size_t) m->data % sizeof(ATOMIC) != 0)
+        {
+          memset(&view, 0, sizeof(view));
+          GSL_ERROR_VAL("memory region is not suitably aligned", GSL_EINVAL, view);
+        }
+
+      if (m->p[0] != 0 || m->p[np - 1] != (int) h.nz)
+        {
+          memset(&view, 0, sizeof(view));
+          GSL_ERROR_VAL("inconsistent number of non-zero elements", GSL_EINVAL, view);
+        }
+
+      m->size1 = h.size1;
+      m->size2 = h.size2;
+      m->nz = h.nz;
+      m->nzmax = h.nz;
+      m->sptype = (int) h.sptype;
+      m->spflags = GSL_SPMATRIX_FLG_FIXED;
+      m->tree = NULL;
+      m->pool = NULL;
+      m->node_size = 0;
+      m->work.work_void = NULL;
+
+      return view;
+    }
+}
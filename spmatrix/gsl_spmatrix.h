@@ -32,6 +32,12 @@ typedef struct gsl_spmatrix_pool_node gsl_spmatrix_pool;
 #define GSL_SPMATRIX_FLG_GROW         (1 << 0) /* allow size of matrix to grow as elements are added */
 #define GSL_SPMATRIX_FLG_FIXED        (1 << 1) /* sparsity pattern is fixed */
 
+/* Matrix Market symmetry types */
+#define GSL_SPMATRIX_MM_GENERAL         0
+#define GSL_SPMATRIX_MM_SYMMETRIC       1
+#define GSL_SPMATRIX_MM_SKEW_SYMMETRIC  2
+#define GSL_SPMATRIX_MM_HERMITIAN       3
+
 /* compare matrix entries (ia,ja) and (ib,jb) - sort by rows first, then by columns */
 #define GSL_SPMATRIX_COMPARE_ROWCOL(m,ia,ja,ib,jb)   ((ia) < (ib) ? -1 : ((ia) > (ib) ? 1 : ((ja) < (jb) ? -1 : ((ja) > (jb)))))
 
@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_char.h>
 #include <gsl/gsl_matrix_char.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_char;
 
+typedef struct
+{
+  gsl_spmatrix_char matrix;
+} _gsl_spmatrix_char_const_view;
+
+typedef const _gsl_spmatrix_char_const_view gsl_spmatrix_char_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_char_memcpy (gsl_spmatrix_char * dest, const gsl_spmatrix_char
 
 int gsl_spmatrix_char_fprintf (FILE * stream, const gsl_spmatrix_char * m, const char * format);
 gsl_spmatrix_char * gsl_spmatrix_char_fscanf (FILE * stream);
+gsl_spmatrix_char * gsl_spmatrix_char_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_char_fprintf_mm (FILE * stream, const gsl_spmatrix_char * m, const char * format, const int symmetry);
 int gsl_spmatrix_char_fwrite (FILE * stream, const gsl_spmatrix_char * m);
 int gsl_spmatrix_char_fread (FILE * stream, gsl_spmatrix_char * m);
+int gsl_spmatrix_char_fwrite_mapped (FILE * stream, const gsl_spmatrix_char * m);
+_gsl_spmatrix_char_const_view gsl_spmatrix_char_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_char_add_to_dense (gsl_matrix_char * a, const gsl_spmatrix_char
 /* properties */
 
 int gsl_spmatrix_char_equal (const gsl_spmatrix_char * a, const gsl_spmatrix_char * b);
+int gsl_spmatrix_char_bandwidth (const gsl_spmatrix_char * m, size_t * lower, size_t * upper);
 char gsl_spmatrix_char_norm1 (const gsl_spmatrix_char * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_char_transpose (gsl_spmatrix_char * m);
 int gsl_spmatrix_char_transpose2 (gsl_spmatrix_char * m);
 int gsl_spmatrix_char_transpose_memcpy (gsl_spmatrix_char * dest, const gsl_spmatrix_char * src);
 
+/* permute */
+
+int gsl_spmatrix_char_permute_sym (gsl_spmatrix_char * dest, const gsl_spmatrix_char * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_CHAR_H__ */
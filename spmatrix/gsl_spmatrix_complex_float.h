@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_complex_float.h>
 #include <gsl/gsl_matrix_complex_float.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_complex_float;
 
+typedef struct
+{
+  gsl_spmatrix_complex_float matrix;
+} _gsl_spmatrix_complex_float_const_view;
+
+typedef const _gsl_spmatrix_complex_float_const_view gsl_spmatrix_complex_float_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_complex_float_memcpy (gsl_spmatrix_complex_float * dest, const
 
 int gsl_spmatrix_complex_float_fprintf (FILE * stream, const gsl_spmatrix_complex_float * m, const char * format);
 gsl_spmatrix_complex_float * gsl_spmatrix_complex_float_fscanf (FILE * stream);
+gsl_spmatrix_complex_float * gsl_spmatrix_complex_float_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_complex_float_fprintf_mm (FILE * stream, const gsl_spmatrix_complex_float * m, const char * format, const int symmetry);
 int gsl_spmatrix_complex_float_fwrite (FILE * stream, const gsl_spmatrix_complex_float * m);
 int gsl_spmatrix_complex_float_fread (FILE * stream, gsl_spmatrix_complex_float * m);
+int gsl_spmatrix_complex_float_fwrite_mapped (FILE * stream, const gsl_spmatrix_complex_float * m);
+_gsl_spmatrix_complex_float_const_view gsl_spmatrix_complex_float_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -167,6 +179,7 @@ int gsl_spmatrix_complex_float_add_to_dense (gsl_matrix_complex_float * a, const
 /* properties */
 
 int gsl_spmatrix_complex_float_equal (const gsl_spmatrix_complex_float * a, const gsl_spmatrix_complex_float * b);
+int gsl_spmatrix_complex_float_bandwidth (const gsl_spmatrix_complex_float * m, size_t * lower, size_t * upper);
 
 /* swap */
 
@@ -174,6 +187,10 @@ int gsl_spmatrix_complex_float_transpose (gsl_spmatrix_complex_float * m);
 int gsl_spmatrix_complex_float_transpose2 (gsl_spmatrix_complex_float * m);
 int gsl_spmatrix_complex_float_transpose_memcpy (gsl_spmatrix_complex_float * dest, const gsl_spmatrix_complex_float * src);
 
+/* permute */
+
+int gsl_spmatrix_complex_float_permute_sym (gsl_spmatrix_complex_float * dest, const gsl_spmatrix_complex_float * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_COMPLEX_FLOAT_H__ */
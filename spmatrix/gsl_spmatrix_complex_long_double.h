@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_complex_long_double.h>
 #include <gsl/gsl_matrix_complex_long_double.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_complex_long_double;
 
+typedef struct
+{
+  gsl_spmatrix_complex_long_double matrix;
+} _gsl_spmatrix_complex_long_double_const_view;
+
+typedef const _gsl_spmatrix_complex_long_double_const_view gsl_spmatrix_complex_long_double_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_complex_long_double_memcpy (gsl_spmatrix_complex_long_double *
 
 int gsl_spmatrix_complex_long_double_fprintf (FILE * stream, const gsl_spmatrix_complex_long_double * m, const char * format);
 gsl_spmatrix_complex_long_double * gsl_spmatrix_complex_long_double_fscanf (FILE * stream);
+gsl_spmatrix_complex_long_double * gsl_spmatrix_complex_long_double_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_complex_long_double_fprintf_mm (FILE * stream, const gsl_spmatrix_complex_long_double * m, const char * format, const int symmetry);
 int gsl_spmatrix_complex_long_double_fwrite (FILE * stream, const gsl_spmatrix_complex_long_double * m);
 int gsl_spmatrix_complex_long_double_fread (FILE * stream, gsl_spmatrix_complex_long_double * m);
+int gsl_spmatrix_complex_long_double_fwrite_mapped (FILE * stream, const gsl_spmatrix_complex_long_double * m);
+_gsl_spmatrix_complex_long_double_const_view gsl_spmatrix_complex_long_double_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -167,6 +179,7 @@ int gsl_spmatrix_complex_long_double_add_to_dense (gsl_matrix_complex_long_doubl
 /* properties */
 
 int gsl_spmatrix_complex_long_double_equal (const gsl_spmatrix_complex_long_double * a, const gsl_spmatrix_complex_long_double * b);
+int gsl_spmatrix_complex_long_double_bandwidth (const gsl_spmatrix_complex_long_double * m, size_t * lower, size_t * upper);
 
 /* swap */
 
@@ -174,6 +187,10 @@ int gsl_spmatrix_complex_long_double_transpose (gsl_spmatrix_complex_long_double
 int gsl_spmatrix_complex_long_double_transpose2 (gsl_spmatrix_complex_long_double * m);
 int gsl_spmatrix_complex_long_double_transpose_memcpy (gsl_spmatrix_complex_long_double * dest, const gsl_spmatrix_complex_long_double * src);
 
+/* permute */
+
+int gsl_spmatrix_complex_long_double_permute_sym (gsl_spmatrix_complex_long_double * dest, const gsl_spmatrix_complex_long_double * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_COMPLEX_LONG_DOUBLE_H__ */
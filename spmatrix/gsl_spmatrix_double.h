@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_double.h>
 #include <gsl/gsl_matrix_double.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix;
 
+typedef struct
+{
+  gsl_spmatrix matrix;
+} _gsl_spmatrix_const_view;
+
+typedef const _gsl_spmatrix_const_view gsl_spmatrix_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_memcpy (gsl_spmatrix * dest, const gsl_spmatrix * src);
 
 int gsl_spmatrix_fprintf (FILE * stream, const gsl_spmatrix * m, const char * format);
 gsl_spmatrix * gsl_spmatrix_fscanf (FILE * stream);
+gsl_spmatrix * gsl_spmatrix_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_fprintf_mm (FILE * stream, const gsl_spmatrix * m, const char * format, const int symmetry);
 int gsl_spmatrix_fwrite (FILE * stream, const gsl_spmatrix * m);
 int gsl_spmatrix_fread (FILE * stream, gsl_spmatrix * m);
+int gsl_spmatrix_fwrite_mapped (FILE * stream, const gsl_spmatrix * m);
+_gsl_spmatrix_const_view gsl_spmatrix_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_add_to_dense (gsl_matrix * a, const gsl_spmatrix * b);
 /* properties */
 
 int gsl_spmatrix_equal (const gsl_spmatrix * a, const gsl_spmatrix * b);
+int gsl_spmatrix_bandwidth (const gsl_spmatrix * m, size_t * lower, size_t * upper);
 double gsl_spmatrix_norm1 (const gsl_spmatrix * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_transpose (gsl_spmatrix * m);
 int gsl_spmatrix_transpose2 (gsl_spmatrix * m);
 int gsl_spmatrix_transpose_memcpy (gsl_spmatrix * dest, const gsl_spmatrix * src);
 
+/* permute */
+
+int gsl_spmatrix_permute_sym (gsl_spmatrix * dest, const gsl_spmatrix * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_DOUBLE_H__ */
@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_int.h>
 #include <gsl/gsl_matrix_int.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_int;
 
+typedef struct
+{
+  gsl_spmatrix_int matrix;
+} _gsl_spmatrix_int_const_view;
+
+typedef const _gsl_spmatrix_int_const_view gsl_spmatrix_int_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_int_memcpy (gsl_spmatrix_int * dest, const gsl_spmatrix_int * s
 
 int gsl_spmatrix_int_fprintf (FILE * stream, const gsl_spmatrix_int * m, const char * format);
 gsl_spmatrix_int * gsl_spmatrix_int_fscanf (FILE * stream);
+gsl_spmatrix_int * gsl_spmatrix_int_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_int_fprintf_mm (FILE * stream, const gsl_spmatrix_int * m, const char * format, const int symmetry);
 int gsl_spmatrix_int_fwrite (FILE * stream, const gsl_spmatrix_int * m);
 int gsl_spmatrix_int_fread (FILE * stream, gsl_spmatrix_int * m);
+int gsl_spmatrix_int_fwrite_mapped (FILE * stream, const gsl_spmatrix_int * m);
+_gsl_spmatrix_int_const_view gsl_spmatrix_int_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_int_add_to_dense (gsl_matrix_int * a, const gsl_spmatrix_int *
 /* properties */
 
 int gsl_spmatrix_int_equal (const gsl_spmatrix_int * a, const gsl_spmatrix_int * b);
+int gsl_spmatrix_int_bandwidth (const gsl_spmatrix_int * m, size_t * lower, size_t * upper);
 int gsl_spmatrix_int_norm1 (const gsl_spmatrix_int * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_int_transpose (gsl_spmatrix_int * m);
 int gsl_spmatrix_int_transpose2 (gsl_spmatrix_int * m);
 int gsl_spmatrix_int_transpose_memcpy (gsl_spmatrix_int * dest, const gsl_spmatrix_int * src);
 
+/* permute */
+
+int gsl_spmatrix_int_permute_sym (gsl_spmatrix_int * dest, const gsl_spmatrix_int * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_INT_H__ */
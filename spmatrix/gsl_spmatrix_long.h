@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_long.h>
 #include <gsl/gsl_matrix_long.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_long;
 
+typedef struct
+{
+  gsl_spmatrix_long matrix;
+} _gsl_spmatrix_long_const_view;
+
+typedef const _gsl_spmatrix_long_const_view gsl_spmatrix_long_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_long_memcpy (gsl_spmatrix_long * dest, const gsl_spmatrix_long
 
 int gsl_spmatrix_long_fprintf (FILE * stream, const gsl_spmatrix_long * m, const char * format);
 gsl_spmatrix_long * gsl_spmatrix_long_fscanf (FILE * stream);
+gsl_spmatrix_long * gsl_spmatrix_long_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_long_fprintf_mm (FILE * stream, const gsl_spmatrix_long * m, const char * format, const int symmetry);
 int gsl_spmatrix_long_fwrite (FILE * stream, const gsl_spmatrix_long * m);
 int gsl_spmatrix_long_fread (FILE * stream, gsl_spmatrix_long * m);
+int gsl_spmatrix_long_fwrite_mapped (FILE * stream, const gsl_spmatrix_long * m);
+_gsl_spmatrix_long_const_view gsl_spmatrix_long_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_long_add_to_dense (gsl_matrix_long * a, const gsl_spmatrix_long
 /* properties */
 
 int gsl_spmatrix_long_equal (const gsl_spmatrix_long * a, const gsl_spmatrix_long * b);
+int gsl_spmatrix_long_bandwidth (const gsl_spmatrix_long * m, size_t * lower, size_t * upper);
 long gsl_spmatrix_long_norm1 (const gsl_spmatrix_long * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_long_transpose (gsl_spmatrix_long * m);
 int gsl_spmatrix_long_transpose2 (gsl_spmatrix_long * m);
 int gsl_spmatrix_long_transpose_memcpy (gsl_spmatrix_long * dest, const gsl_spmatrix_long * src);
 
+/* permute */
+
+int gsl_spmatrix_long_permute_sym (gsl_spmatrix_long * dest, const gsl_spmatrix_long * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_LONG_H__ */
@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_short.h>
 #include <gsl/gsl_matrix_short.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_short;
 
+typedef struct
+{
+  gsl_spmatrix_short matrix;
+} _gsl_spmatrix_short_const_view;
+
+typedef const _gsl_spmatrix_short_const_view gsl_spmatrix_short_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_short_memcpy (gsl_spmatrix_short * dest, const gsl_spmatrix_sho
 
 int gsl_spmatrix_short_fprintf (FILE * stream, const gsl_spmatrix_short * m, const char * format);
 gsl_spmatrix_short * gsl_spmatrix_short_fscanf (FILE * stream);
+gsl_spmatrix_short * gsl_spmatrix_short_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_short_fprintf_mm (FILE * stream, const gsl_spmatrix_short * m, const char * format, const int symmetry);
 int gsl_spmatrix_short_fwrite (FILE * stream, const gsl_spmatrix_short * m);
 int gsl_spmatrix_short_fread (FILE * stream, gsl_spmatrix_short * m);
+int gsl_spmatrix_short_fwrite_mapped (FILE * stream, const gsl_spmatrix_short * m);
+_gsl_spmatrix_short_const_view gsl_spmatrix_short_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_short_add_to_dense (gsl_matrix_short * a, const gsl_spmatrix_sh
 /* properties */
 
 int gsl_spmatrix_short_equal (const gsl_spmatrix_short * a, const gsl_spmatrix_short * b);
+int gsl_spmatrix_short_bandwidth (const gsl_spmatrix_short * m, size_t * lower, size_t * upper);
 short gsl_spmatrix_short_norm1 (const gsl_spmatrix_short * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_short_transpose (gsl_spmatrix_short * m);
 int gsl_spmatrix_short_transpose2 (gsl_spmatrix_short * m);
 int gsl_spmatrix_short_transpose_memcpy (gsl_spmatrix_short * dest, const gsl_spmatrix_short * src);
 
+/* permute */
+
+int gsl_spmatrix_short_permute_sym (gsl_spmatrix_short * dest, const gsl_spmatrix_short * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_SHORT_H__ */
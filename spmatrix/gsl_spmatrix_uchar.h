@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_uchar.h>
 #include <gsl/gsl_matrix_uchar.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_uchar;
 
+typedef struct
+{
+  gsl_spmatrix_uchar matrix;
+} _gsl_spmatrix_uchar_const_view;
+
+typedef const _gsl_spmatrix_uchar_const_view gsl_spmatrix_uchar_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_uchar_memcpy (gsl_spmatrix_uchar * dest, const gsl_spmatrix_uch
 
 int gsl_spmatrix_uchar_fprintf (FILE * stream, const gsl_spmatrix_uchar * m, const char * format);
 gsl_spmatrix_uchar * gsl_spmatrix_uchar_fscanf (FILE * stream);
+gsl_spmatrix_uchar * gsl_spmatrix_uchar_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_uchar_fprintf_mm (FILE * stream, const gsl_spmatrix_uchar * m, const char * format, const int symmetry);
 int gsl_spmatrix_uchar_fwrite (FILE * stream, const gsl_spmatrix_uchar * m);
 int gsl_spmatrix_uchar_fread (FILE * stream, gsl_spmatrix_uchar * m);
+int gsl_spmatrix_uchar_fwrite_mapped (FILE * stream, const gsl_spmatrix_uchar * m);
+_gsl_spmatrix_uchar_const_view gsl_spmatrix_uchar_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_uchar_add_to_dense (gsl_matrix_uchar * a, const gsl_spmatrix_uc
 /* properties */
 
 int gsl_spmatrix_uchar_equal (const gsl_spmatrix_uchar * a, const gsl_spmatrix_uchar * b);
+int gsl_spmatrix_uchar_bandwidth (const gsl_spmatrix_uchar * m, size_t * lower, size_t * upper);
 unsigned char gsl_spmatrix_uchar_norm1 (const gsl_spmatrix_uchar * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_uchar_transpose (gsl_spmatrix_uchar * m);
 int gsl_spmatrix_uchar_transpose2 (gsl_spmatrix_uchar * m);
 int gsl_spmatrix_uchar_transpose_memcpy (gsl_spmatrix_uchar * dest, const gsl_spmatrix_uchar * src);
 
+/* permute */
+
+int gsl_spmatrix_uchar_permute_sym (gsl_spmatrix_uchar * dest, const gsl_spmatrix_uchar * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_UCHAR_H__ */
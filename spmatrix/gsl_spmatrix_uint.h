@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_uint.h>
 #include <gsl/gsl_matrix_uint.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_uint;
 
+typedef struct
+{
+  gsl_spmatrix_uint matrix;
+} _gsl_spmatrix_uint_const_view;
+
+typedef const _gsl_spmatrix_uint_const_view gsl_spmatrix_uint_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_uint_memcpy (gsl_spmatrix_uint * dest, const gsl_spmatrix_uint
 
 int gsl_spmatrix_uint_fprintf (FILE * stream, const gsl_spmatrix_uint * m, const char * format);
 gsl_spmatrix_uint * gsl_spmatrix_uint_fscanf (FILE * stream);
+gsl_spmatrix_uint * gsl_spmatrix_uint_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_uint_fprintf_mm (FILE * stream, const gsl_spmatrix_uint * m, const char * format, const int symmetry);
 int gsl_spmatrix_uint_fwrite (FILE * stream, const gsl_spmatrix_uint * m);
 int gsl_spmatrix_uint_fread (FILE * stream, gsl_spmatrix_uint * m);
+int gsl_spmatrix_uint_fwrite_mapped (FILE * stream, const gsl_spmatrix_uint * m);
+_gsl_spmatrix_uint_const_view gsl_spmatrix_uint_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_uint_add_to_dense (gsl_matrix_uint * a, const gsl_spmatrix_uint
 /* properties */
 
 int gsl_spmatrix_uint_equal (const gsl_spmatrix_uint * a, const gsl_spmatrix_uint * b);
+int gsl_spmatrix_uint_bandwidth (const gsl_spmatrix_uint * m, size_t * lower, size_t * upper);
 unsigned int gsl_spmatrix_uint_norm1 (const gsl_spmatrix_uint * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_uint_transpose (gsl_spmatrix_uint * m);
 int gsl_spmatrix_uint_transpose2 (gsl_spmatrix_uint * m);
 int gsl_spmatrix_uint_transpose_memcpy (gsl_spmatrix_uint * dest, const gsl_spmatrix_uint * src);
 
+/* permute */
+
+int gsl_spmatrix_uint_permute_sym (gsl_spmatrix_uint * dest, const gsl_spmatrix_uint * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_UINT_H__ */
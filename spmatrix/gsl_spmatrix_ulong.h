@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_ulong.h>
 #include <gsl/gsl_matrix_ulong.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_ulong;
 
+typedef struct
+{
+  gsl_spmatrix_ulong matrix;
+} _gsl_spmatrix_ulong_const_view;
+
+typedef const _gsl_spmatrix_ulong_const_view gsl_spmatrix_ulong_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_ulong_memcpy (gsl_spmatrix_ulong * dest, const gsl_spmatrix_ulo
 
 int gsl_spmatrix_ulong_fprintf (FILE * stream, const gsl_spmatrix_ulong * m, const char * format);
 gsl_spmatrix_ulong * gsl_spmatrix_ulong_fscanf (FILE * stream);
+gsl_spmatrix_ulong * gsl_spmatrix_ulong_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_ulong_fprintf_mm (FILE * stream, const gsl_spmatrix_ulong * m, const char * format, const int symmetry);
 int gsl_spmatrix_ulong_fwrite (FILE * stream, const gsl_spmatrix_ulong * m);
 int gsl_spmatrix_ulong_fread (FILE * stream, gsl_spmatrix_ulong * m);
+int gsl_spmatrix_ulong_fwrite_mapped (FILE * stream, const gsl_spmatrix_ulong * m);
+_gsl_spmatrix_ulong_const_view gsl_spmatrix_ulong_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_ulong_add_to_dense (gsl_matrix_ulong * a, const gsl_spmatrix_ul
 /* properties */
 
 int gsl_spmatrix_ulong_equal (const gsl_spmatrix_ulong * a, const gsl_spmatrix_ulong * b);
+int gsl_spmatrix_ulong_bandwidth (const gsl_spmatrix_ulong * m, size_t * lower, size_t * upper);
 unsigned long gsl_spmatrix_ulong_norm1 (const gsl_spmatrix_ulong * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_ulong_transpose (gsl_spmatrix_ulong * m);
 int gsl_spmatrix_ulong_transpose2 (gsl_spmatrix_ulong * m);
 int gsl_spmatrix_ulong_transpose_memcpy (gsl_spmatrix_ulong * dest, const gsl_spmatrix_ulong * src);
 
+/* permute */
+
+int gsl_spmatrix_ulong_permute_sym (gsl_spmatrix_ulong * dest, const gsl_spmatrix_ulong * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_ULONG_H__ */
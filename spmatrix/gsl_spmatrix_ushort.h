@@ -25,6 +25,7 @@
 #include <gsl/gsl_bst.h>
 #include <gsl/gsl_vector_ushort.h>
 #include <gsl/gsl_matrix_ushort.h>
+#include <gsl/gsl_permutation.h>
 
 #undef __BEGIN_DECLS
 #undef __END_DECLS
@@ -105,6 +106,13 @@ typedef struct
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
 } gsl_spmatrix_ushort;
 
+typedef struct
+{
+  gsl_spmatrix_ushort matrix;
+} _gsl_spmatrix_ushort_const_view;
+
+typedef const _gsl_spmatrix_ushort_const_view gsl_spmatrix_ushort_const_view;
+
 /*
  * Prototypes
  */
@@ -138,8 +146,12 @@ int gsl_spmatrix_ushort_memcpy (gsl_spmatrix_ushort * dest, const gsl_spmatrix_u
 
 int gsl_spmatrix_ushort_fprintf (FILE * stream, const gsl_spmatrix_ushort * m, const char * format);
 gsl_spmatrix_ushort * gsl_spmatrix_ushort_fscanf (FILE * stream);
+gsl_spmatrix_ushort * gsl_spmatrix_ushort_fscanf_mm (FILE * stream, const int sptype);
+int gsl_spmatrix_ushort_fprintf_mm (FILE * stream, const gsl_spmatrix_ushort * m, const char * format, const int symmetry);
 int gsl_spmatrix_ushort_fwrite (FILE * stream, const gsl_spmatrix_ushort * m);
 int gsl_spmatrix_ushort_fread (FILE * stream, gsl_spmatrix_ushort * m);
+int gsl_spmatrix_ushort_fwrite_mapped (FILE * stream, const gsl_spmatrix_ushort * m);
+_gsl_spmatrix_ushort_const_view gsl_spmatrix_ushort_const_view_mapped (const void * base, const size_t len);
 
 /* get/set */
 
@@ -172,6 +184,7 @@ int gsl_spmatrix_ushort_add_to_dense (gsl_matrix_ushort * a, const gsl_spmatrix_
 /* properties */
 
 int gsl_spmatrix_ushort_equal (const gsl_spmatrix_ushort * a, const gsl_spmatrix_ushort * b);
+int gsl_spmatrix_ushort_bandwidth (const gsl_spmatrix_ushort * m, size_t * lower, size_t * upper);
 unsigned short gsl_spmatrix_ushort_norm1 (const gsl_spmatrix_ushort * a);
 
 /* swap */
@@ -180,6 +193,10 @@ int gsl_spmatrix_ushort_transpose (gsl_spmatrix_ushort * m);
 int gsl_spmatrix_ushort_transpose2 (gsl_spmatrix_ushort * m);
 int gsl_spmatrix_ushort_transpose_memcpy (gsl_spmatrix_ushort * dest, const gsl_spmatrix_ushort * src);
 
+/* permute */
+
+int gsl_spmatrix_ushort_permute_sym (gsl_spmatrix_ushort * dest, const gsl_spmatrix_ushort * src, const gsl_permutation * p);
+
 __END_DECLS
 
 #endif /* __GSL_SPMATRIX_USHORT_H__ */
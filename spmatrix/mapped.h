@@ -0,0 +1,60 @@
+/* spmatrix/mapped.h
+ *
+ * Header of the mapped binary sparse matrix format, shared by file.c
+ * and the tests
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_SPMATRIX_MAPPED_H__
+#define __GSL_SPMATRIX_MAPPED_H__
+
+#include <stddef.h>
+
+/*
+ * Mapped binary format, written by gsl_spmatrix_fwrite_mapped(). The file
+ * consists of the header below, followed by the arrays p, i and data, each
+ * starting at an offset from the beginning of the file which is a multiple
+ * of SPMATRIX_MAP_ALIGN bytes. All values are stored in native byte order,
+ * so that a page-aligned mapping of the file can be used directly as the
+ * storage of a sparse matrix.
+ */
+
+#define SPMATRIX_MAP_MAGIC       "GSLSPMAT"
+#define SPMATRIX_MAP_VERSION     1
+#define SPMATRIX_MAP_BYTEORDER   0x01020304
+#define SPMATRIX_MAP_ALIGN       64
+#define SPMATRIX_MAP_TYPELEN     40
+
+typedef struct
+{
+  char magic[8];                      /* SPMATRIX_MAP_MAGIC */
+  unsigned char sizes[8];             /* sizeof(size_t), sizeof(int), sizeof(ATOMIC), MULTIPLICITY */
+  char type[SPMATRIX_MAP_TYPELEN];    /* type name, e.g. "gsl_spmatrix_float" */
+  size_t byteorder;                   /* SPMATRIX_MAP_BYTEORDER */
+  size_t version;                     /* SPMATRIX_MAP_VERSION */
+  size_t sptype;                      /* GSL_SPMATRIX_CSC or GSL_SPMATRIX_CSR */
+  size_t size1;                       /* number of rows */
+  size_t size2;                       /* number of columns */
+  size_t nz;                          /* number of non-zero elements */
+  size_t offset_p;                    /* byte offset of p array */
+  size_t offset_i;                    /* byte offset of i array */
+  size_t offset_data;                 /* byte offset of data array */
+  size_t length;                      /* total length of file in bytes */
+} spmatrix_map_header;
+
+#endif /* __GSL_SPMATRIX_MAPPED_H__ */
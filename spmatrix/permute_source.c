@@ -0,0 +1,138 @@
+/* spmatrix/permute_source.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+gsl_spmatrix_permute_sym()
+  Apply a symmetric permutation to a square sparse matrix,
+
+dest = P src P^T
+
+so that dest(i,j) = src(p[i],p[j])
+
+Inputs: dest - (output) permuted matrix, same storage format as src
+        src  - square sparse matrix
+        p    - permutation
+
+Return: success/error
+
+Notes:
+1) In compressed formats, column (CSC) or row (CSR) k of dest is a
+copy of column/row p[k] of src with its indices renumbered, so the
+operation requires O(n + nnz) work
+*/
+
+int
+FUNCTION (gsl_spmatrix, permute_sym) (TYPE (gsl_spmatrix) * dest, const TYPE (gsl_spmatrix) * src,
+                                      const gsl_permutation * p)
+{
+  const size_t N = src->size1;
+
+  if (N != src->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (dest->size1 != N || dest->size2 != N)
+    {
+      GSL_ERROR("dest matrix must have same dimensions as src", GSL_EBADLEN);
+    }
+  else if (p->size != N)
+    {
+      GSL_ERROR("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else if (dest->sptype != src->sptype)
+    {
+      GSL_ERROR("cannot copy matrices of different storage formats",
+                GSL_EINVAL);
+    }
+  else if (dest == src)
+    {
+      GSL_ERROR("in-place permutation is not supported", GSL_EINVAL);
+    }
+  else
+    {
+      int status = GSL_SUCCESS;
+      const size_t nz = src->nz;
+      int * pinv = dest->work.work_int;
+      size_t k, r;
+
+      if (dest->nzmax < nz)
+        {
+          status = FUNCTION (gsl_spmatrix, realloc) (nz, dest);
+          if (status)
+            return status;
+        }
+
+      /* compute inverse permutation */
+      for (k = 0; k < N; ++k)
+        pinv[p->data[k]] = (int) k;
+
+      if (GSL_SPMATRIX_ISCOO(src))
+        {
+          for (k = 0; k < nz; ++k)
+            {
+              dest->i[k] = pinv[src->i[k]];
+              dest->p[k] = pinv[src->p[k]];
+
+              for (r = 0; r < MULTIPLICITY; ++r)
+                dest->data[MULTIPLICITY * k + r] = src->data[MULTIPLICITY * k + r];
+            }
+
+          dest->nz = nz;
+
+          /* binary tree must be rebuilt with the new indices */
+          status = FUNCTION (gsl_spmatrix, tree_rebuild) (dest);
+        }
+      else if (GSL_SPMATRIX_ISCSC(src) || GSL_SPMATRIX_ISCSR(src))
+        {
+          const int * Ai = src->i;
+          const int * Ap = src->p;
+          const ATOMIC * Ad = src->data;
+          int * Bi = dest->i;
+          int * Bp = dest->p;
+          ATOMIC * Bd = dest->data;
+          int q, idx = 0;
+
+          for (k = 0; k < N; ++k)
+            {
+              const size_t pk = p->data[k];
+
+              Bp[k] = idx;
+
+              for (q = Ap[pk]; q < Ap[pk + 1]; ++q)
+                {
+                  Bi[idx] = pinv[Ai[q]];
+
+                  for (r = 0; r < MULTIPLICITY; ++r)
+                    Bd[MULTIPLICITY * idx + r] = Ad[MULTIPLICITY * q + r];
+
+                  ++idx;
+                }
+            }
+
+          Bp[N] = idx;
+          dest->nz = nz;
+        }
+      else
+        {
+          GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+        }
+
+      return status;
+    }
+}
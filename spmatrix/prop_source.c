@@ -123,6 +123,70 @@ FUNCTION (gsl_spmatrix, equal) (const TYPE (gsl_spmatrix) * a, const TYPE (gsl_s
     }
 }
 
+/*
+gsl_spmatrix_bandwidth()
+  Compute the lower and upper bandwidths of a sparse matrix,
+
+lower = max { i - j : A(i,j) != 0 }
+upper = max { j - i : A(i,j) != 0 }
+
+Inputs: m     - sparse matrix
+        lower - (output) lower bandwidth
+        upper - (output) upper bandwidth
+
+Return: success/error
+*/
+
+int
+FUNCTION (gsl_spmatrix, bandwidth) (const TYPE (gsl_spmatrix) * m, size_t * lower, size_t * upper)
+{
+  size_t kl = 0, ku = 0;
+
+  if (GSL_SPMATRIX_ISCOO(m))
+    {
+      size_t n;
+
+      for (n = 0; n < m->nz; ++n)
+        {
+          int d = m->i[n] - m->p[n];
+
+          if (d > 0)
+            kl = GSL_MAX(kl, (size_t) d);
+          else
+            ku = GSL_MAX(ku, (size_t) -d);
+        }
+    }
+  else if (GSL_SPMATRIX_ISCSC(m) || GSL_SPMATRIX_ISCSR(m))
+    {
+      const size_t N = GSL_SPMATRIX_ISCSC(m) ? m->size2 : m->size1;
+      size_t k;
+      int q;
+
+      for (k = 0; k < N; ++k)
+        {
+          for (q = m->p[k]; q < m->p[k + 1]; ++q)
+            {
+              /* d = row - column */
+              int d = GSL_SPMATRIX_ISCSC(m) ? m->i[q] - (int) k : (int) k - m->i[q];
+
+              if (d > 0)
+                kl = GSL_MAX(kl, (size_t) d);
+              else
+                ku = GSL_MAX(ku, (size_t) -d);
+            }
+        }
+    }
+  else
+    {
+      GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+    }
+
+  *lower = kl;
+  *upper = ku;
+
+  return GSL_SUCCESS;
+}
+
 #if !defined(UNSIGNED) && !defined(BASE_GSL_COMPLEX) && !defined(BASE_GSL_COMPLEX_FLOAT) && !defined(BASE_GSL_COMPLEX_LONG)
 
 ATOMIC
@@ -19,14 +19,19 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <math.h>
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_spmatrix.h>
 
+#include "mapped.h"
+
 int status = 0;
 
 #define BASE_GSL_COMPLEX_LONG
@@ -113,6 +118,81 @@ int status = 0;
 #include "templates_off.h"
 #undef  BASE_CHAR
 
+/* error code of the last error, recorded by test_error_handler() */
+static int test_errno = 0;
+
+static void
+test_error_handler (const char *reason, const char *file, int line, int gsl_errno)
+{
+  (void) reason;
+  (void) file;
+  (void) line;
+  test_errno = gsl_errno;
+}
+
+/* read the Matrix Market file contents str and check that it is rejected with error code expected */
+static void
+test_mm_invalid (const char *str, const int expected, const char *desc)
+{
+  char filename[] = "test_mm.dat";
+  gsl_error_handler_t *old_handler = gsl_set_error_handler (&test_error_handler);
+  gsl_spmatrix *m;
+  FILE *f;
+
+  f = fopen (filename, "w");
+  fputs (str, f);
+  fclose (f);
+
+  test_errno = 0;
+
+  f = fopen (filename, "r");
+  m = gsl_spmatrix_fscanf_mm (f, GSL_SPMATRIX_CSR);
+  fclose (f);
+
+  gsl_test (m != NULL, "gsl_spmatrix_fscanf_mm %s returns NULL", desc);
+  gsl_test_int (test_errno, expected, "gsl_spmatrix_fscanf_mm %s error code", desc);
+
+  if (m)
+    gsl_spmatrix_free (m);
+
+  gsl_set_error_handler (old_handler);
+  unlink (filename);
+}
+
+static void
+test_mm (void)
+{
+  const char *banner = "%%MatrixMarket matrix coordinate real general\n";
+  char buf[1024];
+
+  sprintf (buf, "%s3 x 1\n1 1 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EFAILED, "malformed size line");
+
+  sprintf (buf, "%s-3 3 1\n1 1 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EFAILED, "negative size1");
+
+  sprintf (buf, "%s3000000000 3 1\n1 1 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EOVRFLW, "size1 > INT_MAX");
+
+  sprintf (buf, "%s3 99999999999999999999999 1\n1 1 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EOVRFLW, "size2 overflows size_t");
+
+  sprintf (buf, "%s3 3 4294967296\n1 1 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EOVRFLW, "nz > INT_MAX");
+
+  sprintf (buf, "%%%%MatrixMarket matrix coordinate real symmetric\n3 3 1500000000\n1 1 1.0\n");
+  test_mm_invalid (buf, GSL_EOVRFLW, "symmetric 2*nz > INT_MAX");
+
+  sprintf (buf, "%s3 3 2\n1 1 1.0\n0 2 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EINVAL, "zero row index");
+
+  sprintf (buf, "%s3 3 2\n1 1 1.0\n2 4 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EINVAL, "column index > size2");
+
+  sprintf (buf, "%s3 3 1\n4294967297 1 1.0\n", banner);
+  test_mm_invalid (buf, GSL_EINVAL, "row index wraps in int");
+}
+
 int
 main (void)
 {
@@ -142,6 +222,8 @@ main (void)
       test_complex_long_double_all (M[i], N[i], density[i], r);
     }
 
+  test_mm ();
+
   gsl_rng_free(r);
 
   exit (gsl_test_summary ());
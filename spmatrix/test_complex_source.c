@@ -745,6 +745,75 @@ FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
   FUNCTION (gsl_spmatrix, free) (C);
 }
 
+static void
+FUNCTION (test, io_mm) (const size_t M, const size_t N, const int sptype,
+                        const double density, gsl_rng * r)
+{
+  const size_t K = GSL_MIN (M, N);
+  TYPE (gsl_spmatrix) * A = FUNCTION (test, random_int) (M, N, density, 1.0, 20.0, r);
+  TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, sptype);
+  TYPE (gsl_spmatrix) * H = FUNCTION (gsl_spmatrix, alloc) (K, K);
+  TYPE (gsl_spmatrix) * C;
+  char filename[] = "test.dat";
+  FILE *f;
+  size_t n;
+
+  f = fopen (filename, "w");
+  FUNCTION (gsl_spmatrix, fprintf_mm) (f, B, OUT_FORMAT, GSL_SPMATRIX_MM_GENERAL);
+  fclose (f);
+
+  f = fopen (filename, "r");
+  C = FUNCTION (gsl_spmatrix, fscanf_mm) (f, sptype);
+  fclose (f);
+
+  status = FUNCTION (gsl_spmatrix, equal) (B, C) != 1;
+  gsl_test (status, NAME (gsl_spmatrix) "_fscanf_mm[%zu,%zu](%s)",
+            M, N, FUNCTION (gsl_spmatrix, type) (B));
+
+  FUNCTION (gsl_spmatrix, free) (C);
+
+  /* hermitian matrix */
+  for (n = 0; n < A->nz; ++n)
+    {
+      size_t i = A->i[n];
+      size_t j = A->p[n];
+      BASE x;
+
+      if (i >= K || j >= K)
+        continue;
+
+      GSL_REAL (x) = A->data[2 * n];
+      GSL_IMAG (x) = (i == j) ? 0 : A->data[2 * n + 1];
+      FUNCTION (gsl_spmatrix, set) (H, i, j, x);
+
+      GSL_IMAG (x) = -GSL_IMAG (x);
+      FUNCTION (gsl_spmatrix, set) (H, j, i, x);
+    }
+
+  C = FUNCTION (gsl_spmatrix, compress) (H, sptype);
+
+  f = fopen (filename, "w");
+  FUNCTION (gsl_spmatrix, fprintf_mm) (f, C, OUT_FORMAT, GSL_SPMATRIX_MM_HERMITIAN);
+  fclose (f);
+
+  FUNCTION (gsl_spmatrix, free) (C);
+
+  f = fopen (filename, "r");
+  C = FUNCTION (gsl_spmatrix, fscanf_mm) (f, GSL_SPMATRIX_COO);
+  fclose (f);
+
+  status = FUNCTION (gsl_spmatrix, equal) (H, C) != 1;
+  gsl_test (status, NAME (gsl_spmatrix) "_fscanf_mm[%zu,%zu](%s) hermitian",
+            K, K, FUNCTION (gsl_spmatrix, type) (B));
+
+  unlink (filename);
+
+  FUNCTION (gsl_spmatrix, free) (A);
+  FUNCTION (gsl_spmatrix, free) (B);
+  FUNCTION (gsl_spmatrix, free) (C);
+  FUNCTION (gsl_spmatrix, free) (H);
+}
+
 static void
 FUNCTION (test, io_binary) (const size_t M, const size_t N, const int sptype,
                             const double density, gsl_rng * r)
@@ -818,6 +887,10 @@ FUNCTION (test, all) (const size_t M, const size_t N, const double density, gsl_
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSR, density, r);
 
+  FUNCTION (test, io_mm) (M, N, GSL_SPMATRIX_COO, density, r);
+  FUNCTION (test, io_mm) (M, N, GSL_SPMATRIX_CSC, density, r);
+  FUNCTION (test, io_mm) (M, N, GSL_SPMATRIX_CSR, density, r);
+
   FUNCTION (test, io_binary) (M, N, GSL_SPMATRIX_COO, density, r);
   FUNCTION (test, io_binary) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, io_binary) (M, N, GSL_SPMATRIX_CSR, density, r);
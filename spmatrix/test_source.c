@@ -738,6 +738,63 @@ FUNCTION (test, norm) (const size_t M, const size_t N, const int sptype)
 
 #endif
 
+static void
+FUNCTION (test, permute) (const size_t N, const int sptype,
+                          const double density, gsl_rng * r)
+{
+  TYPE (gsl_spmatrix) * A = FUNCTION (test, random) (N, N, density, 1.0, 20.0, r);
+  TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, sptype);
+  TYPE (gsl_spmatrix) * C = FUNCTION (gsl_spmatrix, alloc_nzmax) (N, N, 1, sptype);
+  gsl_permutation * p = gsl_permutation_alloc (N);
+  size_t lower, upper, lower_expected = 0, upper_expected = 0;
+  size_t i, j;
+
+  /* random permutation */
+  gsl_permutation_init (p);
+  for (i = 0; i < N; ++i)
+    {
+      size_t k = (size_t) (gsl_rng_uniform (r) * N);
+      gsl_permutation_swap (p, i, k);
+    }
+
+  FUNCTION (gsl_spmatrix, permute_sym) (C, B, p);
+
+  status = 0;
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          BASE cij = FUNCTION (gsl_spmatrix, get) (C, i, j);
+          BASE aij = FUNCTION (gsl_spmatrix, get) (A, p->data[i], p->data[j]);
+
+          if (cij != aij)
+            status = 1;
+
+          if (cij != (BASE) 0)
+            {
+              if (i > j)
+                lower_expected = GSL_MAX (lower_expected, i - j);
+              else
+                upper_expected = GSL_MAX (upper_expected, j - i);
+            }
+        }
+    }
+
+  gsl_test (status, NAME (gsl_spmatrix) "_permute_sym[%zu](%s)",
+            N, FUNCTION (gsl_spmatrix, type) (B));
+
+  FUNCTION (gsl_spmatrix, bandwidth) (C, &lower, &upper);
+
+  status = lower != lower_expected || upper != upper_expected;
+  gsl_test (status, NAME (gsl_spmatrix) "_bandwidth[%zu](%s)",
+            N, FUNCTION (gsl_spmatrix, type) (C));
+
+  gsl_permutation_free (p);
+  FUNCTION (gsl_spmatrix, free) (A);
+  FUNCTION (gsl_spmatrix, free) (B);
+  FUNCTION (gsl_spmatrix, free) (C);
+}
+
 static void
 FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
                            const double density, gsl_rng * r)
@@ -767,6 +824,81 @@ FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
   FUNCTION (gsl_spmatrix, free) (C);
 }
 
+static void
+FUNCTION (test, io_mm) (const size_t M, const size_t N, const int sptype,
+                        const double density, gsl_rng * r)
+{
+  const size_t K = GSL_MIN (M, N);
+  TYPE (gsl_spmatrix) * A = FUNCTION (test, random_int) (M, N, density, 1.0, 20.0, r);
+  TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, sptype);
+  TYPE (gsl_spmatrix) * S = FUNCTION (gsl_spmatrix, alloc) (K, K);
+  TYPE (gsl_spmatrix) * C;
+  char filename[] = "test.dat";
+  FILE *f;
+  size_t n;
+
+  f = fopen (filename, "w");
+  FUNCTION (gsl_spmatrix, fprintf_mm) (f, B, OUT_FORMAT, GSL_SPMATRIX_MM_GENERAL);
+  fclose (f);
+
+  /* read in same storage format as written, which preserves element order */
+  f = fopen (filename, "r");
+  C = FUNCTION (gsl_spmatrix, fscanf_mm) (f, sptype);
+  fclose (f);
+
+  status = FUNCTION (gsl_spmatrix, equal) (B, C) != 1;
+  gsl_test (status, NAME (gsl_spmatrix) "_fscanf_mm[%zu,%zu](%s)",
+            M, N, FUNCTION (gsl_spmatrix, type) (B));
+
+  FUNCTION (gsl_spmatrix, free) (C);
+
+  f = fopen (filename, "r");
+  C = FUNCTION (gsl_spmatrix, fscanf_mm) (f, GSL_SPMATRIX_COO);
+  fclose (f);
+
+  status = FUNCTION (gsl_spmatrix, equal) (A, C) != 1;
+  gsl_test (status, NAME (gsl_spmatrix) "_fscanf_mm[%zu,%zu](%s) COO",
+            M, N, FUNCTION (gsl_spmatrix, type) (B));
+
+  FUNCTION (gsl_spmatrix, free) (C);
+
+  /* symmetric matrix */
+  for (n = 0; n < A->nz; ++n)
+    {
+      size_t i = A->i[n];
+      size_t j = A->p[n];
+
+      if (i < K && j < K)
+        {
+          FUNCTION (gsl_spmatrix, set) (S, i, j, A->data[n]);
+          FUNCTION (gsl_spmatrix, set) (S, j, i, A->data[n]);
+        }
+    }
+
+  C = FUNCTION (gsl_spmatrix, compress) (S, sptype);
+
+  f = fopen (filename, "w");
+  FUNCTION (gsl_spmatrix, fprintf_mm) (f, C, OUT_FORMAT, GSL_SPMATRIX_MM_SYMMETRIC);
+  fclose (f);
+
+  FUNCTION (gsl_spmatrix, free) (C);
+
+  f = fopen (filename, "r");
+  C = FUNCTION (gsl_spmatrix, fscanf_mm) (f, GSL_SPMATRIX_COO);
+  fclose (f);
+
+  status = FUNCTION (gsl_spmatrix, equal) (S, C) != 1;
+  gsl_test (status, NAME (gsl_spmatrix) "_fscanf_mm[%zu,%zu](%s) symmetric",
+            K, K, FUNCTION (gsl_spmatrix, type) (B));
+
+  unlink (filename);
+
+  FUNCTION (gsl_spmatrix, free) (A);
+  FUNCTION (gsl_spmatrix, free) (B);
+  FUNCTION (gsl_spmatrix, free) (C);
+  FUNCTION (gsl_spmatrix, free) (S);
+}
+
 static void
 FUNCTION (test, io_binary) (const size_t M, const size_t N, const int sptype,
                             const double density, gsl_rng * r)
@@ -796,6 +928,83 @@ FUNCTION (test, io_binary) (const size_t M, const size_t N, const int sptype,
   FUNCTION (gsl_spmatrix, free) (C);
 }
 
+static void
+FUNCTION (test, io_mapped) (const size_t M, const size_t N, const int sptype,
+                            const double density, gsl_rng * r)
+{
+  TYPE (gsl_spmatrix) * A = FUNCTION (test, random) (M, N, density, 1.0, 20.0, r);
+  TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, sptype);
+  char filename[] = "test.dat";
+  FILE *f;
+  long len;
+  void *buf;
+
+  f = fopen (filename, "wb");
+  FUNCTION (gsl_spmatrix, fwrite_mapped) (f, B);
+  fclose (f);
+
+  /* read the file image into memory; a memory mapping of the file may be used instead */
+  f = fopen (filename, "rb");
+  fseek (f, 0L, SEEK_END);
+  len = ftell (f);
+  rewind (f);
+  buf = malloc ((size_t) len);
+  status = fread (buf, 1, (size_t) len, f) != (size_t) len;
+  gsl_test (status, NAME (gsl_spmatrix) "_fwrite_mapped[%zu,%zu](%s) length",
+            M, N, FUNCTION (gsl_spmatrix, type) (B));
+  fclose (f);
+
+  {
+    VIEW (gsl_spmatrix, const_view) v = FUNCTION (gsl_spmatrix, const_view_mapped) (buf, (size_t) len);
+
+    status = FUNCTION (gsl_spmatrix, equal) (B, &v.matrix) != 1;
+    gsl_test (status, NAME (gsl_spmatrix) "_const_view_mapped[%zu,%zu](%s)",
+              M, N, FUNCTION (gsl_spmatrix, type) (B));
+
+    status = (size_t) ((char *) v.matrix.data - (char *) buf) % SPMATRIX_MAP_ALIGN != 0;
+    gsl_test (status, NAME (gsl_spmatrix) "_const_view_mapped[%zu,%zu](%s) alignment",
+              M, N, FUNCTION (gsl_spmatrix, type) (B));
+  }
+
+  {
+    /* header offsets which wrap around when the array sizes are added
+     * must be rejected */
+    const size_t pos = offsetof (spmatrix_map_header, offset_data);
+    size_t bad = ((size_t) -1) & ~((size_t) SPMATRIX_MAP_ALIGN - 1);
+    gsl_error_handler_t *old_handler = gsl_set_error_handler_off ();
+    size_t orig;
+
+    memcpy (&orig, (char *) buf + pos, sizeof (size_t));
+
+    memcpy ((char *) buf + pos, &bad, sizeof (size_t));
+    {
+      VIEW (gsl_spmatrix, const_view) v = FUNCTION (gsl_spmatrix, const_view_mapped) (buf, (size_t) len);
+      status = v.matrix.data != NULL;
+      gsl_test (status, NAME (gsl_spmatrix) "_const_view_mapped[%zu,%zu](%s) corrupt offset",
+                M, N, FUNCTION (gsl_spmatrix, type) (B));
+    }
+
+    /* misaligned offset */
+    bad = orig + sizeof (int);
+    memcpy ((char *) buf + pos, &bad, sizeof (size_t));
+    {
+      VIEW (gsl_spmatrix, const_view) v = FUNCTION (gsl_spmatrix, const_view_mapped) (buf, (size_t) len);
+      status = v.matrix.data != NULL;
+      gsl_test (status, NAME (gsl_spmatrix) "_const_view_mapped[%zu,%zu](%s) misaligned offset",
+                M, N, FUNCTION (gsl_spmatrix, type) (B));
+    }
+
+    memcpy ((char *) buf + pos, &orig, sizeof (size_t));
+    gsl_set_error_handler (old_handler);
+  }
+
+  unlink (filename);
+  free (buf);
+
+  FUNCTION (gsl_spmatrix, free) (A);
+  FUNCTION (gsl_spmatrix, free) (B);
+}
+
 static void
 FUNCTION (test, all) (const size_t M, const size_t N, const double density, gsl_rng * r)
 {
@@ -846,11 +1055,22 @@ FUNCTION (test, all) (const size_t M, const size_t N, const double density, gsl_
   FUNCTION (test, norm) (M, N, GSL_SPMATRIX_CSR);
 #endif
 
+  FUNCTION (test, permute) (M, GSL_SPMATRIX_COO, density, r);
+  FUNCTION (test, permute) (M, GSL_SPMATRIX_CSC, density, r);
+  FUNCTION (test, permute) (M, GSL_SPMATRIX_CSR, density, r);
+
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_COO, density, r);
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSR, density, r);
 
+  FUNCTION (test, io_mm) (M, N, GSL_SPMATRIX_COO, density, r);
+  FUNCTION (test, io_mm) (M, N, GSL_SPMATRIX_CSC, density, r);
+  FUNCTION (test, io_mm) (M, N, GSL_SPMATRIX_CSR, density, r);
+
   FUNCTION (test, io_binary) (M, N, GSL_SPMATRIX_COO, density, r);
   FUNCTION (test, io_binary) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, io_binary) (M, N, GSL_SPMATRIX_CSR, density, r);
+
+  FUNCTION (test, io_mapped) (M, N, GSL_SPMATRIX_CSC, density, r);
+  FUNCTION (test, io_mapped) (M, N, GSL_SPMATRIX_CSR, density, r);
 }
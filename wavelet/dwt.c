@@ -23,13 +23,17 @@
 
 #include <config.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_wavelet.h>
 #include <gsl/gsl_wavelet2d.h>
 
+#include "lifting.h"
+
 #define ELEMENT(a,stride,i) ((a)[(stride)*(i)])
 
 static int binary_logn (const size_t n);
 static void dwt_step (const gsl_wavelet * w, double *a, size_t stride, size_t n, gsl_wavelet_direction dir, gsl_wavelet_workspace * work);
+static void dwt_columns (const gsl_wavelet * w, double *data, size_t tda, size_t ncol, size_t len, int single_step, gsl_wavelet_direction dir, gsl_wavelet_workspace * work);
 
 static int
 binary_logn (const size_t n)
@@ -64,6 +68,12 @@ dwt_step (const gsl_wavelet * w, double *a, size_t stride, size_t n,
   size_t k;
   size_t n1, ni, nh, nmod;
 
+  if (w->lifting != NULL)
+    {
+      gsl_wavelet_lifting_step (w, a, stride, n, dir, work);
+      return;
+    }
+
   for (i = 0; i < work->n; i++)
     {
       work->scratch[i] = 0.0;
@@ -115,6 +125,63 @@ dwt_step (const gsl_wavelet * w, double *a, size_t stride, size_t n,
     }
 }
 
+/* transform the first ncol columns of a matrix, over their first len
+   rows: fully, or by a single level if single_step is set. With a
+   blocked workspace the columns are copied GSL_WAVELET2D_BLOCK at a time
+   to contiguous storage, which reads the matrix a row segment at a
+   time instead of one element per cache line */
+
+static void
+dwt_columns (const gsl_wavelet * w, double *data, size_t tda, size_t ncol,
+             size_t len, int single_step, gsl_wavelet_direction dir,
+             gsl_wavelet_workspace * work)
+{
+  size_t i, j, j0;
+
+  if (work->block == NULL)
+    {
+      for (j = 0; j < ncol; j++)        /* for every column j */
+        {
+          if (single_step)
+            dwt_step (w, &ELEMENT(data, 1, j), tda, len, dir, work);
+          else
+            gsl_wavelet_transform (w, &ELEMENT(data, 1, j), tda, len, dir, work);
+        }
+
+      return;
+    }
+
+  for (j0 = 0; j0 < ncol; j0 += GSL_WAVELET2D_BLOCK)
+    {
+      const size_t nb = GSL_MIN (GSL_WAVELET2D_BLOCK, ncol - j0);
+      double *block = work->block;
+
+      for (i = 0; i < len; i++)
+        {
+          const double *row = &ELEMENT(data, tda, i) + j0;
+
+          for (j = 0; j < nb; j++)
+            block[j * len + i] = row[j];
+        }
+
+      for (j = 0; j < nb; j++)
+        {
+          if (single_step)
+            dwt_step (w, block + j * len, 1, len, dir, work);
+          else
+            gsl_wavelet_transform (w, block + j * len, 1, len, dir, work);
+        }
+
+      for (i = 0; i < len; i++)
+        {
+          double *row = &ELEMENT(data, tda, i) + j0;
+
+          for (j = 0; j < nb; j++)
+            row[j] = block[j * len + i];
+        }
+    }
+}
+
 int
 gsl_wavelet_transform (const gsl_wavelet * w, 
                        double *data, size_t stride, size_t n,
@@ -217,17 +284,11 @@ gsl_wavelet2d_transform (const gsl_wavelet * w,
         {
           gsl_wavelet_transform (w, &ELEMENT(data, tda, i), 1, size1, dir, work);
         }
-      for (i = 0; i < size2; i++)       /* for every column j */
-        {
-          gsl_wavelet_transform (w, &ELEMENT(data, 1, i), tda, size2, dir, work);
-        }
+      dwt_columns (w, data, tda, size2, size1, 0, dir, work);
     }
   else
     {
-      for (i = 0; i < size2; i++)       /* for every column j */
-        {
-          gsl_wavelet_transform (w, &ELEMENT(data, 1, i), tda, size2, dir, work);
-        }
+      dwt_columns (w, data, tda, size2, size1, 0, dir, work);
       for (i = 0; i < size1; i++)       /* for every row j */
         {
           gsl_wavelet_transform (w, &ELEMENT(data, tda, i), 1, size1, dir, work);
@@ -273,20 +334,14 @@ gsl_wavelet2d_nstransform (const gsl_wavelet * w,
             {
               dwt_step (w, &ELEMENT(data, tda, j), 1, i, dir, work);
             }
-          for (j = 0; j < i; j++)       /* for every column j */
-            {
-              dwt_step (w, &ELEMENT(data, 1, j), tda, i, dir, work);
-            }
+          dwt_columns (w, data, tda, i, i, 1, dir, work);
         }
     }
   else
     {
       for (i = 2; i <= size1; i <<= 1)
         {
-          for (j = 0; j < i; j++)       /* for every column j */
-            {
-              dwt_step (w, &ELEMENT(data, 1, j), tda, i, dir, work);
-            }
+          dwt_columns (w, data, tda, i, i, 1, dir, work);
           for (j = 0; j < i; j++)       /* for every row j */
             {
               dwt_step (w, &ELEMENT(data, tda, j), 1, i, dir, work);
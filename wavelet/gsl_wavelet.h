@@ -49,6 +49,8 @@ typedef struct
 }
 gsl_wavelet_type;
 
+typedef struct gsl_wavelet_lifting_struct gsl_wavelet_lifting;
+
 typedef struct
 {
   const gsl_wavelet_type *type;
@@ -58,6 +60,7 @@ typedef struct
   const double *g2;
   size_t nc;
   size_t offset;
+  const gsl_wavelet_lifting *lifting;  /* lifting factorization, or NULL */
 }
 gsl_wavelet;
 
@@ -65,6 +68,7 @@ typedef struct
 {
   double *scratch;
   size_t n;
+  double *block;              /* columns for blocked 2d transforms, or NULL */
 }
 gsl_wavelet_workspace;
 
@@ -37,6 +37,11 @@
 
 __BEGIN_DECLS
 
+/* number of columns transformed together with a blocked workspace */
+#define GSL_WAVELET2D_BLOCK   16
+
+gsl_wavelet_workspace *gsl_wavelet2d_workspace_alloc (size_t n);
+
 int gsl_wavelet2d_transform (const gsl_wavelet * w, 
                              double *data, 
                              size_t tda, size_t size1, size_t size2,
@@ -0,0 +1,71 @@
+/* wavelet/gsl_wavelet_swt.h
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_WAVELET_SWT_H__
+#define __GSL_WAVELET_SWT_H__
+#include <stdlib.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector_double.h>
+#include <gsl/gsl_matrix_double.h>
+#include <gsl/gsl_wavelet.h>
+
+#undef __BEGIN_DECLS
+#undef __END_DECLS
+#ifdef __cplusplus
+# define __BEGIN_DECLS extern "C" {
+# define __END_DECLS }
+#else
+# define __BEGIN_DECLS          /* empty */
+# define __END_DECLS            /* empty */
+#endif
+
+__BEGIN_DECLS
+
+typedef struct
+{
+  size_t nlevels;             /* number of levels J */
+  size_t nmax;                /* maximum length of a chunk */
+  size_t nc;                  /* number of wavelet coefficients */
+  size_t offset;              /* wavelet offset */
+  size_t delay;               /* delay of outputs with respect to the input */
+  size_t *hlen;               /* length of input history for each level */
+  size_t *dlen;               /* length of delay line for each detail level */
+  double **hist;              /* input history followed by new input, for each level */
+  double **dline;             /* delay line followed by new outputs, for each detail level */
+  double *buf;                /* storage for hist and dline */
+} gsl_wavelet_swt_stream_workspace;
+
+int gsl_wavelet_swt_forward (const gsl_wavelet * w, const gsl_vector * x,
+                             gsl_matrix * W, gsl_wavelet_workspace * work);
+
+int gsl_wavelet_swt_inverse (const gsl_wavelet * w, const gsl_matrix * W,
+                             gsl_vector * x, gsl_wavelet_workspace * work);
+
+gsl_wavelet_swt_stream_workspace *gsl_wavelet_swt_stream_alloc (const gsl_wavelet * w,
+                                                                const size_t nlevels,
+                                                                const size_t nmax);
+void gsl_wavelet_swt_stream_free (gsl_wavelet_swt_stream_workspace * stream);
+int gsl_wavelet_swt_stream_reset (gsl_wavelet_swt_stream_workspace * stream);
+size_t gsl_wavelet_swt_stream_delay (const gsl_wavelet_swt_stream_workspace * stream);
+int gsl_wavelet_swt_stream_apply (const gsl_wavelet * w, const gsl_vector * x, gsl_matrix * W,
+                                  gsl_wavelet_swt_stream_workspace * stream);
+
+__END_DECLS
+
+#endif /* __GSL_WAVELET_SWT_H__ */
@@ -0,0 +1,224 @@
+/* wavelet/lifting.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Lifting factorizations of the short wavelet filters, following
+ * I. Daubechies and W. Sweldens, "Factoring Wavelet Transforms into
+ * Lifting Steps", J. Fourier Anal. Appl., 4 (1998) 247--269.
+ *
+ * The factorizations are written for the phase convention of dwt.c,
+ * where the smooth and detail coefficients of a level are
+ *
+ * s[i] = sum_k h1[k] x[2i + k],  d[i] = sum_k g1[k] x[2i + k]
+ *
+ * with x[j] = a[j - offset], so that a lifting step produces the same
+ * coefficients as the convolution in dwt_step() up to rounding.
+ */
+
+#include <config.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_wavelet.h>
+
+#include "lifting.h"
+
+#define ELEMENT(a,stride,i) ((a)[(stride)*(i)])
+
+/* index j + shift modulo a power of 2 */
+#define LIFTING_INDEX(j,shift,mask) (((j) + (size_t) (shift)) & (mask))
+
+static void lifting_apply (double *x, const double *y, const size_t m,
+                           const lifting_step * step, const double sign);
+
+/* Haar: predict the odd sample from the even one, then update */
+static const gsl_wavelet_lifting lifting_haar = {
+  2,
+  {
+    { LIFTING_PREDICT, { -1.0, 0.0 }, { 0, 0 } },
+    { LIFTING_UPDATE, { 0.5, 0.0 }, { 0, 0 } }
+  },
+  M_SQRT2,
+  -M_SQRT1_2,
+  0,
+  0
+};
+
+/* Daubechies 4: one predict and two update steps */
+static const gsl_wavelet_lifting lifting_daubechies_4 = {
+  3,
+  {
+    { LIFTING_UPDATE, { 1.73205080756887729352744634151, 0.0 }, { 0, 0 } },
+    { LIFTING_PREDICT, { -0.43301270189221932338186158538, 0.06698729810778067661813841462 }, { 0, -1 } },
+    { LIFTING_UPDATE, { -1.0, 0.0 }, { 1, 0 } }
+  },
+  0.51763809020504152469779767525,
+  -1.93185165257813657349948639945,
+  0,
+  1
+};
+
+/* B-spline 2,2 (the 5/3 filter pair): linear prediction and update */
+static const gsl_wavelet_lifting lifting_bspline_202 = {
+  2,
+  {
+    { LIFTING_PREDICT, { -0.5, -0.5 }, { 0, 1 } },
+    { LIFTING_UPDATE, { 0.25, 0.25 }, { -1, 0 } }
+  },
+  M_SQRT2,
+  M_SQRT1_2,
+  1,
+  1
+};
+
+/*
+gsl_wavelet_lifting_find()
+  Look up the lifting factorization of a wavelet
+
+Inputs: T      - wavelet type
+        member - wavelet member
+
+Return: pointer to lifting factorization, or NULL if the wavelet has
+none, in which case the convolution form is used
+*/
+
+const gsl_wavelet_lifting *
+gsl_wavelet_lifting_find (const gsl_wavelet_type * T, size_t member)
+{
+  if (T == gsl_wavelet_haar || T == gsl_wavelet_haar_centered)
+    return &lifting_haar;
+  else if ((T == gsl_wavelet_daubechies || T == gsl_wavelet_daubechies_centered) && member == 4)
+    return &lifting_daubechies_4;
+  else if ((T == gsl_wavelet_bspline || T == gsl_wavelet_bspline_centered) && member == 202)
+    return &lifting_bspline_202;
+  else
+    return NULL;
+}
+
+/*
+gsl_wavelet_lifting_step()
+  Perform one level of the wavelet transform with lifting steps
+
+Inputs: w      - wavelet, with w->lifting != NULL
+        a      - data, length n
+        stride - stride of a
+        n      - length of current level, a power of 2
+        dir    - direction of transform
+        work   - workspace, length at least n
+
+Notes:
+1) The even and odd samples are separated into the two halves of the
+scratch space, where the lifting steps are applied in place, at a cost
+of a few operations per sample instead of w->nc for the convolution
+*/
+
+void
+gsl_wavelet_lifting_step (const gsl_wavelet * w, double *a, size_t stride, size_t n,
+                          gsl_wavelet_direction dir, gsl_wavelet_workspace * work)
+{
+  const gsl_wavelet_lifting * L = w->lifting;
+  const size_t nh = n >> 1;
+  const size_t mask = nh - 1;
+  const size_t nmask = n - 1;
+  const size_t shift = n - (w->offset & nmask);
+  double * e = work->scratch;
+  double * o = work->scratch + nh;
+  size_t i, j;
+
+  if (dir == gsl_wavelet_forward)
+    {
+      for (j = 0; j < nh; ++j)
+        {
+          e[j] = ELEMENT (a, stride, (2 * j + shift) & nmask);
+          o[j] = ELEMENT (a, stride, (2 * j + 1 + shift) & nmask);
+        }
+
+      for (i = 0; i < L->nsteps; ++i)
+        {
+          const lifting_step * step = &(L->step[i]);
+
+          if (step->type == LIFTING_PREDICT)
+            lifting_apply (o, e, nh, step, 1.0);
+          else
+            lifting_apply (e, o, nh, step, 1.0);
+        }
+
+      for (j = 0; j < nh; ++j)
+        {
+          ELEMENT (a, stride, j) = L->ks * e[LIFTING_INDEX (j, L->ss, mask)];
+          ELEMENT (a, stride, j + nh) = L->kd * o[LIFTING_INDEX (j, L->sd, mask)];
+        }
+    }
+  else
+    {
+      const double ks_inv = 1.0 / L->ks;
+      const double kd_inv = 1.0 / L->kd;
+
+      for (j = 0; j < nh; ++j)
+        {
+          e[LIFTING_INDEX (j, L->ss, mask)] = ks_inv * ELEMENT (a, stride, j);
+          o[LIFTING_INDEX (j, L->sd, mask)] = kd_inv * ELEMENT (a, stride, j + nh);
+        }
+
+      for (i = L->nsteps; i-- > 0; )
+        {
+          const lifting_step * step = &(L->step[i]);
+
+          if (step->type == LIFTING_PREDICT)
+            lifting_apply (o, e, nh, step, -1.0);
+          else
+            lifting_apply (e, o, nh, step, -1.0);
+        }
+
+      for (j = 0; j < nh; ++j)
+        {
+          ELEMENT (a, stride, (2 * j + shift) & nmask) = e[j];
+          ELEMENT (a, stride, (2 * j + 1 + shift) & nmask) = o[j];
+        }
+    }
+}
+
+/* x[j] += sign * (c0 * y[j + s0] + c1 * y[j + s1]), with periodic
+   indices; the interior is done without wrapping */
+
+static void
+lifting_apply (double *x, const double *y, const size_t m,
+               const lifting_step * step, const double sign)
+{
+  const size_t mask = m - 1;
+  const double c0 = sign * step->c[0];
+  const double c1 = sign * step->c[1];
+  const int s0 = step->shift[0];
+  const int s1 = step->shift[1];
+  size_t j;
+
+  if (m < 3)
+    {
+      for (j = 0; j < m; ++j)
+        x[j] += c0 * y[LIFTING_INDEX (j, s0, mask)] + c1 * y[LIFTING_INDEX (j, s1, mask)];
+
+      return;
+    }
+
+  x[0] += c0 * y[LIFTING_INDEX (0, s0, mask)] + c1 * y[LIFTING_INDEX (0, s1, mask)];
+
+  for (j = 1; j < m - 1; ++j)
+    x[j] += c0 * y[j + s0] + c1 * y[j + s1];
+
+  x[m - 1] += c0 * y[LIFTING_INDEX (m - 1, s0, mask)] + c1 * y[LIFTING_INDEX (m - 1, s1, mask)];
+}
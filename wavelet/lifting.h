@@ -0,0 +1,67 @@
+/* wavelet/lifting.h
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_WAVELET_LIFTING_H__
+#define __GSL_WAVELET_LIFTING_H__
+
+#include <gsl/gsl_wavelet.h>
+
+/* maximum number of lifting steps in a factorization */
+#define LIFTING_MAX_STEPS     4
+
+/*
+ * A lifting step adds a two-tap filter of one polyphase component to
+ * the other,
+ *
+ * x[j] += c[0] * y[j + shift[0]] + c[1] * y[j + shift[1]]
+ *
+ * with indices taken modulo the length of the components. For an
+ * update step x is the even component and y the odd one, for a
+ * predict step the roles are reversed.
+ */
+
+enum
+{
+  LIFTING_PREDICT,
+  LIFTING_UPDATE
+};
+
+typedef struct
+{
+  int type;                   /* LIFTING_PREDICT or LIFTING_UPDATE */
+  double c[2];                /* filter coefficients */
+  int shift[2];               /* filter taps, in {-1, 0, 1} */
+} lifting_step;
+
+struct gsl_wavelet_lifting_struct
+{
+  size_t nsteps;                          /* number of lifting steps */
+  lifting_step step[LIFTING_MAX_STEPS];   /* lifting steps, in forward order */
+  double ks;                              /* scaling of smooth coefficients */
+  double kd;                              /* scaling of detail coefficients */
+  int ss;                                 /* shift of smooth coefficients */
+  int sd;                                 /* shift of detail coefficients */
+};
+
+const gsl_wavelet_lifting *gsl_wavelet_lifting_find (const gsl_wavelet_type * T, size_t member);
+
+void gsl_wavelet_lifting_step (const gsl_wavelet * w, double *a, size_t stride, size_t n,
+                               gsl_wavelet_direction dir, gsl_wavelet_workspace * work);
+
+#endif /* __GSL_WAVELET_LIFTING_H__ */
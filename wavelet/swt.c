@@ -0,0 +1,480 @@
+/* wavelet/swt.c
+ *
+ * Copyright (C) 2021 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Stationary (undecimated) wavelet transform. Level j of the transform
+ * applies the filters of the wavelet, dilated by 2^{j-1} and scaled by
+ * 1/sqrt(2), to the smooth coefficients of level j-1 without
+ * decimation,
+ *
+ * s_j(t) = 1/sqrt(2) sum_k h1[k] s_{j-1}(t + (k - offset) 2^{j-1})
+ * d_j(t) = 1/sqrt(2) sum_k g1[k] s_{j-1}(t + (k - offset) 2^{j-1})
+ *
+ * with s_0 = x, so that every level has the length n of the input. The
+ * coefficients of the decimated transform of gsl_wavelet_transform()
+ * are 2^{j/2} d_j(2^j i). The inverse applies the synthesis filters
+ * h2, g2 in the same way.
+ */
+
+#include <config.h>
+#include <string.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_wavelet.h>
+#include <gsl/gsl_wavelet_swt.h>
+
+#define ELEMENT(a,stride,i) ((a)[(stride)*(i)])
+
+static size_t swt_dilation (const size_t j, const size_t n);
+static size_t swt_shift (const size_t k, const size_t offset, const size_t step, const size_t n);
+static void swt_analysis (const gsl_wavelet * w, const size_t step, const double * x,
+                          const size_t n, double * s, double * d);
+static void swt_synthesis (const gsl_wavelet * w, const size_t step, const double * s,
+                           const size_t stride, const double * d, const size_t n, double * x);
+
+/*
+gsl_wavelet_swt_forward()
+  Compute the stationary wavelet transform of a signal
+
+Inputs: w    - wavelet
+        x    - input signal, length n
+        W    - (output) wavelet coefficients, (J+1)-by-n, where J is the
+               number of levels. Row j-1 contains the detail coefficients
+               d_j of level j = 1,...,J and row J the smooth coefficients
+               s_J
+        work - workspace, length at least n
+
+Return: success/error
+
+Notes:
+1) The signal is extended periodically, and n may be any length
+*/
+
+int
+gsl_wavelet_swt_forward (const gsl_wavelet * w, const gsl_vector * x,
+                         gsl_matrix * W, gsl_wavelet_workspace * work)
+{
+  const size_t n = x->size;
+
+  if (W->size2 != n)
+    {
+      GSL_ERROR ("matrix columns must match signal length", GSL_EBADLEN);
+    }
+  else if (W->size1 == 0)
+    {
+      GSL_ERROR ("matrix must have at least one row", GSL_EBADLEN);
+    }
+  else if (work->n < n)
+    {
+      GSL_ERROR ("not enough workspace provided", GSL_EINVAL);
+    }
+  else if (n == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t J = W->size1 - 1;
+      gsl_vector_view s = gsl_matrix_row (W, J);
+      size_t j;
+
+      gsl_vector_memcpy (&s.vector, x);
+
+      for (j = 1; j <= J; ++j)
+        {
+          double * d = gsl_matrix_ptr (W, j - 1, 0);
+
+          swt_analysis (w, swt_dilation (j, n), s.vector.data, n, work->scratch, d);
+          memcpy (s.vector.data, work->scratch, n * sizeof (double));
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_wavelet_swt_inverse()
+  Invert the stationary wavelet transform
+
+Inputs: w    - wavelet
+        W    - wavelet coefficients, (J+1)-by-n, as computed by
+               gsl_wavelet_swt_forward()
+        x    - (output) signal, length n
+        work - workspace, length at least n
+
+Return: success/error
+*/
+
+int
+gsl_wavelet_swt_inverse (const gsl_wavelet * w, const gsl_matrix * W,
+                         gsl_vector * x, gsl_wavelet_workspace * work)
+{
+  const size_t n = x->size;
+
+  if (W->size2 != n)
+    {
+      GSL_ERROR ("matrix columns must match signal length", GSL_EBADLEN);
+    }
+  else if (W->size1 == 0)
+    {
+      GSL_ERROR ("matrix must have at least one row", GSL_EBADLEN);
+    }
+  else if (work->n < n)
+    {
+      GSL_ERROR ("not enough workspace provided", GSL_EINVAL);
+    }
+  else if (n == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const size_t J = W->size1 - 1;
+      gsl_vector_const_view s = gsl_matrix_const_row (W, J);
+      gsl_vector_view v = gsl_vector_view_array (work->scratch, n);
+      size_t j;
+
+      gsl_vector_memcpy (x, &s.vector);
+
+      for (j = J; j >= 1; --j)
+        {
+          const double * d = gsl_matrix_const_ptr (W, j - 1, 0);
+
+          swt_synthesis (w, swt_dilation (j, n), x->data, x->stride, d, n, work->scratch);
+          gsl_vector_memcpy (x, &v.vector);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_wavelet_swt_stream_alloc()
+  Allocate a workspace for computing the stationary wavelet transform
+of a signal supplied in chunks
+
+Inputs: w       - wavelet
+        nlevels - number of levels J
+        nmax    - maximum length of a chunk
+
+Return: pointer to workspace
+
+Notes:
+1) The memory required is proportional to nc 2^J + J nmax, independent
+of the total length of the signal
+*/
+
+gsl_wavelet_swt_stream_workspace *
+gsl_wavelet_swt_stream_alloc (const gsl_wavelet * w, const size_t nlevels,
+                              const size_t nmax)
+{
+  gsl_wavelet_swt_stream_workspace * stream;
+  size_t j, total = 0;
+
+  if (nlevels == 0)
+    {
+      GSL_ERROR_NULL ("number of levels must be positive", GSL_EDOM);
+    }
+  else if (nmax == 0)
+    {
+      GSL_ERROR_NULL ("chunk length must be positive", GSL_EDOM);
+    }
+
+  stream = calloc (1, sizeof (gsl_wavelet_swt_stream_workspace));
+  if (stream == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  stream->nlevels = nlevels;
+  stream->nmax = nmax;
+  stream->nc = w->nc;
+  stream->offset = w->offset;
+
+  stream->hlen = malloc (nlevels * sizeof (size_t));
+  stream->dlen = malloc (nlevels * sizeof (size_t));
+  stream->hist = malloc (nlevels * sizeof (double *));
+  stream->dline = malloc (nlevels * sizeof (double *));
+
+  if (stream->hlen == NULL || stream->dlen == NULL ||
+      stream->hist == NULL || stream->dline == NULL)
+    {
+      gsl_wavelet_swt_stream_free (stream);
+      GSL_ERROR_NULL ("failed to allocate level arrays", GSL_ENOMEM);
+    }
+
+  /* level j+1 looks ahead by (nc - 1 - offset) 2^j samples of level j,
+     so its outputs lag the input by D_j = (nc - 1 - offset)(2^{j+1} - 1);
+     the details of the lower levels are delayed to match level J */
+
+  for (j = 0; j < nlevels; ++j)
+    {
+      const size_t step = (size_t) 1 << j;
+      stream->hlen[j] = (w->nc - 1) * step;
+    }
+
+  stream->delay = (w->nc - 1 - w->offset) * (((size_t) 1 << nlevels) - 1);
+
+  for (j = 0; j < nlevels; ++j)
+    {
+      const size_t Dj = (w->nc - 1 - w->offset) * (((size_t) 1 << (j + 1)) - 1);
+      stream->dlen[j] = stream->delay - Dj;
+      total += stream->hlen[j] + stream->dlen[j] + 2 * nmax;
+    }
+
+  stream->buf = calloc (total, sizeof (double));
+  if (stream->buf == NULL)
+    {
+      gsl_wavelet_swt_stream_free (stream);
+      GSL_ERROR_NULL ("failed to allocate buffers", GSL_ENOMEM);
+    }
+
+  total = 0;
+  for (j = 0; j < nlevels; ++j)
+    {
+      stream->hist[j] = stream->buf + total;
+      total += stream->hlen[j] + nmax;
+
+      stream->dline[j] = stream->buf + total;
+      total += stream->dlen[j] + nmax;
+    }
+
+  return stream;
+}
+
+void
+gsl_wavelet_swt_stream_free (gsl_wavelet_swt_stream_workspace * stream)
+{
+  RETURN_IF_NULL (stream);
+
+  if (stream->hlen)
+    free (stream->hlen);
+
+  if (stream->dlen)
+    free (stream->dlen);
+
+  if (stream->hist)
+    free (stream->hist);
+
+  if (stream->dline)
+    free (stream->dline);
+
+  if (stream->buf)
+    free (stream->buf);
+
+  free (stream);
+}
+
+/* clear the history, to start a new signal */
+
+int
+gsl_wavelet_swt_stream_reset (gsl_wavelet_swt_stream_workspace * stream)
+{
+  size_t j;
+
+  for (j = 0; j < stream->nlevels; ++j)
+    {
+      memset (stream->hist[j], 0, stream->hlen[j] * sizeof (double));
+      memset (stream->dline[j], 0, stream->dlen[j] * sizeof (double));
+    }
+
+  return GSL_SUCCESS;
+}
+
+size_t
+gsl_wavelet_swt_stream_delay (const gsl_wavelet_swt_stream_workspace * stream)
+{
+  return stream->delay;
+}
+
+/*
+gsl_wavelet_swt_stream_apply()
+  Compute the stationary wavelet transform of the next chunk of a
+signal
+
+Inputs: w      - wavelet, the same as given to gsl_wavelet_swt_stream_alloc()
+        x      - next chunk of input, length m <= nmax
+        W      - (output) wavelet coefficients, (J+1)-by-m, in the layout of
+                 gsl_wavelet_swt_forward()
+        stream - workspace
+
+Return: success/error
+
+Notes:
+1) Column i of W holds the coefficients at time t - delay, where t is
+the position of x[i] in the signal and delay is given by
+gsl_wavelet_swt_stream_delay(). These are the coefficients which
+gsl_wavelet_swt_forward() computes for the signal extended by zeros,
+rather than periodically; the first delay columns correspond to times
+before the start of the signal
+*/
+
+int
+gsl_wavelet_swt_stream_apply (const gsl_wavelet * w, const gsl_vector * x, gsl_matrix * W,
+                              gsl_wavelet_swt_stream_workspace * stream)
+{
+  const size_t m = x->size;
+  const size_t J = stream->nlevels;
+
+  if (m > stream->nmax)
+    {
+      GSL_ERROR ("chunk is longer than nmax", GSL_EBADLEN);
+    }
+  else if (W->size1 != J + 1 || W->size2 != m)
+    {
+      GSL_ERROR ("matrix must be (J+1)-by-m", GSL_EBADLEN);
+    }
+  else if (w->nc != stream->nc || w->offset != stream->offset)
+    {
+      GSL_ERROR ("wavelet does not match workspace", GSL_EINVAL);
+    }
+  else if (m == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      size_t i, j, k;
+
+      for (i = 0; i < m; ++i)
+        stream->hist[0][stream->hlen[0] + i] = gsl_vector_get (x, i);
+
+      for (j = 0; j < J; ++j)
+        {
+          const size_t step = (size_t) 1 << j;
+          const double * u = stream->hist[j];
+          double * d = stream->dline[j] + stream->dlen[j];
+          double * s = (j + 1 < J) ? stream->hist[j + 1] + stream->hlen[j + 1] :
+                                     gsl_matrix_ptr (W, J, 0);
+
+          /* causal form of the filters: u[hlen + i] is the newest sample */
+          for (i = 0; i < m; ++i)
+            s[i] = d[i] = 0.0;
+
+          for (k = 0; k < w->nc; ++k)
+            {
+              const double hk = M_SQRT1_2 * w->h1[k];
+              const double gk = M_SQRT1_2 * w->g1[k];
+              const double * uk = u + k * step;
+
+              for (i = 0; i < m; ++i)
+                {
+                  s[i] += hk * uk[i];
+                  d[i] += gk * uk[i];
+                }
+            }
+
+          memmove (stream->hist[j], stream->hist[j] + m, stream->hlen[j] * sizeof (double));
+
+          /* delayed detail coefficients */
+          for (i = 0; i < m; ++i)
+            gsl_matrix_set (W, j, i, stream->dline[j][i]);
+
+          memmove (stream->dline[j], stream->dline[j] + m, stream->dlen[j] * sizeof (double));
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* dilation 2^{j-1} of level j modulo n, which is all that is needed
+   for periodic indices and does not overflow for large j */
+
+static size_t
+swt_dilation (const size_t j, const size_t n)
+{
+  size_t i, step = 1 % n;
+
+  for (i = 1; i < j; ++i)
+    step = (2 * step) % n;
+
+  return step;
+}
+
+/* offset o in [0,n) such that x(t + (k - offset) step) = x[(t + o) mod n] */
+
+static size_t
+swt_shift (const size_t k, const size_t offset, const size_t step, const size_t n)
+{
+  const size_t a = (k % n) * step % n;
+  const size_t b = (offset % n) * step % n;
+
+  return (a + n - b) % n;
+}
+
+/* one level of the forward transform, x -> (s, d); x must not overlap
+   s or d */
+
+static void
+swt_analysis (const gsl_wavelet * w, const size_t step, const double * x,
+              const size_t n, double * s, double * d)
+{
+  size_t k, t;
+
+  for (t = 0; t < n; ++t)
+    s[t] = d[t] = 0.0;
+
+  for (k = 0; k < w->nc; ++k)
+    {
+      const size_t o = swt_shift (k, w->offset, step, n);
+      const double hk = M_SQRT1_2 * w->h1[k];
+      const double gk = M_SQRT1_2 * w->g1[k];
+
+      for (t = 0; t < n - o; ++t)
+        {
+          s[t] += hk * x[t + o];
+          d[t] += gk * x[t + o];
+        }
+
+      for (; t < n; ++t)
+        {
+          s[t] += hk * x[t + o - n];
+          d[t] += gk * x[t + o - n];
+        }
+    }
+}
+
+/* one level of the inverse transform, (s, d) -> x; s has stride
+   stride, and x must not overlap s or d */
+
+static void
+swt_synthesis (const gsl_wavelet * w, const size_t step, const double * s,
+               const size_t stride, const double * d, const size_t n, double * x)
+{
+  size_t k, t;
+
+  for (t = 0; t < n; ++t)
+    x[t] = 0.0;
+
+  for (k = 0; k < w->nc; ++k)
+    {
+      /* x(t) receives s(t - (k - offset) step) */
+      const size_t o = (n - swt_shift (k, w->offset, step, n)) % n;
+      const double hk = M_SQRT1_2 * w->h2[k];
+      const double gk = M_SQRT1_2 * w->g2[k];
+
+      for (t = 0; t < n - o; ++t)
+        x[t] += hk * ELEMENT (s, stride, t + o) + gk * d[t + o];
+
+      for (; t < n; ++t)
+        x[t] += hk * ELEMENT (s, stride, t + o - n) + gk * d[t + o - n];
+    }
+}
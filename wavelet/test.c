@@ -3,12 +3,14 @@
 #include <math.h>
 
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_test.h>
 
 #include <gsl/gsl_wavelet.h>
 #include <gsl/gsl_wavelet2d.h>
+#include <gsl/gsl_wavelet_swt.h>
 
 #define N_BS 11
 
@@ -31,6 +33,18 @@ test_1d (size_t N, size_t stride, const gsl_wavelet_type * T, size_t member);
 void
 test_2d (size_t N, size_t tda, const gsl_wavelet_type * T, size_t member, int type);
 
+void
+test_lifting (size_t N, const gsl_wavelet_type * T, size_t member);
+
+void
+test_2d_block (size_t N, size_t tda, const gsl_wavelet_type * T, size_t member, int type);
+
+void
+test_swt (size_t N, size_t J, const gsl_wavelet_type * T, size_t member);
+
+void
+test_swt_stream (size_t N, size_t J, size_t nmax, const gsl_wavelet_type * T, size_t member);
+
 int
 main (int argc, char **argv)
 {
@@ -105,6 +119,63 @@ main (int argc, char **argv)
         }
     }
 
+  /* Lifting steps against convolution */
+
+  for (N = 1; N <= 1024; N *= 2)
+    {
+      test_lifting (N, gsl_wavelet_haar, 2);
+      test_lifting (N, gsl_wavelet_haar_centered, 2);
+      test_lifting (N, gsl_wavelet_daubechies, 4);
+      test_lifting (N, gsl_wavelet_daubechies_centered, 4);
+      test_lifting (N, gsl_wavelet_bspline, 202);
+      test_lifting (N, gsl_wavelet_bspline_centered, 202);
+    }
+
+  /* Blocked two-dimensional transforms, with matrices spanning several
+     blocks of columns */
+
+  for (N = 1; N <= 128; N *= 2)
+    {
+      for (tda = N; tda <= N + 3; tda++)
+        {
+          test_2d_block (N, tda, gsl_wavelet_daubechies, 4, S);
+          test_2d_block (N, tda, gsl_wavelet_daubechies, 4, NS);
+          test_2d_block (N, tda, gsl_wavelet_daubechies_centered, 10, S);
+          test_2d_block (N, tda, gsl_wavelet_daubechies_centered, 10, NS);
+          test_2d_block (N, tda, gsl_wavelet_bspline_centered, 202, S);
+          test_2d_block (N, tda, gsl_wavelet_bspline_centered, 202, NS);
+        }
+    }
+
+  /* Stationary transforms of arbitrary length */
+
+  {
+    const size_t swt_lengths[] = { 1, 2, 7, 16, 100, 128, 1000, 0 };
+
+    for (i = 0; swt_lengths[i] != 0; i++)
+      {
+        size_t J;
+
+        N = swt_lengths[i];
+
+        for (J = 0; J <= 6; J += 2)
+          {
+            test_swt (N, J, gsl_wavelet_haar, 2);
+            test_swt (N, J, gsl_wavelet_daubechies, 4);
+            test_swt (N, J, gsl_wavelet_daubechies_centered, 10);
+            test_swt (N, J, gsl_wavelet_bspline, 103);
+            test_swt (N, J, gsl_wavelet_bspline_centered, 309);
+            test_swt (N, J, gsl_wavelet_coiflet, 2);
+            test_swt (N, J, gsl_wavelet_coiflet_centered, 1);
+          }
+      }
+
+    test_swt_stream (500, 1, 1, gsl_wavelet_haar, 2);
+    test_swt_stream (500, 3, 17, gsl_wavelet_daubechies_centered, 6);
+    test_swt_stream (1000, 5, 64, gsl_wavelet_bspline_centered, 202);
+    test_swt_stream (1000, 4, 100, gsl_wavelet_coiflet, 2);
+  }
+
   exit (gsl_test_summary ());
 }
 
@@ -281,3 +352,230 @@ test_2d (size_t N, size_t tda, const gsl_wavelet_type * T, size_t member, int ty
   gsl_matrix_free (m2);
   gsl_matrix_free (mdelta);
 }
+
+
+void
+test_lifting (size_t N, const gsl_wavelet_type * T, size_t member)
+{
+  gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (N);
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  gsl_wavelet wconv = *w;
+  double *x = (double *)malloc (N * sizeof (double));
+  double *y = (double *)malloc (N * sizeof (double));
+  double maxerr = 0.0;
+  size_t i;
+
+  /* the same wavelet, using the convolution form */
+  wconv.lifting = NULL;
+
+  gsl_test (w->lifting == NULL, "%s(%d) has lifting steps",
+            gsl_wavelet_name (w), member);
+
+  for (i = 0; i < N; i++)
+    x[i] = y[i] = urand ();
+
+  gsl_wavelet_transform_forward (w, x, 1, N, work);
+  gsl_wavelet_transform_forward (&wconv, y, 1, N, work);
+
+  for (i = 0; i < N; i++)
+    maxerr = GSL_MAX (maxerr, fabs (x[i] - y[i]));
+
+  gsl_test (maxerr > N * 1e-15,
+            "%s(%d) lifting forward, n = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, N, maxerr);
+
+  maxerr = 0.0;
+
+  for (i = 0; i < N; i++)
+    x[i] = y[i] = urand ();
+
+  gsl_wavelet_transform_inverse (w, x, 1, N, work);
+  gsl_wavelet_transform_inverse (&wconv, y, 1, N, work);
+
+  for (i = 0; i < N; i++)
+    maxerr = GSL_MAX (maxerr, fabs (x[i] - y[i]));
+
+  gsl_test (maxerr > N * 1e-15,
+            "%s(%d) lifting inverse, n = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, N, maxerr);
+
+  gsl_wavelet_workspace_free (work);
+  gsl_wavelet_free (w);
+  free (x);
+  free (y);
+}
+
+
+void
+test_2d_block (size_t N, size_t tda, const gsl_wavelet_type * T, size_t member, int type)
+{
+  gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (N);
+  gsl_wavelet_workspace *bwork = gsl_wavelet2d_workspace_alloc (N);
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  double *data1 = (double *)malloc (N * tda * sizeof (double));
+  double *data2 = (double *)malloc (N * tda * sizeof (double));
+  const char * name = (type == 1) ? "standard" : "nonstd" ;
+  int dir, status = 0;
+  size_t i;
+
+  for (i = 0; i < N * tda; i++)
+    data1[i] = data2[i] = urand ();
+
+  /* the blocked transform performs the same operations on each column,
+     so the results must be identical */
+
+  for (dir = 0; dir < 2; dir++)
+    {
+      gsl_wavelet_direction d = dir ? gsl_wavelet_backward : gsl_wavelet_forward;
+
+      if (type == 1)
+        {
+          gsl_wavelet2d_transform (w, data1, tda, N, N, d, work);
+          gsl_wavelet2d_transform (w, data2, tda, N, N, d, bwork);
+        }
+      else
+        {
+          gsl_wavelet2d_nstransform (w, data1, tda, N, N, d, work);
+          gsl_wavelet2d_nstransform (w, data2, tda, N, N, d, bwork);
+        }
+
+      for (i = 0; i < N * tda; i++)
+        status |= (data1[i] != data2[i]);
+    }
+
+  gsl_test (status, "%s(%d)-2d %s blocked, n = %d, tda = %d",
+            gsl_wavelet_name (w), member, name, N, tda);
+
+  gsl_wavelet_workspace_free (work);
+  gsl_wavelet_workspace_free (bwork);
+  gsl_wavelet_free (w);
+  free (data1);
+  free (data2);
+}
+
+
+void
+test_swt (size_t N, size_t J, const gsl_wavelet_type * T, size_t member)
+{
+  gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (N);
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  gsl_vector *x = gsl_vector_alloc (N);
+  gsl_vector *y = gsl_vector_alloc (2 * N);
+  gsl_vector_view yv = gsl_vector_subvector_with_stride (y, 1, 2, N);
+  gsl_matrix *W = gsl_matrix_alloc (J + 1, N);
+  double maxerr = 0.0;
+  size_t i;
+
+  /* the coiflet filters are only orthonormal to about 1e-11 */
+  const double tol = (T == gsl_wavelet_coiflet || T == gsl_wavelet_coiflet_centered) ? 1e-10 : 1e-12;
+
+  for (i = 0; i < N; i++)
+    gsl_vector_set (x, i, urand ());
+
+  /* reconstruct into a vector with stride */
+  gsl_wavelet_swt_forward (w, x, W, work);
+  gsl_wavelet_swt_inverse (w, W, &yv.vector, work);
+
+  for (i = 0; i < N; i++)
+    maxerr = GSL_MAX (maxerr, fabs (gsl_vector_get (x, i) - gsl_vector_get (&yv.vector, i)));
+
+  gsl_test (maxerr > tol, "%s(%d) swt, n = %d, J = %d, maxerr = %g",
+            gsl_wavelet_name (w), member, N, J, maxerr);
+
+  /* for n = 2^J the decimated transform samples the stationary one */
+  if (N == ((size_t) 1 << J) && J > 0)
+    {
+      size_t j, k;
+      double scale = 1.0;
+
+      gsl_wavelet_transform_forward (w, x->data, x->stride, N, work);
+      maxerr = 0.0;
+
+      for (j = 1; j <= J; j++)
+        {
+          const size_t nj = N >> j;
+
+          scale *= M_SQRT2;
+
+          for (k = 0; k < nj; k++)
+            {
+              double dwt = gsl_vector_get (x, nj + k);
+              double swt = scale * gsl_matrix_get (W, j - 1, k << j);
+              maxerr = GSL_MAX (maxerr, fabs (dwt - swt));
+            }
+        }
+
+      maxerr = GSL_MAX (maxerr, fabs (gsl_vector_get (x, 0) - scale * gsl_matrix_get (W, J, 0)));
+
+      gsl_test (maxerr > tol, "%s(%d) swt matches dwt, n = %d, maxerr = %g",
+                gsl_wavelet_name (w), member, N, maxerr);
+    }
+
+  gsl_wavelet_workspace_free (work);
+  gsl_wavelet_free (w);
+  gsl_vector_free (x);
+  gsl_vector_free (y);
+  gsl_matrix_free (W);
+}
+
+
+void
+test_swt_stream (size_t N, size_t J, size_t nmax, const gsl_wavelet_type * T, size_t member)
+{
+  gsl_wavelet *w = gsl_wavelet_alloc (T, member);
+  gsl_wavelet_swt_stream_workspace *stream = gsl_wavelet_swt_stream_alloc (w, J, nmax);
+  const size_t delay = gsl_wavelet_swt_stream_delay (stream);
+  const size_t pad = w->nc << J;
+  gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (N + 2 * pad);
+  gsl_vector *x = gsl_vector_calloc (N + 2 * pad);
+  gsl_matrix *W = gsl_matrix_alloc (J + 1, N + 2 * pad);
+  gsl_matrix *Ws = gsl_matrix_alloc (J + 1, N);
+  gsl_vector_view xv = gsl_vector_subvector (x, pad, N);
+  size_t pass, i;
+
+  for (i = 0; i < N; i++)
+    gsl_vector_set (&xv.vector, i, urand ());
+
+  /* the stream computes the transform of the signal extended by zeros */
+  gsl_wavelet_swt_forward (w, x, W, work);
+
+  /* the second pass checks that reset clears the history */
+  for (pass = 0; pass < 2; pass++)
+    {
+      double maxerr = 0.0;
+      size_t i0 = 0, j;
+
+      while (i0 < N)
+        {
+          const size_t r = (size_t) (urand () * nmax) + 1;
+          const size_t len = GSL_MIN (r, N - i0);
+          gsl_vector_view xc = gsl_vector_subvector (&xv.vector, i0, len);
+          gsl_matrix_view Wc = gsl_matrix_submatrix (Ws, 0, i0, J + 1, len);
+
+          gsl_wavelet_swt_stream_apply (w, &xc.vector, &Wc.matrix, stream);
+          i0 += len;
+        }
+
+      for (j = 0; j <= J; j++)
+        {
+          for (i = 0; i < N; i++)
+            {
+              double y = gsl_matrix_get (Ws, j, i);
+              double yb = gsl_matrix_get (W, j, pad + i - delay);
+              maxerr = GSL_MAX (maxerr, fabs (y - yb));
+            }
+        }
+
+      gsl_test (maxerr > 1e-12, "%s(%d) swt stream pass = %d, n = %d, J = %d, nmax = %d, maxerr = %g",
+                gsl_wavelet_name (w), member, pass, N, J, nmax, maxerr);
+
+      gsl_wavelet_swt_stream_reset (stream);
+    }
+
+  gsl_wavelet_swt_stream_free (stream);
+  gsl_wavelet_workspace_free (work);
+  gsl_wavelet_free (w);
+  gsl_vector_free (x);
+  gsl_matrix_free (W);
+  gsl_matrix_free (Ws);
+}
@@ -21,6 +21,9 @@
 #include <stdlib.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_wavelet.h>
+#include <gsl/gsl_wavelet2d.h>
+
+#include "lifting.h"
 
 gsl_wavelet *
 gsl_wavelet_alloc (const gsl_wavelet_type * T, size_t k)
@@ -46,6 +49,9 @@ gsl_wavelet_alloc (const gsl_wavelet_type * T, size_t k)
       GSL_ERROR_VAL ("invalid wavelet member", GSL_EINVAL, 0);
     }
 
+  /* use lifting steps instead of the convolution where available */
+  w->lifting = gsl_wavelet_lifting_find (T, k);
+
   return w;
 }
 
@@ -111,6 +117,7 @@ gsl_wavelet_workspace_alloc (size_t n)
     }
 
   work->n = n;
+  work->block = NULL;
   work->scratch = (double *) malloc (n * sizeof (double));
 
   if (work->scratch == NULL)
@@ -130,5 +137,43 @@ gsl_wavelet_workspace_free (gsl_wavelet_workspace * work)
   /* release scratch space */
   free (work->scratch);
   work->scratch = NULL;
+  free (work->block);
   free (work);
 }
+
+/*
+gsl_wavelet2d_workspace_alloc()
+  Allocate a workspace for 2d transforms of n-by-n matrices which
+processes the columns in blocks
+
+Inputs: n - matrix dimension
+
+Return: pointer to workspace
+
+Notes:
+1) In addition to the scratch space of gsl_wavelet_workspace_alloc(),
+the workspace holds GSL_WAVELET2D_BLOCK columns of length n, which are
+copied to contiguous storage and transformed together. This avoids
+a cache miss for every element of a column of a large matrix
+*/
+
+gsl_wavelet_workspace *
+gsl_wavelet2d_workspace_alloc (size_t n)
+{
+  gsl_wavelet_workspace *work = gsl_wavelet_workspace_alloc (n);
+
+  if (work == NULL)
+    {
+      GSL_ERROR_VAL ("failed to allocate workspace", GSL_ENOMEM, 0);
+    }
+
+  work->block = (double *) malloc (GSL_WAVELET2D_BLOCK * n * sizeof (double));
+
+  if (work->block == NULL)
+    {
+      gsl_wavelet_workspace_free (work);
+      GSL_ERROR_VAL ("failed to allocate block space", GSL_ENOMEM, 0);
+    }
+
+  return work;
+}